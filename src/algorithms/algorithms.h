@@ -7,6 +7,7 @@
 #pragma once
 
 #include "./bfs.h"
+#include "./msbfs.h"
 #include "./dfs.h"
 #include "./all_paths.h"
 #include "./detect_cycle.h"
@@ -196,7 +196,7 @@ AllPathsCtx *AllPathsCtx_New
 	ctx->relationIDs    =  relationIDs;
 	ctx->relationCount  =  relationCount;
 	ctx->levels         =  array_new(LevelConnection *, 1);
-	ctx->path           =  Path_New(1);
+	ctx->path           =  Path_New(g, 1);
 	ctx->neighbors      =  array_new(Edge, 32);
 	ctx->dst            =  dst;
 	ctx->shortest_paths =  shortest_paths;
@@ -0,0 +1,77 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "./msbfs.h"
+
+GrB_Info MSBFS
+(
+	GrB_Matrix *levels,         // [output] per source reached levels
+	GrB_Matrix A,               // adjacency matrix, not modified
+	const GrB_Index *sources,   // source nodes
+	GrB_Index k,                // number of sources
+	int64_t max_level           // max level to reach, 0 for unlimited
+) {
+	ASSERT(A      != NULL);
+	ASSERT(levels != NULL);
+	ASSERT(k == 0 || sources != NULL);
+
+	GrB_Info info;
+	GrB_Index n;       // number of nodes
+	GrB_Index nvals;   // number of nodes discovered at current level
+	GrB_Matrix F;      // frontier, F[i, j] node j discovered by source i
+	GrB_Matrix L;      // levels, L[i, j] level at which source i reached j
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&F, GrB_BOOL, k, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_new(&L, GrB_INT64, k, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// both matrices are expected to be sparse
+	GxB_Matrix_Option_set(F, GxB_SPARSITY_CONTROL, GxB_SPARSE);
+	GxB_Matrix_Option_set(L, GxB_SPARSITY_CONTROL, GxB_SPARSE);
+
+	// initial frontier, each source discovers itself at level 0
+	for(GrB_Index i = 0; i < k; i++) {
+		ASSERT(sources[i] < n);
+		info = GrB_Matrix_setElement_BOOL(F, true, i, sources[i]);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_setElement_INT64(L, 0, i, sources[i]);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	for(int64_t level = 1; max_level == 0 || level <= max_level; level++) {
+		// F<!L> = F * A, advance all frontiers, skipping visited nodes
+		info = GrB_mxm(F, L, NULL, GxB_ANY_PAIR_BOOL, F, A, GrB_DESC_RSC);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_nvals(&nvals, F);
+		ASSERT(info == GrB_SUCCESS);
+
+		// all frontiers are depleted
+		if(nvals == 0) break;
+
+		// L<F> = level
+		info = GrB_Matrix_assign_INT64(L, F, NULL, level, GrB_ALL, k, GrB_ALL,
+				n, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// discard sources, the only entries at level 0
+	info = GxB_Matrix_select(L, NULL, NULL, GxB_NONZERO, L, NULL, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_wait(L, GrB_MATERIALIZE);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&F);
+	*levels = L;
+
+	return info;
+}
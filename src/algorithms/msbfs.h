@@ -0,0 +1,26 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// multi-source BFS
+// traverses 'A' from all sources at once, advancing a frontier matrix
+// holding one row per source, each level costs a single masked mxm
+//
+// on return 'levels' is a k x n INT64 matrix, where k is the number of
+// sources and n the dimension of 'A', levels[i, j] is the number of hops
+// separating source i from node j, only reachable nodes are present
+// sources themselves are not included
+GrB_Info MSBFS
+(
+	GrB_Matrix *levels,         // [output] per source reached levels
+	GrB_Matrix A,               // adjacency matrix, not modified
+	const GrB_Index *sources,   // source nodes
+	GrB_Index k,                // number of sources
+	int64_t max_level           // max level to reach, 0 for unlimited
+);
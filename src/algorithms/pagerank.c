@@ -69,6 +69,21 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	double tol,                 // stop when norm (r-rnew,2) < tol
 	int *iters                  // number of iterations taken
 ) {
+	return Pagerank_Personalized(Phandle, NULL, A, NULL, NULL, itermax, tol,
+			iters) ;
+}
+
+GrB_Info Pagerank_Personalized  // GrB_SUCCESS or error condition
+(
+	LAGraph_PageRank **Phandle, // output: array of LAGraph_PageRank structs
+	GrB_Vector *rank,           // optional output: dense FP32 rank of each node
+	GrB_Matrix A,               // binary input graph, not modified
+	GrB_Vector r0,              // optional initial ranking, warm start
+	GrB_Vector p,               // optional personalization weights
+	int itermax,                // max number of iterations
+	double tol,                 // stop when norm (r-rnew,2) < tol
+	int *iters                  // number of iterations taken
+) {
 
 	//--------------------------------------------------------------------------
 	// initializations
@@ -80,11 +95,12 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	LAGraph_PageRank *P = NULL ;
 	GrB_BinaryOp op_diff = NULL ;
 	GrB_Index n, nvals, *I = NULL ;
-	GrB_Vector r = NULL, t = NULL, d = NULL ;
+	GrB_Vector r = NULL, t = NULL, d = NULL, w = NULL ;
 	GrB_Matrix C = NULL, D = NULL, T = NULL ;
 
 	assert(Phandle);
 	(*Phandle) = NULL ;
+	if(rank != NULL) (*rank) = NULL ;
 
 	// n = size (A,1) ;         // number of nodes
 	assert(GrB_Matrix_nrows(&n, A) == GrB_SUCCESS) ;
@@ -99,6 +115,31 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	assert(GrB_Vector_new(&r, GrB_FP32, n) == GrB_SUCCESS) ;
 	assert(GrB_assign(r, NULL, NULL, x, GrB_ALL, n, NULL) == GrB_SUCCESS) ;
 
+	// warm start, r (i) = r0 (i) for all ranked nodes i, normalized
+	if(r0 != NULL) {
+		assert(GrB_assign(r, NULL, NULL, r0, GrB_ALL, n, NULL) == GrB_SUCCESS) ;
+		assert(GrB_reduce(&rsum, NULL, GxB_PLUS_FP32_MONOID, r, NULL) == GrB_SUCCESS) ;
+		if(rsum > 0) {
+			assert(GrB_Vector_assign_FP32(r, NULL, GrB_TIMES_FP32, 1 / rsum,
+						GrB_ALL, n, NULL) == GrB_SUCCESS) ;
+		}
+	}
+
+	// w = p / sum (p), personalized teleport weights
+	if(p != NULL) {
+		float psum ;
+		assert(GrB_Vector_new(&w, GrB_FP32, n) == GrB_SUCCESS) ;
+		assert(GrB_assign(w, NULL, NULL, p, GrB_ALL, n, NULL) == GrB_SUCCESS) ;
+		assert(GrB_reduce(&psum, NULL, GxB_PLUS_FP32_MONOID, w, NULL) == GrB_SUCCESS) ;
+		if(psum > 0) {
+			assert(GrB_Vector_assign_FP32(w, w, GrB_TIMES_FP32, 1 / psum,
+						GrB_ALL, n, GrB_DESC_S) == GrB_SUCCESS) ;
+		} else {
+			// no weight, fallback to uniform teleport
+			GrB_free(&w) ;
+		}
+	}
+
 	// d (i) = out deg of node i
 	assert(GrB_Vector_new(&d, GrB_FP32, n) == GrB_SUCCESS) ;
 	assert(GrB_reduce(d, NULL, NULL, GrB_PLUS_FP32, A, NULL) == GrB_SUCCESS) ;
@@ -172,9 +213,16 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 		// using the transpose of A, scaled (dot product)
 		assert(GrB_mxv(t, NULL, NULL, GxB_PLUS_TIMES_FP32, C, r, NULL) == GrB_SUCCESS) ;
 
-		// t += teleport_scalar ;
-		float teleport_scalar = teleport * rsum ;
-		assert(GrB_assign(t, NULL, GrB_PLUS_FP32, teleport_scalar, GrB_ALL, n, NULL) == GrB_SUCCESS) ;
+		if(w == NULL) {
+			// t += teleport_scalar ;
+			float teleport_scalar = teleport * rsum ;
+			assert(GrB_assign(t, NULL, GrB_PLUS_FP32, teleport_scalar, GrB_ALL, n, NULL) == GrB_SUCCESS) ;
+		} else {
+			// t += w * (1 - DAMPING) * sum (r) ;
+			float teleport_scalar = (one - DAMPING) * rsum ;
+			assert(GrB_Vector_apply_BinaryOp2nd_FP32(t, NULL, GrB_PLUS_FP32,
+						GrB_TIMES_FP32, w, teleport_scalar, NULL) == GrB_SUCCESS) ;
+		}
 		//----------------------------------------------------------------------
 		// rdiff = sum ((r-t).^2)
 		//----------------------------------------------------------------------
@@ -204,6 +252,11 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	// r = r / rsum
 	assert(GrB_Vector_assign_FP32(r, NULL, GrB_TIMES_FP32, 1 / rsum, GrB_ALL, n, NULL) == GrB_SUCCESS) ;
 
+	// hand a copy of the unsorted ranking back to the caller
+	if(rank != NULL) {
+		assert(GrB_Vector_dup(rank, r) == GrB_SUCCESS) ;
+	}
+
 	//--------------------------------------------------------------------------
 	// sort the nodes by pagerank
 	//--------------------------------------------------------------------------
@@ -249,6 +302,7 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	GrB_free(&r) ;
 	GrB_free(&t) ;
 	GrB_free(&d) ;
+	GrB_free(&w) ;
 	GrB_free(&op_diff) ;
 
 	return (GrB_SUCCESS) ;
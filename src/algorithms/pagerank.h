@@ -38,3 +38,19 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	double tol,                 // stop when norm (r-rnew,2) < tol
 	int *iters                  // number of iterations taken
 );
+
+// pagerank with an optional initial ranking and personalization weights
+// 'r0' may be sparse, missing entries start from 1/n, 'r0' is normalized
+// teleportation is restricted to the entries of 'p' in proportion to
+// their weights, a NULL 'p' teleports uniformly
+GrB_Info Pagerank_Personalized  // GrB_SUCCESS or error condition
+(
+	LAGraph_PageRank **Phandle, // output: array of LAGraph_PageRank structs
+	GrB_Vector *rank,           // optional output: dense FP32 rank of each node
+	GrB_Matrix A,               // binary input graph, not modified
+	GrB_Vector r0,              // optional initial ranking, warm start
+	GrB_Vector p,               // optional personalization weights
+	int itermax,                // max number of iterations
+	double tol,                 // stop when norm (r-rnew,2) < tol
+	int *iters                  // number of iterations taken
+);
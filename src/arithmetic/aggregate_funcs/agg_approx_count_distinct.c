@@ -0,0 +1,72 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "agg_funcs.h"
+#include "../func_desc.h"
+#include "../../util/arr.h"
+#include "../../util/sketch/hll.h"
+
+//------------------------------------------------------------------------------
+// ApproxCountDistinct
+//------------------------------------------------------------------------------
+
+// HyperLogLog based distinct count, unlike count(DISTINCT x)
+// values aren't retained, only their hashes are observed
+
+AggregateResult AGG_APPROX_COUNT_DISTINCT(SIValue *argv, int argc,
+		void *private_data) {
+	AggregateCtx *ctx = private_data;
+
+	SIValue v = argv[0];
+	if(SI_TYPE(v) == T_NULL) return AGGREGATE_OK;
+
+	// registers are allocated on first non-null value
+	if(ctx->private_data == NULL) ctx->private_data = HLL_New();
+
+	HLL_Add(ctx->private_data, SIValue_HashCode(v));
+
+	return AGGREGATE_OK;
+}
+
+void ApproxCountDistinctFinalize(void *ctx_ptr) {
+	AggregateCtx *ctx = ctx_ptr;
+	HLL *hll = ctx->private_data;
+	if(hll == NULL) return;
+
+	Aggregate_SetResult(ctx, SI_LongVal(HLL_Count(hll)));
+}
+
+void ApproxCountDistinct_Free(void *pdata) {
+	ASSERT(pdata != NULL);
+	HLL_Free(pdata);
+}
+
+AggregateCtx *ApproxCountDistinct_PrivateData(void)
+{
+	AggregateCtx *ctx = rm_malloc(sizeof(AggregateCtx));
+
+	ctx->result = SI_LongVal(0);  // count default value is 0
+	ctx->private_data = NULL;
+
+	return ctx;
+}
+
+void Register_APPROX_COUNT_DISTINCT(void) {
+	SIType *types;
+	SIType ret_type;
+	AR_FuncDesc *func_desc;
+
+	types = array_new(SIType, 1);
+	array_append(types, SI_ALL);
+	ret_type = T_INT64;
+	func_desc = AR_AggFuncDescNew("approxCountDistinct",
+			AGG_APPROX_COUNT_DISTINCT, 1, 1, types, ret_type,
+			ApproxCountDistinct_Free, ApproxCountDistinctFinalize,
+			ApproxCountDistinct_PrivateData);
+	AR_RegFunc(func_desc);
+}
+
@@ -85,14 +85,17 @@ SIValue Aggregate_GetResult
 //------------------------------------------------------------------------------
 
 // forward declarations
-void Register_AVG        (void);
-void Register_SUM        (void);
-void Register_MAX        (void);
-void Register_MIN        (void);
-void Register_STD        (void);
-void Register_COUNT      (void);
-void Register_COLLECT    (void);
-void Register_PRECENTILE (void);
+void Register_AVG                   (void);
+void Register_SUM                   (void);
+void Register_MAX                   (void);
+void Register_MIN                   (void);
+void Register_STD                   (void);
+void Register_COUNT                 (void);
+void Register_COLLECT               (void);
+void Register_PRECENTILE            (void);
+void Register_PERCENTILE_APPROX     (void);
+void Register_APPROX_COUNT_DISTINCT (void);
+void Register_TOPK                  (void);
 
 // register all aggregation functions
 void Register_AggFuncs() {
@@ -104,6 +107,9 @@ void Register_AggFuncs() {
 	Register_COUNT();
 	Register_COLLECT();
 	Register_PRECENTILE();
+	Register_PERCENTILE_APPROX();
+	Register_APPROX_COUNT_DISTINCT();
+	Register_TOPK();
 }
 
 // routine for freeing a generic aggregate function context
@@ -0,0 +1,108 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "agg_funcs.h"
+#include "../func_desc.h"
+#include "../../errors.h"
+#include "../../util/arr.h"
+#include "../../util/sketch/tdigest.h"
+
+//------------------------------------------------------------------------------
+// PercentileApprox
+//------------------------------------------------------------------------------
+
+// t-digest based percentile, unlike percentileCont and percentileDisc
+// memory consumption doesn't grow with the number of aggregated values
+typedef struct {
+	double percentile;
+	TDigest *digest;
+} _agg_PercApproxCtx;
+
+AggregateResult AGG_PERC_APPROX(SIValue *argv, int argc, void *private_data) {
+	AggregateCtx *ctx = private_data;
+	_agg_PercApproxCtx *perc_ctx = ctx->private_data;
+
+	// on the first invocation, initialize the context
+	if(perc_ctx->digest == NULL) {
+		// the second argument is the requested percentile, which we only
+		// need to apply on the first function invocation
+		SIValue_ToDouble(&argv[1], &perc_ctx->percentile);
+		if(perc_ctx->percentile < 0 || perc_ctx->percentile > 1) {
+			ErrorCtx_SetError("Invalid input - '%f' is not a valid argument, must be a number in the range 0.0 to 1.0",
+							  perc_ctx->percentile);
+		}
+		perc_ctx->digest = TDigest_New(TDIGEST_DEFAULT_COMPRESSION);
+	}
+
+	SIValue v = argv[0];
+	if(SI_TYPE(v) == T_NULL) return AGGREGATE_OK;
+
+	double n;
+	SIValue_ToDouble(&v, &n);
+	TDigest_Add(perc_ctx->digest, n, 1);
+
+	return AGGREGATE_OK;
+}
+
+void PercApproxFinalize(void *ctx_ptr) {
+	AggregateCtx *ctx = ctx_ptr;
+	_agg_PercApproxCtx *perc_ctx = ctx->private_data;
+	if(perc_ctx == NULL) return;
+
+	if(perc_ctx->digest == NULL || TDigest_Count(perc_ctx->digest) == 0) {
+		Aggregate_SetResult(ctx, SI_NullVal());
+		return;
+	}
+
+	// invalid percentile, error had already been set
+	if(perc_ctx->percentile < 0 || perc_ctx->percentile > 1) return;
+
+	double n = TDigest_Quantile(perc_ctx->digest, perc_ctx->percentile);
+	Aggregate_SetResult(ctx, SI_DoubleVal(n));
+}
+
+void PercentileApprox_Free(void *pdata) {
+	ASSERT(pdata != NULL);
+
+	_agg_PercApproxCtx *ctx = pdata;
+	if(ctx->digest != NULL) {
+		TDigest_Free(ctx->digest);
+	}
+	rm_free(ctx);
+}
+
+AggregateCtx *PercentileApprox_PrivateData(void)
+{
+	AggregateCtx *ctx = rm_malloc(sizeof(AggregateCtx));
+
+	ctx->result = SI_NullVal();  // percentile default value is NULL
+
+	// initialize private data
+	_agg_PercApproxCtx *pdata = rm_calloc(1, sizeof(_agg_PercApproxCtx));
+	pdata->percentile = -1; // invalid percentile value
+	pdata->digest = NULL;
+
+	ctx->private_data = pdata;
+
+	return ctx;
+}
+
+void Register_PERCENTILE_APPROX(void) {
+	SIType *types;
+	SIType ret_type;
+	AR_FuncDesc *func_desc;
+
+	types = array_new(SIType, 2);
+	array_append(types, T_NULL | T_INT64 | T_DOUBLE);
+	array_append(types, T_NULL | T_INT64 | T_DOUBLE);
+	ret_type = T_NULL | T_DOUBLE;
+	func_desc = AR_AggFuncDescNew("percentileApprox", AGG_PERC_APPROX, 2, 2,
+			types, ret_type, PercentileApprox_Free, PercApproxFinalize,
+			PercentileApprox_PrivateData);
+	AR_RegFunc(func_desc);
+}
+
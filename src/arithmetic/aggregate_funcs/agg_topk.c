@@ -0,0 +1,152 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "agg_funcs.h"
+#include "../func_desc.h"
+#include "../../errors.h"
+#include "../../util/arr.h"
+#include "../../datatypes/array.h"
+#include "../../util/sketch/count_min.h"
+#include <stdlib.h>
+
+//------------------------------------------------------------------------------
+// TopK
+//------------------------------------------------------------------------------
+
+// count-min sketch based heavy hitters
+// value frequencies are estimated by the sketch, only the k most frequent
+// values seen so far are retained as candidates
+
+typedef struct {
+	SIValue v;       // candidate value
+	uint64_t hash;   // value hash
+	uint64_t count;  // estimated frequency
+} _TopKCandidate;
+
+typedef struct {
+	int64_t k;                    // number of values to report
+	CountMinSketch *cms;          // frequency estimator
+	_TopKCandidate *candidates;   // k most frequent values
+} _agg_TopKCtx;
+
+static int _candidate_cmp
+(
+	const void *a,
+	const void *b
+) {
+	uint64_t x = ((const _TopKCandidate *)a)->count;
+	uint64_t y = ((const _TopKCandidate *)b)->count;
+	// descending order
+	return (x < y) - (x > y);
+}
+
+AggregateResult AGG_TOPK(SIValue *argv, int argc, void *private_data) {
+	AggregateCtx *ctx = private_data;
+	_agg_TopKCtx *topk_ctx = ctx->private_data;
+
+	// on the first invocation, initialize the context
+	if(topk_ctx->cms == NULL) {
+		// the second argument is the number of values to report, which we
+		// only need to apply on the first function invocation
+		topk_ctx->k = SI_GET_NUMERIC(argv[1]);
+		if(SI_TYPE(argv[1]) != T_INT64 || topk_ctx->k < 1) {
+			ErrorCtx_SetError("Invalid input - '%lld' is not a valid argument, must be a positive integer",
+							  (long long)topk_ctx->k);
+		}
+		topk_ctx->cms = CMS_New();
+		topk_ctx->candidates = array_new(_TopKCandidate, 1);
+	}
+
+	SIValue v = argv[0];
+	if(SI_TYPE(v) == T_NULL || topk_ctx->k < 1) return AGGREGATE_OK;
+
+	uint64_t hash = SIValue_HashCode(v);
+	uint64_t count = CMS_Increment(topk_ctx->cms, hash);
+
+	// update candidate frequency
+	uint n = array_len(topk_ctx->candidates);
+	uint min_idx = 0;
+	for(uint i = 0; i < n; i++) {
+		_TopKCandidate *c = topk_ctx->candidates + i;
+		if(c->hash == hash && SIValue_Compare(c->v, v, NULL) == 0) {
+			c->count = count;
+			return AGGREGATE_OK;
+		}
+		if(c->count < topk_ctx->candidates[min_idx].count) min_idx = i;
+	}
+
+	_TopKCandidate candidate = {SI_CloneValue(v), hash, count};
+
+	if(n < topk_ctx->k) {
+		array_append(topk_ctx->candidates, candidate);
+	} else if(count > topk_ctx->candidates[min_idx].count) {
+		// evict least frequent candidate
+		SIValue_Free(topk_ctx->candidates[min_idx].v);
+		topk_ctx->candidates[min_idx] = candidate;
+	} else {
+		SIValue_Free(candidate.v);
+	}
+
+	return AGGREGATE_OK;
+}
+
+void TopKFinalize(void *ctx_ptr) {
+	AggregateCtx *ctx = ctx_ptr;
+	_agg_TopKCtx *topk_ctx = ctx->private_data;
+	if(topk_ctx == NULL || topk_ctx->candidates == NULL) return;
+
+	uint n = array_len(topk_ctx->candidates);
+	qsort(topk_ctx->candidates, n, sizeof(_TopKCandidate), _candidate_cmp);
+
+	// values ordered by estimated frequency, most frequent first
+	for(uint i = 0; i < n; i++) {
+		SIArray_Append(&ctx->result, topk_ctx->candidates[i].v);
+	}
+}
+
+void TopK_Free(void *pdata) {
+	ASSERT(pdata != NULL);
+
+	_agg_TopKCtx *ctx = pdata;
+	if(ctx->cms != NULL) {
+		CMS_Free(ctx->cms);
+	}
+	if(ctx->candidates != NULL) {
+		uint n = array_len(ctx->candidates);
+		for(uint i = 0; i < n; i++) SIValue_Free(ctx->candidates[i].v);
+		array_free(ctx->candidates);
+	}
+	rm_free(ctx);
+}
+
+AggregateCtx *TopK_PrivateData(void)
+{
+	AggregateCtx *ctx = rm_malloc(sizeof(AggregateCtx));
+
+	ctx->result = SI_Array(0);  // topK default value is an empty array
+
+	// initialize private data
+	_agg_TopKCtx *pdata = rm_calloc(1, sizeof(_agg_TopKCtx));
+	ctx->private_data = pdata;
+
+	return ctx;
+}
+
+void Register_TOPK(void) {
+	SIType *types;
+	SIType ret_type;
+	AR_FuncDesc *func_desc;
+
+	types = array_new(SIType, 2);
+	array_append(types, SI_ALL);
+	array_append(types, T_INT64);
+	ret_type = T_ARRAY;
+	func_desc = AR_AggFuncDescNew("topK", AGG_TOPK, 2, 2, types, ret_type,
+			TopK_Free, TopKFinalize, TopK_PrivateData);
+	AR_RegFunc(func_desc);
+}
+
@@ -281,6 +281,14 @@ char *AlgebraicExpression_ToString
 	const AlgebraicExpression *exp  // Root node.
 );
 
+// Return the order in which the operands of multiplication 'exp' are
+// evaluated, e.g. ((A * B) * C), unaliased operands are printed as '?'
+// caller is responsible for freeing the returned string
+char *AlgebraicExpression_MulOrder
+(
+	const AlgebraicExpression *exp  // Multiplication node.
+);
+
 //------------------------------------------------------------------------------
 // AlgebraicExpression optimizations
 //------------------------------------------------------------------------------
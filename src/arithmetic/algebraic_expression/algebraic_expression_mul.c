@@ -6,67 +6,306 @@
 
 #include "utils.h"
 #include "../../query_ctx.h"
+#include "../../util/rmalloc.h"
+#include "../../util/sds/sds.h"
 #include "../algebraic_expression.h"
 
-RG_Matrix _Eval_Mul
+// cost assigned to a multiplication whose left operand isn't synced
+// RG_mxm requires its left operand to be free of pending changes
+#define UNSYNCED_PENALTY 1e30
+
+// multiplication chain operand
+typedef struct {
+	RG_Matrix M;      // operand matrix
+	GrB_Index nrows;  // number of rows
+	GrB_Index ncols;  // number of columns
+	double nvals;     // number of entries
+	bool diagonal;    // operand is a label diagonal
+	bool synced;      // operand has no pending changes
+	const char *alias;  // operand alias
+} ChainOperand;
+
+// multiplication chain evaluation plan
+// entry [i * n + j] describes the sub-chain operands[i..j]
+typedef struct {
+	uint n;                // number of operands
+	ChainOperand *ops;     // operands
+	double *nnz;           // estimated number of entries in sub-chain result
+	double *cost;          // estimated cost of evaluating sub-chain
+	uint *split;           // sub-chain is evaluated as [i..split] * [split+1..j]
+} ChainPlan;
+
+#define PLAN_AT(arr, plan, i, j) (arr)[(i) * (plan)->n + (j)]
+
+// estimates the work of multiplying sub-chain [i..k] by sub-chain [k+1..j]
+static double _MulCost
 (
-	const AlgebraicExpression *exp,
+	const ChainPlan *plan,
+	uint i,            // first operand of left sub-chain
+	uint k,            // last operand of left sub-chain
+	uint j,            // last operand of right sub-chain
+	double *nnz        // [output] estimated number of entries in result
+) {
+	double l     = PLAN_AT(plan->nnz, plan, i, k);
+	double r     = PLAN_AT(plan->nnz, plan, k + 1, j);
+	double inner = (plan->ops[k].ncols > 0) ? plan->ops[k].ncols : 1;
+	double dense = (double)plan->ops[i].nrows * (double)plan->ops[j].ncols;
+
+	// each left entry meets, on average, r / inner right entries
+	double flops = l * r / inner;
+	*nnz = (flops < dense) ? flops : dense;
+
+	// multiplying by a label diagonal filters the other side
+	// which is linear in its number of entries
+	if(k + 1 == j && plan->ops[j].diagonal) flops = l;
+	else if(i == k && plan->ops[i].diagonal) flops = r;
+
+	// RG_mxm requires a synced left operand
+	// sub-chain results are always synced
+	if(i == k && !plan->ops[i].synced) flops += UNSYNCED_PENALTY;
+
+	// result materialization
+	return flops + *nnz;
+}
+
+// choose multiplication order by dynamic programming
+// minimizing the estimated number of operations
+static void _ChainPlan_Build
+(
+	ChainPlan *plan
+) {
+	uint n = plan->n;
+
+	for(uint i = 0; i < n; i++) {
+		PLAN_AT(plan->nnz, plan, i, i)  = plan->ops[i].nvals;
+		PLAN_AT(plan->cost, plan, i, i) = 0;
+	}
+
+	for(uint len = 2; len <= n; len++) {
+		for(uint i = 0; i + len - 1 < n; i++) {
+			uint j = i + len - 1;
+			double best_cost = -1;
+
+			for(uint k = i; k < j; k++) {
+				double nnz;
+				double cost = PLAN_AT(plan->cost, plan, i, k) +
+					PLAN_AT(plan->cost, plan, k + 1, j) +
+					_MulCost(plan, i, k, j, &nnz);
+
+				// prefer left to right evaluation on ties
+				// i.e. the latest split, [i..j-1] * [j]
+				if(best_cost < 0 || cost <= best_cost) {
+					best_cost = cost;
+					PLAN_AT(plan->nnz, plan, i, j)   = nnz;
+					PLAN_AT(plan->split, plan, i, j) = k;
+				}
+			}
+
+			PLAN_AT(plan->cost, plan, i, j) = best_cost;
+		}
+	}
+}
+
+// evaluate sub-chain operands[i..j]
+// result is stored in 'res' when i < j, if 'res' is NULL a new matrix
+// is created, for a single operand the operand itself is returned
+static RG_Matrix _ChainPlan_Eval
+(
+	const ChainPlan *plan,
+	uint i,
+	uint j,
 	RG_Matrix res
 ) {
-	//--------------------------------------------------------------------------
-	// validate expression
-	//--------------------------------------------------------------------------
+	if(i == j) return plan->ops[i].M;
 
-	ASSERT(exp != NULL) ;
-	ASSERT(AlgebraicExpression_ChildCount(exp) > 1) ;
-	ASSERT(AlgebraicExpression_OperationCount(exp, AL_EXP_MUL) == 1) ;
+	GrB_Info info;
+	UNUSED(info);
+
+	if(res == NULL) {
+		info = RG_Matrix_new(&res, GrB_BOOL, plan->ops[i].nrows,
+				plan->ops[j].ncols);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	uint k = PLAN_AT(plan->split, plan, i, j);
+
+	// left sub-chain reuses 'res' when dimensions agree
+	// just as a left to right evaluation accumulates into 'res'
+	RG_Matrix L_res = (plan->ops[k].ncols == plan->ops[j].ncols) ? res : NULL;
+	RG_Matrix L = _ChainPlan_Eval(plan, i, k, L_res);
 
-	GrB_Info             info    ;
-	RG_Matrix            M       ;  // current operand
-	GrB_Index            nvals   ;  // NNZ in res
-	AlgebraicExpression  *c      ;  // current child node
+	// exit early if left hand side is empty, 0 * A = 0
+	GrB_Index nvals;
+	info = RG_Matrix_nvals(&nvals, L);
+	ASSERT(info == GrB_SUCCESS);
 
-	UNUSED(info) ;
+	if(nvals == 0) {
+		if(L != res && i < k) RG_Matrix_free(&L);
+		info = RG_Matrix_clear(res);
+		ASSERT(info == GrB_SUCCESS);
+		return res;
+	}
+
+	RG_Matrix R = _ChainPlan_Eval(plan, k + 1, j, NULL);
+
+	info = RG_mxm(res, GxB_ANY_PAIR_BOOL, L, R);
+	ASSERT(info == GrB_SUCCESS);
+
+	// free intermediates
+	if(L != res && i < k) RG_Matrix_free(&L);
+	if(k + 1 < j) RG_Matrix_free(&R);
+
+	return res;
+}
+
+// collect the operands of multiplication 'exp' and plan their evaluation
+// identity operands are skipped, returns the number of remaining operands
+// the plan is built only when more than one operand remains
+static uint _ChainPlan_Init
+(
+	ChainPlan *plan,
+	const AlgebraicExpression *exp
+) {
+	uint child_count = AlgebraicExpression_ChildCount(exp);
+
+	//--------------------------------------------------------------------------
+	// collect operands
+	//--------------------------------------------------------------------------
 
-	RG_Matrix     A             =  NULL                                 ; 
-	bool          res_modified  =  false                                ;
-	GrB_Semiring  semiring      =  GxB_ANY_PAIR_BOOL                    ;
-	uint          child_count   =  AlgebraicExpression_ChildCount(exp)  ;
+	uint n = 0;
+	ChainOperand *ops = rm_malloc(sizeof(ChainOperand) * child_count);
 
 	for(uint i = 0; i < child_count; i++) {
-		c = CHILD_AT(exp, i) ;
-		ASSERT(c->type == AL_OPERAND) ;
+		AlgebraicExpression *c = CHILD_AT(exp, i);
+		ASSERT(c->type == AL_OPERAND);
 
-		M = c->operand.matrix ;
+		RG_Matrix M = c->operand.matrix;
 
 		// skip identity matrix, A*I = A
-		if(M == IDENTITY_MATRIX) continue ;
-
-		// first time A is set
-		if(A == NULL) {
-			A = M ;
-			continue ;
-		}
+		if(M == IDENTITY_MATRIX) continue;
 
-		// both A and M are valid matrices, perform multiplication
-		info = RG_mxm(res, semiring, A, M) ;
-		res_modified = true ;
-		// setup for next iteration
-		A = res ;
+		GrB_Index nvals;
+		ChainOperand *op = ops + n++;
 
-		// exit early if 'res' is empty 0 * A = 0
-		info = RG_Matrix_nvals(&nvals, res);
-		ASSERT(info == GrB_SUCCESS) ;
-		if(nvals == 0) break ;
+		op->M        = M;
+		op->alias    = (c->operand.edge) ? c->operand.edge : c->operand.src;
+		op->diagonal = c->operand.diagonal;
+		op->synced   = RG_Matrix_Synced(M);
+		RG_Matrix_nrows(&op->nrows, M);
+		RG_Matrix_ncols(&op->ncols, M);
+		RG_Matrix_nvals(&nvals, M);
+		op->nvals = nvals;
 	}
 
-	if(!res_modified) {
-		// expecting at-least one operand not to be the identity matrix
-		ASSERT(A != IDENTITY_MATRIX) ;
-		info = RG_Matrix_copy(res, A) ;
-		ASSERT(info == GrB_SUCCESS) ;
+	// expecting at-least one operand not to be the identity matrix
+	ASSERT(n > 0);
+
+	plan->n     = n;
+	plan->ops   = ops;
+	plan->nnz   = NULL;
+	plan->cost  = NULL;
+	plan->split = NULL;
+
+	if(n == 1) return n;
+
+	//--------------------------------------------------------------------------
+	// plan
+	//--------------------------------------------------------------------------
+
+	// intermediate sizes depend on evaluation order
+	// e.g. F * L_a * R1 * L_b * R2 * L_c
+	// is best evaluated left to right when F holds a handful of rows
+	// while R1 * L_b might be cheaper to compute first when F is large
+	plan->nnz   = rm_malloc(sizeof(double) * n * n);
+	plan->cost  = rm_malloc(sizeof(double) * n * n);
+	plan->split = rm_malloc(sizeof(uint) * n * n);
+
+	_ChainPlan_Build(plan);
+
+	return n;
+}
+
+static void _ChainPlan_Free
+(
+	ChainPlan *plan
+) {
+	if(plan->nnz)   rm_free(plan->nnz);
+	if(plan->cost)  rm_free(plan->cost);
+	if(plan->split) rm_free(plan->split);
+	rm_free(plan->ops);
+}
+
+// print the evaluation order of sub-chain operands[i..j] into 'buff'
+static void _ChainPlan_Print
+(
+	const ChainPlan *plan,
+	uint i,
+	uint j,
+	sds *buff
+) {
+	if(i == j) {
+		// operands aren't required to be aliased
+		const char *alias = plan->ops[i].alias;
+		*buff = sdscat(*buff, (alias != NULL) ? alias : "?");
+		return;
 	}
 
-	return res ;
+	uint k = PLAN_AT(plan->split, plan, i, j);
+
+	*buff = sdscat(*buff, "(");
+	_ChainPlan_Print(plan, i, k, buff);
+	*buff = sdscat(*buff, " * ");
+	_ChainPlan_Print(plan, k + 1, j, buff);
+	*buff = sdscat(*buff, ")");
 }
 
+char *AlgebraicExpression_MulOrder
+(
+	const AlgebraicExpression *exp
+) {
+	ASSERT(exp != NULL);
+	ASSERT(AlgebraicExpression_OperationCount(exp, AL_EXP_MUL) == 1);
+
+	ChainPlan plan;
+	uint n = _ChainPlan_Init(&plan, exp);
+
+	sds buff = sdsempty();
+	_ChainPlan_Print(&plan, 0, n - 1, &buff);
+	char *order = rm_strdup(buff);
+
+	sdsfree(buff);
+	_ChainPlan_Free(&plan);
+
+	return order;
+}
+
+RG_Matrix _Eval_Mul
+(
+	const AlgebraicExpression *exp,
+	RG_Matrix res
+) {
+	//--------------------------------------------------------------------------
+	// validate expression
+	//--------------------------------------------------------------------------
+
+	ASSERT(exp != NULL) ;
+	ASSERT(AlgebraicExpression_ChildCount(exp) > 1) ;
+	ASSERT(AlgebraicExpression_OperationCount(exp, AL_EXP_MUL) == 1) ;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	ChainPlan plan;
+	uint n = _ChainPlan_Init(&plan, exp);
+
+	if(n == 1) {
+		info = RG_Matrix_copy(res, plan.ops[0].M);
+		ASSERT(info == GrB_SUCCESS);
+	} else {
+		_ChainPlan_Eval(&plan, 0, n - 1, res);
+	}
+
+	_ChainPlan_Free(&plan);
+
+	return res;
+}
@@ -7,6 +7,7 @@
 #include "../../util/arr.h"
 #include "../../query_ctx.h"
 #include "../algebraic_expression.h"
+#include "../../graph/algebraic_view.h"
 #include "../../configuration/config.h"
 
 static inline bool _AlgebraicExpression_IsMultiplicationNode(const AlgebraicExpression *node) {
@@ -411,6 +412,54 @@ void AlgebraicExpression_PushDownTranspose(AlgebraicExpression *root) {
 	}
 }
 
+// substitute runs of operands matching a materialized view with the view
+// the first operand of the run is set to the view's matrix
+// while the remaining operands are set to the identity matrix
+static void _AlgebraicExpression_UtilizeViews
+(
+	AlgebraicExpression *root
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Graph *g = gc->g;
+
+	uint view_count = Graph_ViewCount(g);
+	if(view_count == 0) return;
+
+	// views do not reflect the query's own modifications
+	AST *ast = QueryCtx_GetAST();
+	if(ast == NULL || !AST_ReadOnly(ast->root)) return;
+
+	if(!_AlgebraicExpression_IsMultiplicationNode(root)) return;
+
+	uint child_count = AlgebraicExpression_ChildCount(root);
+	for(uint i = 0; i < view_count; i++) {
+		AlgebraicView *v = Graph_GetViewAt(g, i);
+		if(v->op_count > child_count) continue;
+
+		for(uint j = 0; j + v->op_count <= child_count; j++) {
+			bool match = true;
+			for(uint k = 0; k < v->op_count && match; k++) {
+				AlgebraicExpression *c = CHILD_AT(root, j + k);
+				// referenced edges are collected from their relation matrix
+				match = (c->type == AL_OPERAND                 &&
+						 c->operand.edge == NULL               &&
+						 c->operand.matrix ==
+						 AlgebraicView_OperandMatrix(v, g, k));
+			}
+			if(!match) continue;
+
+			RG_Matrix V = AlgebraicView_Matrix(v, g);
+			if(V == NULL) break;
+
+			CHILD_AT(root, j)->operand.matrix = V;
+			for(uint k = 1; k < v->op_count; k++) {
+				CHILD_AT(root, j + k)->operand.matrix = IDENTITY_MATRIX;
+			}
+			j += v->op_count - 1;
+		}
+	}
+}
+
 //------------------------------------------------------------------------------
 // AlgebraicExpression optimizations
 //------------------------------------------------------------------------------
@@ -426,5 +475,8 @@ void AlgebraicExpression_Optimize
 
 	// Retrieve all operands now that they are guaranteed to be leaves.
 	_AlgebraicExpression_PopulateOperands(*exp, QueryCtx_GetGraphCtx());
+
+	// Substitute materialized views.
+	_AlgebraicExpression_UtilizeViews(*exp);
 }
 
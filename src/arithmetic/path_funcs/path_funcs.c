@@ -5,6 +5,7 @@
  */
 
 #include "path_funcs.h"
+#include "rax.h"
 #include "../func_desc.h"
 #include "../../ast/ast.h"
 #include "../../util/arr.h"
@@ -12,7 +13,6 @@
 #include "../../util/rmalloc.h"
 #include "../../configuration/config.h"
 #include "../../datatypes/path/sipath_builder.h"
-#include "../../algorithms/LAGraph/LAGraph_bfs.h"
 
 /* Creates a path from a given sequence of graph entities.
  * The first argument is the ast node represents the path.
@@ -26,7 +26,7 @@ SIValue AR_TOPATH(SIValue *argv, int argc, void *private_data) {
 	uint nelements = cypher_ast_pattern_path_nelements(ast_path);
 	ASSERT(argc == (nelements + 1));
 
-	SIValue path = SIPathBuilder_New(nelements);
+	SIValue path = SIPathBuilder_New(QueryCtx_GetGraph(), nelements);
 	for(uint i = 0; i < nelements; i++) {
 		SIValue element = argv[i + 1];
 		if(SI_TYPE(element) == T_NULL) {
@@ -69,9 +69,6 @@ void ShortestPath_Free(void *ctx_ptr) {
 	ShortestPathCtx *ctx = ctx_ptr;
 	if(ctx->reltypes) array_free(ctx->reltypes);
 	if(ctx->reltype_names) array_free(ctx->reltype_names);
-	if(ctx->free_matrices) {
-		GrB_free(&ctx->R);
-	}
 	rm_free(ctx);
 }
 
@@ -85,17 +82,93 @@ void *ShortestPath_Clone(void *orig) {
 	/* Clone reltype names but not IDs, to avoid
 	 * a scenario in which a traversed type is created after the
 	 * shortestPath query is cached. */
-	ctx_clone->reltype_count = ctx->reltype_count;
+	ctx_clone->reltype_count = array_len(ctx->reltype_names);
 	ctx_clone->reltypes = NULL;
 	if(ctx->reltype_names) array_clone(ctx_clone->reltype_names, ctx->reltype_names);
 	else ctx_clone->reltype_names = NULL;
-	// Do not clone matrix data
-	ctx_clone->R = GrB_NULL;
-	ctx_clone->free_matrices = false;
+	ctx_clone->resolved = false;
 
 	return ctx_clone;
 }
 
+// one side of a bidirectional breadth first search
+typedef struct {
+	rax *parents;        // reached node ID -> node it was reached from
+	NodeID *frontier;    // nodes discovered by the last expanded level
+	uint depth;          // number of expanded levels
+	bool transposed;     // traverse transposed matrices
+} BFSSide;
+
+// expand 'side' frontier by a single level, reading matrices in place
+// returns true once a node already reached by 'other' is discovered
+static bool _ShortestPath_Expand
+(
+	const Graph *g,
+	const ShortestPathCtx *ctx,
+	BFSSide *side,
+	const BFSSide *other,
+	NodeID *meet
+) {
+	bool found = false;
+	uint frontier_len = array_len(side->frontier);
+	NodeID *next = array_new(NodeID, frontier_len);
+
+	// without relationship types the adjacency matrix is traversed
+	uint matrix_count = (ctx->reltypes == NULL) ? 1 : ctx->reltype_count;
+	for(uint i = 0; i < matrix_count && !found; i++) {
+		int r = (ctx->reltypes == NULL) ? GRAPH_NO_RELATION : ctx->reltypes[i];
+		RG_Matrix M = Graph_GetRelationMatrix(g, r, side->transposed);
+
+		RG_MatrixTupleIter it = {0};
+		RG_MatrixTupleIter_attach(&it, M);
+
+		for(uint j = 0; j < frontier_len && !found; j++) {
+			NodeID src = side->frontier[j];
+			RG_MatrixTupleIter_iterate_row(&it, src);
+
+			// entry values are not read, next_BOOL scans matrices of any type
+			GrB_Index dest;
+			while(RG_MatrixTupleIter_next_BOOL(&it, NULL, &dest, NULL) ==
+					GrB_SUCCESS) {
+				// skip nodes this side has already reached
+				if(!raxTryInsert(side->parents, (unsigned char *)&dest,
+							sizeof(NodeID), (void *)(uintptr_t)src, NULL)) {
+					continue;
+				}
+
+				// frontiers meet
+				if(raxFind(other->parents, (unsigned char *)&dest,
+							sizeof(NodeID)) != raxNotFound) {
+					*meet = dest;
+					found = true;
+					break;
+				}
+
+				array_append(next, dest);
+			}
+		}
+
+		RG_MatrixTupleIter_detach(&it);
+	}
+
+	array_free(side->frontier);
+	side->frontier = next;
+	side->depth++;
+
+	return found;
+}
+
+// node 'id' was reached from
+static inline NodeID _ShortestPath_Parent
+(
+	rax *parents,
+	NodeID id
+) {
+	void *parent = raxFind(parents, (unsigned char *)&id, sizeof(NodeID));
+	ASSERT(parent != raxNotFound);
+	return (NodeID)(uintptr_t)parent;
+}
+
 SIValue AR_SHORTEST_PATH(SIValue *argv, int argc, void *private_data) {
 	if(SI_TYPE(argv[0]) == T_NULL) return SI_NullVal();
 	if(SI_TYPE(argv[1]) == T_NULL) return SI_NullVal();
@@ -103,19 +176,11 @@ SIValue AR_SHORTEST_PATH(SIValue *argv, int argc, void *private_data) {
 	Node             *srcNode   =  argv[0].ptrval;
 	Node             *destNode  =  argv[1].ptrval;
 	ShortestPathCtx  *ctx       =  private_data;
-	GrB_Index src_id            =  ENTITY_GET_ID(srcNode);
-	GrB_Index dest_id           =  ENTITY_GET_ID(destNode);
-
-	GrB_Info res;
-	UNUSED(res);
-	Edge *edges = NULL;
-	GrB_Vector V = GrB_NULL;  // vector of results
-	GrB_Vector PI = GrB_NULL; // vector backtracking results to their parents
-	GraphContext *gc = QueryCtx_GetGraphCtx();
+	NodeID           src_id     =  ENTITY_GET_ID(srcNode);
+	NodeID           dest_id    =  ENTITY_GET_ID(destNode);
+	GraphContext     *gc        =  QueryCtx_GetGraphCtx();
 
-	GrB_Index max_level = (ctx->maxHops == EDGE_LENGTH_INF) ? 0 : ctx->maxHops;
-
-	if(ctx->R == GrB_NULL) {
+	if(!ctx->resolved) {
 		// First invocation, initialize unset context members.
 		if(ctx->reltype_count > 0) {
 			// Retrieve IDs of traversed relationship types.
@@ -129,85 +194,72 @@ SIValue AR_SHORTEST_PATH(SIValue *argv, int argc, void *private_data) {
 			// Update the reltype count, as it may have changed due to missing schemas
 			ctx->reltype_count = array_len(ctx->reltypes);
 		}
+		ctx->resolved = true;
+	}
 
-		// Get edge matrix and transpose matrix, if available.
-		if(ctx->reltypes == NULL) {
-			// No edge types were specified, use the overall adjacency matrix.
-			ctx->free_matrices = true;
-			res = RG_Matrix_export(&ctx->R, Graph_GetAdjacencyMatrix(gc->g,
-						false));
-			ASSERT(res == GrB_SUCCESS);
-		} else if(ctx->reltype_count == 0) {
-			// If edge types were specified but none were valid,
-			// use the zero matrix
-			ctx->free_matrices = true;
-			res = RG_Matrix_export(&ctx->R, Graph_GetZeroMatrix(gc->g));
-			ASSERT(res == GrB_SUCCESS);
-		} else if(ctx->reltype_count == 1) {
-			ctx->free_matrices = true;
-			res = RG_Matrix_export(&ctx->R, Graph_GetRelationMatrix(gc->g,
-						ctx->reltypes[0], false));
-			ASSERT(res == GrB_SUCCESS);
-		} else {
-			// we have multiple edge types, combine them into a boolean matrix
-			ctx->free_matrices = true;
-			GrB_Index dims = Graph_RequiredMatrixDim(gc->g);
-			res = GrB_Matrix_new(&ctx->R, GrB_BOOL, dims, dims);
-			ASSERT(res == GrB_SUCCESS);
-
-			for(uint i = 0; i < ctx->reltype_count; i ++) {
-				GrB_Matrix adj;
-				res = RG_Matrix_export(&adj, Graph_GetRelationMatrix(gc->g,
-							ctx->reltypes[i], false));
-				ASSERT(res == GrB_SUCCESS);
-				res = GrB_eWiseAdd(ctx->R, GrB_NULL, GrB_NULL,
-						GxB_ANY_PAIR_BOOL, ctx->R, adj, GrB_NULL);
-				ASSERT(res == GrB_SUCCESS);
-				res = GrB_Matrix_free(&adj);
-				ASSERT(res == GrB_SUCCESS);
-			}
+	// a path with no edges connects a node to itself
+	if(src_id == dest_id) {
+		// Only emit a path with no edges if minHops is 0
+		if(ctx->minHops != 0) return SI_NullVal();
+		SIValue p = SIPathBuilder_New(gc->g, 0);
+		SIPathBuilder_AppendNode(p, SI_Node(srcNode));
+		return p;
+	}
 
-			GrB_Index nrows;
-			res = GrB_Matrix_nrows(&nrows, ctx->R);
-			ASSERT(res == GrB_SUCCESS);
+	/* Search from both ends, the source side follows outgoing edges
+	 * while the destination side follows incoming edges, using the transposed
+	 * matrices. Each step expands the smaller frontier by a single level
+	 * and the search stops as soon as the two frontiers meet. */
+	BFSSide fwd = {raxNew(), array_new(NodeID, 1), 0, false};
+	BFSSide bwd = {raxNew(), array_new(NodeID, 1), 0, true};
+	raxInsert(fwd.parents, (unsigned char *)&src_id, sizeof(NodeID),
+			(void *)(uintptr_t)src_id, NULL);
+	raxInsert(bwd.parents, (unsigned char *)&dest_id, sizeof(NodeID),
+			(void *)(uintptr_t)dest_id, NULL);
+	array_append(fwd.frontier, src_id);
+	array_append(bwd.frontier, dest_id);
+
+	NodeID meet;
+	bool found = false;
+	while(!found &&
+		  fwd.depth + bwd.depth < ctx->maxHops &&
+		  array_len(fwd.frontier) > 0 &&
+		  array_len(bwd.frontier) > 0) {
+		if(array_len(fwd.frontier) <= array_len(bwd.frontier)) {
+			found = _ShortestPath_Expand(gc->g, ctx, &fwd, &bwd, &meet);
+		} else {
+			found = _ShortestPath_Expand(gc->g, ctx, &bwd, &fwd, &meet);
 		}
 	}
 
-	// Invoke the BFS algorithm
-	res = LG_BreadthFirstSearch_SSGrB(&V, &PI, ctx->R, src_id, &dest_id,
-		max_level);
-	ASSERT(res == GrB_SUCCESS);
-	ASSERT(V != GrB_NULL);
-	ASSERT(PI != GrB_NULL);
-
 	SIValue p = SI_NullVal();
+	if(!found) goto cleanup; // no path found
 
-	// The length of the path is equal to the level of the destination node
-	GrB_Index path_len;
-	res = GrB_Vector_extractElement(&path_len, V, dest_id);
-	if(res == GrB_NO_VALUE) goto cleanup; // no path found
-
-	// Only emit a path with no edges if minHops is 0
-	if(path_len == 0 && ctx->minHops != 0) goto cleanup;
-
-	/* Build path in reverse, starting by appending the destination node.
-	 * The path is built in reverse because we have the destination's parent
-	 * in the PI array, and can use this to backtrack until we reach the source. */
-	p = SIPathBuilder_New(path_len);
-	SIPathBuilder_AppendNode(p, SI_Node(destNode));
+	// collect path nodes, from the meeting node back to the source
+	// and from the meeting node forward to the destination
+	NodeID *ids = array_new(NodeID, fwd.depth + bwd.depth + 1);
+	for(NodeID id = meet; id != src_id; id = _ShortestPath_Parent(fwd.parents, id)) {
+		array_append(ids, id);
+	}
+	array_append(ids, src_id);
+	array_reverse(ids);
+	for(NodeID id = meet; id != dest_id;) {
+		id = _ShortestPath_Parent(bwd.parents, id);
+		array_append(ids, id);
+	}
 
-	edges = array_new(Edge, 1);
+	uint path_len = array_len(ids) - 1;
+	p = SIPathBuilder_New(gc->g, path_len);
+	SIPathBuilder_AppendNode(p, SI_Node(srcNode));
 
-	NodeID id = destNode->id;
+	Edge *edges = array_new(Edge, 1);
 	for(uint i = 0; i < path_len; i ++) {
 		array_clear(edges);
-		GrB_Index parent_id;
-		// Find the parent of the reached node.
-		GrB_Info res = GrB_Vector_extractElement(&parent_id, PI, id);
-		ASSERT(res == GrB_SUCCESS);
+		NodeID parent_id = ids[i];
+		NodeID id = ids[i + 1];
 
 		// Retrieve edges connecting the parent node to the current node.
-		if(ctx->reltype_count == 0) {
+		if(ctx->reltypes == NULL) {
 			Graph_GetEdgesConnectingNodes(gc->g, parent_id, id, GRAPH_NO_RELATION, &edges);
 		} else {
 			for(uint j = 0; j < ctx->reltype_count; j ++) {
@@ -220,19 +272,23 @@ SIValue AR_SHORTEST_PATH(SIValue *argv, int argc, void *private_data) {
 		SIPathBuilder_AppendEdge(p, SI_Edge(&edges[0]), false);
 
 		// Append the reached node to the path.
-		id = edges[0].srcNodeID;
-		Node n = GE_NEW_NODE();
-		Graph_GetNode(gc->g, id, &n);
-		SIPathBuilder_AppendNode(p, SI_Node(&n));
+		if(id == dest_id) {
+			SIPathBuilder_AppendNode(p, SI_Node(destNode));
+		} else {
+			Node n = GE_NEW_NODE();
+			Graph_GetNode(gc->g, id, &n);
+			SIPathBuilder_AppendNode(p, SI_Node(&n));
+		}
 	}
 
-	// Reverse the path so it starts at the source
-	Path_Reverse(p.ptrval);
+	array_free(ids);
+	array_free(edges);
 
 cleanup:
-	if(V) GrB_free(&V);
-	if(PI) GrB_free(&PI);
-	if(edges) array_free(edges);
+	raxFree(fwd.parents);
+	raxFree(bwd.parents);
+	array_free(fwd.frontier);
+	array_free(bwd.frontier);
 
 	return p;
 }
@@ -6,7 +6,6 @@
 
 #pragma once
 #include "../../value.h"
-#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
 
 // Context struct containing traversal data for shortestPath function calls
 typedef struct {
@@ -15,8 +14,7 @@ typedef struct {
 	const char **reltype_names;  /* Relationship type names */
 	int *reltypes;               /* Relationship type IDs */
 	uint reltype_count;          /* Number of traversed relationship types */
-	GrB_Matrix R;                /* Traversed relationship matrix */
-	bool free_matrices;          /* If true, R will ultimately be freed */
+	bool resolved;               /* Relationship type IDs were resolved */
 } ShortestPathCtx;
 
 void Register_PathFuncs();
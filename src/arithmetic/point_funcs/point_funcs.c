@@ -9,10 +9,7 @@
 #include "../../errors.h"
 #include "../../util/arr.h"
 #include "../../datatypes/map.h"
-#include <math.h>
-
-#define EARTH_RADIUS 6378140.0
-#define DegreeToRadians(d) ((d) * M_PI / 180.0)
+#include "../../datatypes/point.h"
 
 SIValue AR_TOPOINT(SIValue *argv, int argc, void *private_data) {
 	SIValue map = argv[0];
@@ -65,37 +62,13 @@ SIValue AR_TOPOINT(SIValue *argv, int argc, void *private_data) {
 }
 
 SIValue AR_DISTANCE(SIValue *argv, int argc, void *private_data) {
-	// compute distance between two points
-	// a = sin²(Δφ/2) + cos φ1 ⋅ cos φ2 ⋅ sin²(Δλ/2)
-	// c = 2 * atan2( √a, √(1−a) )
-	// d = R * c
-	// where φ represent the latitudes, and λ represent the longitudes
-
 	SIValue p1 = argv[0];
 	SIValue p2 = argv[1];
 
 	// check inputs
 	if(SI_TYPE(p1) == T_NULL || SI_TYPE(p2) == T_NULL) return SI_NullVal();
 
-	float lat[2] = { DegreeToRadians(p1.point.latitude),
-					 DegreeToRadians(p2.point.latitude)
-				   };
-
-	float lon[2] = { DegreeToRadians(p1.point.longitude),
-					 DegreeToRadians(p2.point.longitude)
-				   };
-
-	float dlat = lat[1] - lat[0];
-	float dlon = lon[1] - lon[0];
-
-	// a = sin²(Δφ/2) + cos φ1 ⋅ cos φ2 ⋅ sin²(Δλ/2)
-	float a = pow(sin(dlat / 2), 2) + cos(lat[0]) * cos(lat[1]) * pow(sin(dlon / 2), 2);
-
-	// c = 2 * atan2( √a, √(1−a) )
-	float c = 2 * atan2(sqrt(a), sqrt(1 - a));
-
-	// d = R * c
-	float d = EARTH_RADIUS * c;
+	float d = Point_Distance(p1, p2);
 
 	return SI_DoubleVal(d);
 }
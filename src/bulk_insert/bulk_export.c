@@ -0,0 +1,405 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "bulk_export.h"
+#include "../datatypes/array.h"
+#include "../datatypes/point.h"
+#include "../schema/schema.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+#include <stdio.h>
+#include <limits.h>
+#include <pthread.h>
+
+// size of each part file's write buffer
+#define BULK_EXPORT_BUFFER_SIZE (1 << 20)
+
+// a range of node IDs of a single label or relationship type
+typedef struct {
+	SchemaType t;    // type of exported entities
+	int schema_id;   // label / relation ID, GRAPH_NO_LABEL for unlabeled nodes
+	uint part;       // part number
+	NodeID min_id;   // first node ID in range
+	NodeID max_id;   // last node ID in range (inclusive)
+} ExportPart;
+
+typedef struct {
+	const GraphContext *gc;   // exported graph
+	const char *dir;          // destination directory
+	const char **attributes;  // attribute names
+	uint attribute_count;     // number of attributes
+	ExportPart *parts;        // parts to export
+	uint part_count;          // number of parts
+	uint next_part;           // next part to pick
+	int res;                  // BULK_FAIL if any part failed
+} ExportCtx;
+
+// part file along with the attribute values of the entity being written
+typedef struct {
+	FILE *f;                  // part file, NULL until first entity is written
+	char *buffer;             // file write buffer
+	char path[PATH_MAX];      // part file path
+	const ExportCtx *ctx;     // export context
+	const ExportPart *part;   // exported part
+	SIValue *values;          // attribute values of current entity
+} ExportWriter;
+
+static void _BulkExport_WriteValue
+(
+	FILE *f,
+	SIValue v
+) {
+	int64_t len;
+	double coord;
+	uint8_t t = BI_NULL;
+
+	switch(SI_TYPE(v)) {
+		case T_BOOL:
+			t = BI_BOOL;
+			fputc(t, f);
+			fputc(v.longval != 0, f);
+			break;
+
+		case T_DOUBLE:
+			t = BI_DOUBLE;
+			fputc(t, f);
+			fwrite(&v.doubleval, sizeof(double), 1, f);
+			break;
+
+		case T_INT64:
+			t = BI_LONG;
+			fputc(t, f);
+			fwrite(&v.longval, sizeof(int64_t), 1, f);
+			break;
+
+		case T_STRING:
+			t = BI_STRING;
+			fputc(t, f);
+			fwrite(v.stringval, strlen(v.stringval) + 1, 1, f);
+			break;
+
+		case T_ARRAY:
+			t = BI_ARRAY;
+			fputc(t, f);
+			len = SIArray_Length(v);
+			fwrite(&len, sizeof(int64_t), 1, f);
+			for(int64_t i = 0; i < len; i++) {
+				_BulkExport_WriteValue(f, SIArray_Get(v, i));
+			}
+			break;
+
+		case T_POINT:
+			t = BI_POINT;
+			fputc(t, f);
+			coord = Point_lat(v);
+			fwrite(&coord, sizeof(double), 1, f);
+			coord = Point_lon(v);
+			fwrite(&coord, sizeof(double), 1, f);
+			break;
+
+		default:
+			// temporal values aren't supported by bulk insert
+			fputc(t, f);
+			break;
+	}
+}
+
+// open part file and write its header, bulk insert header format:
+// - entity name : null-terminated C string
+// - property count : 4-byte unsigned integer
+// [0..property_count] : null-terminated C string
+static bool _BulkExport_OpenPart
+(
+	ExportWriter *w
+) {
+	const ExportPart *part = w->part;
+	const ExportCtx *ctx = w->ctx;
+
+	int n;
+	const char *name = "";
+	if(part->t == SCHEMA_EDGE) {
+		n = snprintf(w->path, PATH_MAX, "%s/edge_%d_%u.bin", ctx->dir,
+				part->schema_id, part->part);
+	} else if(part->schema_id == GRAPH_NO_LABEL) {
+		n = snprintf(w->path, PATH_MAX, "%s/node_unlabeled_%u.bin", ctx->dir,
+				part->part);
+	} else {
+		n = snprintf(w->path, PATH_MAX, "%s/node_%d_%u.bin", ctx->dir,
+				part->schema_id, part->part);
+	}
+	if(n >= PATH_MAX) return false;
+
+	if(part->schema_id != GRAPH_NO_LABEL) {
+		Schema *s = GraphContext_GetSchemaByID(ctx->gc, part->schema_id,
+				part->t);
+		name = Schema_GetName(s);
+	}
+
+	// part files are never overwritten
+	w->f = fopen(w->path, "wbx");
+	if(w->f == NULL) return false;
+	setvbuf(w->f, w->buffer, _IOFBF, BULK_EXPORT_BUFFER_SIZE);
+
+	fwrite(name, strlen(name) + 1, 1, w->f);
+	uint32_t prop_count = ctx->attribute_count;
+	fwrite(&prop_count, sizeof(uint32_t), 1, w->f);
+	for(uint i = 0; i < prop_count; i++) {
+		const char *attr = ctx->attributes[i];
+		fwrite(attr, strlen(attr) + 1, 1, w->f);
+	}
+
+	return true;
+}
+
+// write entity's attributes, a value for each of the graph's attributes
+static bool _BulkExport_WriteAttributes
+(
+	ExportWriter *w,
+	const GraphEntity *e
+) {
+	uint attribute_count = w->ctx->attribute_count;
+	for(uint i = 0; i < attribute_count; i++) w->values[i] = SI_NullVal();
+
+	// place entity's attributes at their header position
+	const AttributeSet set = GraphEntity_GetAttributes(e);
+	uint count = ATTRIBUTE_SET_COUNT(set);
+	for(uint i = 0; i < count; i++) {
+		Attribute_ID attr_id;
+		SIValue v = AttributeSet_GetIdx(set, i, &attr_id);
+		// attribute introduced after the export began
+		if(attr_id >= attribute_count) continue;
+		w->values[attr_id] = v;
+	}
+
+	for(uint i = 0; i < attribute_count; i++) {
+		_BulkExport_WriteValue(w->f, w->values[i]);
+	}
+
+	return !ferror(w->f);
+}
+
+static bool _BulkExport_LabeledNodes
+(
+	ExportWriter *w
+) {
+	const ExportPart *part = w->part;
+	Graph *g = w->ctx->gc->g;
+	RG_Matrix L = Graph_GetLabelMatrix(g, part->schema_id);
+
+	NodeID id;
+	bool ok = true;
+	RG_MatrixTupleIter it = {0};
+	RG_MatrixTupleIter_AttachRange(&it, L, part->min_id, part->max_id);
+	while(ok && RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL)
+			== GrB_SUCCESS) {
+		Node n;
+		if(!Graph_GetNode(g, id, &n)) continue;
+		if(w->f == NULL && !_BulkExport_OpenPart(w)) {
+			ok = false;
+			break;
+		}
+		fwrite(&id, sizeof(NodeID), 1, w->f);
+		ok = _BulkExport_WriteAttributes(w, (GraphEntity *)&n);
+	}
+	RG_MatrixTupleIter_detach(&it);
+
+	return ok;
+}
+
+static bool _BulkExport_UnlabeledNodes
+(
+	ExportWriter *w
+) {
+	const ExportPart *part = w->part;
+	Graph *g = w->ctx->gc->g;
+
+	for(NodeID id = part->min_id; id <= part->max_id; id++) {
+		Node n;
+		LabelID l;
+		if(!Graph_GetNode(g, id, &n)) continue;
+		if(Graph_GetNodeLabels(g, &n, &l, 1) > 0) continue;
+
+		if(w->f == NULL && !_BulkExport_OpenPart(w)) return false;
+		fwrite(&id, sizeof(NodeID), 1, w->f);
+		if(!_BulkExport_WriteAttributes(w, (GraphEntity *)&n)) return false;
+	}
+
+	return true;
+}
+
+static bool _BulkExport_Edges
+(
+	ExportWriter *w
+) {
+	const ExportPart *part = w->part;
+	Graph *g = w->ctx->gc->g;
+	RG_Matrix R = Graph_GetRelationMatrix(g, part->schema_id, false);
+
+	bool ok = true;
+	NodeID src;
+	NodeID dest;
+	Edge *edges = array_new(Edge, 1);
+	RG_MatrixTupleIter it = {0};
+	RG_MatrixTupleIter_AttachRange(&it, R, part->min_id, part->max_id);
+	while(ok && RG_MatrixTupleIter_next_UINT64(&it, &src, &dest, NULL)
+			== GrB_SUCCESS) {
+		// expand multi-edges
+		array_clear(edges);
+		Graph_GetEdgesConnectingNodes(g, src, dest, part->schema_id, &edges);
+
+		uint edge_count = array_len(edges);
+		for(uint i = 0; ok && i < edge_count; i++) {
+			Edge *e = edges + i;
+			EdgeID id = ENTITY_GET_ID(e);
+			if(w->f == NULL && !_BulkExport_OpenPart(w)) {
+				ok = false;
+				break;
+			}
+			fwrite(&id, sizeof(EdgeID), 1, w->f);
+			fwrite(&src, sizeof(NodeID), 1, w->f);
+			fwrite(&dest, sizeof(NodeID), 1, w->f);
+			ok = _BulkExport_WriteAttributes(w, (GraphEntity *)e);
+		}
+	}
+	RG_MatrixTupleIter_detach(&it);
+	array_free(edges);
+
+	return ok;
+}
+
+static void *_BulkExport_Worker
+(
+	void *arg
+) {
+	ExportCtx *ctx = (ExportCtx *)arg;
+
+	ExportWriter w;
+	w.ctx = ctx;
+	w.buffer = rm_malloc(BULK_EXPORT_BUFFER_SIZE);
+	w.values = rm_malloc(sizeof(SIValue) * MAX(ctx->attribute_count, 1));
+
+	while(true) {
+		uint i = __atomic_fetch_add(&ctx->next_part, 1, __ATOMIC_RELAXED);
+		if(i >= ctx->part_count) break;
+
+		w.f = NULL;
+		w.part = ctx->parts + i;
+
+		bool ok;
+		if(w.part->t == SCHEMA_EDGE) {
+			ok = _BulkExport_Edges(&w);
+		} else if(w.part->schema_id == GRAPH_NO_LABEL) {
+			ok = _BulkExport_UnlabeledNodes(&w);
+		} else {
+			ok = _BulkExport_LabeledNodes(&w);
+		}
+
+		// parts without entities don't produce a file
+		if(w.f != NULL) {
+			ok &= !ferror(w.f);
+			ok &= (fclose(w.f) == 0);
+		}
+
+		if(!ok) {
+			__atomic_store_n(&ctx->res, BULK_FAIL, __ATOMIC_RELAXED);
+			// abort remaining parts
+			__atomic_store_n(&ctx->next_part, ctx->part_count,
+					__ATOMIC_RELAXED);
+			break;
+		}
+	}
+
+	rm_free(w.values);
+	rm_free(w.buffer);
+	return NULL;
+}
+
+// split the node ID space into block aligned ranges
+static void _BulkExport_AddParts
+(
+	ExportPart **parts,
+	SchemaType t,
+	int schema_id,
+	NodeID node_cap,
+	NodeID part_size
+) {
+	uint part = 0;
+	for(NodeID min_id = 0; min_id < node_cap; min_id += part_size) {
+		ExportPart p = {
+			.t         = t,
+			.schema_id = schema_id,
+			.part      = part++,
+			.min_id    = min_id,
+			.max_id    = MIN(min_id + part_size, node_cap) - 1,
+		};
+		array_append(*parts, p);
+	}
+}
+
+int BulkExport
+(
+	const GraphContext *gc,
+	const char *dir,
+	const char **attributes,
+	uint attribute_count,
+	uint thread_count
+) {
+	ASSERT(gc           != NULL);
+	ASSERT(dir          != NULL);
+	ASSERT(thread_count > 0);
+
+	Graph *g = gc->g;
+	NodeID node_cap = Graph_UncompactedNodeCount(g);
+	NodeID part_size = g->nodes->blockCap * BULK_EXPORT_BLOCKS_PER_PART;
+
+	// build parts, labels and relationships are scanned one range at a time
+	ExportPart *parts = array_new(ExportPart, 0);
+
+	int label_count = Graph_LabelTypeCount(g);
+	for(int l = 0; l < label_count; l++) {
+		_BulkExport_AddParts(&parts, SCHEMA_NODE, l, node_cap, part_size);
+	}
+	_BulkExport_AddParts(&parts, SCHEMA_NODE, GRAPH_NO_LABEL, node_cap,
+			part_size);
+
+	int relation_count = Graph_RelationTypeCount(g);
+	for(int r = 0; r < relation_count; r++) {
+		_BulkExport_AddParts(&parts, SCHEMA_EDGE, r, node_cap, part_size);
+	}
+
+	ExportCtx ctx = {
+		.gc              = gc,
+		.dir             = dir,
+		.attributes      = attributes,
+		.attribute_count = attribute_count,
+		.parts           = parts,
+		.part_count      = array_len(parts),
+		.next_part       = 0,
+		.res             = BULK_OK,
+	};
+
+	thread_count = MIN(thread_count, MAX(ctx.part_count, 1));
+	pthread_t *threads = rm_malloc(sizeof(pthread_t) * thread_count);
+
+	// spawn workers, falling back to the calling thread on failure
+	uint spawned = 0;
+	for(; spawned < thread_count; spawned++) {
+		if(pthread_create(threads + spawned, NULL, _BulkExport_Worker,
+					&ctx) != 0) {
+			break;
+		}
+	}
+	if(spawned == 0) _BulkExport_Worker(&ctx);
+
+	for(uint i = 0; i < spawned; i++) pthread_join(threads[i], NULL);
+
+	rm_free(threads);
+	array_free(parts);
+
+	return ctx.res;
+}
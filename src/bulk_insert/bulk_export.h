@@ -0,0 +1,42 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "bulk_insert.h"
+
+// number of datablock blocks covered by a single export part
+#define BULK_EXPORT_BLOCKS_PER_PART 16
+
+/*
+ * Bulk export is the inverse of bulk insert, it dumps a graph's entities
+ * into a directory using the bulk insert binary encoding.
+ *
+ * every label, relationship type and unlabeled nodes are exported
+ * in parts, each covering a range of node IDs and written to its own file:
+ *
+ * node_<label id>_<part>.bin
+ * node_unlabeled_<part>.bin
+ * edge_<relation id>_<part>.bin
+ *
+ * file format:
+ * - header : bulk insert header, listing every attribute in the graph
+ * - node record : 8-byte node ID followed by a value per attribute
+ * - edge record : 8-byte edge ID, 8-byte source ID, 8-byte destination ID
+ *                 followed by a value per attribute
+ *
+ * missing attributes are encoded as BI_NULL
+ * a node carrying multiple labels is written to each of its labels' files */
+
+// export graph entities into 'dir', returns BULK_OK on success
+int BulkExport
+(
+	const GraphContext *gc,   // graph to export
+	const char *dir,          // destination directory
+	const char **attributes,  // attribute names, indexed by attribute ID
+	uint attribute_count,     // number of attributes
+	uint thread_count         // number of exporting threads
+);
@@ -11,17 +11,6 @@
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 
-// the first byte of each property in the binary stream
-// is used to indicate the type of the subsequent SIValue
-typedef enum {
-	BI_NULL = 0,
-	BI_BOOL = 1,
-	BI_DOUBLE = 2,
-	BI_STRING = 3,
-	BI_LONG = 4,
-	BI_ARRAY = 5,
-} TYPE;
-
 /* binary header format:
  * - entity name : null-terminated C string
  * - property count : 4-byte unsigned integer
@@ -125,23 +114,25 @@ static SIValue _BulkInsert_ReadProperty
 	size_t* data_idx
 ) {
     // binary property format:
-	// - property type : 1-byte integer corresponding to TYPE enum
+	// - property type : 1-byte integer corresponding to BI_TYPE enum
 	// - Nothing if type is NULL
 	// - 1-byte true/false if type is boolean
 	// - 8-byte double if type is double
 	// - 8-byte integer if type is integer
 	// - Null-terminated C string if type is string
 	// - 8-byte array length followed by N values if type is array
+	// - 8-byte latitude followed by 8-byte longitude if type is point
 
     // possible property values
     bool b;
     double d;
+    double lon;
     int64_t i;
     int64_t len;
     const char* s;
 
     SIValue v = SI_NullVal();
-    TYPE t = data[*data_idx];
+    BI_TYPE t = data[*data_idx];
     *data_idx += 1;
 
 	switch (t) {
@@ -185,6 +176,14 @@ static SIValue _BulkInsert_ReadProperty
 			}
 			break;
 
+		case BI_POINT:
+			d = *(double*)&data[*data_idx];
+			*data_idx += sizeof(double);
+			lon = *(double*)&data[*data_idx];
+			*data_idx += sizeof(double);
+			v = SI_Point(d, lon);
+			break;
+
 		default:
 			ASSERT(false);
 			break;
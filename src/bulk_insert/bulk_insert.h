@@ -14,6 +14,18 @@
 #define BULK_OK 1
 #define BULK_FAIL 0
 
+// the first byte of each property in the binary stream
+// is used to indicate the type of the subsequent SIValue
+typedef enum {
+	BI_NULL = 0,
+	BI_BOOL = 1,
+	BI_DOUBLE = 2,
+	BI_STRING = 3,
+	BI_LONG = 4,
+	BI_ARRAY = 5,
+	BI_POINT = 6,
+} BI_TYPE;
+
 /*
  * Bulk insert performs fast insertion of large amount of data,
  * it's an alternative to Cypher's CREATE query, one should prefer using
@@ -0,0 +1,167 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../redismodule.h"
+#include "../configuration/config.h"
+#include "../graph/graphcontext.h"
+#include "../util/rmalloc.h"
+#include "../util/blocked_client.h"
+#include "../bulk_insert/bulk_export.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+typedef struct {
+	RedisModuleBlockedClient *bc;  // client waiting for the export to finish
+	uint64_t node_count;           // number of exported nodes
+	uint64_t edge_count;           // number of exported edges
+} ExportRequest;
+
+// invoked on Redis main thread once the export child exits
+static void _Graph_ExportDone
+(
+	int exitcode,
+	int bysignal,
+	void *user_data
+) {
+	ExportRequest *req = (ExportRequest *)user_data;
+	RedisModuleCtx *ctx = RedisModule_GetThreadSafeContext(req->bc);
+
+	if(exitcode != 0 || bysignal != 0) {
+		RedisModule_ReplyWithError(ctx, "Failed to export graph");
+	} else {
+		char *reply;
+		int len = asprintf(&reply, "%llu nodes exported, %llu edges exported",
+				(unsigned long long)req->node_count,
+				(unsigned long long)req->edge_count);
+		RedisModule_ReplyWithStringBuffer(ctx, reply, len);
+		free(reply);
+	}
+
+	RedisModule_FreeThreadSafeContext(ctx);
+	RedisGraph_UnblockClient(req->bc);
+	rm_free(req);
+}
+
+// usage:
+// GRAPH.EXPORT G <name>
+//
+// entities are written to a new directory named 'name' under EXPORT_DIR
+// the export runs within a forked child, working on a snapshot of the graph
+// the read lock is only held while forking
+int Graph_Export
+(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+) {
+	//--------------------------------------------------------------------------
+	// validations
+	//--------------------------------------------------------------------------
+
+	ASSERT(ctx  != NULL);
+	ASSERT(argv != NULL);
+	if(argc != 3) {
+		RedisModule_WrongArity(ctx);
+		return REDISMODULE_OK;
+	}
+
+	if(RedisModule_Fork == NULL) {
+		RedisModule_ReplyWithError(ctx,
+				"GRAPH.EXPORT requires Redis fork support");
+		return REDISMODULE_OK;
+	}
+
+	// exports are confined to the directory configured at load time
+	const char *export_dir = NULL;
+	bool res = Config_Option_get(Config_EXPORT_DIR, &export_dir);
+	ASSERT(res);
+	if(export_dir == NULL) {
+		RedisModule_ReplyWithError(ctx,
+				"GRAPH.EXPORT is disabled, EXPORT_DIR isn't configured");
+		return REDISMODULE_OK;
+	}
+
+	// name must be a single path component
+	const char *name = RedisModule_StringPtrLen(argv[2], NULL);
+	if(name[0] == '\0' || strchr(name, '/') != NULL ||
+			strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+		RedisModule_ReplyWithError(ctx, "Invalid export name");
+		return REDISMODULE_OK;
+	}
+
+	char dir[PATH_MAX];
+	if(snprintf(dir, PATH_MAX, "%s/%s", export_dir, name) >= PATH_MAX) {
+		RedisModule_ReplyWithError(ctx, "Export name is too long");
+		return REDISMODULE_OK;
+	}
+
+	// get a hold of the graph key
+	RedisModuleString *key = argv[1];
+	GraphContext *gc = GraphContext_Retrieve(ctx, key, true, false);
+	if(gc == NULL) {
+		// if GraphContext is null, key access failed and an error been emitted
+		return REDISMODULE_OK;
+	}
+
+	// never write into an existing directory
+	if(mkdir(dir, 0700) != 0) {
+		RedisModule_ReplyWithError(ctx, (errno == EEXIST) ?
+				"Export already exists" : "Failed to create export directory");
+		GraphContext_DecreaseRefCount(gc);
+		return REDISMODULE_OK;
+	}
+
+	// collect attribute names ahead of forking
+	// the child must not contend on the attributes lock
+	uint attribute_count = GraphContext_AttributeCount(gc);
+	const char **attributes =
+		rm_malloc(sizeof(char *) * MAX(attribute_count, 1));
+	for(uint i = 0; i < attribute_count; i++) {
+		attributes[i] = GraphContext_GetAttributeString(gc, i);
+	}
+
+	uint thread_count;
+	res = Config_Option_get(Config_THREAD_POOL_SIZE, &thread_count);
+	ASSERT(res);
+	UNUSED(res);
+
+	ExportRequest *req = rm_malloc(sizeof(ExportRequest));
+	req->bc = RedisGraph_BlockClient(ctx);
+
+	// the fork prepare handler holds a read lock on every graph
+	// while forking, the child inherits a consistent snapshot
+	Graph *g = gc->g;
+	req->node_count = Graph_NodeCount(g);
+	req->edge_count = Graph_EdgeCount(g);
+
+	int pid = RedisModule_Fork(_Graph_ExportDone, req);
+	if(pid == 0) {
+		// child process, export graph snapshot and exit
+		int rc = BulkExport(gc, dir, attributes, attribute_count,
+				thread_count);
+		RedisModule_ExitFromChild(rc == BULK_OK ? 0 : 1);
+	}
+
+	rm_free(attributes);
+	GraphContext_DecreaseRefCount(gc);
+
+	if(pid == -1) {
+		// another child process (e.g. BGSAVE) is running
+		rmdir(dir);
+		RedisModuleCtx *bc_ctx = RedisModule_GetThreadSafeContext(req->bc);
+		RedisModule_ReplyWithError(bc_ctx,
+				"Failed to fork export process, a background save may be in progress");
+		RedisModule_FreeThreadSafeContext(bc_ctx);
+		RedisGraph_UnblockClient(req->bc);
+		rm_free(req);
+	}
+
+	return REDISMODULE_OK;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../redismodule.h"
+#include "../graph/graphcontext.h"
+#include "../graph/graph_memory.h"
+#include "../util/rmalloc.h"
+#include "../util/thpool/pools.h"
+#include "../util/blocked_client.h"
+
+typedef struct {
+	RedisModuleBlockedClient *bc;  // client waiting for the report
+	GraphContext *gc;              // graph to inspect
+} MemoryRequest;
+
+// compute graph's memory usage under a read lock, preventing concurrent writes
+static GraphMemoryUsage *_Graph_MemoryUsage
+(
+	GraphContext *gc,
+	bool exact,
+	uint64_t samples
+) {
+	Graph_AcquireReadLock(gc->g);
+	GraphMemoryUsage *usage = GraphMemoryUsage_New(gc, exact, samples);
+	Graph_ReleaseLock(gc->g);
+
+	return usage;
+}
+
+// retain report, exposed via INFO
+// must be called while holding the GIL
+static void _Graph_MemoryRetain
+(
+	GraphContext *gc,
+	GraphMemoryUsage *usage
+) {
+	if(gc->memory_usage != NULL) GraphMemoryUsage_Free(gc->memory_usage);
+	gc->memory_usage = usage;
+}
+
+// reader thread job, walks every graph entity
+// keeping Redis main thread responsive on large graphs
+static void _Graph_MemoryExact
+(
+	void *args
+) {
+	MemoryRequest *req = (MemoryRequest *)args;
+	GraphContext *gc = req->gc;
+
+	GraphMemoryUsage *usage = _Graph_MemoryUsage(gc, true, 0);
+
+	RedisModuleCtx *ctx = RedisModule_GetThreadSafeContext(req->bc);
+	GraphMemoryUsage_Reply(usage, gc, ctx);
+
+	// INFO reads the retained report from the main thread
+	RedisModule_ThreadSafeContextLock(ctx);
+	_Graph_MemoryRetain(gc, usage);
+	RedisModule_ThreadSafeContextUnlock(ctx);
+
+	RedisModule_FreeThreadSafeContext(ctx);
+	RedisGraph_UnblockClient(req->bc);
+	GraphContext_DecreaseRefCount(gc);
+	rm_free(req);
+}
+
+// usage:
+// GRAPH.MEMORY G
+// GRAPH.MEMORY G EXACT
+// GRAPH.MEMORY G SAMPLES 4096
+int Graph_Memory
+(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+) {
+	//--------------------------------------------------------------------------
+	// validations
+	//--------------------------------------------------------------------------
+
+	ASSERT(ctx  != NULL);
+	ASSERT(argv != NULL);
+	if(argc < 2 || argc > 4) {
+		RedisModule_WrongArity(ctx);
+		return REDISMODULE_OK;
+	}
+
+	bool exact = false;
+	long long samples = GRAPH_MEMORY_DEFAULT_SAMPLES;
+
+	// handle mode e.g. GRAPH.MEMORY G EXACT
+	if(argc > 2) {
+		const char *mode = RedisModule_StringPtrLen(argv[2], NULL);
+		if(argc == 3 && strcasecmp(mode, "exact") == 0) {
+			exact = true;
+		} else if(argc == 4 && strcasecmp(mode, "samples") == 0) {
+			if(RedisModule_StringToLongLong(argv[3], &samples) != REDISMODULE_OK
+					|| samples <= 0) {
+				RedisModule_ReplyWithError(ctx,
+						"SAMPLES must be a positive integer");
+				return REDISMODULE_OK;
+			}
+		} else {
+			RedisModule_ReplyWithError(ctx, "Unknown subcommand");
+			return REDISMODULE_OK;
+		}
+	}
+
+	// get a hold of the graph key
+	RedisModuleString *key = argv[1];
+	GraphContext *gc = GraphContext_Retrieve(ctx, key, true, false);
+	if(gc == NULL) {
+		// if GraphContext is null, key access failed and an error been emitted
+		return REDISMODULE_OK;
+	}
+
+	// an exact report walks every entity, run it on a reader thread
+	// unless the client can't be blocked
+	int flags = RedisModule_GetContextFlags(ctx);
+	bool blockable = !(flags & (REDISMODULE_CTX_FLAGS_MULTI         |
+								REDISMODULE_CTX_FLAGS_LUA           |
+								REDISMODULE_CTX_FLAGS_DENY_BLOCKING |
+								REDISMODULE_CTX_FLAGS_LOADING));
+
+	if(exact && blockable) {
+		MemoryRequest *req = rm_malloc(sizeof(MemoryRequest));
+		req->gc = gc;
+		req->bc = RedisGraph_BlockClient(ctx);
+
+		if(ThreadPools_AddWorkReader(_Graph_MemoryExact, req) ==
+				THPOOL_QUEUE_FULL) {
+			RedisModuleCtx *bc_ctx = RedisModule_GetThreadSafeContext(req->bc);
+			RedisModule_ReplyWithError(bc_ctx, "Max pending queries exceeded");
+			RedisModule_FreeThreadSafeContext(bc_ctx);
+			RedisGraph_UnblockClient(req->bc);
+			GraphContext_DecreaseRefCount(gc);
+			rm_free(req);
+		}
+
+		return REDISMODULE_OK;
+	}
+
+	GraphMemoryUsage *usage = _Graph_MemoryUsage(gc, exact, samples);
+	GraphMemoryUsage_Reply(usage, gc, ctx);
+	_Graph_MemoryRetain(gc, usage);
+
+	GraphContext_DecreaseRefCount(gc);
+
+	return REDISMODULE_OK;
+}
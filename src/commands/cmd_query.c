@@ -5,6 +5,7 @@
  */
 
 #include "RG.h"
+#include "xxhash.h"
 #include "../errors.h"
 #include "cmd_context.h"
 #include "../ast/ast.h"
@@ -14,10 +15,21 @@
 #include "../graph/graph.h"
 #include "../util/rmalloc.h"
 #include "../util/cache/cache.h"
+#include "../util/admission.h"
 #include "../util/thpool/pools.h"
+#include "../util/thread_budget.h"
+#include "../configuration/config.h"
+#include "../execution_plan/ops/ops.h"
 #include "../execution_plan/execution_plan.h"
+#include "../execution_plan/execution_plan_build/execution_plan_modify.h"
 #include "execution_ctx.h"
 
+// estimated memory consumed by a record materialized by an eager operation
+#define RECORD_MEM_ESTIMATE 64
+
+// estimated number of nodes produced by an index scan or an ID seek
+#define INDEX_SCAN_ESTIMATE 1024
+
 // GraphQueryCtx stores the allocations required to execute a query.
 typedef struct {
 	GraphContext *graph_ctx;  // graph context
@@ -28,6 +40,7 @@ typedef struct {
 	bool readonly_query;      // read only query
 	bool profile;             // profile query
 	CronTaskHandle timeout;   // timeout cron task
+	AdmissionTicket admission;  // query's admission
 } GraphQueryCtx;
 
 static GraphQueryCtx *GraphQueryCtx_New
@@ -38,7 +51,8 @@ static GraphQueryCtx *GraphQueryCtx_New
 	CommandCtx *command_ctx,
 	bool readonly_query,
 	bool profile,
-	CronTaskHandle timeout
+	CronTaskHandle timeout,
+	AdmissionTicket admission
 ) {
 	GraphQueryCtx *ctx = rm_malloc(sizeof(GraphQueryCtx));
 
@@ -50,6 +64,7 @@ static GraphQueryCtx *GraphQueryCtx_New
 	ctx->readonly_query  =  readonly_query;
 	ctx->profile         =  profile;
 	ctx->timeout         =  timeout;
+	ctx->admission       =  admission;
 
 	return ctx;
 }
@@ -148,13 +163,204 @@ inline static bool _readonly_cmd_mode(CommandCtx *ctx) {
 	return strcasecmp(CommandCtx_GetCommandName(ctx), "graph.RO_QUERY") == 0;
 }
 
-/* _ExecuteQuery accepts a GraphQeuryCtx as an argument
- * it may be called directly by a reader thread or the Redis main thread,
- * or dispatched as a worker thread job. */
-static void _ExecuteQuery(void *args) {
-	ASSERT(args != NULL);
+// number of entries in the matrices an algebraic expression operates on
+static uint64_t _ExpressionMatrixWork
+(
+	const AlgebraicExpression *exp,
+	GraphContext *gc
+) {
+	if(exp->type == AL_OPERATION) {
+		uint64_t work = 0;
+		uint n = AlgebraicExpression_ChildCount(exp);
+		for(uint i = 0; i < n; i++) {
+			work += _ExpressionMatrixWork(exp->operation.children[i], gc);
+		}
+		return work;
+	}
+
+	Graph *g = gc->g;
+	RG_Matrix m = NULL;
+	const char *label = exp->operand.label;
+
+	if(label == NULL) {
+		// unlabeled nodes are represented by the identity matrix
+		if(exp->operand.diagonal) return 0;
+		m = g->adjacency_matrix;
+	} else {
+		SchemaType t = exp->operand.diagonal ? SCHEMA_NODE : SCHEMA_EDGE;
+		Schema *s = GraphContext_GetSchema(gc, label, t);
+		// unknown label or relationship type, operand is empty
+		if(s == NULL) return 0;
+		m = (t == SCHEMA_NODE) ? g->labels[Schema_GetID(s)] :
+			g->relations[Schema_GetID(s)];
+	}
+
+	GrB_Index nvals;
+	RG_Matrix_nvals(&nvals, m);
+	return nvals;
+}
+
+// estimate the amount of matrix work performed by plan
+// sums the number of entries in every matrix traversed by the plan
+static uint64_t _EstimateMatrixWork
+(
+	const ExecutionPlan *plan,
+	GraphContext *gc
+) {
+	const OPType types[4] = {OPType_CONDITIONAL_TRAVERSE,
+		OPType_CONDITIONAL_VAR_LEN_TRAVERSE, OPType_EXPAND_INTO, OPType_DEGREE};
+
+	OpBase **ops = ExecutionPlan_CollectOpsMatchingType(plan->root, types, 4);
+
+	uint64_t work = 0;
+	uint op_count = array_len(ops);
+	for(uint i = 0; i < op_count; i++) {
+		OpBase *op = ops[i];
+		switch(op->type) {
+			case OPType_CONDITIONAL_TRAVERSE:
+				work += _ExpressionMatrixWork(((OpCondTraverse *)op)->ae, gc);
+				break;
+			case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+				work += _ExpressionMatrixWork(((CondVarLenTraverse *)op)->ae,
+						gc);
+				break;
+			case OPType_EXPAND_INTO:
+				work += _ExpressionMatrixWork(((OpExpandInto *)op)->ae, gc);
+				break;
+			case OPType_DEGREE: {
+				OpDegree *degree = (OpDegree *)op;
+				for(uint j = 0; j < degree->hop_count; j++) {
+					work += _ExpressionMatrixWork(degree->hops[j].ae, gc);
+				}
+				break;
+			}
+			default:
+				ASSERT(false);
+				break;
+		}
+	}
+
+	array_free(ops);
+
+	return work;
+}
+
+// number of nodes with label, 0 for unknown labels
+static uint64_t _LabelCardinality
+(
+	const Graph *g,
+	int label_id
+) {
+	return (label_id < 0) ? 0 : Graph_LabeledNodeCount(g, label_id);
+}
+
+// estimate the number of records produced by a scan operation
+static uint64_t _ScanCardinality
+(
+	const OpBase *op,
+	const Graph *g
+) {
+	switch(op->type) {
+		case OPType_ALL_NODE_SCAN:
+			return Graph_NodeCount(g);
+		case OPType_NODE_BY_LABEL_SCAN:
+		case OPType_NODE_BY_LABEL_AND_ID_SCAN:
+			return _LabelCardinality(g, ((NodeByLabelScan *)op)->n.label_id);
+		case OPType_NODE_BY_INDEX_SCAN:
+			return MIN(INDEX_SCAN_ESTIMATE,
+					_LabelCardinality(g, ((IndexScan *)op)->n.label_id));
+		case OPType_NODE_BY_GEO_INDEX_SCAN:
+			return MIN(INDEX_SCAN_ESTIMATE,
+					_LabelCardinality(g, ((NodeByGeoIndexScan *)op)->n.label_id));
+		default:
+			return INDEX_SCAN_ESTIMATE;
+	}
+}
+
+// estimate the amount of memory consumed by plan
+// operations which materialize their input may buffer every record produced
+// by the plan's scans, plans without scans or eager operations fall back to
+// admission's minimal reservation
+static size_t _EstimateMemory
+(
+	const ExecutionPlan *plan,
+	const Graph *g
+) {
+	// index operations
+	if(plan == NULL) return 0;
+
+	const OPType eager_types[9] = {OPType_AGGREGATE, OPType_SORT,
+		OPType_DISTINCT, OPType_CARTESIAN_PRODUCT, OPType_VALUE_HASH_JOIN,
+		OPType_CREATE, OPType_UPDATE, OPType_DELETE, OPType_MERGE};
+
+	const OPType scan_types[7] = {OPType_ALL_NODE_SCAN,
+		OPType_NODE_BY_LABEL_SCAN, OPType_NODE_BY_LABEL_AND_ID_SCAN,
+		OPType_NODE_BY_INDEX_SCAN, OPType_NODE_BY_GEO_INDEX_SCAN,
+		OPType_EDGE_BY_INDEX_SCAN, OPType_NODE_BY_ID_SEEK};
+
+	OpBase **ops = ExecutionPlan_CollectOpsMatchingType(plan->root,
+			eager_types, 9);
+	uint64_t eager_count = array_len(ops);
+	array_free(ops);
+
+	ops = ExecutionPlan_CollectOpsMatchingType(plan->root, scan_types, 7);
+	uint64_t records = 0;
+	uint scan_count = array_len(ops);
+	for(uint i = 0; i < scan_count; i++) {
+		records += _ScanCardinality(ops[i], g);
+	}
+	array_free(ops);
+
+	size_t estimate = eager_count * records * RECORD_MEM_ESTIMATE;
+
+	// a query can't consume more than its memory capacity
+	int64_t capacity;
+	Config_Option_get(Config_QUERY_MEM_CAPACITY, &capacity);
+	if(capacity != QUERY_MEM_CAPACITY_UNLIMITED && estimate > (size_t)capacity) {
+		estimate = capacity;
+	}
+
+	return estimate;
+}
+
+// reserve query's memory within the server wide budget
+// queries which can't block, e.g. running on Redis main thread, don't wait
+// returns false if the query was rejected
+static bool _AdmitQuery
+(
+	AdmissionTicket *admission,  // [output] query admission
+	CommandCtx *command_ctx,     // command context
+	ExecutionCtx *exec_ctx,      // execution context
+	GraphContext *gc             // graph context
+) {
+	if(!AdmissionControl_Enabled()) {
+		return AdmissionControl_Admit(admission, 0, 0, 0) != ADMISSION_REJECTED;
+	}
+
+	// fingerprint query by its text, excluding parameters, and graph
+	const char *query = QueryCtx_GetQueryCtx()->query_data.query_no_params;
+	XXH64_hash_t fingerprint = XXH64(query, strlen(query),
+			XXH64(gc->graph_name, strlen(gc->graph_name), 0));
+
+	uint64_t wait = 0;
+	if(command_ctx->thread != EXEC_THREAD_MAIN) {
+		wait = (command_ctx->timeout != 0)
+			? command_ctx->timeout
+			: ADMISSION_DEFAULT_WAIT;
+	}
+
+	return AdmissionControl_Admit(admission, fingerprint,
+			_EstimateMemory(exec_ctx->plan, gc->g), wait) != ADMISSION_REJECTED;
+}
+
+// executes query, replicating it if the graph was modified
+// on return the query may still hold its commit locks
+static ResultSet *_RunQuery
+(
+	GraphQueryCtx *gq_ctx
+) {
+	ASSERT(gq_ctx != NULL);
 
-	GraphQueryCtx   *gq_ctx       =  args;
 	QueryCtx        *query_ctx    =  gq_ctx->query_ctx;
 	GraphContext    *gc           =  gq_ctx->graph_ctx;
 	RedisModuleCtx  *rm_ctx       =  gq_ctx->rm_ctx;
@@ -166,13 +372,6 @@ static void _ExecuteQuery(void *args) {
 	ExecutionPlan   *plan         =  exec_ctx->plan;
 	ExecutionType   exec_type     =  exec_ctx->exec_type;
 
-	// if we have migrated to a writer thread,
-	// update thread-local storage and track the CommandCtx
-	if(command_ctx->thread == EXEC_THREAD_WRITER) {
-		QueryCtx_SetTLS(query_ctx);
-		CommandCtx_TrackCtx(command_ctx);
-	}
-
 	// instantiate the query ResultSet
 	bool compact = command_ctx->compact;
 	ResultSetFormatterType resultset_format = profile
@@ -191,12 +390,14 @@ static void _ExecuteQuery(void *args) {
 	} else {
 		/* if this is a writer query `we need to re-open the graph key with write flag
 		 * this notifies Redis that the key is "dirty" any watcher on that key will
-		 * be notified */
-		CommandCtx_ThreadSafeContextLock(command_ctx);
+		 * be notified
+		 * a group committed query already runs under the GIL */
+		bool gil_held = query_ctx->internal_exec_ctx.locked_for_commit;
+		if(!gil_held) CommandCtx_ThreadSafeContextLock(command_ctx);
 		{
 			GraphContext_MarkWriter(rm_ctx, gc);
 		}
-		CommandCtx_ThreadSafeContextUnlock(command_ctx);
+		if(!gil_held) CommandCtx_ThreadSafeContextUnlock(command_ctx);
 	}
 
 	if(exec_type == EXECUTION_TYPE_QUERY) {  // query operation
@@ -205,6 +406,22 @@ static void _ExecuteQuery(void *args) {
 		Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_FLUSH_RESIZE);
 
 		ExecutionPlan_PreparePlan(plan);
+
+		// a timed out query fails after its last commit
+		// and a query exceeding its memory capacity may fail while committing
+		// as such all modifications must be logged for rollback
+		int64_t mem_capacity;
+		Config_Option_get(Config_QUERY_MEM_CAPACITY, &mem_capacity);
+		if(gq_ctx->timeout != 0 ||
+		   mem_capacity != QUERY_MEM_CAPACITY_UNLIMITED) {
+			UndoLog_AllowFinalCommit(&query_ctx->undo_log, false);
+		}
+
+		// limit the number of threads GraphBLAS operations may use
+		// according to the query's workload and the number of concurrent queries
+		ThreadBudget_Acquire(_EstimateMatrixWork(plan, gc),
+				gq_ctx->admission.max_threads);
+
 		if(profile) {
 			ExecutionPlan_Profile(plan);
 			if(!ErrorCtx_EncounteredError()) ExecutionPlan_Print(plan, rm_ctx);
@@ -219,6 +436,14 @@ static void _ExecuteQuery(void *args) {
 		// emit error if query timed out
 		if(ExecutionPlan_Drained(plan)) ErrorCtx_SetError("Query timed out");
 
+		ThreadBudget_Release();
+
+		// feed observed cardinalities back to the cached query
+		if(exec_ctx->feedback && !ErrorCtx_EncounteredError()) {
+			PlanFeedback_Observe(exec_ctx->feedback,
+					exec_ctx->params_signature, plan);
+		}
+
 		ExecutionPlan_Free(plan);
 		exec_ctx->plan = NULL;
 	} else if(exec_type == EXECUTION_TYPE_INDEX_CREATE ||
@@ -239,32 +464,195 @@ static void _ExecuteQuery(void *args) {
 	if(ResultSetStat_IndicateModification(&result_set->stats)) {
 		QueryCtx_Replicate(query_ctx);
 	}
-	
-	QueryCtx_UnlockCommit();
 
-	if(!profile || ErrorCtx_EncounteredError()) {
+	return result_set;
+}
+
+// reply to the client and account for the query's execution
+static void _ReplyQuery
+(
+	GraphQueryCtx *gq_ctx,
+	ResultSet *result_set
+) {
+	ASSERT(gq_ctx     != NULL);
+	ASSERT(result_set != NULL);
+
+	GraphContext *gc          = gq_ctx->graph_ctx;
+	CommandCtx   *command_ctx = gq_ctx->command_ctx;
+
+	if(!gq_ctx->profile || ErrorCtx_EncounteredError()) {
 		// if we encountered an error, ResultSet_Reply will emit the error
 		// send result-set back to client
 		ResultSet_Reply(result_set);
 	}
 
-	if(readonly) Graph_ReleaseLock(gc->g); // release read lock
+	if(gq_ctx->readonly_query) Graph_ReleaseLock(gc->g); // release read lock
 
 	// log query to slowlog
 	SlowLog *slowlog = GraphContext_GetSlowLog(gc);
 	SlowLog_Add(slowlog, command_ctx->command_name, command_ctx->query,
 				QueryCtx_GetExecutionTime(), NULL);
 
-	// clean up
-	ExecutionCtx_Free(exec_ctx);
-	GraphContext_DecreaseRefCount(gc);
-	CommandCtx_Free(command_ctx);
+	// release query's memory reservation, reporting its actual consumption
+	AdmissionControl_Release(&gq_ctx->admission, rm_peak_n_alloced());
+}
+
+// free query's allocations, unblocking its client
+static void _FreeQuery
+(
+	GraphQueryCtx *gq_ctx,
+	ResultSet *result_set
+) {
+	ASSERT(gq_ctx != NULL);
+
+	ExecutionCtx_Free(gq_ctx->exec_ctx);
+	GraphContext_DecreaseRefCount(gq_ctx->graph_ctx);
+	CommandCtx_Free(gq_ctx->command_ctx);
 	QueryCtx_Free(); // reset the QueryCtx and free its allocations
 	ErrorCtx_Clear();
 	ResultSet_Free(result_set);
 	GraphQueryCtx_Free(gq_ctx);
 }
 
+/* _ExecuteQuery accepts a GraphQeuryCtx as an argument
+ * it may be called directly by a reader thread or the Redis main thread,
+ * or dispatched as a worker thread job. */
+static void _ExecuteQuery(void *args) {
+	ASSERT(args != NULL);
+
+	GraphQueryCtx *gq_ctx      = args;
+	CommandCtx    *command_ctx = gq_ctx->command_ctx;
+
+	// if we have migrated to a writer thread,
+	// update thread-local storage and track the CommandCtx
+	if(command_ctx->thread == EXEC_THREAD_WRITER) {
+		QueryCtx_SetTLS(gq_ctx->query_ctx);
+		CommandCtx_TrackCtx(command_ctx);
+	}
+
+	ResultSet *result_set = _RunQuery(gq_ctx);
+
+	QueryCtx_UnlockCommit();
+
+	_ReplyQuery(gq_ctx, result_set);
+	_FreeQuery(gq_ctx, result_set);
+}
+
+//------------------------------------------------------------------------------
+// Group commit
+//------------------------------------------------------------------------------
+
+// returns true if plan reads the graph before committing its modifications
+// e.g. MATCH ... SET, as opposed to a plain CREATE
+static bool _PlanReadsGraph
+(
+	const ExecutionPlan *plan
+) {
+	// index operations scan the graph
+	if(plan == NULL) return true;
+
+	const OPType types[14] = {OPType_ALL_NODE_SCAN, OPType_NODE_BY_LABEL_SCAN,
+		OPType_NODE_BY_INDEX_SCAN, OPType_NODE_BY_GEO_INDEX_SCAN,
+		OPType_EDGE_BY_INDEX_SCAN, OPType_NODE_BY_ID_SEEK,
+		OPType_NODE_BY_LABEL_AND_ID_SCAN, OPType_EXPAND_INTO,
+		OPType_CONDITIONAL_TRAVERSE, OPType_CONDITIONAL_VAR_LEN_TRAVERSE,
+		OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO, OPType_MERGE,
+		OPType_PROC_CALL, OPType_DEGREE};
+
+	OpBase **ops = ExecutionPlan_CollectOpsMatchingType(plan->root, types, 14);
+	bool reads = (array_len(ops) > 0);
+	array_free(ops);
+
+	return reads;
+}
+
+// execute a group of write queries back to back
+// every query runs its read phase unlocked and takes the GIL, graph key and
+// graph write lock only once it commits, as an individual query would
+// the locks are then held on behalf of the group and shared by the following
+// queries which don't read the graph, e.g. plain CREATE queries
+// and released before a query which does, or once the group is done
+// every query rolls back its own modifications through its undo log
+// and is replicated individually, in commit order
+static void _ExecuteWriteGroup
+(
+	GraphQueryCtx **group,  // queries to execute, in arrival order
+	uint n                  // number of queries
+) {
+	ASSERT(n > 0);
+	ASSERT(group != NULL);
+
+	// query holding commit locks on behalf of the group
+	// freed only once the locks are released, as its context opened the key
+	GraphQueryCtx *holder            = NULL;
+	ResultSet     *holder_result_set = NULL;
+
+	for(uint i = 0; i < n; i++) {
+		GraphQueryCtx *gq_ctx = group[i];
+
+		// don't block Redis and the graph's readers while reading the graph
+		if(holder != NULL && _PlanReadsGraph(gq_ctx->exec_ctx->plan)) {
+			QueryCtx_SetTLS(holder->query_ctx);
+			QueryCtx_UnlockCommit();
+			_FreeQuery(holder, holder_result_set);
+			holder = NULL;
+		}
+
+		QueryCtx_SetTLS(gq_ctx->query_ctx);
+		CommandCtx_TrackCtx(gq_ctx->command_ctx);
+		if(holder != NULL) QueryCtx_ShareCommitLock(holder->query_ctx);
+
+		ResultSet *result_set = _RunQuery(gq_ctx);
+
+		// keep the locks taken by the query for the rest of the group
+		bool hold = holder == NULL && i + 1 < n &&
+			gq_ctx->query_ctx->internal_exec_ctx.locked_for_commit;
+
+		if(!hold) QueryCtx_UnlockCommit();  // shared locks are only dropped
+
+		_ReplyQuery(gq_ctx, result_set);
+
+		if(hold) {
+			holder            = gq_ctx;
+			holder_result_set = result_set;
+			ErrorCtx_Clear();  // holder's error was reported
+			CommandCtx_UntrackCtx(gq_ctx->command_ctx);
+			QueryCtx_RemoveFromTLS();
+		} else {
+			_FreeQuery(gq_ctx, result_set);
+		}
+	}
+
+	// release group's commit locks
+	if(holder != NULL) {
+		QueryCtx_SetTLS(holder->query_ctx);
+		QueryCtx_UnlockCommit();
+		_FreeQuery(holder, holder_result_set);
+	}
+}
+
+// writer thread job, drains graph's pending write queries
+// committing them in groups of up to WRITE_GROUP_SIZE queries
+static void _ExecutePendingWrites(void *args) {
+	ASSERT(args != NULL);
+
+	GraphContext *gc = args;
+
+	uint n;
+	uint64_t group_size;
+	Config_Option_get(Config_WRITE_GROUP_SIZE, &group_size);
+	GraphQueryCtx **group = rm_malloc(sizeof(GraphQueryCtx *) * group_size);
+
+	while((n = GraphContext_DequeueWrites(gc, (void **)group, group_size)) > 0) {
+		_ExecuteWriteGroup(group, n);
+	}
+
+	rm_free(group);
+
+	// release the reference taken when the job was scheduled
+	GraphContext_DecreaseRefCount(gc);
+}
+
 static void _DelegateWriter(GraphQueryCtx *gq_ctx) {
 	ASSERT(gq_ctx != NULL);
 
@@ -283,9 +671,17 @@ static void _DelegateWriter(GraphQueryCtx *gq_ctx) {
 	// update execution thread to writer
 	gq_ctx->command_ctx->thread = EXEC_THREAD_WRITER;
 
-	// dispatch work to the writer thread
-	int res = ThreadPools_AddWorkWriter(_ExecuteQuery, gq_ctx, 0);
-	ASSERT(res == 0);
+	// queue query on its graph, such that writes execute in arrival order
+	// regardless of the group size in effect when they were delegated
+	// the first query queued schedules a job draining the queue
+	GraphContext *gc = gq_ctx->graph_ctx;
+	if(GraphContext_EnqueueWrite(gc, gq_ctx)) {
+		// the job keeps the graph alive until its queue is drained
+		GraphContext_IncreaseRefCount(gc);
+		int res = ThreadPools_AddWorkWriter(_ExecutePendingWrites, gc, 0);
+		ASSERT(res == 0);
+		UNUSED(res);
+	}
 }
 
 void _query(bool profile, void *args) {
@@ -325,6 +721,13 @@ void _query(bool profile, void *args) {
 		goto cleanup;
 	}
 
+	// reject early rather than fail once memory is exhausted
+	AdmissionTicket admission;
+	if(!_AdmitQuery(&admission, command_ctx, exec_ctx, gc)) {
+		ErrorCtx_SetError("TRYAGAIN query memory budget exhausted, retry later");
+		goto cleanup;
+	}
+
 	CronTaskHandle timeout_task = 0;
 
 	// enforce specified timeout when query is readonly
@@ -335,7 +738,8 @@ void _query(bool profile, void *args) {
 
 	// populate the container struct for invoking _ExecuteQuery.
 	GraphQueryCtx *gq_ctx = GraphQueryCtx_New(gc, ctx, exec_ctx, command_ctx,
-											  readonly, profile, timeout_task);
+											  readonly, profile, timeout_task,
+											  admission);
 
 	// if 'thread' is redis main thread, continue running
 	// if readonly is true we're executing on a worker thread from
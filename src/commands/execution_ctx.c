@@ -28,6 +28,11 @@ static ExecutionCtx *_ExecutionCtx_New(AST *ast, ExecutionPlan *plan,
 	exec_ctx->plan      = plan;
 	exec_ctx->cached    = false;
 	exec_ctx->exec_type = exec_type;
+	exec_ctx->params_signature = 0;
+	// only cached query plans are subject to re-optimization
+	exec_ctx->feedback = (exec_type == EXECUTION_TYPE_QUERY)
+		? PlanFeedback_New()
+		: NULL;
 
 	return exec_ctx;
 }
@@ -42,6 +47,10 @@ ExecutionCtx *ExecutionCtx_Clone(ExecutionCtx *orig) {
 	execution_ctx->plan      = ExecutionPlan_Clone(orig->plan);
 	execution_ctx->cached    = orig->cached;
 	execution_ctx->exec_type = orig->exec_type;
+	execution_ctx->params_signature = orig->params_signature;
+	execution_ctx->feedback = (orig->feedback)
+		? PlanFeedback_Share(orig->feedback)
+		: NULL;
 
 	return execution_ctx;
 }
@@ -97,6 +106,18 @@ ExecutionCtx *ExecutionCtx_FromQuery(const char *query) {
 		// Set parameters parse result in the execution ast.
 		AST_SetParamsParseResult(ret->ast, params_parse_result);
 		ret->cached = true;
+
+		// prefer a plan re-optimized for these parameters
+		// according to cardinalities observed by previous executions
+		if(ret->feedback) {
+			ret->params_signature = PlanFeedback_ParamsSignature();
+			ExecutionPlan *variant = PlanFeedback_GetPlan(ret->feedback,
+					ret->params_signature);
+			if(variant) {
+				ExecutionPlan_Free(ret->plan);
+				ret->plan = variant;
+			}
+		}
 		return ret;
 	}
 
@@ -131,6 +152,7 @@ ExecutionCtx *ExecutionCtx_FromQuery(const char *query) {
 															exec_type);
 		ExecutionCtx *exec_ctx_from_cache = Cache_SetGetValue(cache,
 															  query_string, exec_ctx_to_cache);
+		exec_ctx_from_cache->params_signature = PlanFeedback_ParamsSignature();
 		return exec_ctx_from_cache;
 	} else {
 		return _ExecutionCtx_New(ast, NULL, exec_type);
@@ -140,6 +162,8 @@ ExecutionCtx *ExecutionCtx_FromQuery(const char *query) {
 void ExecutionCtx_Free(ExecutionCtx *ctx) {
 	if(ctx == NULL) return;
 	if(ctx->plan != NULL) ExecutionPlan_Free(ctx->plan);
+	// plan variants refer to the AST, release them first
+	if(ctx->feedback != NULL) PlanFeedback_Free(ctx->feedback);
 	if(ctx->ast != NULL) AST_Free(ctx->ast);
 
 	rm_free(ctx);
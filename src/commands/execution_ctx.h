@@ -8,6 +8,7 @@
 
 #include "../ast/ast.h"
 #include "../execution_plan/execution_plan.h"
+#include "../execution_plan/plan_feedback.h"
 
 /**
  * @brief  Execution type derived from a query
@@ -26,6 +27,8 @@ typedef struct {
 	bool cached;                // cache hit/miss
 	ExecutionPlan *plan;        // execution plan
 	ExecutionType exec_type;    // execution type: query, index create/delete
+	PlanFeedback *feedback;     // runtime feedback, shared with the cached context
+	uint64_t params_signature;  // signature of the query's parameters
 } ExecutionCtx;
 
 /**
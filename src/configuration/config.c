@@ -10,6 +10,8 @@
 #include <string.h>
 #include <limits.h>
 #include <errno.h>
+#include <sys/stat.h>
+#include "util/rmalloc.h"
 #include "util/redis_version.h"
 #include "../deps/GraphBLAS/Include/GraphBLAS.h"
 
@@ -49,12 +51,36 @@
 // Max mem(bytes) that query/thread can utilize at any given time
 #define QUERY_MEM_CAPACITY "QUERY_MEM_CAPACITY"
 
+// Max mem(bytes) reserved by all in-flight queries
+#define QUERY_MEM_BUDGET "QUERY_MEM_BUDGET"
+
+// max number of write queries committed together
+#define WRITE_GROUP_SIZE "WRITE_GROUP_SIZE"
+
+// index string trigrams for substring search
+#define INDEX_TRIGRAMS "INDEX_TRIGRAMS"
+
+// directory GRAPH.EXPORT writes to
+#define EXPORT_DIR "EXPORT_DIR"
+
 // number of pending changed befor RG_Matrix flushed
 #define DELTA_MAX_PENDING_CHANGES "DELTA_MAX_PENDING_CHANGES"
 
 // size of node creation buffer
 #define NODE_CREATION_BUFFER "NODE_CREATION_BUFFER"
 
+// config param, bitmask of CPUs thread pool threads may run on
+#define THREAD_CPU_MASK "THREAD_CPU_MASK"
+
+// config param, NUMA node thread pool threads may run on
+#define THREAD_NUMA_NODE "THREAD_NUMA_NODE"
+
+// config param, NUMA memory policy of graph allocations
+#define MEMORY_POLICY "MEMORY_POLICY"
+
+// config param, transposed matrix policy of new relationship types
+#define TRANSPOSE_POLICY "TRANSPOSE_POLICY"
+
 //------------------------------------------------------------------------------
 // Configuration defaults
 //------------------------------------------------------------------------------
@@ -71,17 +97,30 @@ typedef struct {
 	bool async_delete;                 // If true, graph deletion is done asynchronously.
 	uint64_t cache_size;               // The cache size for each thread, per graph.
 	uint thread_pool_size;             // Thread count for thread pool.
+	uint thread_pool_max_size;         // Max thread count at run-time, 0 unbounded.
 	uint omp_thread_count;             // Maximum number of OpenMP threads.
 	uint64_t resultset_size;           // resultset maximum size, UINT64_MAX unlimited
 	uint64_t vkey_entity_count;        // The limit of number of entities encoded at once for each RDB key.
 	uint64_t max_queued_queries;       // max number of queued queries
 	int64_t query_mem_capacity;        // Max mem(bytes) that query/thread can utilize at any given time
+	uint64_t query_mem_budget;         // Max mem(bytes) reserved by all in-flight queries
+	uint64_t write_group_size;         // max number of write queries committed together
+	bool index_trigrams;               // index string trigrams for substring search
+	char *export_dir;                  // directory GRAPH.EXPORT writes to, NULL disabled
 	uint64_t node_creation_buffer;     // Number of extra node creations to buffer as margin in matrices
 	int64_t delta_max_pending_changes; // number of pending changed befor RG_Matrix flushed
+	uint64_t thread_cpu_mask;          // CPUs thread pool threads may run on, 0 any
+	int64_t thread_numa_node;          // NUMA node thread pool threads may run on, -1 any
+	uint64_t memory_policy;            // NUMA memory policy of graph allocations
+	uint64_t transpose_policy;         // transpose policy of new relationship types
 	Config_on_change cb;               // callback function which being called when config param changed
 } RG_Config;
 
-RG_Config config; // global module configuration
+// global module configuration
+// thread placement must be valid even before the configuration is initialized
+RG_Config config = {
+	.thread_numa_node = THREAD_NUMA_NODE_ANY
+};
 
 //------------------------------------------------------------------------------
 // config value parsing
@@ -248,6 +287,15 @@ static uint Config_thread_pool_size_get(void) {
 	return config.thread_pool_size;
 }
 
+// thread pool capacity
+// the thread pool may grow at run-time up to the larger of its load-time
+// size and the number of cores
+static uint Config_thread_pool_max_size(void) {
+	int CPUCount = sysconf(_SC_NPROCESSORS_ONLN);
+	uint cores = (CPUCount != -1) ? CPUCount : 1;
+	return (config.thread_pool_size > cores) ? config.thread_pool_size : cores;
+}
+
 //------------------------------------------------------------------------------
 // OpenMP thread count
 //------------------------------------------------------------------------------
@@ -339,6 +387,67 @@ static uint64_t Config_query_mem_capacity_get(void) {
 	return config.query_mem_capacity;
 }
 
+//------------------------------------------------------------------------------
+// query mem budget
+//------------------------------------------------------------------------------
+
+static void Config_query_mem_budget_set
+(
+	uint64_t budget
+) {
+	config.query_mem_budget = budget;
+}
+
+static uint64_t Config_query_mem_budget_get(void) {
+	return config.query_mem_budget;
+}
+
+//------------------------------------------------------------------------------
+// write group size
+//------------------------------------------------------------------------------
+
+static void Config_write_group_size_set
+(
+	uint64_t size
+) {
+	config.write_group_size = size;
+}
+
+static uint64_t Config_write_group_size_get(void) {
+	return config.write_group_size;
+}
+
+//------------------------------------------------------------------------------
+// index trigrams
+//------------------------------------------------------------------------------
+
+static void Config_index_trigrams_set
+(
+	bool index_trigrams
+) {
+	config.index_trigrams = index_trigrams;
+}
+
+static bool Config_index_trigrams_get(void) {
+	return config.index_trigrams;
+}
+
+//------------------------------------------------------------------------------
+// export directory
+//------------------------------------------------------------------------------
+
+static void Config_export_dir_set
+(
+	const char *export_dir
+) {
+	if(config.export_dir != NULL) rm_free(config.export_dir);
+	config.export_dir = (export_dir != NULL) ? rm_strdup(export_dir) : NULL;
+}
+
+static const char *Config_export_dir_get(void) {
+	return config.export_dir;
+}
+
 //------------------------------------------------------------------------------
 // delta max pending changes
 //------------------------------------------------------------------------------
@@ -372,6 +481,54 @@ static uint64_t Config_node_creation_buffer_get(void) {
 	return config.node_creation_buffer;
 }
 
+//------------------------------------------------------------------------------
+// thread placement
+//------------------------------------------------------------------------------
+
+static void Config_thread_cpu_mask_set
+(
+	uint64_t mask
+) {
+	config.thread_cpu_mask = mask;
+}
+
+static uint64_t Config_thread_cpu_mask_get(void) {
+	return config.thread_cpu_mask;
+}
+
+static void Config_thread_numa_node_set
+(
+	int64_t node
+) {
+	config.thread_numa_node = node;
+}
+
+static int64_t Config_thread_numa_node_get(void) {
+	return config.thread_numa_node;
+}
+
+static void Config_memory_policy_set
+(
+	uint64_t policy
+) {
+	config.memory_policy = policy;
+}
+
+static uint64_t Config_memory_policy_get(void) {
+	return config.memory_policy;
+}
+
+static void Config_transpose_policy_set
+(
+	uint64_t policy
+) {
+	config.transpose_policy = policy;
+}
+
+static uint64_t Config_transpose_policy_get(void) {
+	return config.transpose_policy;
+}
+
 bool Config_Contains_field
 (
 	const char *field_str,
@@ -401,10 +558,26 @@ bool Config_Contains_field
 		f = Config_MAX_QUEUED_QUERIES;
 	} else if(!(strcasecmp(field_str, QUERY_MEM_CAPACITY))) {
 		f = Config_QUERY_MEM_CAPACITY;
+	} else if(!(strcasecmp(field_str, QUERY_MEM_BUDGET))) {
+		f = Config_QUERY_MEM_BUDGET;
+	} else if(!(strcasecmp(field_str, WRITE_GROUP_SIZE))) {
+		f = Config_WRITE_GROUP_SIZE;
+	} else if(!(strcasecmp(field_str, INDEX_TRIGRAMS))) {
+		f = Config_INDEX_TRIGRAMS;
+	} else if(!(strcasecmp(field_str, EXPORT_DIR))) {
+		f = Config_EXPORT_DIR;
 	} else if(!(strcasecmp(field_str, DELTA_MAX_PENDING_CHANGES))) {
 		f = Config_DELTA_MAX_PENDING_CHANGES;
 	} else if(!(strcasecmp(field_str, NODE_CREATION_BUFFER))) {
 		f = Config_NODE_CREATION_BUFFER;
+	} else if(!(strcasecmp(field_str, THREAD_CPU_MASK))) {
+		f = Config_THREAD_CPU_MASK;
+	} else if(!(strcasecmp(field_str, THREAD_NUMA_NODE))) {
+		f = Config_THREAD_NUMA_NODE;
+	} else if(!(strcasecmp(field_str, MEMORY_POLICY))) {
+		f = Config_MEMORY_POLICY;
+	} else if(!(strcasecmp(field_str, TRANSPOSE_POLICY))) {
+		f = Config_TRANSPOSE_POLICY;
 	} else {
 		return false;
 	}
@@ -463,6 +636,22 @@ const char *Config_Field_name
 			name = QUERY_MEM_CAPACITY;
 			break;
 
+		case Config_QUERY_MEM_BUDGET:
+			name = QUERY_MEM_BUDGET;
+			break;
+
+		case Config_WRITE_GROUP_SIZE:
+			name = WRITE_GROUP_SIZE;
+			break;
+
+		case Config_INDEX_TRIGRAMS:
+			name = INDEX_TRIGRAMS;
+			break;
+
+		case Config_EXPORT_DIR:
+			name = EXPORT_DIR;
+			break;
+
 		case Config_DELTA_MAX_PENDING_CHANGES:
 			name = DELTA_MAX_PENDING_CHANGES;
 			break;
@@ -471,6 +660,22 @@ const char *Config_Field_name
 			name = NODE_CREATION_BUFFER;
 			break;
 
+		case Config_THREAD_CPU_MASK:
+			name = THREAD_CPU_MASK;
+			break;
+
+		case Config_THREAD_NUMA_NODE:
+			name = THREAD_NUMA_NODE;
+			break;
+
+		case Config_MEMORY_POLICY:
+			name = MEMORY_POLICY;
+			break;
+
+		case Config_TRANSPOSE_POLICY:
+			name = TRANSPOSE_POLICY;
+			break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -524,11 +729,36 @@ static void _Config_SetToDefaults(void) {
 	// no limit on query memory capacity
 	config.query_mem_capacity = QUERY_MEM_CAPACITY_UNLIMITED;
 
+	// no admission control
+	config.query_mem_budget = QUERY_MEM_BUDGET_UNLIMITED;
+
+	// write queries are committed individually
+	config.write_group_size = WRITE_GROUP_SIZE_DEFAULT;
+
+	// substring predicates are not indexed
+	config.index_trigrams = false;
+
+	// graph export is disabled
+	Config_export_dir_set(NULL);
+
 	// number of pending changed befor RG_Matrix flushed
 	config.delta_max_pending_changes = DELTA_MAX_PENDING_CHANGES_DEFAULT;
 
 	// the amount of empty space to reserve for node creations in matrices
 	config.node_creation_buffer = NODE_CREATION_BUFFER_DEFAULT;
+
+	// threads may run on any CPU
+	config.thread_cpu_mask = THREAD_CPU_MASK_ANY;
+	config.thread_numa_node = THREAD_NUMA_NODE_ANY;
+
+	// system default memory placement
+	config.memory_policy = MEMORY_POLICY_DEFAULT;
+
+	// relationship transposes are maintained
+	config.transpose_policy = TRANSPOSE_POLICY_ALWAYS;
+
+	// thread pool size is unbounded at load-time
+	config.thread_pool_max_size = 0;
 }
 
 int Config_Init
@@ -601,6 +831,9 @@ int Config_Init
 		return REDISMODULE_ERR;
 	}
 
+	// bound thread pool size at run-time
+	config.thread_pool_max_size = Config_thread_pool_max_size();
+
 	return REDISMODULE_OK;
 }
 
@@ -766,6 +999,62 @@ bool Config_Option_get
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// query mem budget
+		//----------------------------------------------------------------------
+
+		case Config_QUERY_MEM_BUDGET: {
+			va_start(ap, field);
+			uint64_t *query_mem_budget = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(query_mem_budget != NULL);
+			(*query_mem_budget) = Config_query_mem_budget_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// write group size
+		//----------------------------------------------------------------------
+
+		case Config_WRITE_GROUP_SIZE: {
+			va_start(ap, field);
+			uint64_t *write_group_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(write_group_size != NULL);
+			(*write_group_size) = Config_write_group_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// index trigrams
+		//----------------------------------------------------------------------
+
+		case Config_INDEX_TRIGRAMS: {
+			va_start(ap, field);
+			bool *index_trigrams = va_arg(ap, bool *);
+			va_end(ap);
+
+			ASSERT(index_trigrams != NULL);
+			(*index_trigrams) = Config_index_trigrams_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// export directory
+		//----------------------------------------------------------------------
+
+		case Config_EXPORT_DIR: {
+			va_start(ap, field);
+			const char **export_dir = va_arg(ap, const char **);
+			va_end(ap);
+
+			ASSERT(export_dir != NULL);
+			(*export_dir) = Config_export_dir_get();
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// number of pending changed befor RG_Matrix flushed
 		//----------------------------------------------------------------------
@@ -794,6 +1083,62 @@ bool Config_Option_get
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// CPUs thread pool threads may run on
+		//----------------------------------------------------------------------
+
+		case Config_THREAD_CPU_MASK: {
+			va_start(ap, field);
+			uint64_t *thread_cpu_mask = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(thread_cpu_mask != NULL);
+			(*thread_cpu_mask) = Config_thread_cpu_mask_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// NUMA node thread pool threads may run on
+		//----------------------------------------------------------------------
+
+		case Config_THREAD_NUMA_NODE: {
+			va_start(ap, field);
+			int64_t *thread_numa_node = va_arg(ap, int64_t *);
+			va_end(ap);
+
+			ASSERT(thread_numa_node != NULL);
+			(*thread_numa_node) = Config_thread_numa_node_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// NUMA memory policy
+		//----------------------------------------------------------------------
+
+		case Config_MEMORY_POLICY: {
+			va_start(ap, field);
+			uint64_t *memory_policy = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(memory_policy != NULL);
+			(*memory_policy) = Config_memory_policy_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// relationship transpose policy
+		//----------------------------------------------------------------------
+
+		case Config_TRANSPOSE_POLICY: {
+			va_start(ap, field);
+			uint64_t *transpose_policy = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(transpose_policy != NULL);
+			(*transpose_policy) = Config_transpose_policy_get();
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -904,6 +1249,12 @@ bool Config_Option_set
 			long long pool_nthreads;
 			if(!_Config_ParsePositiveInteger(val, &pool_nthreads)) return false;
 
+			if(config.thread_pool_max_size != 0 &&
+			   pool_nthreads > config.thread_pool_max_size) {
+				if(err) *err = "THREAD_COUNT can't exceed the larger of its load-time value and the number of cores";
+				return false;
+			}
+
 			Config_thread_pool_size_set(pool_nthreads);
 		}
 		break;
@@ -956,6 +1307,64 @@ bool Config_Option_set
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// query mem budget
+		//----------------------------------------------------------------------
+
+		case Config_QUERY_MEM_BUDGET: {
+			long long query_mem_budget;
+			if(!_Config_ParseNonNegativeInteger(val, &query_mem_budget)) return false;
+
+			Config_query_mem_budget_set(query_mem_budget);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// write group size
+		//----------------------------------------------------------------------
+
+		case Config_WRITE_GROUP_SIZE: {
+			long long write_group_size;
+			if(!_Config_ParseNonNegativeInteger(val, &write_group_size)) return false;
+			// a group holds at least one query
+			if(write_group_size < 1) return false;
+
+			Config_write_group_size_set(write_group_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// index trigrams
+		//----------------------------------------------------------------------
+
+		case Config_INDEX_TRIGRAMS: {
+			bool index_trigrams;
+			if(!_Config_ParseYesNo(val, &index_trigrams)) return false;
+
+			Config_index_trigrams_set(index_trigrams);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// export directory
+		//----------------------------------------------------------------------
+
+		case Config_EXPORT_DIR: {
+			// resolve symbolic links and relative components
+			char *export_dir = realpath(val, NULL);
+			struct stat st;
+			if(export_dir == NULL || stat(export_dir, &st) != 0 ||
+					!S_ISDIR(st.st_mode)) {
+				free(export_dir);
+				if(err) *err = "EXPORT_DIR must be an existing directory";
+				return false;
+			}
+
+			Config_export_dir_set(export_dir);
+			free(export_dir);
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// number of pending changed befor RG_Matrix flushed
 		//----------------------------------------------------------------------
@@ -994,6 +1403,63 @@ bool Config_Option_set
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// CPUs thread pool threads may run on
+		//----------------------------------------------------------------------
+
+		case Config_THREAD_CPU_MASK: {
+			long long thread_cpu_mask;
+			if(!_Config_ParseNonNegativeInteger(val, &thread_cpu_mask)) return false;
+
+			Config_thread_cpu_mask_set(thread_cpu_mask);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// NUMA node thread pool threads may run on
+		//----------------------------------------------------------------------
+
+		case Config_THREAD_NUMA_NODE: {
+			long long thread_numa_node;
+			if(!_Config_ParseInteger(val, &thread_numa_node)) return false;
+			if(thread_numa_node < THREAD_NUMA_NODE_ANY) return false;
+
+			Config_thread_numa_node_set(thread_numa_node);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// NUMA memory policy
+		//----------------------------------------------------------------------
+
+		case Config_MEMORY_POLICY: {
+			long long memory_policy;
+			if(!_Config_ParseNonNegativeInteger(val, &memory_policy)) return false;
+			if(memory_policy > MEMORY_POLICY_INTERLEAVE) {
+				if(err) *err = "MEMORY_POLICY must be 0 (default), 1 (local) or 2 (interleave)";
+				return false;
+			}
+
+			Config_memory_policy_set(memory_policy);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// relationship transpose policy
+		//----------------------------------------------------------------------
+
+		case Config_TRANSPOSE_POLICY: {
+			long long transpose_policy;
+			if(!_Config_ParseNonNegativeInteger(val, &transpose_policy)) return false;
+			if(transpose_policy > TRANSPOSE_POLICY_NEVER) {
+				if(err) *err = "TRANSPOSE_POLICY must be 0 (always), 1 (lazy) or 2 (never)";
+				return false;
+			}
+
+			Config_transpose_policy_set(transpose_policy);
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -13,8 +13,27 @@
 #define CONFIG_TIMEOUT_NO_TIMEOUT          0
 #define VKEY_ENTITY_COUNT_UNLIMITED        UINT64_MAX
 #define QUERY_MEM_CAPACITY_UNLIMITED       0
+#define QUERY_MEM_BUDGET_UNLIMITED         0
 #define NODE_CREATION_BUFFER_DEFAULT       16384
 #define DELTA_MAX_PENDING_CHANGES_DEFAULT  10000
+#define THREAD_CPU_MASK_ANY                0
+#define THREAD_NUMA_NODE_ANY               -1
+#define WRITE_GROUP_SIZE_DEFAULT           1
+
+// memory policy applied to threads allocating graph data
+typedef enum {
+	MEMORY_POLICY_DEFAULT    = 0,  // system default
+	MEMORY_POLICY_LOCAL      = 1,  // allocate on the thread's NUMA node
+	MEMORY_POLICY_INTERLEAVE = 2,  // interleave pages across NUMA nodes
+} MemoryPolicy;
+
+// maintenance policy of relationship transposed matrices
+// values match RG_TransposePolicy
+typedef enum {
+	TRANSPOSE_POLICY_ALWAYS = 0,  // transpose is maintained
+	TRANSPOSE_POLICY_LAZY   = 1,  // transpose is built on first use
+	TRANSPOSE_POLICY_NEVER  = 2,  // transpose is built on demand, never maintained
+} TransposePolicy;
 
 typedef enum {
 	Config_TIMEOUT                   = 0,   // timeout value for queries
@@ -30,7 +49,15 @@ typedef enum {
 	Config_QUERY_MEM_CAPACITY        = 10,  // max mem(bytes) that query/thread can utilize at any given time
 	Config_DELTA_MAX_PENDING_CHANGES = 11,  // number of pending changes before RG_Matrix flushed
 	Config_NODE_CREATION_BUFFER      = 12,  // size of buffer to maintain as margin in matrices
-	Config_END_MARKER                = 13
+	Config_THREAD_CPU_MASK           = 13,  // CPUs thread pool threads are restricted to
+	Config_THREAD_NUMA_NODE          = 14,  // NUMA node thread pool threads are restricted to
+	Config_MEMORY_POLICY             = 15,  // NUMA memory policy of graph allocations
+	Config_TRANSPOSE_POLICY          = 16,  // transpose policy of new relationship types
+	Config_QUERY_MEM_BUDGET          = 17,  // max mem(bytes) reserved by all in-flight queries
+	Config_WRITE_GROUP_SIZE          = 18,  // max number of write queries committed together
+	Config_INDEX_TRIGRAMS            = 19,  // index string trigrams for substring search
+	Config_EXPORT_DIR                = 20,  // directory GRAPH.EXPORT writes to
+	Config_END_MARKER                = 21
 } Config_Option_Field;
 
 // callback function, invoked once configuration changes as a result of
@@ -38,16 +65,19 @@ typedef enum {
 typedef void (*Config_on_change)(Config_Option_Field type);
 
 // Run-time configurable fields
-#define RUNTIME_CONFIG_COUNT 8
+#define RUNTIME_CONFIG_COUNT 11
 static const Config_Option_Field RUNTIME_CONFIGS[] = {
 	Config_TIMEOUT,
+	Config_THREAD_POOL_SIZE,
 	Config_TIMEOUT_MAX,
 	Config_TIMEOUT_DEFAULT,
 	Config_RESULTSET_MAX_SIZE,
 	Config_MAX_QUEUED_QUERIES,
 	Config_QUERY_MEM_CAPACITY,
+	Config_QUERY_MEM_BUDGET,
 	Config_VKEY_MAX_ENTITY_COUNT,
-	Config_DELTA_MAX_PENDING_CHANGES
+	Config_DELTA_MAX_PENDING_CHANGES,
+	Config_WRITE_GROUP_SIZE
 };
 
 // Set module-level configurations to defaults or to user arguments where provided.
@@ -6,6 +6,7 @@
 
 #include "RG.h"
 #include "util/rmalloc.h"
+#include "util/admission.h"
 #include "reconf_handler.h"
 #include "util/thpool/pools.h"
 
@@ -26,6 +27,21 @@ void reconf_handler(Config_Option_Field type) {
 			}
 			break;
 		
+		//----------------------------------------------------------------------
+		// thread pool size
+		//----------------------------------------------------------------------
+
+		case Config_THREAD_POOL_SIZE:
+			{
+				uint thread_count;
+				bool res = Config_Option_get(type, &thread_count);
+				ASSERT(res);
+				res = ThreadPools_SetReadersCount(thread_count);
+				ASSERT(res);
+				UNUSED(res);
+			}
+			break;
+
 		//----------------------------------------------------------------------
 		// query mem capacity
 		//----------------------------------------------------------------------
@@ -39,6 +55,22 @@ void reconf_handler(Config_Option_Field type) {
 			}
 			break;
 
+		//----------------------------------------------------------------------
+		// query mem budget
+		//----------------------------------------------------------------------
+
+		case Config_QUERY_MEM_BUDGET:
+			{
+				uint64_t query_mem_budget;
+				bool res = Config_Option_get(type, &query_mem_budget);
+				ASSERT(res);
+				UNUSED(res);
+				// admission control learns from queries' memory consumption
+				rm_set_mem_tracking(query_mem_budget != QUERY_MEM_BUDGET_UNLIMITED);
+				AdmissionControl_SetBudget(query_mem_budget);
+			}
+			break;
+
         //----------------------------------------------------------------------
         // all other options
         //----------------------------------------------------------------------
@@ -8,49 +8,138 @@
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 
-Path *Path_New(size_t len) {
+// attribute set of entities which can't be retrieved from the graph
+static AttributeSet _empty_attributes = NULL;
+
+// discard hydrated entities, invoked whenever the path is modified
+static inline void _Path_Invalidate(Path *p) {
+	if(p->hydrated_nodes != NULL) {
+		array_free(p->hydrated_nodes);
+		p->hydrated_nodes = NULL;
+	}
+	if(p->hydrated_edges != NULL) {
+		array_free(p->hydrated_edges);
+		p->hydrated_edges = NULL;
+	}
+}
+
+static Node _Path_HydrateNode(const Path *p, NodeID id) {
+	Node n = GE_NEW_NODE();
+	n.id = id;
+	if(p->g == NULL || !Graph_GetNode(p->g, id, &n)) {
+		n.attributes = &_empty_attributes;
+	}
+	return n;
+}
+
+static Edge _Path_HydrateEdge(const Path *p, const PathEdge *pe) {
+	Edge e;
+	memset(&e, 0, sizeof(Edge));
+	e.id         = pe->id;
+	e.relationID = pe->relationID;
+	e.srcNodeID  = pe->src;
+	e.destNodeID = pe->dest;
+	if(p->g == NULL || !Graph_GetEdge(p->g, pe->id, &e)) {
+		e.attributes = &_empty_attributes;
+	}
+	return e;
+}
+
+static inline PathEdge _Path_CompactEdge(const Edge *e) {
+	return (PathEdge) {
+		.id         = ENTITY_GET_ID(e),
+		.src        = e->srcNodeID,
+		.dest       = e->destNodeID,
+		.relationID = e->relationID
+	};
+}
+
+Path *Path_New(const Graph *g, size_t len) {
 	Path *path = rm_malloc(sizeof(Path));
-	path->edges = array_new(Edge, len);
-	path->nodes = array_new(Node, len + 1);
+	path->g              = g;
+	path->edges          = array_new(PathEdge, len);
+	path->nodes          = array_new(NodeID, len + 1);
+	path->hydrated_nodes = NULL;
+	path->hydrated_edges = NULL;
 	return path;
 }
 
 void Path_EnsureLen(Path *p, size_t len) {
+	_Path_Invalidate(p);
 	p->nodes = array_ensure_len(p->nodes, len);
 	p->edges = array_ensure_len(p->edges, len - 1);
 }
 
 void Path_AppendNode(Path *p, Node n) {
-	array_append(p->nodes, n);
+	_Path_Invalidate(p);
+	array_append(p->nodes, ENTITY_GET_ID(&n));
 }
 
 void Path_AppendEdge(Path *p, Edge e) {
-	array_append(p->edges, e);
+	_Path_Invalidate(p);
+	array_append(p->edges, _Path_CompactEdge(&e));
 }
 
 void Path_SetNode(Path *p, uint i, Node n) {
-	p->nodes[i] = n;
+	_Path_Invalidate(p);
+	p->nodes[i] = ENTITY_GET_ID(&n);
 }
 
 void Path_SetEdge(Path *p, uint i, Edge e) {
-	p->edges[i] = e;
+	_Path_Invalidate(p);
+	p->edges[i] = _Path_CompactEdge(&e);
+}
+
+// hydrate all path entities at once
+// subsequent accesses reuse hydrated entities until the path is modified
+static void _Path_Hydrate(Path *p) {
+	if(p->hydrated_nodes != NULL) return;
+
+	uint node_count = Path_NodeCount(p);
+	uint edge_count = Path_EdgeCount(p);
+
+	p->hydrated_nodes = array_new(Node, node_count);
+	p->hydrated_edges = array_new(Edge, edge_count);
+
+	for(uint i = 0; i < node_count; i++) {
+		array_append(p->hydrated_nodes, _Path_HydrateNode(p, p->nodes[i]));
+	}
+	for(uint i = 0; i < edge_count; i++) {
+		array_append(p->hydrated_edges, _Path_HydrateEdge(p, p->edges + i));
+	}
+}
+
+Node *Path_GetNode(Path *p, int index) {
+	ASSERT(index >= 0 && index < Path_NodeCount(p));
+	_Path_Hydrate(p);
+	return &p->hydrated_nodes[index];
+}
+
+Edge *Path_GetEdge(Path *p, int index) {
+	ASSERT(index >= 0 && index < Path_EdgeCount(p));
+	_Path_Hydrate(p);
+	return &p->hydrated_edges[index];
 }
 
-Node *Path_GetNode(const Path *p, int index) {
+NodeID Path_GetNodeID(const Path *p, int index) {
 	ASSERT(index >= 0 && index < Path_NodeCount(p));
-	return &p->nodes[index];
+	return p->nodes[index];
 }
 
-Edge *Path_GetEdge(const Path *p, int index) {
+EdgeID Path_GetEdgeID(const Path *p, int index) {
 	ASSERT(index >= 0 && index < Path_EdgeCount(p));
-	return &p->edges[index];
+	return p->edges[index].id;
 }
 
 Node Path_PopNode(Path *p) {
-	return array_pop(p->nodes);
+	_Path_Invalidate(p);
+	return _Path_HydrateNode(p, array_pop(p->nodes));
 }
+
 Edge Path_PopEdge(Path *p) {
-	return array_pop(p->edges);
+	_Path_Invalidate(p);
+	PathEdge pe = array_pop(p->edges);
+	return _Path_HydrateEdge(p, &pe);
 }
 
 size_t Path_NodeCount(const Path *p) {
@@ -62,7 +151,7 @@ size_t Path_EdgeCount(const Path *p) {
 }
 
 Node Path_Head(Path *p) {
-	return p->nodes[array_len(p->nodes) - 1];
+	return _Path_HydrateNode(p, p->nodes[array_len(p->nodes) - 1]);
 }
 
 size_t Path_Len(const Path *p) {
@@ -73,29 +162,35 @@ bool Path_ContainsNode(const Path *p, Node *n) {
 	uint32_t pathDepth = Path_NodeCount(p);
 	EntityID nId = ENTITY_GET_ID(n);
 	for(int i = 0; i < pathDepth; i++) {
-		if(ENTITY_GET_ID(p->nodes + i) == nId) return true;
+		if(p->nodes[i] == nId) return true;
 	}
 	return false;
 }
 
 Path *Path_Clone(const Path *p) {
 	Path *clone = rm_malloc(sizeof(Path));
+	clone->g              = p->g;
+	clone->hydrated_nodes = NULL;
+	clone->hydrated_edges = NULL;
 	array_clone(clone->nodes, p->nodes);
 	array_clone(clone->edges, p->edges);
 	return clone;
 }
 
 void Path_Reverse(Path *p) {
+	_Path_Invalidate(p);
 	array_reverse(p->nodes);
 	array_reverse(p->edges);
 }
 
 void Path_Clear(Path *p) {
+	_Path_Invalidate(p);
 	array_clear(p->nodes);
 	array_clear(p->edges);
 }
 
 void Path_Free(Path *p) {
+	_Path_Invalidate(p);
 	array_free(p->nodes);
 	array_free(p->edges);
 	rm_free(p);
@@ -6,16 +6,33 @@
 
 #pragma once
 
+#include "../../graph/graph.h"
 #include "../../graph/entities/node.h"
 #include "../../graph/entities/edge.h"
 
+// compact edge representation, holds only what is required to rebuild the edge
 typedef struct {
-	Node *nodes;    // Nodes in paths.
-	Edge *edges;    // Edges in path.
+	EdgeID id;       // edge ID
+	NodeID src;      // source node ID
+	NodeID dest;     // destination node ID
+	int relationID;  // relationship type ID
+} PathEdge;
+
+// a path holds only the IDs of its nodes and edges
+// length, endpoints IDs and comparisons are computed directly from IDs
+// full entities are hydrated from the graph once an element is accessed
+typedef struct {
+	NodeID *nodes;          // IDs of nodes in path
+	PathEdge *edges;        // edges in path
+	const Graph *g;         // graph entities are hydrated from
+	Node *hydrated_nodes;   // hydrated nodes, NULL until accessed
+	Edge *hydrated_edges;   // hydrated edges, NULL until accessed
 } Path;
 
 // creates a new Path with given capacity
-Path *Path_New(size_t len);
+// entities are hydrated from 'g', which may be NULL in which case
+// hydrated entities are attribute-less
+Path *Path_New(const Graph *g, size_t len);
 
 // ensure the nodes and edge array in a specific len
 void Path_EnsureLen(Path *p, size_t len);
@@ -33,10 +50,18 @@ void Path_SetNode(Path *p, uint i, Node n);
 void Path_SetEdge(Path *p, uint i, Edge e);
 
 // returns a refernce to a node in the specific index
-Node *Path_GetNode(const Path *p, int index);
+// reference is valid until path is modified
+Node *Path_GetNode(Path *p, int index);
 
 // returns a refernce to an edge in the specific index
-Edge *Path_GetEdge(const Path *p, int index);
+// reference is valid until path is modified
+Edge *Path_GetEdge(Path *p, int index);
+
+// returns the ID of the node in the specific index
+NodeID Path_GetNodeID(const Path *p, int index);
+
+// returns the ID of the edge in the specific index
+EdgeID Path_GetEdgeID(const Path *p, int index);
 
 // removes the last node from the path
 Node Path_PopNode(Path *p);
@@ -70,4 +95,3 @@ void Path_Clear(Path *p);
 
 // deletes the path nodes and edges arrays
 void Path_Free(Path *p);
-
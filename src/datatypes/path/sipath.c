@@ -95,19 +95,23 @@ size_t SIPath_EdgeCount(SIValue p) {
 }
 
 XXH64_hash_t SIPath_HashCode(SIValue p) {
+	// hash entity IDs directly, avoid hydrating path entities
+	Path *path = (Path *) p.ptrval;
 	SIType t = SI_TYPE(p);
 	XXH64_hash_t hashCode = XXH64(&t, sizeof(t), 0);
-	size_t nodeCount = SIPath_NodeCount(p);
+	size_t nodeCount = Path_NodeCount(path);
+	Node n = GE_NEW_NODE();
+	Edge e = {0};
 	for(size_t i = 0; i < nodeCount - 1 ; i++) {
-		SIValue node = SIPath_GetNode(p, i);
-		hashCode = 31 * hashCode + SIValue_HashCode(node);
-		SIValue edge = SIPath_GetRelationship(p, i);
-		hashCode = 31 * hashCode + SIValue_HashCode(edge);
+		n.id = Path_GetNodeID(path, i);
+		hashCode = 31 * hashCode + SIValue_HashCode(SI_Node(&n));
+		e.id = Path_GetEdgeID(path, i);
+		hashCode = 31 * hashCode + SIValue_HashCode(SI_Edge(&e));
 	}
 	// Handle last node.
 	if(nodeCount > 0) {
-		SIValue node = SIPath_GetNode(p, nodeCount - 1);
-		hashCode = 31 * hashCode + SIValue_HashCode(node);
+		n.id = Path_GetNodeID(path, nodeCount - 1);
+		hashCode = 31 * hashCode + SIValue_HashCode(SI_Node(&n));
 	}
 	return hashCode;
 }
@@ -145,28 +149,32 @@ void SIPath_ToString(SIValue p, char **buf, size_t *bufferLen, size_t *bytesWrit
 	*bytesWritten += snprintf(*buf + *bytesWritten, *bufferLen, "]");
 }
 
-int SIPath_Compare(SIValue p1, SIValue p2) {
+// compare IDs in the same manner SIValue_Compare compares graph entities
+static inline int _SIPath_CompareIDs(EntityID a, EntityID b) {
+	return a - b;
+}
 
-	size_t p1NodeCount = SIPath_NodeCount(p1);
-	size_t p2NodeCount = SIPath_NodeCount(p2);
+int SIPath_Compare(SIValue p1, SIValue p2) {
+	// paths are compared by entity IDs, no need to hydrate path entities
+	Path *path1 = (Path *) p1.ptrval;
+	Path *path2 = (Path *) p2.ptrval;
+	size_t p1NodeCount = Path_NodeCount(path1);
+	size_t p2NodeCount = Path_NodeCount(path2);
 	// Get minimal length
 	size_t nodeCount = p1NodeCount <= p2NodeCount ? p1NodeCount : p2NodeCount;
 	int res = 0;
 	for(size_t i = 0; i < nodeCount - 1 ; i++) {
-		SIValue p1node = SIPath_GetNode(p1, i);
-		SIValue p2node = SIPath_GetNode(p2, i);
-		res = SIValue_Compare(p1node, p2node, NULL);
+		res = _SIPath_CompareIDs(Path_GetNodeID(path1, i),
+				Path_GetNodeID(path2, i));
 		if(res) return res;
-		SIValue p1edge = SIPath_GetRelationship(p1, i);
-		SIValue p2edge = SIPath_GetRelationship(p2, i);
-		res = SIValue_Compare(p1edge, p2edge, NULL);
+		res = _SIPath_CompareIDs(Path_GetEdgeID(path1, i),
+				Path_GetEdgeID(path2, i));
 		if(res) return res;
 	}
 	// Handle last node.
 	if(nodeCount > 0) {
-		SIValue p1node = SIPath_GetNode(p1, nodeCount - 1);
-		SIValue p2node = SIPath_GetNode(p2, nodeCount - 1);
-		res = SIValue_Compare(p1node, p2node, NULL);
+		res = _SIPath_CompareIDs(Path_GetNodeID(path1, nodeCount - 1),
+				Path_GetNodeID(path2, nodeCount - 1));
 		if(res) return res;
 	}
 	return p1NodeCount - p2NodeCount;
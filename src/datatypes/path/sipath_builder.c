@@ -8,28 +8,9 @@
 #include "../../RG.h"
 #include "../../util/rmalloc.h"
 
-/**
- * @brief  Reverse the direction of an edge.
- * @note   A new copy of the edge is created, in order not to invalidate any data in the original edge
- *         in case it required elsewhere.
- * @param  *e: Pointer to the original edge.
- * @retval New edge with inverse direction.
- */
-static Edge _Edge_ReverseDirection(Edge *e) {
-	Edge edge = *e;
-	edge.srcNodeID = e->destNodeID;
-	edge.destNodeID = e->srcNodeID;
-	return edge;
-}
-
-static void _SIPath_Reverse(SIValue p) {
-	Path *path = (Path *) p.ptrval;
-	Path_Reverse(path);
-}
-
-SIValue SIPathBuilder_New(uint entity_count) {
+SIValue SIPathBuilder_New(const Graph *g, uint entity_count) {
 	SIValue path;
-	path.ptrval = Path_New(entity_count / 2);
+	path.ptrval = Path_New(g, entity_count / 2);
 	path.type = T_PATH;
 	path.allocation = M_SELF;
 	return path;
@@ -47,8 +28,7 @@ void SIPathBuilder_AppendEdge(SIValue p, SIValue e, bool RTLEdge) {
 	ASSERT(Path_NodeCount(path) > 0);
 	// The edge should connect nodes[edge_count] to nodes[edge_count+1]
 	uint edge_count = Path_EdgeCount(path);
-	Node *n = Path_GetNode(path, edge_count);
-	EntityID nId = ENTITY_GET_ID(n);
+	EntityID nId = Path_GetNodeID(path, edge_count);
 	// Validate source node is in the right place.
 	ASSERT(nId == edge->srcNodeID || nId == edge->destNodeID);
 	/* Reverse direction if needed. A direction change is needed if the last node in the path, reading
@@ -58,36 +38,54 @@ void SIPathBuilder_AppendEdge(SIValue p, SIValue e, bool RTLEdge) {
 	 * Query: MATCH p=(a)<-[]-(b)
 	 * e direction needs to be change. */
 
-	Edge edge_to_append = (RTLEdge && nId == edge->srcNodeID) ? _Edge_ReverseDirection(edge) : *edge;
+	Edge edge_to_append = *edge;
+	if(RTLEdge && nId == edge->srcNodeID) {
+		edge_to_append.srcNodeID  = edge->destNodeID;
+		edge_to_append.destNodeID = edge->srcNodeID;
+	}
 	Path_AppendEdge(path, edge_to_append);
 }
 
-void SIPathBuilder_AppendPath(SIValue path, SIValue new_path, bool RTLEdge) {
-	uint path_node_count = SIPath_NodeCount(path);
+void SIPathBuilder_AppendPath(SIValue p, SIValue other, bool RTLEdge) {
+	Path *path = (Path *) p.ptrval;
+	Path *new_path = (Path *) other.ptrval;
+	uint path_node_count = Path_NodeCount(path);
 	ASSERT(path_node_count > 0);
 	// No need to append empty paths.
-	uint new_path_node_count = SIPath_NodeCount(new_path);
+	uint new_path_node_count = Path_NodeCount(new_path);
 
 	if(new_path_node_count <= 1) return;
 
-	SIValue last_LTR_node = SIPath_GetNode(path, path_node_count - 1);
-	EntityID last_LTR_node_id = ENTITY_GET_ID((Node *)last_LTR_node.ptrval);
-	SIValue new_path_node_0 = SIPath_Head(new_path);
-	EntityID new_path_node_0_id = ENTITY_GET_ID((Node *)new_path_node_0.ptrval);
-	SIValue new_path_last_node = SIPath_Last(new_path);
-	EntityID new_path_last_node_id = ENTITY_GET_ID((Node *)new_path_last_node.ptrval);
+	// work directly on entity IDs, appended entities are never hydrated
+	NodeID last_LTR_node_id = Path_GetNodeID(path, path_node_count - 1);
+	NodeID new_path_node_0_id = Path_GetNodeID(new_path, 0);
+	NodeID new_path_last_node_id = Path_GetNodeID(new_path, new_path_node_count - 1);
 	// Validate current last LTR node is in either edges of the path.
 	ASSERT(last_LTR_node_id == new_path_node_0_id || last_LTR_node_id == new_path_last_node_id);
-	int new_path_edge_count = SIPath_Length(new_path);
+	uint new_path_edge_count = Path_EdgeCount(new_path);
 
 	// Check if path needs to be rverse inserated or not.
-	if(last_LTR_node_id == new_path_last_node_id) _SIPath_Reverse(new_path);
+	if(last_LTR_node_id == new_path_last_node_id) Path_Reverse(new_path);
 
-	for(uint i = 0; i < new_path_edge_count - 1; i++) {
-		SIPathBuilder_AppendEdge(path, SIPath_GetRelationship(new_path, i), RTLEdge);
+	Node n = GE_NEW_NODE();
+	Edge e = {0};
+	for(uint i = 0; i < new_path_edge_count; i++) {
+		const PathEdge *pe = new_path->edges + i;
+		e.id         = pe->id;
+		e.relationID = pe->relationID;
+		e.srcNodeID  = pe->src;
+		e.destNodeID = pe->dest;
+		// Reverse edge direction if needed, see SIPathBuilder_AppendEdge.
+		NodeID nId = Path_GetNodeID(path, Path_EdgeCount(path));
+		if(RTLEdge && nId == pe->src) {
+			e.srcNodeID  = pe->dest;
+			e.destNodeID = pe->src;
+		}
+		Path_AppendEdge(path, e);
 		// Insert only nodes which are not the last and the first, since they will be added by append node specifically.
-		SIPathBuilder_AppendNode(path, SIPath_GetNode(new_path, i + 1));
-
+		if(i < new_path_edge_count - 1) {
+			n.id = Path_GetNodeID(new_path, i + 1);
+			Path_AppendNode(path, n);
+		}
 	}
-	SIPathBuilder_AppendEdge(path, SIPath_GetRelationship(new_path, new_path_edge_count - 1), RTLEdge);
 }
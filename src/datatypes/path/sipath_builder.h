@@ -25,10 +25,11 @@
 /**
  * @brief  Creates a new empty SIPath with allocated space to given number of entities.
  * @note   The size entity_count is just an initial capcity and can dynamically grow.
+ * @param  g: Graph path entities are hydrated from.
  * @param  entity_count: Initial number of entities.
  * @retval Empty SIPath.
  */
-SIValue SIPathBuilder_New(uint entity_count);
+SIValue SIPathBuilder_New(const Graph *g, uint entity_count);
 
 /**
  * @brief  Appends a SINode into SIPath.
@@ -8,6 +8,9 @@
 
 #include "../value.h"
 
+#define EARTH_RADIUS 6378140.0
+#define DegreeToRadians(d) ((d) * M_PI / 180.0)
+
 // returns latitude of given point
 float Point_lat(SIValue point);
 
@@ -17,3 +20,6 @@ float Point_lon(SIValue point);
 // returns a coordinate (latitude or longitude) of a given point
 SIValue Point_GetCoordinate(SIValue point, SIValue key);
 
+
+// returns the distance in meters between two points
+float Point_Distance(SIValue a, SIValue b);
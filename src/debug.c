@@ -9,10 +9,14 @@
 #include <pthread.h>
 #include <sys/types.h>
 #include "RG.h"
+#include "util/arr.h"
+#include "util/admission.h"
 #include "util/thpool/pools.h"
+#include "graph/graph_memory.h"
 #include "commands/cmd_context.h"
 
 extern CommandCtx **command_ctxs;
+extern GraphContext **graphs_in_keyspace;
 
 static struct sigaction old_act;
 
@@ -37,9 +41,27 @@ static void logCommands(void) {
 	}
 }
 
+// report memory usage last computed by GRAPH.MEMORY for each graph
+static void _InfoMemory(RedisModuleInfoCtx *ctx) {
+	RedisModule_InfoAddSection(ctx, "memory");
+
+	uint graph_count = array_len(graphs_in_keyspace);
+	for(uint i = 0; i < graph_count; i++) {
+		GraphContext *gc = graphs_in_keyspace[i];
+		if(gc->memory_usage != NULL) {
+			GraphMemoryUsage_Info(gc->memory_usage, gc, ctx);
+		}
+	}
+}
+
 void InfoFunc(RedisModuleInfoCtx *ctx, int for_crash_report) {
-	// make sure information is requested for crash report
-	if(!for_crash_report) return;
+	// memory usage is exported as metrics, walking the graphs is left
+	// to GRAPH.MEMORY as INFO is expected to return immediately
+	if(!for_crash_report) {
+		_InfoMemory(ctx);
+		AdmissionControl_Info(ctx);
+		return;
+	}
 
 	// pause all working threads
 	// NOTE: pausing is not an atomic action;
@@ -18,8 +18,8 @@ struct ExecutionPlan {
 	OpBase *root;                       // Root operation of overall ExecutionPlan.
 	AST *ast_segment;                   // The segment which the current ExecutionPlan segment is built from.
 	rax *record_map;                    // Mapping between identifiers and record indices.
-	QueryGraph *query_graph;            // QueryGraph representing all graph entities in this segment.
-	QueryGraph **connected_components;  // Array of all connected components in this segment.
+	QueryGraph *query_graph;            // QueryGraph representing all graph entities in this segment, shared by clones.
+	QueryGraph **connected_components;  // Array of all connected components in this segment, NULL in clones.
 	ObjectPool *record_pool;
 	bool prepared;                      // Indicates if the execution plan is ready for execute.
 };
@@ -61,7 +61,8 @@ static void _ExecutionPlan_ProcessQueryGraph
 		uint expCount = array_len(exps);
 
 		// Reorder exps, to the most performant arrangement of evaluation.
-		orderExpressions(qg, exps, &expCount, ft, bound_vars);
+		orderExpressions(qg, exps, &expCount, ft, bound_vars,
+				QueryCtx_GetPlanHints());
 
 		// Create the SCAN operation that will be the tail of the traversal chain.
 		QGNode *src = QueryGraph_GetNodeByAlias(qg, AlgebraicExpression_Src(exps[0]));
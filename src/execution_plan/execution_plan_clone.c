@@ -15,14 +15,15 @@ static ExecutionPlan *_ClonePlanInternals(const ExecutionPlan *template) {
 
 	clone->record_map = raxClone(template->record_map);
 	if(template->ast_segment) clone->ast_segment = AST_ShallowCopy(template->ast_segment);
+	// the query graph isn't modified once the template is built
+	// share it rather than copy it, unknown IDs are resolved in place
+	// which is idempotent as schemas are never removed
 	if(template->query_graph) {
 		QueryGraph_ResolveUnknownRelIDs(template->query_graph);
-		clone->query_graph = QueryGraph_Clone(template->query_graph);
-	}
-	// TODO improve QueryGraph logic so that we do not need to store or clone connected_components.
-	if(template->connected_components) {
-		array_clone_with_cb(clone->connected_components, template->connected_components, QueryGraph_Clone);
+		clone->query_graph = QueryGraph_Share(template->query_graph);
 	}
+	// connected components are only used while building the template
+	// no need to clone them
 
 	return clone;
 }
@@ -66,7 +67,8 @@ static ExecutionPlan *_ExecutionPlan_Clone(const ExecutionPlan *template) {
 
 /* This function clones the input ExecutionPlan by recursively visiting its tree of ops.
  * When an op is encountered that was constructed as part of a different ExecutionPlan segment, that segment
- * and its internal members (FilterTree, record mapping, query graphs, and AST segment) are also cloned. */
+ * and its internal members (FilterTree, record mapping and AST segment) are also cloned,
+ * while its query graph is shared with the template. */
 ExecutionPlan *ExecutionPlan_Clone(const ExecutionPlan *template) {
 	ASSERT(template != NULL);
 	// Store the original AST pointer.
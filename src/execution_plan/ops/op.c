@@ -7,6 +7,7 @@
 #include "op.h"
 #include "RG.h"
 #include "../../util/rmalloc.h"
+#include "../../util/thread_budget.h"
 #include "../../util/simple_timer.h"
 
 /* Forward declarations */
@@ -156,6 +157,17 @@ static void _OpBase_StatsToString
 					" | Records produced: %d, Execution time: %f ms",
 					op->stats->profileRecordCount,
 					op->stats->profileExecTime);
+
+	// report number of threads algebraic operations were allowed to use
+	if(op->type == OPType_CONDITIONAL_TRAVERSE          ||
+	   op->type == OPType_CONDITIONAL_VAR_LEN_TRAVERSE  ||
+	   op->type == OPType_EXPAND_INTO                   ||
+	   op->type == OPType_DEGREE) {
+		int threads = ThreadBudget_Threads();
+		if(threads > 0) {
+			*buff = sdscatprintf(*buff, ", GraphBLAS threads: %d", threads);
+		}
+	}
 }
 
 void OpBase_ToString
@@ -20,6 +20,7 @@ typedef enum {
 	OPType_ALL_NODE_SCAN,
 	OPType_NODE_BY_LABEL_SCAN,
 	OPType_NODE_BY_INDEX_SCAN,
+	OPType_NODE_BY_GEO_INDEX_SCAN,
 	OPType_EDGE_BY_INDEX_SCAN,
 	OPType_NODE_BY_ID_SEEK,
 	OPType_NODE_BY_LABEL_AND_ID_SCAN,
@@ -52,6 +53,7 @@ typedef enum {
 	OPType_OR_APPLY_MULTIPLEXER,
 	OPType_AND_APPLY_MULTIPLEXER,
 	OPType_OPTIONAL,
+	OPType_DEGREE,
 } OPType;
 
 typedef enum {
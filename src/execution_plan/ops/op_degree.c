@@ -0,0 +1,808 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "op_degree.h"
+#include "RG.h"
+#include "shared/print_functions.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../../util/thread_budget.h"
+#include "../../graph/rg_matrix/rg_compress.h"
+#include <pthread.h>
+
+// number of source nodes to reduce at once
+#define BATCH_SIZE 1024
+
+// number of compressed entries decoded before they're reduced
+#define DECODE_CHUNK_SIZE 65536
+
+// forward declarations
+static Record DegreeConsume(OpBase *opBase);
+static OpResult DegreeReset(OpBase *opBase);
+static OpBase *DegreeClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void DegreeFree(OpBase *opBase);
+
+//------------------------------------------------------------------------------
+// multi-edge semiring
+//------------------------------------------------------------------------------
+
+// PLUS_MULTIPLICITY semiring, sums the number of edges held by each entry
+// multiplied by the number of rows produced by the entry's destination
+static GrB_Semiring _multiplicity_semiring = NULL;
+static pthread_once_t _multiplicity_once = PTHREAD_ONCE_INIT;
+
+// z = number of edges represented by relation matrix entry x, times y
+static void _edge_multiplicity(void *_z, const void *_x, const void *_y) {
+	uint64_t       *z = (uint64_t *)_z;
+	const uint64_t *x = (const uint64_t *)_x;
+	const uint64_t *y = (const uint64_t *)_y;
+
+	if(SINGLE_EDGE(*x)) {
+		*z = *y;
+	} else {
+		EdgeID *ids = (EdgeID *)(CLEAR_MSB(*x));
+		*z = array_len(ids) * (*y);
+	}
+}
+
+static void _init_multiplicity_semiring(void) {
+	GrB_Info info;
+	UNUSED(info);
+	GrB_BinaryOp op;
+
+	info = GrB_BinaryOp_new(&op, _edge_multiplicity, GrB_UINT64, GrB_UINT64,
+			GrB_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Semiring_new(&_multiplicity_semiring, GrB_PLUS_MONOID_UINT64,
+			op);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+//------------------------------------------------------------------------------
+// degree computation
+//------------------------------------------------------------------------------
+
+// w<mask> += T * x, T holding the decoded tuples I, J, X
+// T is emptied once reduced
+static void _reduce_decoded
+(
+	GrB_Vector w,           // output vector
+	GrB_Vector mask,        // rows to reduce, NULL for all
+	GrB_Matrix T,           // empty matrix to build from tuples
+	GrB_BinaryOp accum,     // accumulator, PLUS or MINUS
+	GrB_Semiring s,         // semiring, PLUS_SECOND or PLUS_MULTIPLICITY
+	GrB_Vector x,           // rows produced per destination node
+	GrB_Descriptor desc,    // descriptor
+	bool values,            // tuples carry UINT64 values
+	GrB_Index **I,          // decoded rows, cleared
+	GrB_Index **J,          // decoded columns, cleared
+	uint64_t **X            // decoded values, cleared
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Index n = array_len(*I);
+	if(n == 0) return;
+
+	// entries are unique
+	if(values) {
+		info = GrB_Matrix_build_UINT64(T, *I, *J, *X, n, GrB_FIRST_UINT64);
+	} else {
+		info = GrB_Matrix_build_BOOL(T, *I, *J, (bool *)memset(*X, 1, n), n,
+				GrB_FIRST_BOOL);
+	}
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_mxv(w, mask, accum, s, T, x, ThreadBudget_Descriptor(desc));
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_clear(T);
+	ASSERT(info == GrB_SUCCESS);
+
+	array_clear(*I);
+	array_clear(*J);
+	array_clear(*X);
+}
+
+// w<mask> += A * x, where A is frozen
+// A's compressed M is decoded in chunks of up to DECODE_CHUNK_SIZE entries
+// each reduced by GraphBLAS, rows are decoded per batch source node
+// entries marked for deletion are subtracted, as in _accumulate_degree
+static void _accumulate_compressed_degree
+(
+	GrB_Vector w,         // output vector
+	GrB_Vector mask,      // rows to reduce, NULL for all
+	RG_Matrix A,          // frozen matrix to reduce
+	GrB_Semiring s,       // semiring, PLUS_SECOND or PLUS_MULTIPLICITY
+	GrB_Vector x,         // rows produced per destination node
+	bool columns          // reduce A's columns instead of its rows
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Type       t;
+	GrB_Index      i;
+	GrB_Index      j;
+	GrB_Index      n;
+	GrB_Index      nrows;
+	GrB_Index      ncols;
+	GrB_Index      dp_nvals;
+	GrB_Index      dm_nvals;
+	uint64_t       v;
+	GrB_Matrix     T;
+	GrB_Matrix     M             =  RG_MATRIX_M(A);
+	GrB_Matrix     DP            =  RG_MATRIX_DELTA_PLUS(A);
+	GrB_Matrix     DM            =  RG_MATRIX_DELTA_MINUS(A);
+	GrB_Descriptor desc          =  NULL;
+
+	// columns are only reduced for all nodes
+	ASSERT(!columns || mask == NULL);
+	if(columns)           desc = GrB_DESC_T0;
+	else if(mask != NULL) desc = GrB_DESC_S;
+
+	const RG_CompressedMatrix *C = A->compressed;
+	RG_CompressedCursor cursor;
+
+	GrB_Matrix_nrows(&nrows, M);
+	GrB_Matrix_ncols(&ncols, M);
+	GrB_Matrix_nvals(&dp_nvals, DP);
+	GrB_Matrix_nvals(&dm_nvals, DM);
+
+	info = GxB_Matrix_type(&t, M);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_new(&T, t, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Index *I = array_new(GrB_Index, 0);
+	GrB_Index *J = array_new(GrB_Index, 0);
+	uint64_t  *X = array_new(uint64_t, 0);
+
+	// rows to decode, all rows when mask is NULL
+	GrB_Index *rows = NULL;
+	if(mask != NULL) {
+		GrB_Vector_nvals(&n, mask);
+		rows = rm_malloc(sizeof(GrB_Index) * MAX(n, 1));
+		info = GrB_Vector_extractTuples_BOOL(rows, NULL, &n, mask);
+		ASSERT(info == GrB_SUCCESS);
+	} else {
+		n = 1;
+	}
+
+	for(GrB_Index r = 0; r < n; r++) {
+		if(rows != NULL) {
+			RG_CompressedCursor_attach(&cursor, C, rows[r], rows[r]);
+		} else {
+			RG_CompressedCursor_attach(&cursor, C, 0, GrB_INDEX_MAX);
+		}
+
+		while(RG_CompressedCursor_next(&cursor, &i, &j, &v)) {
+			array_append(I, i);
+			array_append(J, j);
+			array_append(X, v);
+			if(array_len(I) == DECODE_CHUNK_SIZE) {
+				_reduce_decoded(w, mask, T, GrB_PLUS_UINT64, s, x, desc,
+						C->values, &I, &J, &X);
+			}
+		}
+	}
+	_reduce_decoded(w, mask, T, GrB_PLUS_UINT64, s, x, desc, C->values,
+			&I, &J, &X);
+
+	if(rows != NULL) rm_free(rows);
+
+	// pending additions are kept uncompressed
+	if(dp_nvals > 0) {
+		info = GrB_mxv(w, mask, GrB_PLUS_UINT64, s, DP, x,
+				ThreadBudget_Descriptor(desc));
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	if(dm_nvals > 0) {
+		// subtract M entries marked for deletion
+		struct GB_Iterator_opaque _it;
+		GxB_Iterator it = &_it;
+
+		info = GxB_rowIterator_attach(it, DM, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GxB_rowIterator_seekRow(it, 0);
+		while(info != GxB_EXHAUSTED) {
+			// empty row of a sparse matrix
+			if(info == GrB_NO_VALUE) {
+				info = GxB_rowIterator_nextRow(it);
+				continue;
+			}
+
+			i = GxB_rowIterator_getRowIndex(it);
+			do {
+				j = GxB_rowIterator_getColIndex(it);
+				if(RG_CompressedMatrix_extract(C, i, j, &v)) {
+					array_append(I, i);
+					array_append(J, j);
+					array_append(X, v);
+				}
+			} while(GxB_rowIterator_nextCol(it) == GrB_SUCCESS);
+
+			info = GxB_rowIterator_nextRow(it);
+		}
+
+		_reduce_decoded(w, mask, T, GrB_MINUS_UINT64, s, x, desc, C->values,
+				&I, &J, &X);
+	}
+
+	GrB_Matrix_free(&T);
+	array_free(I);
+	array_free(J);
+	array_free(X);
+}
+
+// w<mask> += A * x, or w += A' * x when reducing columns
+// reduces A without flushing its pending changes
+// entries marked for deletion are still present in A's M matrix
+// and are subtracted
+static void _accumulate_degree
+(
+	GrB_Vector w,         // output vector
+	GrB_Vector mask,      // rows to reduce, NULL for all
+	RG_Matrix A,          // matrix to reduce
+	GrB_Semiring s,       // semiring, PLUS_SECOND or PLUS_MULTIPLICITY
+	GrB_Vector x,         // rows produced per destination node
+	bool columns          // reduce A's columns instead of its rows
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Index      nrows;
+	GrB_Index      ncols;
+	GrB_Index      dp_nvals;
+	GrB_Index      dm_nvals;
+	GrB_Matrix     M     =  RG_MATRIX_M(A);
+	GrB_Matrix     DP    =  RG_MATRIX_DELTA_PLUS(A);
+	GrB_Matrix     DM    =  RG_MATRIX_DELTA_MINUS(A);
+	GrB_Descriptor desc  =  NULL;
+
+	// frozen matrices keep M compressed, decode the reduced rows directly
+	if(A->compressed != NULL) {
+		_accumulate_compressed_degree(w, mask, A, s, x, columns);
+		return;
+	}
+
+	// columns are only reduced for all nodes
+	ASSERT(!columns || mask == NULL);
+	if(columns)           desc = GrB_DESC_T0;
+	else if(mask != NULL) desc = GrB_DESC_S;
+
+	GrB_Matrix_nvals(&dp_nvals, DP);
+	GrB_Matrix_nvals(&dm_nvals, DM);
+
+	info = GrB_mxv(w, mask, GrB_PLUS_UINT64, s, M, x,
+			ThreadBudget_Descriptor(desc));
+	ASSERT(info == GrB_SUCCESS);
+
+	if(dp_nvals > 0) {
+		info = GrB_mxv(w, mask, GrB_PLUS_UINT64, s, DP, x,
+				ThreadBudget_Descriptor(desc));
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	if(dm_nvals > 0) {
+		// D = M entries marked for deletion
+		GrB_Matrix D;
+		GrB_Matrix_nrows(&nrows, M);
+		GrB_Matrix_ncols(&ncols, M);
+		info = GrB_Matrix_new(&D, GrB_UINT64, nrows, ncols);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_eWiseMult_BinaryOp(D, NULL, NULL, GrB_FIRST_UINT64,
+				M, DM, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_mxv(w, mask, GrB_MINUS_UINT64, s, D, x,
+				ThreadBudget_Descriptor(desc));
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Matrix_free(&D);
+	}
+}
+
+// collect the IDs of the relationship types traversed by hop
+static int *_relation_ids
+(
+	OpDegree *op,
+	const DegreeHop *hop
+) {
+	int *ids = array_new(int, 1);
+
+	if(hop->relations == NULL) {
+		// any relationship type
+		int n = Graph_RelationTypeCount(op->g);
+		for(int i = 0; i < n; i++) array_append(ids, i);
+		return ids;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	uint n = array_len(hop->relations);
+	for(uint i = 0; i < n; i++) {
+		Schema *s = GraphContext_GetSchema(gc, hop->relations[i], SCHEMA_EDGE);
+		// relationship type doesn't exists, no edges to count
+		if(s != NULL) array_append(ids, Schema_GetID(s));
+	}
+
+	return ids;
+}
+
+// w<mask> = sum of x over the edges connecting each node to its neighbors
+// when mask is NULL w is computed for all nodes
+// 'incoming' caches the reduction of incoming multi-edge relations
+static void _edges_degree
+(
+	OpDegree *op,
+	const DegreeHop *hop,
+	GrB_Vector w,
+	GrB_Vector mask,
+	GrB_Vector x,
+	GrB_Vector *incoming
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	int *relations = _relation_ids(op, hop);
+	int *multi     = array_new(int, 0);
+	uint n = array_len(relations);
+
+	for(uint i = 0; i < n; i++) {
+		int r = relations[i];
+		bool multi_edge = Graph_RelationshipContainsMultiEdge(op->g, r, false);
+
+		if(!multi_edge) {
+			// an entry represents a single edge, count entries
+			RG_Matrix R = Graph_GetRelationMatrix(op->g, r, hop->transpose);
+			_accumulate_degree(w, mask, R, GxB_PLUS_SECOND_UINT64, x, false);
+		} else if(!hop->transpose) {
+			RG_Matrix R = Graph_GetRelationMatrix(op->g, r, false);
+			_accumulate_degree(w, mask, R, _multiplicity_semiring, x, false);
+		} else {
+			// transposed matrix doesn't hold edge IDs
+			array_append(multi, r);
+		}
+	}
+
+	// reduce the columns of multi-edge relations once for all nodes
+	if(array_len(multi) > 0 && *incoming == NULL) {
+		info = GrB_Vector_new(incoming, GrB_UINT64,
+				Graph_RequiredMatrixDim(op->g));
+		ASSERT(info == GrB_SUCCESS);
+
+		uint m = array_len(multi);
+		for(uint i = 0; i < m; i++) {
+			RG_Matrix R = Graph_GetRelationMatrix(op->g, multi[i], false);
+			_accumulate_degree(*incoming, NULL, R, _multiplicity_semiring, x,
+					true);
+		}
+	}
+
+	if(array_len(multi) > 0) {
+		GrB_Descriptor desc = (mask == NULL) ? NULL : GrB_DESC_S;
+		info = GrB_Vector_eWiseAdd_BinaryOp(w, mask, NULL, GrB_PLUS_UINT64, w,
+				*incoming, desc);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	array_free(multi);
+	array_free(relations);
+}
+
+// w<mask> = sum of x over the distinct neighbors of each node
+// when mask is NULL w is computed for all nodes
+static void _neighbors_degree
+(
+	OpDegree *op,
+	const DegreeHop *hop,
+	GrB_Vector w,
+	GrB_Vector mask,
+	GrB_Vector x
+) {
+	RG_Matrix A = NULL;
+
+	if(hop->relations == NULL) {
+		A = Graph_GetAdjacencyMatrix(op->g, hop->transpose);
+	} else {
+		// distinct neighbors are computed for a single relationship type
+		ASSERT(array_len(hop->relations) == 1);
+		GraphContext *gc = QueryCtx_GetGraphCtx();
+		Schema *s = GraphContext_GetSchema(gc, hop->relations[0], SCHEMA_EDGE);
+		if(s == NULL) return;
+		A = Graph_GetRelationMatrix(op->g, Schema_GetID(s), hop->transpose);
+	}
+
+	_accumulate_degree(w, mask, A, GxB_PLUS_SECOND_UINT64, x, false);
+}
+
+// computes counts for each source node in batch
+// and adds the non-empty ones to the output records
+static void _process_batch
+(
+	OpDegree *op,
+	Record *batch,
+	uint n
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	// build mask out of batch source nodes
+	info = GrB_Vector_clear(op->mask);
+	ASSERT(info == GrB_SUCCESS);
+
+	for(uint i = 0; i < n; i++) {
+		Node *src = Record_GetNode(batch[i], op->src_idx);
+		info = GrB_Vector_setElement_BOOL(op->mask, true, ENTITY_GET_ID(src));
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	const DegreeHop *hop = op->hops;
+	for(uint t = 0; t < DEGREE_TYPE_COUNT; t++) {
+		if(!op->required[t]) continue;
+		GrB_Vector w = op->degrees[t];
+		info = GrB_Vector_clear(w);
+		ASSERT(info == GrB_SUCCESS);
+
+		if(t == DEGREE_EDGES) {
+			_edges_degree(op, hop, w, op->mask, op->x, &op->incoming);
+		} else {
+			_neighbors_degree(op, hop, w, op->mask, op->x);
+		}
+	}
+
+	uint count = array_len(op->types);
+	for(uint i = 0; i < n; i++) {
+		Record r = batch[i];
+		Node *src = Record_GetNode(r, op->src_idx);
+		NodeID id = ENTITY_GET_ID(src);
+
+		bool empty = true;
+		for(uint j = 0; j < count; j++) {
+			uint64_t degree = 0;
+			GrB_Vector_extractElement_UINT64(&degree, op->degrees[op->types[j]],
+					id);
+			Record_AddScalar(r, op->rec_idxs[j], SI_LongVal(degree));
+			empty &= (degree == 0);
+		}
+
+		// node has no neighbors, a traversal wouldn't have produced a group
+		if(empty) {
+			OpBase_DeleteRecord(r);
+			continue;
+		}
+
+		if(op->key_idx != op->src_idx) Record_AddNode(r, op->key_idx, *src);
+		array_append(op->records, r);
+	}
+}
+
+// computes the number of rows each node produces when traversed
+// for a single hop each neighbor produces a single row
+// for a two hop chain, the second hop count of every node is computed once
+static void _compute_factor
+(
+	OpDegree *op
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	size_t dim = Graph_RequiredMatrixDim(op->g);
+
+	// iso-valued vector, no memory is allocated per entry
+	GrB_Vector ones;
+	info = GrB_Vector_new(&ones, GrB_UINT64, dim);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_assign_UINT64(ones, NULL, NULL, 1, GrB_ALL, dim, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(op->hop_count == 1) {
+		op->x = ones;
+		return;
+	}
+
+	// x = second hop count per node, all nodes
+	// x[i] counts the second hop rows leaving node i, a row reduction
+	GrB_Vector incoming = NULL;
+	const DegreeHop *hop = op->hops + 1;
+
+	info = GrB_Vector_new(&op->x, GrB_UINT64, dim);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(hop->type == DEGREE_EDGES) {
+		_edges_degree(op, hop, op->x, NULL, ones, &incoming);
+	} else {
+		_neighbors_degree(op, hop, op->x, NULL, ones);
+	}
+
+	if(incoming != NULL) GrB_Vector_free(&incoming);
+	GrB_Vector_free(&ones);
+}
+
+// consume child eagerly, just like the aggregation this op replaces
+static void _compute
+(
+	OpDegree *op
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	pthread_once(&_multiplicity_once, _init_multiplicity_semiring);
+
+	OpBase *child = op->op.children[0];
+	size_t dim = Graph_RequiredMatrixDim(op->g);
+
+	if(op->mask == NULL) {
+		info = GrB_Vector_new(&op->mask, GrB_BOOL, dim);
+		ASSERT(info == GrB_SUCCESS);
+
+		for(uint t = 0; t < DEGREE_TYPE_COUNT; t++) {
+			if(!op->required[t]) continue;
+			info = GrB_Vector_new(op->degrees + t, GrB_UINT64, dim);
+			ASSERT(info == GrB_SUCCESS);
+		}
+	}
+
+	if(op->x == NULL) _compute_factor(op);
+
+	op->records = array_new(Record, 0);
+	Record batch[BATCH_SIZE];
+
+	while(true) {
+		uint n = 0;
+		while(n < BATCH_SIZE) {
+			Record r = OpBase_Consume(child);
+			if(r == NULL) break;
+
+			// the child Record may not contain the source node in scenarios
+			// like a failed OPTIONAL MATCH
+			if(Record_GetNode(r, op->src_idx) == NULL) {
+				OpBase_DeleteRecord(r);
+				continue;
+			}
+
+			Record_PersistScalars(r);
+			batch[n++] = r;
+		}
+
+		if(n == 0) break;
+		_process_batch(op, batch, n);
+	}
+}
+
+static void DegreeToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	const OpDegree *op = (const OpDegree *)ctx;
+	TraversalToString(ctx, buf, op->hops[0].ae);
+
+	if(op->hop_count == 2) {
+		// append second hop, skipping the op name and the shared node
+		// e.g. Degree | (a)->(b)->(c)
+		sds hop = sdsempty();
+		TraversalToString(ctx, &hop, op->hops[1].ae);
+		char *pattern = strchr(hop, ')');
+		ASSERT(pattern != NULL);
+		*buf = sdscat(*buf, pattern + 1);
+		sdsfree(hop);
+	}
+}
+
+// extract traversed relationship types from expression
+// expecting either R, T(R), R+S or T(R+S)
+static void _DegreeHop_Init
+(
+	DegreeHop *hop,
+	AlgebraicExpression *ae
+) {
+	hop->ae        = ae;
+	hop->type      = (AlgebraicExpression_Edge(ae) != NULL) ?
+		DEGREE_EDGES : DEGREE_NEIGHBORS;
+	hop->transpose = false;
+	hop->relations = NULL;
+
+	const AlgebraicExpression *root = ae;
+	if(root->type == AL_OPERATION &&
+	   root->operation.op == AL_EXP_TRANSPOSE) {
+		hop->transpose = true;
+		root = root->operation.children[0];
+	}
+
+	if(root->type == AL_OPERAND) {
+		const char *relation = AlgebraicExpression_Label(root);
+		if(relation != NULL) {
+			hop->relations = array_new(const char *, 1);
+			array_append(hop->relations, relation);
+		}
+	} else {
+		ASSERT(root->operation.op == AL_EXP_ADD);
+		uint n = AlgebraicExpression_ChildCount(root);
+		hop->relations = array_new(const char *, n);
+		for(uint i = 0; i < n; i++) {
+			const AlgebraicExpression *c = root->operation.children[i];
+			array_append(hop->relations, AlgebraicExpression_Label(c));
+		}
+	}
+}
+
+static void _DegreeHop_Free
+(
+	DegreeHop *hop
+) {
+	if(hop->ae != NULL) {
+		AlgebraicExpression_Free(hop->ae);
+		hop->ae = NULL;
+	}
+
+	if(hop->relations != NULL) {
+		array_free(hop->relations);
+		hop->relations = NULL;
+	}
+}
+
+OpBase *NewDegreeOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	AlgebraicExpression *ae,
+	AlgebraicExpression *next,
+	const char *key,
+	const char **aliases,
+	DegreeType *types
+) {
+	ASSERT(g       != NULL);
+	ASSERT(ae      != NULL);
+	ASSERT(key     != NULL);
+	ASSERT(types   != NULL);
+	ASSERT(aliases != NULL);
+	ASSERT(array_len(types) == array_len(aliases));
+
+	OpDegree *op = rm_calloc(1, sizeof(OpDegree));
+
+	op->g         = g;
+	op->key       = key;
+	op->types     = types;
+	op->aliases   = aliases;
+	op->hop_count = (next == NULL) ? 1 : 2;
+
+	_DegreeHop_Init(op->hops, ae);
+	if(next != NULL) _DegreeHop_Init(op->hops + 1, next);
+
+	// set our Op operations
+	OpBase_Init((OpBase *)op, OPType_DEGREE, "Degree", NULL, DegreeConsume,
+			DegreeReset, DegreeToString, DegreeClone, DegreeFree, false, plan);
+
+	bool aware = OpBase_Aware((OpBase *)op, AlgebraicExpression_Src(ae),
+			&op->src_idx);
+	UNUSED(aware);
+	ASSERT(aware == true);
+
+	op->key_idx = OpBase_Modifies((OpBase *)op, key);
+
+	uint count = array_len(types);
+	op->rec_idxs = array_new(int, count);
+	for(uint i = 0; i < count; i++) {
+		op->required[types[i]] = true;
+		array_append(op->rec_idxs, OpBase_Modifies((OpBase *)op, aliases[i]));
+	}
+
+	return (OpBase *)op;
+}
+
+static Record DegreeConsume
+(
+	OpBase *opBase
+) {
+	OpDegree *op = (OpDegree *)opBase;
+
+	if(op->records == NULL) _compute(op);
+
+	if(op->record_idx < array_len(op->records)) {
+		return op->records[op->record_idx++];
+	}
+
+	return NULL;
+}
+
+static void _free_records
+(
+	OpDegree *op
+) {
+	if(op->records == NULL) return;
+
+	// records which were already emitted are owned by the consumer
+	uint n = array_len(op->records);
+	for(uint i = op->record_idx; i < n; i++) {
+		OpBase_DeleteRecord(op->records[i]);
+	}
+
+	array_free(op->records);
+	op->records    = NULL;
+	op->record_idx = 0;
+}
+
+static void _free_vectors
+(
+	OpDegree *op
+) {
+	if(op->x        != NULL) GrB_Vector_free(&op->x);
+	if(op->mask     != NULL) GrB_Vector_free(&op->mask);
+	if(op->incoming != NULL) GrB_Vector_free(&op->incoming);
+
+	for(uint t = 0; t < DEGREE_TYPE_COUNT; t++) {
+		if(op->degrees[t] != NULL) GrB_Vector_free(op->degrees + t);
+	}
+}
+
+static OpResult DegreeReset
+(
+	OpBase *opBase
+) {
+	OpDegree *op = (OpDegree *)opBase;
+
+	_free_records(op);
+
+	// graph might have changed, recompute counts computed for all nodes
+	// and reallocate vectors, as the graph might have grown
+	_free_vectors(op);
+
+	return OP_OK;
+}
+
+static OpBase *DegreeClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_DEGREE);
+	const OpDegree *op = (const OpDegree *)opBase;
+
+	const char **aliases;
+	DegreeType *types;
+	array_clone(aliases, op->aliases);
+	array_clone(types, op->types);
+
+	AlgebraicExpression *next = (op->hop_count == 2) ?
+		AlgebraicExpression_Clone(op->hops[1].ae) : NULL;
+
+	return NewDegreeOp(plan, QueryCtx_GetGraph(),
+			AlgebraicExpression_Clone(op->hops[0].ae), next, op->key, aliases,
+			types);
+}
+
+static void DegreeFree
+(
+	OpBase *opBase
+) {
+	OpDegree *op = (OpDegree *)opBase;
+
+	_free_records(op);
+
+	for(uint i = 0; i < op->hop_count; i++) _DegreeHop_Free(op->hops + i);
+
+	if(op->aliases != NULL) {
+		array_free(op->aliases);
+		op->aliases = NULL;
+	}
+
+	if(op->types != NULL) {
+		array_free(op->types);
+		op->types = NULL;
+	}
+
+	if(op->rec_idxs != NULL) {
+		array_free(op->rec_idxs);
+		op->rec_idxs = NULL;
+	}
+
+	_free_vectors(op);
+}
+
@@ -0,0 +1,75 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../arithmetic/algebraic_expression.h"
+#include "../../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// kind of count computed by the Degree operation
+typedef enum {
+	DEGREE_EDGES,      // number of edges connecting node to its neighbors
+	DEGREE_NEIGHBORS,  // number of distinct neighbors
+} DegreeType;
+
+#define DEGREE_TYPE_COUNT 2
+
+// a single hop traversed by the Degree operation
+typedef struct {
+	AlgebraicExpression *ae;   // traversal expression, single hop
+	const char **relations;    // relationship types, NULL for any relation
+	bool transpose;            // traverse incoming edges
+	DegreeType type;           // records produced per traversed entry
+} DegreeHop;
+
+// OpDegree replaces a single hop traversal followed by a neighbors count
+// aggregation grouped by the traversal source, e.g.
+// MATCH (a:User)-[:FOLLOWS]->(b) RETURN a, count(b)
+// counts are computed by reducing the relation matrix rows of each batch
+// of source nodes rather than expanding and hashing every traversed edge
+//
+// a two hop chain counting rows per source is kept factorized, e.g.
+// MATCH (a:User)-[:FOLLOWS]->(b)-[:LIKES]->(c) RETURN a, count(c)
+// the number of rows each intermediate node produces is computed once
+// and the first hop reduces these counts rather than materializing
+// a record per (a, b, c) combination
+typedef struct {
+	OpBase op;
+	Graph *g;
+	DegreeHop hops[2];         // traversed hops, second hop is optional
+	uint hop_count;            // number of traversed hops
+	const char *key;           // alias under which source node is projected
+	const char **aliases;      // alias of each projected count
+	DegreeType *types;         // type of each projected count
+	int src_idx;               // source node record index
+	int key_idx;               // projected source node record index
+	int *rec_idxs;             // record index of each projected count
+	GrB_Vector mask;           // batch source nodes
+	GrB_Vector x;              // rows produced per destination node
+	GrB_Vector incoming;       // incoming multi-edge counts, computed once
+	GrB_Vector degrees[DEGREE_TYPE_COUNT];  // batch counts by type
+	bool required[DEGREE_TYPE_COUNT];       // count types in use
+	Record *records;           // eagerly computed output records
+	uint record_idx;           // next record to emit
+} OpDegree;
+
+// creates a new Degree operation
+// 'next' is an optional second hop, continuing from the first hop destination
+// takes ownership over 'ae', 'next', 'aliases' and 'types'
+OpBase *NewDegreeOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	Graph *g,                   // graph
+	AlgebraicExpression *ae,    // single hop traversal expression
+	AlgebraicExpression *next,  // second hop traversal expression, optional
+	const char *key,            // alias under which source node is projected
+	const char **aliases,       // alias of each projected count
+	DegreeType *types           // type of each projected count
+);
+
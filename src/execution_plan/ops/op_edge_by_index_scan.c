@@ -6,13 +6,20 @@
 
 #include "op_edge_by_index_scan.h"
 #include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../../util/qsort.h"
 #include "shared/print_functions.h"
 #include "../../filter_tree/ft_to_rsq.h"
 
+// max number of index hits held in a mask
+// a less selective filter is resolved by querying the index per input record
+#define MASK_CAP 65536
+
 // forward declarations
 static OpResult EdgeIndexScanInit(OpBase *opBase);
 static Record EdgeIndexScanConsume(OpBase *opBase);
 static Record EdgeIndexScanConsumeFromChild(OpBase *opBase);
+static Record EdgeIndexScanConsumeFromMask(OpBase *opBase);
 static OpResult EdgeIndexScanReset(OpBase *opBase);
 static void EdgeIndexScanFree(OpBase *opBase);
 
@@ -59,6 +66,9 @@ OpBase *NewEdgeIndexScanOp
 	op->current_dest_node_id =  NULL;
 	op->unresolved_filters   =  NULL;
 	op->rebuild_index_query  =  false;
+	op->use_mask             =  false;
+	op->mask                 =  NULL;
+	op->mask_idx             =  0;
 
 	// set our Op operations
 	OpBase_Init(
@@ -79,6 +89,38 @@ OpBase *NewEdgeIndexScanOp
 	return (OpBase *)op;
 }
 
+// restrict index query to edges connecting resolved endpoints
+// the query is rebuilt for each input record
+static void _ConstrainResolvedEndpoints
+(
+	OpEdgeIndexScan *op
+) {
+	const char *alias =  QGEdge_Alias(op->edge);
+	if(op->srcAware) {
+		op->current_src_node_id  = AR_EXP_NewConstOperandNode(SI_NullVal());
+		FT_FilterNode *ft = FilterTree_CreatePredicateFilter(OP_EQUAL, 
+			AR_EXP_NewAttributeAccessNode(AR_EXP_NewVariableOperandNode(alias), "_src_id"), 
+			op->current_src_node_id);
+		FT_FilterNode *root = FilterTree_CreateConditionFilter(OP_AND);
+		FilterTree_AppendLeftChild(root, op->filter);
+		FilterTree_AppendRightChild(root, ft);
+		op->filter = root;
+		op->rebuild_index_query = true;
+	}
+
+	if(op->destAware) {
+		op->current_dest_node_id  = AR_EXP_NewConstOperandNode(SI_NullVal());
+		FT_FilterNode *ft = FilterTree_CreatePredicateFilter(OP_EQUAL, 
+			AR_EXP_NewAttributeAccessNode(AR_EXP_NewVariableOperandNode(alias), "_dest_id"), 
+			op->current_dest_node_id);
+		FT_FilterNode *root = FilterTree_CreateConditionFilter(OP_AND);
+		FilterTree_AppendLeftChild(root, op->filter);
+		FilterTree_AppendRightChild(root, ft);
+		op->filter = root;
+		op->rebuild_index_query = true;
+	}
+}
+
 static OpResult EdgeIndexScanInit
 (
 	OpBase *opBase
@@ -102,42 +144,28 @@ static OpResult EdgeIndexScanInit
 	}
 
 	if(opBase->childCount > 0) {
-		const char *alias =  QGEdge_Alias(op->edge);
-		if(op->srcAware) {
-			op->current_src_node_id  = AR_EXP_NewConstOperandNode(SI_NullVal());
-			FT_FilterNode *ft = FilterTree_CreatePredicateFilter(OP_EQUAL, 
-				AR_EXP_NewAttributeAccessNode(AR_EXP_NewVariableOperandNode(alias), "_src_id"), 
-				op->current_src_node_id);
-			FT_FilterNode *root = FilterTree_CreateConditionFilter(OP_AND);
-			FilterTree_AppendLeftChild(root, op->filter);
-			FilterTree_AppendRightChild(root, ft);
-			op->filter = root;
-			op->rebuild_index_query = true;
-		}
-
-		if(op->destAware) {
-			op->current_dest_node_id  = AR_EXP_NewConstOperandNode(SI_NullVal());
-			FT_FilterNode *ft = FilterTree_CreatePredicateFilter(OP_EQUAL, 
-				AR_EXP_NewAttributeAccessNode(AR_EXP_NewVariableOperandNode(alias), "_dest_id"), 
-				op->current_dest_node_id);
-			FT_FilterNode *root = FilterTree_CreateConditionFilter(OP_AND);
-			FilterTree_AppendLeftChild(root, op->filter);
-			FilterTree_AppendRightChild(root, ft);
-			op->filter = root;
-			op->rebuild_index_query = true;
-		}
-
-		if(!op->rebuild_index_query) {
-			// find out how many different entities are refered to 
-			// within the filter tree, if number of entities equals 1
-			// (current edge being scanned) there's no need to re-build the index
-			// query for every input record
-			rax *entities = FilterTree_CollectModified(op->filter);
-			op->rebuild_index_query = raxSize(entities) > 1;
-			raxFree(entities);
+		// find out how many different entities are refered to
+		// within the filter tree, if number of entities equals 1
+		// (current edge being scanned) the index query is the same
+		// for every input record
+		rax *entities = FilterTree_CollectModified(op->filter);
+		bool edge_only = raxSize(entities) == 1;
+		raxFree(entities);
+
+		// the index is queried once and its hits are matched against the
+		// input records' resolved endpoints, as hits are collected upfront
+		// the query mustn't modify the graph
+		AST *ast = QueryCtx_GetAST();
+		op->use_mask = edge_only && (op->srcAware || op->destAware) &&
+			ast != NULL && AST_ReadOnly(ast->root);
+
+		if(op->use_mask) {
+			OpBase_UpdateConsume(opBase, EdgeIndexScanConsumeFromMask);
+		} else {
+			_ConstrainResolvedEndpoints(op);
+			op->rebuild_index_query |= !edge_only;
+			OpBase_UpdateConsume(opBase, EdgeIndexScanConsumeFromChild);
 		}
-
-		OpBase_UpdateConsume(opBase, EdgeIndexScanConsumeFromChild);
 	}
 
 	return OP_OK;
@@ -312,6 +340,158 @@ pull_index:
 	goto pull_index;
 }
 
+// endpoint by which mask hits are matched against input records
+static inline EntityID _MaskKey
+(
+	const OpEdgeIndexScan *op,
+	const EdgeIndexKey *key
+) {
+	return (op->srcAware) ? key->src_id : key->dest_id;
+}
+
+static int _MaskCmp
+(
+	const void *a,
+	const void *b,
+	void *udata
+) {
+	const OpEdgeIndexScan *op = (const OpEdgeIndexScan *)udata;
+	const EdgeIndexKey *ka = (const EdgeIndexKey *)a;
+	const EdgeIndexKey *kb = (const EdgeIndexKey *)b;
+
+	EntityID x = _MaskKey(op, ka);
+	EntityID y = _MaskKey(op, kb);
+	if(x != y) return (x < y) ? -1 : 1;
+
+	// order hits sharing an endpoint by edge ID
+	if(ka->edge_id != kb->edge_id) return (ka->edge_id < kb->edge_id) ? -1 : 1;
+	return 0;
+}
+
+// query the index once, collecting all hits into the mask
+// returns false if there are too many hits for a mask
+static bool _BuildMask
+(
+	OpEdgeIndexScan *op
+) {
+	ASSERT(op->mask == NULL);
+
+	RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
+			op->filter, op->idx);
+	ASSERT(rs_query_node != NULL);
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(rs_query_node,
+			op->idx);
+
+	bool fits = true;
+	const EdgeIndexKey *edgeKey = NULL;
+	op->mask = array_new(EdgeIndexKey, 0);
+	while((edgeKey = RediSearch_ResultsIteratorNext(iter, op->idx, NULL))
+			!= NULL) {
+		if(array_len(op->mask) == MASK_CAP) {
+			fits = false;
+			break;
+		}
+		array_append(op->mask, *edgeKey);
+	}
+
+	// release index read lock
+	RediSearch_ResultsIteratorFree(iter);
+
+	if(!fits) {
+		array_free(op->mask);
+		op->mask = NULL;
+		if(op->unresolved_filters != NULL) {
+			FilterTree_Free(op->unresolved_filters);
+			op->unresolved_filters = NULL;
+		}
+		return false;
+	}
+
+	sort_r(op->mask, array_len(op->mask), sizeof(EdgeIndexKey), _MaskCmp, op);
+	return true;
+}
+
+// position mask at the first hit connected to the input record
+static void _SeekMask
+(
+	OpEdgeIndexScan *op
+) {
+	int idx = (op->srcAware) ? op->srcRecIdx : op->destRecIdx;
+	EntityID id = ENTITY_GET_ID(Record_GetNode(op->child_record, idx));
+
+	// lower bound
+	uint lo = 0;
+	uint hi = array_len(op->mask);
+	while(lo < hi) {
+		uint mid = lo + (hi - lo) / 2;
+		if(_MaskKey(op, op->mask + mid) < id) lo = mid + 1;
+		else hi = mid;
+	}
+
+	op->mask_idx = lo;
+}
+
+static Record EdgeIndexScanConsumeFromMask
+(
+	OpBase *opBase
+) {
+	OpEdgeIndexScan	*op = (OpEdgeIndexScan*)opBase;
+
+	// collect index hits on first call
+	if(op->mask == NULL && !_BuildMask(op)) {
+		// filter isn't selective enough, query index per input record
+		op->use_mask = false;
+		_ConstrainResolvedEndpoints(op);
+		OpBase_UpdateConsume(opBase, EdgeIndexScanConsumeFromChild);
+		return EdgeIndexScanConsumeFromChild(opBase);
+	}
+
+	uint mask_len = array_len(op->mask);
+
+	while(true) {
+		//----------------------------------------------------------------------
+		// emit hits connected to the current input record
+		//----------------------------------------------------------------------
+
+		if(op->child_record != NULL) {
+			int idx = (op->srcAware) ? op->srcRecIdx : op->destRecIdx;
+			EntityID id = ENTITY_GET_ID(Record_GetNode(op->child_record, idx));
+
+			while(op->mask_idx < mask_len &&
+				  _MaskKey(op, op->mask + op->mask_idx) == id) {
+				const EdgeIndexKey *edgeKey = op->mask + op->mask_idx;
+				op->mask_idx++;
+
+				// both endpoints are resolved, make sure hit connects them
+				if(op->srcAware && op->destAware) {
+					Node *dest = Record_GetNode(op->child_record, op->destRecIdx);
+					if(edgeKey->dest_id != ENTITY_GET_ID(dest)) continue;
+				}
+
+				// populate record with edge
+				_UpdateRecord(op, op->child_record, edgeKey);
+				// apply unresolved filters
+				if(_PassUnresolvedFilters(op, op->child_record)) {
+					// clone the held Record, as it will be freed upstream
+					return OpBase_CloneRecord(op->child_record);
+				}
+			}
+
+			OpBase_DeleteRecord(op->child_record);
+			op->child_record = NULL;
+		}
+
+		//----------------------------------------------------------------------
+		// pull from child
+		//----------------------------------------------------------------------
+
+		op->child_record = OpBase_Consume(op->op.children[0]);
+		if(op->child_record == NULL) return NULL; // depleted
+
+		_SeekMask(op);
+	}
+}
+
 static Record EdgeIndexScanConsume
 (
 	OpBase *opBase
@@ -355,11 +535,19 @@ static OpResult EdgeIndexScanReset(OpBase *opBase) {
 		op->iter = NULL;
 	}
 
-	if(op->unresolved_filters) {
+	if(op->child_record) {
+		OpBase_DeleteRecord(op->child_record);
+		op->child_record = NULL;
+	}
+
+	// mask is kept, the graph isn't modified by masked scans
+	if(op->unresolved_filters && !op->use_mask) {
 		FilterTree_Free(op->unresolved_filters);
 		op->unresolved_filters = NULL;
 	}
 
+	op->mask_idx = 0;
+
 	return OP_OK;
 }
 
@@ -388,5 +576,10 @@ static void EdgeIndexScanFree(OpBase *opBase) {
 		FilterTree_Free(op->unresolved_filters);
 		op->unresolved_filters = NULL;
 	}
+
+	if(op->mask) {
+		array_free(op->mask);
+		op->mask = NULL;
+	}
 }
 
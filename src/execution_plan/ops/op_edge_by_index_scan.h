@@ -9,6 +9,7 @@
 #include "op.h"
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
+#include "../../index/index.h"
 #include "redisearch_api.h"
 
 typedef struct {
@@ -28,6 +29,9 @@ typedef struct {
 	AR_ExpNode *current_dest_node_id;   // current destination node id
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
 	Record child_record;                // input record in case op ins't a tap
+	bool use_mask;                      // match input records against index hits collected once
+	EdgeIndexKey *mask;                 // index hits, sorted by the resolved endpoint
+	uint mask_idx;                      // current hit within mask
 } OpEdgeIndexScan;
 
 // creates a new OpEdgeIndexScan operation
@@ -15,6 +15,8 @@ static void FilterFree(OpBase *opBase);
 OpBase *NewFilterOp(const ExecutionPlan *plan, FT_FilterNode *filterTree) {
 	OpFilter *op = rm_malloc(sizeof(OpFilter));
 	op->filterTree = filterTree;
+	op->evaluated = 0;
+	op->passed = 0;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_FILTER, "Filter", NULL, FilterConsume,
@@ -35,8 +37,12 @@ static Record FilterConsume(OpBase *opBase) {
 		if(!r) break;
 
 		/* Pass record through filter tree */
-		if(FilterTree_applyFilters(filter->filterTree, r) == FILTER_PASS) break;
-		else OpBase_DeleteRecord(r);
+		filter->evaluated++;
+		if(FilterTree_applyFilters(filter->filterTree, r) == FILTER_PASS) {
+			filter->passed++;
+			break;
+		}
+		OpBase_DeleteRecord(r);
 	}
 
 	return r;
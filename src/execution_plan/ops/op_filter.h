@@ -15,6 +15,8 @@
 typedef struct {
 	OpBase op;
 	FT_FilterNode *filterTree;
+	uint64_t evaluated;          // Number of records the filter was applied to.
+	uint64_t passed;             // Number of records which passed the filter.
 } OpFilter;
 
 /* Creates a new Filter operation */
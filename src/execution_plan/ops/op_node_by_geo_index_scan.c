@@ -0,0 +1,259 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "op_node_by_geo_index_scan.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../../datatypes/point.h"
+#include "shared/print_functions.h"
+#include <math.h>
+
+// initial number of results requested by a nearest neighbours scan
+#define GEO_SCAN_INITIAL_BATCH 64
+
+// forward declarations
+static OpResult GeoIndexScanInit(OpBase *opBase);
+static Record GeoIndexScanConsume(OpBase *opBase);
+static OpResult GeoIndexScanReset(OpBase *opBase);
+static void GeoIndexScanFree(OpBase *opBase);
+
+static void GeoIndexScanToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	NodeByGeoIndexScan *op = (NodeByGeoIndexScan *)ctx;
+	ScanToString(ctx, buf, op->n.alias, op->n.label);
+}
+
+static OpBase *_NewGeoIndexScanOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	NodeScanCtx n,
+	GeoIndex *idx,
+	Attribute_ID attribute,
+	SIValue center,
+	double radius,
+	bool inclusive
+) {
+	ASSERT(g    != NULL);
+	ASSERT(idx  != NULL);
+	ASSERT(plan != NULL);
+	ASSERT(SI_TYPE(center) == T_POINT);
+
+	NodeByGeoIndexScan *op = rm_calloc(1, sizeof(NodeByGeoIndexScan));
+
+	op->g          = g;
+	op->n          = n;
+	op->idx        = idx;
+	op->batch      = GEO_SCAN_INITIAL_BATCH;
+	op->center     = center;
+	op->radius     = radius;
+	op->inclusive  = inclusive;
+	op->attribute  = attribute;
+
+	// set our op operations
+	OpBase_Init((OpBase *)op, OPType_NODE_BY_GEO_INDEX_SCAN,
+			"Node By Geo Index Scan", GeoIndexScanInit, GeoIndexScanConsume,
+			GeoIndexScanReset, GeoIndexScanToString, NULL, GeoIndexScanFree,
+			false, plan);
+
+	op->nodeRecIdx = OpBase_Modifies((OpBase *)op, n.alias);
+
+	return (OpBase *)op;
+}
+
+OpBase *NewGeoIndexRadiusScanOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	NodeScanCtx n,
+	GeoIndex *idx,
+	Attribute_ID attribute,
+	SIValue center,
+	double radius,
+	bool inclusive
+) {
+	return _NewGeoIndexScanOp(plan, g, n, idx, attribute, center, radius,
+			inclusive);
+}
+
+OpBase *NewGeoIndexNearestScanOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	NodeScanCtx n,
+	GeoIndex *idx,
+	Attribute_ID attribute,
+	SIValue center
+) {
+	return _NewGeoIndexScanOp(plan, g, n, idx, attribute, center, INFINITY,
+			true);
+}
+
+bool GeoIndexScan_OrderedBy
+(
+	const NodeByGeoIndexScan *op,
+	Attribute_ID attribute,
+	SIValue center
+) {
+	ASSERT(op != NULL);
+
+	return (op->attribute == attribute &&
+			SI_TYPE(center) == T_POINT &&
+			Point_lat(center) == Point_lat(op->center) &&
+			Point_lon(center) == Point_lon(op->center));
+}
+
+static OpResult GeoIndexScanInit
+(
+	OpBase *opBase
+) {
+	NodeByGeoIndexScan *op = (NodeByGeoIndexScan *)opBase;
+
+	// resolve label ID now if it is still unknown
+	if(op->n.label_id == GRAPH_UNKNOWN_LABEL) {
+		GraphContext *gc = QueryCtx_GetGraphCtx();
+		Schema *s = GraphContext_GetSchema(gc, op->n.label, SCHEMA_NODE);
+		if(s != NULL) op->n.label_id = Schema_GetID(s);
+	}
+
+	return OP_OK;
+}
+
+// query index for the next batch of results
+static void _FetchResults
+(
+	NodeByGeoIndexScan *op
+) {
+	if(op->results != NULL) array_free(op->results);
+
+	if(op->radius == INFINITY) {
+		op->results = GeoIndex_Nearest(op->idx, op->center, op->batch);
+	} else {
+		op->results = GeoIndex_Radius(op->idx, op->center, op->radius,
+				op->inclusive);
+	}
+}
+
+// get next indexed node
+// returns false once index is depleted
+static bool _NextIndexed
+(
+	NodeByGeoIndexScan *op,
+	EntityID *id
+) {
+	if(op->index_depleted) return false;
+
+	if(op->results == NULL) _FetchResults(op);
+
+	if(op->result_idx == array_len(op->results)) {
+		// a radius scan is answered by a single batch, a nearest scan
+		// is depleted once the index returned fewer results than requested
+		if(op->radius != INFINITY || array_len(op->results) < op->batch) {
+			op->index_depleted = true;
+			return false;
+		}
+
+		// results are deterministically ordered, a larger batch
+		// begins with the nodes we've already produced
+		op->batch *= 4;
+		_FetchResults(op);
+
+		if(op->result_idx == array_len(op->results)) {
+			op->index_depleted = true;
+			return false;
+		}
+	}
+
+	*id = op->results[op->result_idx++].id;
+	return true;
+}
+
+// get next labeled node which isn't indexed
+// these have no distance and are ordered last
+static bool _NextUnindexed
+(
+	NodeByGeoIndexScan *op,
+	EntityID *id
+) {
+	// radius scan doesn't produce nodes without location
+	if(op->radius != INFINITY) return false;
+	if(op->n.label_id == GRAPH_UNKNOWN_LABEL) return false;
+
+	if(op->iter.A == NULL) {
+		RG_Matrix L = Graph_GetLabelMatrix(op->g, op->n.label_id);
+		RG_MatrixTupleIter_attach(&op->iter, L);
+	}
+
+	GrB_Index node_id;
+	while(RG_MatrixTupleIter_next_BOOL(&op->iter, &node_id, NULL, NULL) ==
+			GrB_SUCCESS) {
+		if(!GeoIndex_Contains(op->idx, node_id)) {
+			*id = node_id;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static Record GeoIndexScanConsume
+(
+	OpBase *opBase
+) {
+	NodeByGeoIndexScan *op = (NodeByGeoIndexScan *)opBase;
+
+	EntityID id;
+	if(!_NextIndexed(op, &id) && !_NextUnindexed(op, &id)) return NULL;
+
+	// populate the record with the actual node
+	Node n = GE_NEW_NODE();
+	int res = Graph_GetNode(op->g, id, &n);
+	ASSERT(res != 0);
+	UNUSED(res);
+
+	Record r = OpBase_CreateRecord(opBase);
+	Record_AddNode(r, op->nodeRecIdx, n);
+
+	return r;
+}
+
+static void _ClearIterators
+(
+	NodeByGeoIndexScan *op
+) {
+	if(op->results != NULL) {
+		array_free(op->results);
+		op->results = NULL;
+	}
+
+	if(op->iter.A != NULL) {
+		RG_MatrixTupleIter_detach(&op->iter);
+		memset(&op->iter, 0, sizeof(RG_MatrixTupleIter));
+	}
+
+	op->batch          = GEO_SCAN_INITIAL_BATCH;
+	op->result_idx     = 0;
+	op->index_depleted = false;
+}
+
+static OpResult GeoIndexScanReset
+(
+	OpBase *opBase
+) {
+	_ClearIterators((NodeByGeoIndexScan *)opBase);
+	return OP_OK;
+}
+
+static void GeoIndexScanFree
+(
+	OpBase *opBase
+) {
+	_ClearIterators((NodeByGeoIndexScan *)opBase);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "shared/scan_functions.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../index/geo_index.h"
+#include "../../graph/rg_matrix/rg_matrix_iter.h"
+
+// NodeByGeoIndexScan, scans a spatial index
+// nodes are produced in ascending distance from a center point
+// either up to a maximum distance (radius scan)
+// or until all nodes have been produced (nearest neighbours scan)
+// in which case labeled nodes missing an indexed location follow
+
+typedef struct {
+	OpBase op;
+	Graph *g;
+	NodeScanCtx n;                // label data of node being scanned
+	uint nodeRecIdx;              // node position within record
+	GeoIndex *idx;                // spatial index to scan
+	Attribute_ID attribute;       // indexed attribute
+	SIValue center;               // scan center
+	double radius;                // max distance, INFINITY for nearest scan
+	bool inclusive;               // include nodes exactly 'radius' away
+	GeoIndexResult *results;      // nodes ordered by distance
+	uint64_t result_idx;          // next result to produce
+	uint64_t batch;               // number of results requested from index
+	bool index_depleted;          // all indexed nodes were produced
+	RG_MatrixTupleIter iter;      // iterator over label, for nodes with no location
+} NodeByGeoIndexScan;
+
+// creates a new NodeByGeoIndexScan operation producing nodes
+// within 'radius' meters from 'center'
+OpBase *NewGeoIndexRadiusScanOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	NodeScanCtx n,
+	GeoIndex *idx,
+	Attribute_ID attribute,
+	SIValue center,
+	double radius,
+	bool inclusive
+);
+
+// creates a new NodeByGeoIndexScan operation producing all labeled nodes
+// ordered by their distance from 'center'
+OpBase *NewGeoIndexNearestScanOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	NodeScanCtx n,
+	GeoIndex *idx,
+	Attribute_ID attribute,
+	SIValue center
+);
+
+// returns true if op produces nodes ordered by their distance from 'center'
+bool GeoIndexScan_OrderedBy
+(
+	const NodeByGeoIndexScan *op,
+	Attribute_ID attribute,  // indexed attribute
+	SIValue center           // distance origin
+);
@@ -6,13 +6,19 @@
 
 #include "op_node_by_index_scan.h"
 #include "../../query_ctx.h"
+#include "../../util/arr.h"
 #include "shared/print_functions.h"
+#include "../../datatypes/array.h"
 #include "../../filter_tree/ft_to_rsq.h"
 
+// max number of input records probed by a single index query
+#define BATCH_SIZE 256
+
 // forward declarations
 static OpResult IndexScanInit(OpBase *opBase);
 static Record IndexScanConsume(OpBase *opBase);
 static Record IndexScanConsumeFromChild(OpBase *opBase);
+static Record IndexScanConsumeBatchFromChild(OpBase *opBase);
 static OpResult IndexScanReset(OpBase *opBase);
 static void IndexScanFree(OpBase *opBase);
 
@@ -38,6 +44,13 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n,
 	op->child_record         =  NULL;
 	op->unresolved_filters   =  NULL;
 	op->rebuild_index_query  =  false;
+	op->batch_probes         =  false;
+	op->attr_id              =  ATTRIBUTE_ID_NONE;
+	op->batch                =  NULL;
+	op->batch_hits           =  NULL;
+	op->batch_count          =  0;
+	op->batch_idx            =  0;
+	op->hit_idx              =  0;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_NODE_BY_INDEX_SCAN, "Node By Index Scan", IndexScanInit, IndexScanConsume,
@@ -47,6 +60,40 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n,
 	return (OpBase *)op;
 }
 
+// returns true if the index can be probed for a batch of input records
+// at once, which is the case for filters of the form: n.v = exp
+// where 'exp' is evaluated against each input record
+static bool _BatchableFilter
+(
+	const IndexScan *op,
+	Attribute_ID *attr_id  // [output] compared attribute
+) {
+	FT_FilterNode *filter = op->filter;
+	if(filter->t != FT_N_PRED || filter->pred.op != OP_EQUAL) return false;
+
+	char *attr = NULL;
+	if(!AR_EXP_IsAttribute(filter->pred.lhs, &attr)) return false;
+
+	// make sure scanned node is only referred to on the left hand side
+	const char *alias = op->n.alias;
+	rax *entities = raxNew();
+	AR_EXP_CollectEntities(filter->pred.lhs, entities);
+	bool lhs = raxFind(entities, (unsigned char *)alias, strlen(alias)) !=
+		raxNotFound;
+	raxRemove(entities, (unsigned char *)alias, strlen(alias), NULL);
+	AR_EXP_CollectEntities(filter->pred.rhs, entities);
+	bool rhs = raxFind(entities, (unsigned char *)alias, strlen(alias)) !=
+		raxNotFound;
+	raxFree(entities);
+
+	if(!lhs || rhs) return false;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	*attr_id = GraphContext_GetAttributeID(gc, attr);
+
+	return true;
+}
+
 static OpResult IndexScanInit(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
@@ -59,7 +106,21 @@ static OpResult IndexScanInit(OpBase *opBase) {
 		op->rebuild_index_query = raxSize(entities) > 1; // this is us
 		raxFree(entities);
 
-		OpBase_UpdateConsume(opBase, IndexScanConsumeFromChild);
+		// probe the index once for a batch of input records
+		// instead of building a query for each of them
+		op->batch_probes = op->rebuild_index_query &&
+			_BatchableFilter(op, &op->attr_id);
+
+		if(op->batch_probes) {
+			op->batch = rm_malloc(sizeof(Record) * BATCH_SIZE);
+			op->batch_hits = rm_malloc(sizeof(EntityID *) * BATCH_SIZE);
+			for(uint i = 0; i < BATCH_SIZE; i++) {
+				op->batch_hits[i] = array_new(EntityID, 1);
+			}
+			OpBase_UpdateConsume(opBase, IndexScanConsumeBatchFromChild);
+		} else {
+			OpBase_UpdateConsume(opBase, IndexScanConsumeFromChild);
+		}
 	}
 
 	// resolve label ID now if it is still unknown
@@ -87,6 +148,35 @@ static inline bool _PassUnresolvedFilters(const IndexScan *op, Record r) {
 	return FilterTree_applyFilters(unresolved_filters, r) == FILTER_PASS;
 }
 
+// builds an index query for given input record
+static RSQNode *_RecordQuery
+(
+	const IndexScan *op,
+	Record r,
+	FT_FilterNode **unresolved_filters  // [output] filters to apply on hits
+) {
+	// resolve runtime variables within filter
+	FT_FilterNode *filter = FilterTree_Clone(op->filter);
+	FilterTree_ResolveVariables(filter, r);
+
+	// make sure there's only one unresolve entity in filter
+	#ifdef RG_DEBUG
+	{
+		rax *entities = FilterTree_CollectModified(filter);
+		ASSERT(raxSize(entities) == 1);
+		raxFree(entities);
+	}
+	#endif
+
+	// convert filter into a RediSearch query
+	RSQNode *rs_query_node = FilterTreeToQueryNode(unresolved_filters,
+			filter, op->idx);
+	FilterTree_Free(filter);
+
+	ASSERT(rs_query_node != NULL);
+	return rs_query_node;
+}
+
 static Record IndexScanConsumeFromChild(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 	const EntityID *nodeId = NULL;
@@ -144,26 +234,10 @@ pull_index:
 		}
 
 		// rebuild index query, probably relies on runtime values
-		// resolve runtime variables within filter
-		FT_FilterNode *filter = FilterTree_Clone(op->filter);
-		FilterTree_ResolveVariables(filter, op->child_record);
-
-		// make sure there's only one unresolve entity in filter
-		#ifdef RG_DEBUG
-		{
-			rax *entities = FilterTree_CollectModified(filter);
-			ASSERT(raxSize(entities) == 1);
-			raxFree(entities);
-		}
-		#endif
-
-		// convert filter into a RediSearch query
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				filter, op->idx);
-		FilterTree_Free(filter);
+		RSQNode *rs_query_node = _RecordQuery(op, op->child_record,
+				&op->unresolved_filters);
 
 		// create iterator
-		ASSERT(rs_query_node != NULL);
 		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 	} else {
 		// build index query only once (first call)
@@ -183,6 +257,209 @@ pull_index:
 	goto pull_index;
 }
 
+// probes the index for a single input record
+// collecting hits which pass the unresolved filters
+static void _ProbeRecord
+(
+	IndexScan *op,
+	Record r,
+	EntityID **hits  // [output] index hits
+) {
+	FT_FilterNode *unresolved_filters = NULL;
+	RSQNode *rs_query_node = _RecordQuery(op, r, &unresolved_filters);
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(rs_query_node,
+			op->idx);
+
+	const EntityID *nodeId = NULL;
+	while((nodeId = RediSearch_ResultsIteratorNext(iter, op->idx, NULL))
+			!= NULL) {
+		if(unresolved_filters != NULL) {
+			_UpdateRecord(op, r, *nodeId);
+			if(FilterTree_applyFilters(unresolved_filters, r) != FILTER_PASS) {
+				continue;
+			}
+		}
+		array_append(*hits, *nodeId);
+	}
+
+	RediSearch_ResultsIteratorFree(iter);
+	if(unresolved_filters != NULL) FilterTree_Free(unresolved_filters);
+}
+
+// routes index hit to the input records it was probed for
+static void _RouteHit
+(
+	IndexScan *op,
+	EntityID id,
+	rax *numerics,  // numeric probe value to input records
+	rax *strings    // string probe value to input records
+) {
+	Node n = GE_NEW_NODE();
+	int res = Graph_GetNode(op->g, id, &n);
+	ASSERT(res != 0);
+
+	SIValue *v = GraphEntity_GetProperty((GraphEntity *)&n, op->attr_id);
+	if(v == ATTRIBUTE_NOTFOUND) return;
+
+	uint *records = raxNotFound;
+	SIType t = SI_TYPE(*v);
+	if(t == T_STRING) {
+		records = raxFind(strings, (unsigned char *)v->stringval,
+				strlen(v->stringval));
+	} else if(t & (SI_NUMERIC | T_BOOL)) {
+		// the index compares numerics and booleans by their numeric value
+		double d = SI_GET_NUMERIC(*v);
+		if(d == 0) d = 0; // -0.0 and 0.0 are equal
+		records = raxFind(numerics, (unsigned char *)&d, sizeof(d));
+	}
+
+	if(records == raxNotFound) return;
+
+	uint n_records = array_len(records);
+	for(uint i = 0; i < n_records; i++) {
+		array_append(op->batch_hits[records[i]], id);
+	}
+}
+
+// pulls a batch of input records and probes the index
+// using a single IN query for all of them
+// returns false if child is depleted
+static bool _ProbeBatch
+(
+	IndexScan *op
+) {
+	OpBase      *child     =  op->op.children[0];
+	AR_ExpNode  *rhs       =  op->filter->pred.rhs;
+	rax         *numerics  =  raxNew();            // probed numeric values
+	rax         *strings   =  raxNew();            // probed string values
+	SIValue     list       =  SI_Array(BATCH_SIZE);  // distinct probed values
+
+	op->batch_idx = 0;
+	op->hit_idx   = 0;
+
+	for(op->batch_count = 0; op->batch_count < BATCH_SIZE; op->batch_count++) {
+		Record r = OpBase_Consume(child);
+		if(r == NULL) break; // depleted
+
+		// records are held until the entire batch is emitted
+		Record_PersistScalars(r);
+
+		uint i = op->batch_count;
+		op->batch[i] = r;
+		array_clear(op->batch_hits[i]);
+
+		SIValue        v        =  AR_EXP_Evaluate(rhs, r);
+		SIType         t        =  SI_TYPE(v);
+		rax            *probes  =  NULL;
+		unsigned char  *key     =  NULL;
+		size_t         key_len  =  0;
+		double         d;
+
+		if(t == T_STRING) {
+			probes  = strings;
+			key     = (unsigned char *)v.stringval;
+			key_len = strlen(v.stringval);
+		} else if(t & (SI_NUMERIC | T_BOOL) &&
+				// TODO: remove when RediSearch INT64 indexing bug fixed
+				!(t == T_INT64 && v.longval & 0x7FF0000000000000)) {
+			d = SI_GET_NUMERIC(v);
+			if(d == 0) d = 0; // -0.0 and 0.0 are equal
+			probes  = numerics;
+			key     = (unsigned char *)&d;
+			key_len = sizeof(d);
+		}
+
+		if(probes == NULL) {
+			// value can't be probed in batch, e.g. null or array
+			_ProbeRecord(op, r, op->batch_hits + i);
+		} else {
+			uint *records = raxFind(probes, key, key_len);
+			if(records == raxNotFound) {
+				// first record to probe for value
+				records = array_new(uint, 1);
+				raxInsert(probes, key, key_len, records, NULL);
+				SIArray_Append(&list, v);
+			}
+			array_append(records, i);
+			// update rax in case array was reallocated
+			raxInsert(probes, key, key_len, records, NULL);
+		}
+
+		SIValue_Free(v);
+	}
+
+	if(SIArray_Length(list) > 0) {
+		// probe index for all distinct values at once: n.v IN list
+		AR_ExpNode *in = AR_EXP_NewOpNode("in", true, 2);
+		in->op.children[0] = AR_EXP_Clone(op->filter->pred.lhs);
+		in->op.children[1] = AR_EXP_NewConstOperandNode(list);
+		FT_FilterNode *filter = FilterTree_CreateExpressionFilter(in);
+
+		FT_FilterNode *unresolved_filters = NULL;
+		RSQNode *rs_query_node = FilterTreeToQueryNode(&unresolved_filters,
+				filter, op->idx);
+		ASSERT(unresolved_filters == NULL);
+		FilterTree_Free(filter);
+
+		RSResultsIterator *iter = RediSearch_GetResultsIterator(rs_query_node,
+				op->idx);
+
+		const EntityID *nodeId = NULL;
+		while((nodeId = RediSearch_ResultsIteratorNext(iter, op->idx, NULL))
+				!= NULL) {
+			_RouteHit(op, *nodeId, numerics, strings);
+		}
+
+		RediSearch_ResultsIteratorFree(iter);
+	} else {
+		SIValue_Free(list);
+	}
+
+	raxFreeWithCallback(numerics, array_free);
+	raxFreeWithCallback(strings, array_free);
+
+	return op->batch_count > 0;
+}
+
+// frees batched input records
+static void _ReleaseBatch
+(
+	IndexScan *op
+) {
+	for(uint i = 0; i < op->batch_count; i++) {
+		OpBase_DeleteRecord(op->batch[i]);
+	}
+
+	op->batch_count = 0;
+	op->batch_idx   = 0;
+	op->hit_idx     = 0;
+}
+
+static Record IndexScanConsumeBatchFromChild(OpBase *opBase) {
+	IndexScan *op = (IndexScan *)opBase;
+
+	while(true) {
+		// emit hits of current batch in input order
+		while(op->batch_idx < op->batch_count) {
+			EntityID *hits = op->batch_hits[op->batch_idx];
+			if(op->hit_idx < array_len(hits)) {
+				Record r = op->batch[op->batch_idx];
+				_UpdateRecord(op, r, hits[op->hit_idx++]);
+				// clone the held Record, as it will be freed upstream
+				return OpBase_CloneRecord(r);
+			}
+
+			// advance to next record
+			op->batch_idx++;
+			op->hit_idx = 0;
+		}
+
+		// batch depleted, probe next batch
+		_ReleaseBatch(op);
+		if(!_ProbeBatch(op)) return NULL;
+	}
+}
+
 static Record IndexScanConsume(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
@@ -226,6 +503,8 @@ static OpResult IndexScanReset(OpBase *opBase) {
 		op->unresolved_filters = NULL;
 	}
 
+	if(op->batch_probes) _ReleaseBatch(op);
+
 	return OP_OK;
 }
 
@@ -254,5 +533,17 @@ static void IndexScanFree(OpBase *opBase) {
 		FilterTree_Free(op->unresolved_filters);
 		op->unresolved_filters = NULL;
 	}
+
+	if(op->batch != NULL) {
+		_ReleaseBatch(op);
+		rm_free(op->batch);
+		op->batch = NULL;
+	}
+
+	if(op->batch_hits != NULL) {
+		for(uint i = 0; i < BATCH_SIZE; i++) array_free(op->batch_hits[i]);
+		rm_free(op->batch_hits);
+		op->batch_hits = NULL;
+	}
 }
 
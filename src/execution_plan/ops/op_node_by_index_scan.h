@@ -24,6 +24,13 @@ typedef struct {
 	FT_FilterNode *filter;              // filter from which to compose index query
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
 	Record child_record;                // the Record this op acts on if it is not a tap
+	bool batch_probes;                  // probe index once for a batch of input records
+	Attribute_ID attr_id;               // attribute compared against input records
+	Record *batch;                      // input records probed together
+	EntityID **batch_hits;              // index hits of each input record
+	uint batch_count;                   // number of records in batch
+	uint batch_idx;                     // current record within batch
+	uint hit_idx;                       // current hit of current record
 } IndexScan;
 
 // creates a new IndexScan operation
@@ -53,6 +53,18 @@ OpBase *NewUpdateOp(const ExecutionPlan *plan, rax *update_exps) {
 	return (OpBase *)op;
 }
 
+// checks if update is the last operation which might fail
+// in which case its commit is never rolled back
+static bool _FinalCommit(const OpUpdate *op) {
+	// only results emission follows the update
+	const OpBase *parent = op->op.parent;
+	while(parent != NULL) {
+		if(parent->type != OPType_RESULTS) return false;
+		parent = parent->parent;
+	}
+	return true;
+}
+
 static OpResult UpdateInit(OpBase *opBase) {
 	OpUpdate *op = (OpUpdate *)opBase;
 
@@ -60,6 +72,7 @@ static OpResult UpdateInit(OpBase *opBase) {
 	op->records       =  array_new(Record, 64);
 	op->node_updates  =  array_new(PendingUpdateCtx, raxSize(op->update_ctxs));
 	op->edge_updates  =  array_new(PendingUpdateCtx, raxSize(op->update_ctxs));
+	op->final_commit  =  _FinalCommit(op);
 
 	return OP_OK;
 }
@@ -97,8 +110,16 @@ static Record UpdateConsume(OpBase *opBase) {
 		// lock everything
 		QueryCtx_LockForCommit();
 
+		// committing updates can't fail, if nothing that might fail follows
+		// there's no need to record these updates in the undo log
+		QueryCtx *query_ctx = QueryCtx_GetQueryCtx();
+		bool unlogged = op->final_commit &&
+			UndoLog_BeginFinalCommit(&query_ctx->undo_log);
+
 		CommitUpdates(op->gc, op->stats, op->node_updates, ENTITY_NODE);
 		CommitUpdates(op->gc, op->stats, op->edge_updates, ENTITY_EDGE);
+
+		if(unlogged) UndoLog_EndFinalCommit(&query_ctx->undo_log);
 	}
 
 	for(uint i = 0; i < node_updates_count; i ++) {
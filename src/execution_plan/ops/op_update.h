@@ -18,6 +18,7 @@ typedef struct {
 	GraphContext *gc;
 	rax *update_ctxs;               // Entities to update and their expressions
 	bool updates_committed;         // True if we've already committed updates and are now in handoff mode.
+	bool final_commit;              // True if no failing operation follows our commit.
 	PendingUpdateCtx *node_updates; // Enqueued node updates
 	PendingUpdateCtx *edge_updates; // Enqueued edge updates
 	ResultSetStatistics *stats;
@@ -15,6 +15,7 @@
 #include "op_filter.h"
 #include "op_node_by_label_scan.h"
 #include "op_node_by_index_scan.h"
+#include "op_node_by_geo_index_scan.h"
 #include "op_update.h"
 #include "op_conditional_traverse.h"
 #include "op_cartesian_product.h"
@@ -38,4 +39,5 @@
 #include "op_semi_apply.h"
 #include "op_apply_multiplexer.h"
 #include "op_optional.h"
+#include "op_degree.h"
 
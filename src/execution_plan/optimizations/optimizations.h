@@ -16,12 +16,14 @@ void orderExpressions(
 	AlgebraicExpression **exps,     // expressions to order
 	uint *exps_count,               // number of expressions
 	const FT_FilterNode *filters,   // filters
-	rax *bound_vars                 // previously-bound variables
+	rax *bound_vars,                // previously-bound variables
+	rax *nonselective               // [optional] aliases with non-selective filters
 );
 
 void compactFilters(ExecutionPlan *plan);
 void reduceScans(ExecutionPlan *plan);
 void utilizeIndices(ExecutionPlan *plan);
+void utilizeSpatialIndex(ExecutionPlan *plan);
 void seekByID(ExecutionPlan *plan);
 void filterVariableLengthEdges(ExecutionPlan *plan);
 void reduceCartesianProductStreamCount(ExecutionPlan *plan);
@@ -30,6 +32,7 @@ void reduceFilters(ExecutionPlan *plan);
 void reduceTraversal(ExecutionPlan *plan);
 void reduceDistinct(ExecutionPlan *plan);
 void reduceCount(ExecutionPlan *plan);
+void reduceDegree(ExecutionPlan *plan);
 void applyLimit(ExecutionPlan *plan);
 void applySkip(ExecutionPlan *plan);
 void optimizeLabelScan(ExecutionPlan *plan);
@@ -24,6 +24,9 @@ void optimizePlan(ExecutionPlan *plan) {
 	// remove redundant SCAN operations
 	reduceScans(plan);
 
+	// replace label scans filtered or ordered by distance with spatial index scans
+	utilizeSpatialIndex(plan);
+
 	// when possible, replace label scan and filter ops with index scans
 	utilizeIndices(plan);
 
@@ -55,6 +58,10 @@ void optimizePlan(ExecutionPlan *plan) {
 	// try to reduce execution plan incase it perform node or edge counting
 	reduceCount(plan);
 
+	// try to reduce a traversal followed by a per node neighbors count
+	// into a relation matrix reduction
+	reduceDegree(plan);
+
 	// let operations know about specified limit(s)
 	applyLimit(plan);
 
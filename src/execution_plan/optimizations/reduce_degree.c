@@ -0,0 +1,255 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// the reduceDegree optimization looks for a single hop traversal
+// followed by an aggregation counting neighbors per traversal source
+// MATCH (a:User)-[:FOLLOWS]->(b) RETURN a, count(b)
+// Scan -> CondTraverse -> Aggregate
+// in which case the traversal and aggregation are replaced by a Degree op
+// which reduces the relation matrix rows of each source node
+// Scan -> Degree
+//
+// a two hop chain counting rows per source is reduced as well
+// MATCH (a:User)-[:FOLLOWS]->(b)-[:LIKES]->(c) RETURN a, count(c)
+// Scan -> CondTraverse -> CondTraverse -> Aggregate
+// avoiding materializing a record per (a, b, c) combination
+
+// expression operand must be a relation matrix
+static bool _relationOperand
+(
+	const AlgebraicExpression *exp
+) {
+	return (exp->type == AL_OPERAND && !exp->operand.diagonal);
+}
+
+// validates traversal expression is either: R, T(R), R+S or T(R+S)
+// sets 'multi_type' if expression traverses more than a single relation
+static bool _validTraversalExpression
+(
+	const AlgebraicExpression *ae,
+	bool *multi_type
+) {
+	*multi_type = false;
+
+	if(ae->type == AL_OPERATION && ae->operation.op == AL_EXP_TRANSPOSE) {
+		ae = ae->operation.children[0];
+	}
+
+	if(_relationOperand(ae)) return true;
+
+	if(ae->type != AL_OPERATION || ae->operation.op != AL_EXP_ADD) return false;
+
+	uint n = AlgebraicExpression_ChildCount(ae);
+	for(uint i = 0; i < n; i++) {
+		const AlgebraicExpression *c = ae->operation.children[i];
+		// untyped operand is covered by the adjacency matrix, not expected here
+		if(!_relationOperand(c) || AlgebraicExpression_Label(c) == NULL) {
+			return false;
+		}
+	}
+
+	*multi_type = true;
+	return true;
+}
+
+// checks if 'exp' is a variadic referring to 'alias'
+static inline bool _isAlias
+(
+	const AR_ExpNode *exp,
+	const char *alias
+) {
+	return (alias != NULL && AR_EXP_IsVariadic(exp) &&
+			strcmp(exp->operand.variadic.entity_alias, alias) == 0);
+}
+
+// determine which count is computed by the aggregation expression
+// returns false if expression can't be computed by reducing a relation matrix
+static bool _countType
+(
+	AR_ExpNode *exp,
+	AlgebraicExpression *ae,
+	DegreeType *type
+) {
+	if(exp->type != AR_EXP_OP ||
+	   exp->op.f->aggregate != true ||
+	   strcasecmp(AR_EXP_GetFuncName(exp), "count") ||
+	   exp->op.child_count != 1) return false;
+
+	const char *src  = AlgebraicExpression_Src(ae);
+	const char *dest = AlgebraicExpression_Dest(ae);
+	const char *edge = AlgebraicExpression_Edge(ae);
+	AR_ExpNode *arg  = exp->op.children[0];
+
+	if(AR_EXP_PerformsDistinct(exp)) {
+		// count(DISTINCT b) or count(DISTINCT e)
+		if(arg->type != AR_EXP_OP || arg->op.child_count != 1) return false;
+		arg = arg->op.children[0];
+
+		if(_isAlias(arg, dest)) *type = DEGREE_NEIGHBORS;
+		else if(_isAlias(arg, edge)) *type = DEGREE_EDGES;
+		else return false;
+
+		return true;
+	}
+
+	// count(a), count(b), count(e) or count(*)
+	// each traversed record is counted
+	// when the edge is not bound a record is produced for each neighbor
+	if(AR_EXP_IsConstant(arg)) {
+		if(SI_TYPE(arg->operand.constant) == T_NULL) return false;
+	} else if(!_isAlias(arg, src) && !_isAlias(arg, dest) &&
+			  !_isAlias(arg, edge)) {
+		return false;
+	}
+
+	*type = (edge != NULL) ? DEGREE_EDGES : DEGREE_NEIGHBORS;
+	return true;
+}
+
+// determine which count is computed over a two hop chain
+// every row produced by the chain is counted, distinct counts aren't supported
+static bool _chainCountType
+(
+	AR_ExpNode *exp,
+	AlgebraicExpression *ae,
+	AlgebraicExpression *next,
+	DegreeType *type
+) {
+	if(exp->type != AR_EXP_OP ||
+	   exp->op.f->aggregate != true ||
+	   strcasecmp(AR_EXP_GetFuncName(exp), "count") ||
+	   exp->op.child_count != 1 ||
+	   AR_EXP_PerformsDistinct(exp)) return false;
+
+	AR_ExpNode *arg = exp->op.children[0];
+
+	if(AR_EXP_IsConstant(arg)) {
+		if(SI_TYPE(arg->operand.constant) == T_NULL) return false;
+	} else if(!_isAlias(arg, AlgebraicExpression_Src(ae))  &&
+			  !_isAlias(arg, AlgebraicExpression_Edge(ae)) &&
+			  !_isAlias(arg, AlgebraicExpression_Src(next))  &&
+			  !_isAlias(arg, AlgebraicExpression_Edge(next)) &&
+			  !_isAlias(arg, AlgebraicExpression_Dest(next))) {
+		return false;
+	}
+
+	// first hop yields a row per edge or per neighbor
+	*type = (AlgebraicExpression_Edge(ae) != NULL) ?
+		DEGREE_EDGES : DEGREE_NEIGHBORS;
+	return true;
+}
+
+static void _reduceDegree
+(
+	ExecutionPlan *plan,
+	OpAggregate *aggregate
+) {
+	OpBase *op = (OpBase *)aggregate;
+
+	// expecting Scan -> CondTraverse -> Aggregate
+	// or Scan -> CondTraverse -> CondTraverse -> Aggregate
+	// within the same segment
+	if(op->childCount != 1 || aggregate->should_cache_records) return;
+	if(aggregate->key_count != 1 || aggregate->aggregate_count == 0) return;
+
+	OpBase *traverse = op->children[0];
+	if(traverse->type != OPType_CONDITIONAL_TRAVERSE ||
+	   traverse->childCount != 1 ||
+	   traverse->plan != op->plan) return;
+
+	OpBase *first = traverse;
+	AlgebraicExpression *next = NULL;
+	if(traverse->children[0]->type == OPType_CONDITIONAL_TRAVERSE) {
+		// two hop chain, count is computed in a factorized manner
+		first = traverse->children[0];
+		next = ((OpCondTraverse *)traverse)->ae;
+		if(first->childCount != 1 || first->plan != op->plan) return;
+	}
+
+	OpBase *scan = first->children[0];
+	if(scan->childCount != 0 || scan->plan != op->plan) return;
+
+	AlgebraicExpression *ae = ((OpCondTraverse *)first)->ae;
+
+	bool multi_type;
+	if(!_validTraversalExpression(ae, &multi_type)) return;
+
+	if(next != NULL) {
+		bool next_multi_type;
+		if(!_validTraversalExpression(next, &next_multi_type)) return;
+
+		// second hop must continue from first hop destination
+		if(strcmp(AlgebraicExpression_Src(next), AlgebraicExpression_Dest(ae))) {
+			return;
+		}
+
+		// distinct neighbors can't be computed by summing relation matrices
+		if(next_multi_type && AlgebraicExpression_Edge(next) == NULL) return;
+	}
+
+	// group by traversal source
+	AR_ExpNode *key = aggregate->key_exps[0];
+	if(!_isAlias(key, AlgebraicExpression_Src(ae))) return;
+
+	uint count = aggregate->aggregate_count;
+	DegreeType *types = array_new(DegreeType, count);
+	for(uint i = 0; i < count; i++) {
+		DegreeType t;
+		AR_ExpNode *exp = aggregate->aggregate_exps[i];
+		bool valid = (next == NULL) ?
+			_countType(exp, ae, &t) : _chainCountType(exp, ae, next, &t);
+
+		// distinct neighbors can't be computed by summing relation matrices
+		if(!valid || (multi_type && t == DEGREE_NEIGHBORS)) {
+			array_free(types);
+			return;
+		}
+		array_append(types, t);
+	}
+
+	const char **aliases = array_new(const char *, count);
+	for(uint i = 0; i < count; i++) {
+		array_append(aliases, aggregate->aggregate_exps[i]->resolved_name);
+	}
+
+	if(next != NULL) next = AlgebraicExpression_Clone(next);
+	OpBase *degree = NewDegreeOp(op->plan, QueryCtx_GetGraph(),
+			AlgebraicExpression_Clone(ae), next, key->resolved_name, aliases,
+			types);
+
+	// new execution plan: "Scan -> Degree"
+	if(first != traverse) {
+		ExecutionPlan_RemoveOp(plan, first);
+		OpBase_Free(first);
+	}
+
+	ExecutionPlan_RemoveOp(plan, traverse);
+	OpBase_Free(traverse);
+
+	ExecutionPlan_ReplaceOp(plan, op, degree);
+	OpBase_Free(op);
+}
+
+void reduceDegree
+(
+	ExecutionPlan *plan
+) {
+	OpBase **aggregations = ExecutionPlan_CollectOps(plan->root,
+			OPType_AGGREGATE);
+
+	uint n = array_len(aggregations);
+	for(uint i = 0; i < n; i++) {
+		_reduceDegree(plan, (OpAggregate *)aggregations[i]);
+	}
+
+	array_free(aggregations);
+}
+
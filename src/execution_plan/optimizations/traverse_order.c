@@ -217,7 +217,8 @@ void orderExpressions
 	AlgebraicExpression **exps,
 	uint *exp_count,
 	const FT_FilterNode *ft,
-	rax *bound_vars
+	rax *bound_vars,
+	rax *nonselective
 ) {
 	// Validate inputs
 	ASSERT(qg          != NULL);
@@ -234,6 +235,18 @@ void orderExpressions
 		filtered_entities = FilterTree_CollectModified(ft);
 		// enrich filtered_entities with independent filtered entities frequency
 		FilterTree_CollectIndependentEntities(ft, filtered_entities);
+
+		// filters observed to discard few records don't make for
+		// a good entry point, don't favour their aliases
+		if(nonselective) {
+			raxIterator it;
+			raxStart(&it, nonselective);
+			raxSeek(&it, "^", NULL, 0);
+			while(raxNext(&it)) {
+				raxRemove(filtered_entities, it.key, it.key_len, NULL);
+			}
+			raxStop(&it);
+		}
 	}
 
 	//--------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 #include "RG.h"
 #include "../../value.h"
 #include "../../util/arr.h"
+#include "../../util/rmalloc.h"
 #include "../../query_ctx.h"
 #include "../ops/op_filter.h"
 #include "../../ast/ast_shared.h"
@@ -88,9 +89,37 @@ static bool _validateInExpression(AR_ExpNode *exp) {
 	return true;
 }
 
+// validates a string search expression of the form:
+// n.v STARTS WITH exp, n.v CONTAINS exp or n.v ENDS WITH exp
+// where 'exp' reduces to a string of at least 'min_len' bytes
+// sets 'v' to the searched string
+static bool _validateStringSearch(const char *filtered_entity,
+		AR_ExpNode *exp, size_t min_len, SIValue *v) {
+	ASSERT(exp->op.child_count == 2);
+
+	AR_ExpNode *lhs = exp->op.children[0];
+	AR_ExpNode *rhs = exp->op.children[1];
+
+	// left hand side should be an attribute of the filtered entity
+	if(!AR_EXP_IsAttribute(lhs, NULL)) return false;
+
+	rax *aliases = raxNew();
+	AR_EXP_CollectEntities(lhs, aliases);
+	bool lhs_entity = raxFind(aliases, (unsigned char *)filtered_entity,
+			strlen(filtered_entity)) != raxNotFound;
+	raxFree(aliases);
+	if(!lhs_entity) return false;
+
+	// searched value must be a known string
+	if(!AR_EXP_ReduceToScalar(rhs, true, v)) return false;
+	if(SI_TYPE(*v) != T_STRING) return false;
+
+	return strlen(v->stringval) >= min_len;
+}
+
 // return true if filter can be resolved by an index query
 static bool _applicable_predicate(const char* filtered_entity,
-		FT_FilterNode *filter) {
+		const Index *idx, FT_FilterNode *filter) {
 
 	SIValue v;
 	bool res              =  false;
@@ -104,6 +133,26 @@ static bool _applicable_predicate(const char* filtered_entity,
 
 	if(isDistanceFilter(filter)) return true;
 
+	// prefix search is answered by a lexical range
+	if(isPrefixFilter(filter)) {
+		return _validateStringSearch(filtered_entity, filter->exp.exp, 1, &v);
+	}
+
+	// substring and suffix searches are narrowed down by indexed trigrams
+	if(isSubstringFilter(filter)) {
+		if(!Index_ContainsTrigrams(idx)) return false;
+		if(!_validateStringSearch(filtered_entity, filter->exp.exp,
+					INDEX_TRIGRAM_LEN, &v)) {
+			return false;
+		}
+
+		// make sure searched string contains an indexable trigram
+		char **trigrams = Index_Trigrams(v.stringval);
+		res = array_len(trigrams) > 0;
+		array_free_cb(trigrams, rm_free);
+		return res;
+	}
+
 	switch(filter->t) {
 	case FT_N_PRED:
 		lhs_exp = filter->pred.lhs;
@@ -160,8 +209,8 @@ static bool _applicable_predicate(const char* filtered_entity,
 		break;
 	case FT_N_COND:
 		// require both ends of the filter to be applicable
-		res = (_applicable_predicate(filtered_entity, filter->cond.left) &&
-				_applicable_predicate(filtered_entity, filter->cond.right));
+		res = (_applicable_predicate(filtered_entity, idx, filter->cond.left) &&
+				_applicable_predicate(filtered_entity, idx, filter->cond.right));
 		break;
 	default:
 		break;
@@ -185,14 +234,15 @@ bool _applicableFilter
 	// prepare it befor checking if applicable.
 	_normalize_filter(filtered_entity, filter);
 
-	// make sure the filter root is not a function, other then IN or distance
+	// make sure the filter root is not a function, other then IN, distance
+	// or string search
 	// make sure the "not equal, <>" operator isn't used
 	if(FilterTree_containsOp(filter_tree, OP_NEQUAL)) {
 		res = false;
 		goto cleanup;
 	}
 
-	if(!_applicable_predicate(filtered_entity, filter_tree)) {
+	if(!_applicable_predicate(filtered_entity, idx, filter_tree)) {
 		res = false;
 		goto cleanup;
 	}
@@ -0,0 +1,262 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../../arithmetic/arithmetic_op.h"
+#include "../../ast/ast_build_op_contexts.h"
+#include "../ops/op_node_by_geo_index_scan.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// the utilizeSpatialIndex optimization replaces a label scan with a spatial
+// index scan when nodes are filtered or ordered by their distance
+// from a constant point
+//
+// MATCH (n:L) WHERE distance(n.loc, point({...})) < 1000 RETURN n
+// Filter -> Label Scan
+// is reduced to a radius scan
+// Geo Index Scan
+//
+// MATCH (n:L) RETURN n ORDER BY distance(n.loc, point({...})) LIMIT 5
+// Limit -> Sort -> Project -> Label Scan
+// is reduced to a nearest neighbours scan, which produces nodes ordered by
+// distance, and so the Sort operation is dropped
+// Limit -> Project -> Geo Index Scan
+
+// distance(n.attr, origin) where origin is a constant point
+typedef struct {
+	Attribute_ID attribute;  // indexed attribute
+	SIValue origin;          // constant point
+} DistanceExp;
+
+// checks if 'exp' computes the distance between 'alias' location
+// and a constant point
+static bool _distanceExpression
+(
+	AR_ExpNode *exp,
+	const char *alias,
+	DistanceExp *dist
+) {
+	if(!AR_EXP_IsOperation(exp)) return false;
+	if(strcasecmp(AR_EXP_GetFuncName(exp), "distance") != 0) return false;
+	if(exp->op.child_count != 2) return false;
+
+	for(int i = 0; i < 2; i++) {
+		AR_ExpNode *attr_exp   = exp->op.children[i];
+		AR_ExpNode *origin_exp = exp->op.children[1 - i];
+
+		// attr_exp should be alias.attr
+		char *attr = NULL;
+		if(!AR_EXP_IsAttribute(attr_exp, &attr)) continue;
+
+		AR_ExpNode *entity = attr_exp->op.children[0];
+		if(!AR_EXP_IsVariadic(entity) ||
+		   strcmp(entity->operand.variadic.entity_alias, alias) != 0) {
+			continue;
+		}
+
+		// origin should be a constant point
+		SIValue origin;
+		if(!AR_EXP_ReduceToScalar(origin_exp, true, &origin)) continue;
+		if(SI_TYPE(origin) != T_POINT) continue;
+
+		GraphContext *gc = QueryCtx_GetGraphCtx();
+		dist->attribute = GraphContext_GetAttributeID(gc, attr);
+		dist->origin    = origin;
+		return (dist->attribute != ATTRIBUTE_ID_NONE);
+	}
+
+	return false;
+}
+
+// checks if filter is of the form: distance(alias.attr, origin) < radius
+static bool _radiusFilter
+(
+	const FT_FilterNode *filter,
+	const char *alias,
+	DistanceExp *dist,
+	double *radius,
+	bool *inclusive
+) {
+	if(filter->t != FT_N_PRED) return false;
+
+	AST_Operator op         = filter->pred.op;
+	AR_ExpNode   *dist_exp  = filter->pred.lhs;
+	AR_ExpNode   *bound_exp = filter->pred.rhs;
+
+	// radius < distance(alias.attr, origin)
+	if(!_distanceExpression(dist_exp, alias, dist)) {
+		dist_exp  = filter->pred.rhs;
+		bound_exp = filter->pred.lhs;
+		op        = ArithmeticOp_ReverseOp(op);
+		if(!_distanceExpression(dist_exp, alias, dist)) return false;
+	}
+
+	if(op != OP_LT && op != OP_LE) return false;
+
+	SIValue bound;
+	if(!AR_EXP_ReduceToScalar(bound_exp, true, &bound)) return false;
+	if(!(SI_TYPE(bound) & SI_NUMERIC)) return false;
+
+	*radius    = SI_GET_NUMERIC(bound);
+	*inclusive = (op == OP_LE);
+	return true;
+}
+
+// returns spatial index of labeled node attribute, NULL if missing
+static GeoIndex *_spatialIndex
+(
+	int label_id,
+	Attribute_ID attribute
+) {
+	if(label_id == GRAPH_UNKNOWN_LABEL) return NULL;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Index *idx = GraphContext_GetIndexByID(gc, label_id, NULL, IDX_EXACT_MATCH,
+			SCHEMA_NODE);
+	if(idx == NULL) return NULL;
+
+	return Index_GetGeoIndex(idx, attribute);
+}
+
+// try to reduce a label scan followed by a radius filter into a radius scan
+static void _reduceRadiusScan
+(
+	ExecutionPlan *plan,
+	NodeByLabelScan *scan
+) {
+	// scan must be a tap
+	if(scan->op.childCount != 0) return;
+
+	const char *alias = scan->n.alias;
+
+	OpBase *parent = scan->op.parent;
+	while(parent != NULL && parent->type == OPType_FILTER) {
+		OpFilter *filter = (OpFilter *)parent;
+
+		double radius;
+		bool inclusive;
+		DistanceExp dist;
+		if(_radiusFilter(filter->filterTree, alias, &dist, &radius,
+					&inclusive)) {
+			GeoIndex *geo = _spatialIndex(scan->n.label_id, dist.attribute);
+			if(geo == NULL) return;
+
+			OpBase *geo_scan = NewGeoIndexRadiusScanOp(scan->op.plan, scan->g,
+					scan->n, geo, dist.attribute, dist.origin, radius,
+					inclusive);
+
+			ExecutionPlan_ReplaceOp(plan, (OpBase *)scan, geo_scan);
+			OpBase_Free((OpBase *)scan);
+
+			ExecutionPlan_RemoveOp(plan, (OpBase *)filter);
+			OpBase_Free((OpBase *)filter);
+			return;
+		}
+
+		parent = parent->parent;
+	}
+}
+
+// try to reduce a sort by distance into a nearest neighbours scan
+static void _reduceDistanceSort
+(
+	ExecutionPlan *plan,
+	OpSort *sort
+) {
+	OpBase *op = (OpBase *)sort;
+
+	// single ascending sort key
+	if(array_len(sort->exps) != 1 || sort->directions[0] != DIR_ASC) return;
+
+	// sort must be limited, otherwise every node is produced regardless
+	OpBase *parent = op->parent;
+	if(parent != NULL && parent->type == OPType_SKIP) parent = parent->parent;
+	if(parent == NULL || parent->type != OPType_LIMIT) return;
+
+	// expecting Sort -> Project -> [Filter]* -> Scan
+	if(op->childCount != 1 || op->children[0]->type != OPType_PROJECT) return;
+	OpProject *project = (OpProject *)op->children[0];
+
+	OpBase *scan = project->op.children[0];
+	while(scan != NULL && scan->type == OPType_FILTER && scan->childCount == 1) {
+		scan = scan->children[0];
+	}
+	if(scan == NULL || scan->childCount != 0) return;
+	if(scan->type != OPType_NODE_BY_LABEL_SCAN &&
+	   scan->type != OPType_NODE_BY_GEO_INDEX_SCAN) return;
+
+	// ORDER BY d, where d is a projected expression
+	AR_ExpNode *exp = sort->exps[0];
+	if(AR_EXP_IsVariadic(exp)) {
+		const char *name = exp->operand.variadic.entity_alias;
+		exp = NULL;
+		for(uint i = 0; i < project->exp_count; i++) {
+			if(strcmp(project->exps[i]->resolved_name, name) == 0) {
+				exp = project->exps[i];
+				break;
+			}
+		}
+		if(exp == NULL) return;
+	}
+
+	DistanceExp dist;
+	if(scan->type == OPType_NODE_BY_GEO_INDEX_SCAN) {
+		// radius scan already produces nodes ordered by distance
+		NodeByGeoIndexScan *geo_scan = (NodeByGeoIndexScan *)scan;
+		if(!_distanceExpression(exp, geo_scan->n.alias, &dist)) return;
+		if(!GeoIndexScan_OrderedBy(geo_scan, dist.attribute, dist.origin)) {
+			return;
+		}
+	} else {
+		NodeByLabelScan *label_scan = (NodeByLabelScan *)scan;
+		if(!_distanceExpression(exp, label_scan->n.alias, &dist)) return;
+
+		GeoIndex *geo = _spatialIndex(label_scan->n.label_id, dist.attribute);
+		if(geo == NULL) return;
+
+		OpBase *geo_scan = NewGeoIndexNearestScanOp(scan->plan, label_scan->g,
+				label_scan->n, geo, dist.attribute, dist.origin);
+
+		ExecutionPlan_ReplaceOp(plan, scan, geo_scan);
+		OpBase_Free(scan);
+	}
+
+	// nodes are produced in order, sort is redundant
+	ExecutionPlan_RemoveOp(plan, op);
+	OpBase_Free(op);
+}
+
+void utilizeSpatialIndex
+(
+	ExecutionPlan *plan
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	// return immediately if the graph has no indices
+	if(!GraphContext_HasIndices(gc)) return;
+
+	// reduce label scans followed by radius filters
+	OpBase **scans = ExecutionPlan_CollectOps(plan->root,
+			OPType_NODE_BY_LABEL_SCAN);
+
+	uint scan_count = array_len(scans);
+	for(uint i = 0; i < scan_count; i++) {
+		_reduceRadiusScan(plan, (NodeByLabelScan *)scans[i]);
+	}
+
+	// reduce sorts by distance
+	OpBase **sorts = ExecutionPlan_CollectOps(plan->root, OPType_SORT);
+
+	uint sort_count = array_len(sorts);
+	for(uint i = 0; i < sort_count; i++) {
+		_reduceDistanceSort(plan, (OpSort *)sorts[i]);
+	}
+
+	array_free(scans);
+	array_free(sorts);
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "plan_feedback.h"
+#include "RG.h"
+#include "xxhash.h"
+#include "../errors.h"
+#include "../query_ctx.h"
+#include "ops/op_filter.h"
+#include "execution_plan_clone.h"
+#include "../util/rmalloc.h"
+#include "../arithmetic/arithmetic_expression.h"
+
+static PlanVariant *_PlanVariant_New(void) {
+	PlanVariant *v = rm_malloc(sizeof(PlanVariant));
+	v->nonselective = raxNew();
+	v->plan = NULL;
+	v->disabled = false;
+	return v;
+}
+
+static void _PlanVariant_Free(void *variant) {
+	PlanVariant *v = (PlanVariant *)variant;
+	if(v->plan) ExecutionPlan_Free(v->plan);
+	raxFree(v->nonselective);
+	rm_free(v);
+}
+
+// collects scanned aliases whose filters passed most of the scanned records
+// looking for: Traverse <- Filter <- ... <- Filter <- Scan
+static void _CollectNonSelective
+(
+	const OpBase *op,
+	rax *nonselective
+) {
+	for(int i = 0; i < op->childCount; i++) {
+		_CollectNonSelective(op->children[i], nonselective);
+	}
+
+	// only consider scans feeding a traversal
+	// as those are the ones the traversal order decides on
+	if(op->type != OPType_CONDITIONAL_TRAVERSE) return;
+
+	OpFilter *top = NULL;
+	OpFilter *bottom = NULL;
+	const OpBase *child = op->children[0];
+	while(child->type == OPType_FILTER) {
+		if(top == NULL) top = (OpFilter *)child;
+		bottom = (OpFilter *)child;
+		child = child->children[0];
+	}
+
+	if(top == NULL) return;
+	if(child->childCount != 0) return;
+	if(child->type != OPType_NODE_BY_LABEL_SCAN &&
+	   child->type != OPType_ALL_NODE_SCAN) return;
+
+	// not enough records to judge selectivity
+	if(bottom->evaluated < PLAN_FEEDBACK_MIN_RECORDS) return;
+	if(top->passed <= bottom->evaluated * PLAN_FEEDBACK_SELECTIVITY_THRESHOLD) {
+		return;
+	}
+
+	const char *alias = child->modifies[0];
+	raxTryInsert(nonselective, (unsigned char *)alias, strlen(alias), NULL,
+			NULL);
+}
+
+PlanFeedback *PlanFeedback_New(void) {
+	PlanFeedback *fb = rm_malloc(sizeof(PlanFeedback));
+	fb->ref_count = 1;
+	fb->variants = raxNew();
+	int res = pthread_mutex_init(&fb->mutex, NULL);
+	ASSERT(res == 0);
+	return fb;
+}
+
+PlanFeedback *PlanFeedback_Share
+(
+	PlanFeedback *fb
+) {
+	ASSERT(fb != NULL);
+
+	__atomic_fetch_add(&fb->ref_count, 1, __ATOMIC_RELAXED);
+	return fb;
+}
+
+uint64_t PlanFeedback_ParamsSignature(void) {
+	rax *params = QueryCtx_GetParams();
+	if(params == NULL || raxSize(params) == 0) return 0;
+
+	// rax is sorted, parameters are visited in the same order
+	// regardless of the order in which they were specified
+	XXH64_hash_t signature = 0;
+	raxIterator it;
+	raxStart(&it, params);
+	raxSeek(&it, "^", NULL, 0);
+	while(raxNext(&it)) {
+		AR_ExpNode *param = it.data;
+		signature = 31 * signature + XXH64(it.key, it.key_len, 0);
+		if(param->type == AR_EXP_OPERAND &&
+		   param->operand.type == AR_EXP_CONSTANT) {
+			signature = 31 * signature +
+				SIValue_HashCode(param->operand.constant);
+		}
+	}
+	raxStop(&it);
+
+	// 0 is reserved for parameterless queries
+	return (signature == 0) ? 1 : signature;
+}
+
+ExecutionPlan *PlanFeedback_GetPlan
+(
+	PlanFeedback *fb,
+	uint64_t signature
+) {
+	ASSERT(fb != NULL);
+
+	ExecutionPlan *plan = NULL;
+
+	pthread_mutex_lock(&fb->mutex);
+
+	PlanVariant *v = raxFind(fb->variants, (unsigned char *)&signature,
+			sizeof(signature));
+	if(v == raxNotFound || v->disabled) goto cleanup;
+
+	if(v->plan == NULL) {
+		// build variant using the cached query's AST
+		QueryCtx_SetPlanHints(v->nonselective);
+		v->plan = NewExecutionPlan();
+		QueryCtx_SetPlanHints(NULL);
+
+		if(ErrorCtx_EncounteredError()) {
+			// fall back to the cached plan
+			ErrorCtx_Clear();
+			ExecutionPlan_Free(v->plan);
+			v->plan = NULL;
+			v->disabled = true;
+			goto cleanup;
+		}
+	}
+
+	plan = ExecutionPlan_Clone(v->plan);
+
+cleanup:
+	pthread_mutex_unlock(&fb->mutex);
+	return plan;
+}
+
+void PlanFeedback_Observe
+(
+	PlanFeedback *fb,
+	uint64_t signature,
+	const ExecutionPlan *plan
+) {
+	ASSERT(fb != NULL);
+	ASSERT(plan != NULL);
+
+	rax *nonselective = raxNew();
+	_CollectNonSelective(plan->root, nonselective);
+
+	if(raxSize(nonselective) == 0) {
+		raxFree(nonselective);
+		return;
+	}
+
+	pthread_mutex_lock(&fb->mutex);
+
+	PlanVariant *v = raxFind(fb->variants, (unsigned char *)&signature,
+			sizeof(signature));
+	if(v == raxNotFound) {
+		// bound the number of tracked signatures
+		if(raxSize(fb->variants) >= PLAN_FEEDBACK_MAX_SIGNATURES) goto cleanup;
+		v = _PlanVariant_New();
+		raxInsert(fb->variants, (unsigned char *)&signature, sizeof(signature),
+				v, NULL);
+	}
+
+	// merge observed aliases into the variant's hints
+	bool modified = false;
+	raxIterator it;
+	raxStart(&it, nonselective);
+	raxSeek(&it, "^", NULL, 0);
+	while(raxNext(&it)) {
+		modified |= raxTryInsert(v->nonselective, it.key, it.key_len, NULL,
+				NULL);
+	}
+	raxStop(&it);
+
+	// hints changed, rebuild variant on its next use
+	// executing clones aren't affected
+	if(modified && v->plan) {
+		ExecutionPlan_Free(v->plan);
+		v->plan = NULL;
+	}
+
+cleanup:
+	pthread_mutex_unlock(&fb->mutex);
+	raxFree(nonselective);
+}
+
+void PlanFeedback_Free
+(
+	PlanFeedback *fb
+) {
+	if(fb == NULL) return;
+
+	// feedback is still in use by other owners
+	if(__atomic_sub_fetch(&fb->ref_count, 1, __ATOMIC_ACQ_REL) > 0) return;
+
+	raxFreeWithCallback(fb->variants, _PlanVariant_Free);
+	pthread_mutex_destroy(&fb->mutex);
+	rm_free(fb);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "execution_plan.h"
+#include "../util/rax_extensions.h"
+#include <pthread.h>
+
+// minimal number of records a filter should evaluate
+// before its selectivity is taken into account
+#define PLAN_FEEDBACK_MIN_RECORDS 1024
+
+// a filter passing more than this fraction of its input is non-selective
+#define PLAN_FEEDBACK_SELECTIVITY_THRESHOLD 0.5
+
+// maximal number of parameter signatures tracked per cached query
+#define PLAN_FEEDBACK_MAX_SIGNATURES 256
+
+// execution plan built for a specific set of parameters
+// taking observed cardinalities into account
+typedef struct {
+	rax *nonselective;    // aliases whose filters were observed to be non-selective
+	ExecutionPlan *plan;  // plan built with 'nonselective' as hints, NULL if stale
+	bool disabled;        // plan construction failed, use the cached plan
+} PlanVariant;
+
+// runtime cardinality feedback collected for a cached query
+// shared by the cached execution context and all of its clones
+typedef struct {
+	uint ref_count;         // number of owners
+	rax *variants;          // parameters signature to PlanVariant
+	pthread_mutex_t mutex;  // guards variants
+} PlanFeedback;
+
+// create a new plan feedback
+PlanFeedback *PlanFeedback_New(void);
+
+// adds an owner to the plan feedback and returns it
+PlanFeedback *PlanFeedback_Share
+(
+	PlanFeedback *fb
+);
+
+// computes a signature for the current query's parameters
+// returns 0 if the query has no parameters
+uint64_t PlanFeedback_ParamsSignature(void);
+
+// returns a clone of the plan variant associated with 'signature'
+// building the variant if it is stale
+// returns NULL if the cached plan should be used
+ExecutionPlan *PlanFeedback_GetPlan
+(
+	PlanFeedback *fb,    // plan feedback
+	uint64_t signature   // parameters signature
+);
+
+// inspects an executed plan, recording filters which turned out
+// to be non-selective when applied right after a scan
+// the plan variant associated with 'signature' is marked stale
+// if the observation changes its hints
+void PlanFeedback_Observe
+(
+	PlanFeedback *fb,           // plan feedback
+	uint64_t signature,         // parameters signature
+	const ExecutionPlan *plan   // executed plan
+);
+
+// removes an owner, frees the plan feedback once its last owner is gone
+void PlanFeedback_Free
+(
+	PlanFeedback *fb
+);
@@ -13,6 +13,22 @@ bool isInFilter(const FT_FilterNode *filter) {
 			strcasecmp(AR_EXP_GetFuncName(filter->exp.exp), "in") == 0);
 }
 
+bool isPrefixFilter(const FT_FilterNode *filter) {
+	return (filter->t == FT_N_EXP &&
+			filter->exp.exp->type == AR_EXP_OP &&
+			strcasecmp(AR_EXP_GetFuncName(filter->exp.exp), "starts with") == 0);
+}
+
+bool isSubstringFilter(const FT_FilterNode *filter) {
+	if(filter->t != FT_N_EXP || filter->exp.exp->type != AR_EXP_OP) {
+		return false;
+	}
+
+	const char *func = AR_EXP_GetFuncName(filter->exp.exp);
+	return (strcasecmp(func, "contains") == 0 ||
+			strcasecmp(func, "ends with") == 0);
+}
+
 // extracts both origin and radius from a distance filter
 // distance(n.location, origin) < radius
 bool extractOriginAndRadius(const FT_FilterNode *filter, SIValue *origin,
@@ -10,6 +10,13 @@
 
 bool isInFilter(const FT_FilterNode *filter);
 
+// returns true if filter is of the form: exp STARTS WITH exp
+bool isPrefixFilter(const FT_FilterNode *filter);
+
+// returns true if filter is of the form:
+// exp CONTAINS exp or exp ENDS WITH exp
+bool isSubstringFilter(const FT_FilterNode *filter);
+
 bool extractOriginAndRadius(const FT_FilterNode *filter, SIValue *origin,
 		SIValue *radius, char **point);
 
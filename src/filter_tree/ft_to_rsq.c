@@ -7,9 +7,11 @@
 #include "ft_to_rsq.h"
 #include "RG.h"
 #include "../util/arr.h"
+#include "../util/rmalloc.h"
 #include "filter_tree_utils.h"
 #include "../datatypes/point.h"
 #include "../datatypes/array.h"
+#include "../index/index.h"
 #include "../util/range/string_range.h"
 #include "../util/range/numeric_range.h"
 
@@ -144,6 +146,96 @@ static RSQNode *_FilterTreeToInQueryNode
 	return U;
 }
 
+// creates a RediSearch lexical range query out of given STARTS WITH filter
+// n.v STARTS WITH 'ab' is resolved as 'ab' <= n.v < 'ac'
+static RSQNode *_FilterTreeToPrefixQueryNode
+(
+	FT_FilterNode *filter,  // filter to convert
+	RSIndex *idx            // queried index
+) {
+	ASSERT(idx    != NULL);
+	ASSERT(filter != NULL);
+	ASSERT(isPrefixFilter(filter));
+
+	// extract both field name and prefix from expression
+	AR_ExpNode *exp = filter->exp.exp;
+
+	char *field;
+	bool attribute = AR_EXP_IsAttribute(exp->op.children[0], &field);
+	ASSERT(attribute == true);
+
+	SIValue prefix = AR_EXP_Evaluate(exp->op.children[1], NULL);
+	ASSERT(SI_TYPE(prefix) == T_STRING);
+
+	// upper bound is the smallest string greater than all strings starting
+	// with prefix, computed by incrementing the last byte which isn't 0xFF
+	size_t len = strlen(prefix.stringval);
+	char upper[len + 1];
+	memcpy(upper, prefix.stringval, len + 1);
+	while(len > 0 && (unsigned char)upper[len - 1] == 0xFF) len--;
+
+	RSQNode *root = RediSearch_CreateTagNode(idx, field);
+	RSQNode *child = NULL;
+
+	if(len == 0) {
+		// no upper bound
+		child = RediSearch_CreateTagLexRangeNode(idx, prefix.stringval,
+				RSLECRANGE_INF, 1, 0);
+	} else {
+		upper[len - 1]++;
+		upper[len] = '\0';
+		child = RediSearch_CreateTagLexRangeNode(idx, prefix.stringval, upper,
+				1, 0);
+	}
+
+	RediSearch_QueryNodeAddChild(root, child);
+
+	return root;
+}
+
+// creates a RediSearch query out of given CONTAINS / ENDS WITH filter
+// the query intersects the trigrams of the searched string
+// yielding a superset of the entities satisfying the filter
+static RSQNode *_FilterTreeToSubstringQueryNode
+(
+	FT_FilterNode *filter,  // filter to convert
+	RSIndex *idx            // queried index
+) {
+	ASSERT(idx    != NULL);
+	ASSERT(filter != NULL);
+	ASSERT(isSubstringFilter(filter));
+
+	// extract both field name and searched string from expression
+	AR_ExpNode *exp = filter->exp.exp;
+
+	char *field;
+	bool attribute = AR_EXP_IsAttribute(exp->op.children[0], &field);
+	ASSERT(attribute == true);
+
+	SIValue v = AR_EXP_Evaluate(exp->op.children[1], NULL);
+	ASSERT(SI_TYPE(v) == T_STRING);
+
+	char trigram_field[strlen(INDEX_FIELD_TRIGRAMS_PREFIX) + strlen(field) + 1];
+	sprintf(trigram_field, INDEX_FIELD_TRIGRAMS_PREFIX "%s", field);
+
+	char **trigrams = Index_Trigrams(v.stringval);
+	uint trigram_count = array_len(trigrams);
+	ASSERT(trigram_count > 0);
+
+	// an entity must contain each of the searched string trigrams
+	RSQNode *root = RediSearch_CreateIntersectNode(idx, false);
+	for(uint i = 0; i < trigram_count; i++) {
+		RSQNode *node = RediSearch_CreateTagNode(idx, trigram_field);
+		RSQNode *child = RediSearch_CreateTagTokenNode(idx, trigrams[i]);
+		RediSearch_QueryNodeAddChild(node, child);
+		RediSearch_QueryNodeAddChild(root, node);
+	}
+
+	array_free_cb(trigrams, rm_free);
+
+	return root;
+}
+
 // reduce filter into a range object
 // return true if filter was reduce, false otherwise
 static bool _predicateTreeToRange
@@ -523,6 +615,18 @@ static bool _FilterTreeToQueryNode
 		return true;
 	}
 
+	if(isPrefixFilter(tree)) {
+		*root = _FilterTreeToPrefixQueryNode(tree, idx);
+		return true;
+	}
+
+	if(isSubstringFilter(tree)) {
+		// the index narrows down candidates
+		// the filter is retained to verify each of them
+		*root = _FilterTreeToSubstringQueryNode(tree, idx);
+		return false;
+	}
+
 	FT_FilterNodeType t = tree->t;
 
 	if(t == FT_N_COND) {
@@ -0,0 +1,563 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "algebraic_view.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+AlgebraicView *AlgebraicView_New
+(
+	const char *name,
+	const int *labels,
+	const int *relations,
+	uint hops
+) {
+	ASSERT(name      != NULL);
+	ASSERT(labels    != NULL);
+	ASSERT(relations != NULL);
+	ASSERT(hops      > 0);
+
+	AlgebraicView *v = rm_calloc(1, sizeof(AlgebraicView));
+
+	v->name  = rm_strdup(name);
+	v->ops   = rm_malloc(sizeof(AlgebraicViewOperand) * (2 * hops + 1));
+	v->stale = true;
+
+	// L_0 * R_1 * L_1 * ... * R_hops * L_hops
+	// unlabeled nodes do not introduce an operand
+	for(uint i = 0; i <= hops; i++) {
+		if(labels[i] != GRAPH_NO_LABEL) {
+			v->ops[v->op_count].id       = labels[i];
+			v->ops[v->op_count].diagonal = true;
+			v->op_count++;
+		}
+
+		if(i == hops) break;
+
+		ASSERT(relations[i] >= 0);
+		v->ops[v->op_count].id       = relations[i];
+		v->ops[v->op_count].diagonal = false;
+		v->op_count++;
+	}
+
+	int res = pthread_mutex_init(&v->mutex, NULL);
+	ASSERT(res == 0);
+	UNUSED(res);
+
+	return v;
+}
+
+RG_Matrix AlgebraicView_OperandMatrix
+(
+	const AlgebraicView *v,
+	const Graph *g,
+	uint idx
+) {
+	ASSERT(v != NULL);
+	ASSERT(g != NULL);
+	ASSERT(idx < v->op_count);
+
+	const AlgebraicViewOperand *op = v->ops + idx;
+	return (op->diagonal) ? g->labels[op->id] : g->relations[op->id];
+}
+
+uint64_t AlgebraicView_EntryCount
+(
+	const AlgebraicView *v
+) {
+	ASSERT(v != NULL);
+
+	GrB_Index nvals = 0;
+	if(v->counts != NULL) GrB_Matrix_nvals(&nvals, v->counts);
+	return nvals;
+}
+
+// update V to reflect the structure of counts
+static void _AlgebraicView_RefreshStructure
+(
+	AlgebraicView *v
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Index n;
+	GrB_Matrix_nrows(&n, v->counts);
+
+	if(v->V == NULL) {
+		info = RG_Matrix_new(&v->V, GrB_BOOL, n, n);
+		ASSERT(info == GrB_SUCCESS);
+	} else {
+		info = RG_Matrix_resize(v->V, n, n);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	info = GrB_Matrix_apply(RG_MATRIX_M(v->V), NULL, NULL, GxB_ONE_BOOL,
+			v->counts, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_wait(RG_MATRIX_M(v->V), GrB_MATERIALIZE);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+// compute view from scratch
+// all operands are expected to be synced and of the same dimensions
+static void _AlgebraicView_Compute
+(
+	AlgebraicView *v,
+	const Graph *g
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Index n = Graph_RequiredMatrixDim(g);
+
+	if(v->counts == NULL) {
+		info = GrB_Matrix_new(&v->counts, GrB_UINT64, n, n);
+		ASSERT(info == GrB_SUCCESS);
+	} else {
+		info = GrB_Matrix_resize(v->counts, n, n);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// counts = 1(L_0) * R_1 * ...
+	RG_Matrix M = AlgebraicView_OperandMatrix(v, g, 0);
+	info = GrB_Matrix_apply(v->counts, NULL, NULL, GxB_ONE_UINT64,
+			RG_MATRIX_M(M), NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	for(uint i = 1; i < v->op_count; i++) {
+		M = AlgebraicView_OperandMatrix(v, g, i);
+		info = GrB_mxm(v->counts, NULL, NULL, GxB_PLUS_FIRST_UINT64, v->counts,
+				RG_MATRIX_M(M), NULL);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	_AlgebraicView_RefreshStructure(v);
+	v->stale = false;
+}
+
+// compute the number of paths passing through 'D' at each position
+// occupied by 'C', and accumulate them into the view's counts
+//
+// C transitions from state 'prev' to state 'next', all other operands
+// are at their current state, operands at positions preceding the
+// position being considered already hold C's next state while operands
+// following it still hold C's previous state
+static void _AlgebraicView_ApplyDelta
+(
+	AlgebraicView *v,
+	const Graph *g,
+	const RG_Matrix C,     // changed matrix
+	GrB_Matrix D,          // entries added to or removed from C
+	GrB_Matrix prev,       // C's previous state
+	GrB_Matrix next,       // C's next state
+	GrB_BinaryOp accum     // plus for additions, minus for deletions
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Index n;
+	GrB_Matrix T;
+	GrB_Matrix_nrows(&n, v->counts);
+
+	info = GrB_Matrix_new(&T, GrB_UINT64, n, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	for(uint p = 0; p < v->op_count; p++) {
+		if(AlgebraicView_OperandMatrix(v, g, p) != C) continue;
+
+		// T = 1(D)
+		info = GrB_Matrix_apply(T, NULL, NULL, GxB_ONE_UINT64, D, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// extend paths to the left, T = A * T
+		for(int q = (int)p - 1; q >= 0; q--) {
+			RG_Matrix M = AlgebraicView_OperandMatrix(v, g, q);
+			GrB_Matrix A = (M == C) ? next : RG_MATRIX_M(M);
+			info = GrB_mxm(T, NULL, NULL, GxB_PLUS_SECOND_UINT64, A, T, NULL);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		// extend paths to the right, T = T * A
+		for(uint q = p + 1; q < v->op_count; q++) {
+			RG_Matrix M = AlgebraicView_OperandMatrix(v, g, q);
+			GrB_Matrix A = (M == C) ? prev : RG_MATRIX_M(M);
+			info = GrB_mxm(T, NULL, NULL, GxB_PLUS_FIRST_UINT64, T, A, NULL);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		info = GrB_Matrix_eWiseAdd_BinaryOp(v->counts, NULL, NULL, accum,
+				v->counts, T, NULL);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	GrB_free(&T);
+}
+
+// try to lock all operands other than C
+// returns false if any of them is locked by another thread
+static bool _AlgebraicView_LockOperands
+(
+	const AlgebraicView *v,
+	const Graph *g,
+	const RG_Matrix C
+) {
+	for(uint i = 0; i < v->op_count; i++) {
+		RG_Matrix M = AlgebraicView_OperandMatrix(v, g, i);
+		if(M == C) continue;
+
+		// operand appears earlier in the chain
+		bool locked = false;
+		for(uint j = 0; j < i && !locked; j++) {
+			locked = (AlgebraicView_OperandMatrix(v, g, j) == M);
+		}
+		if(locked) continue;
+
+		if(!RG_Matrix_TryLock(M)) {
+			// release acquired locks
+			for(uint j = 0; j < i; j++) {
+				RG_Matrix L = AlgebraicView_OperandMatrix(v, g, j);
+				if(L == C) continue;
+				bool released = false;
+				for(uint k = 0; k < j && !released; k++) {
+					released = (AlgebraicView_OperandMatrix(v, g, k) == L);
+				}
+				if(!released) RG_Matrix_Unlock(L);
+			}
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void _AlgebraicView_UnlockOperands
+(
+	const AlgebraicView *v,
+	const Graph *g,
+	const RG_Matrix C
+) {
+	for(uint i = 0; i < v->op_count; i++) {
+		RG_Matrix M = AlgebraicView_OperandMatrix(v, g, i);
+		if(M == C) continue;
+
+		bool released = false;
+		for(uint j = 0; j < i && !released; j++) {
+			released = (AlgebraicView_OperandMatrix(v, g, j) == M);
+		}
+		if(!released) RG_Matrix_Unlock(M);
+	}
+}
+
+// checks if all operands share the view's dimensions
+static bool _AlgebraicView_DimensionsAgree
+(
+	const AlgebraicView *v,
+	const Graph *g
+) {
+	GrB_Index n;
+	GrB_Matrix_nrows(&n, v->counts);
+
+	for(uint i = 0; i < v->op_count; i++) {
+		GrB_Index nrows;
+		RG_Matrix M = AlgebraicView_OperandMatrix(v, g, i);
+		GrB_Matrix_nrows(&nrows, RG_MATRIX_M(M));
+		if(nrows != n) return false;
+	}
+
+	return true;
+}
+
+// update view with C's pending changes
+// C's pending deletions are merged first followed by its pending additions
+static void _AlgebraicView_Update
+(
+	AlgebraicView *v,
+	const Graph *g,
+	const RG_Matrix C
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	if(v->stale) return;
+
+	// other operands might be modified concurrently
+	// in which case the view is recomputed on its next use
+	if(!_AlgebraicView_LockOperands(v, g, C)) {
+		v->stale = true;
+		return;
+	}
+
+	// an operand was resized, recompute on next use
+	if(!_AlgebraicView_DimensionsAgree(v, g)) {
+		v->stale = true;
+		_AlgebraicView_UnlockOperands(v, g, C);
+		return;
+	}
+
+	GrB_Matrix M  = RG_MATRIX_M(C);
+	GrB_Matrix DP = RG_MATRIX_DELTA_PLUS(C);
+	GrB_Matrix DM = RG_MATRIX_DELTA_MINUS(C);
+
+	GrB_Index dp_nvals;
+	GrB_Index dm_nvals;
+	GrB_Matrix_nvals(&dp_nvals, DP);
+	GrB_Matrix_nvals(&dm_nvals, DM);
+
+	// C's state once deletions are merged
+	GrB_Matrix C_del = M;
+	if(dm_nvals > 0) {
+		info = GrB_Matrix_dup(&C_del, M);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_transpose(C_del, DM, GrB_NULL, C_del, GrB_DESC_RSCT0);
+		ASSERT(info == GrB_SUCCESS);
+
+		_AlgebraicView_ApplyDelta(v, g, C, DM, M, C_del, GrB_MINUS_UINT64);
+
+		// drop node pairs no longer connected
+		info = GrB_Matrix_select_UINT64(v->counts, NULL, NULL,
+				GrB_VALUENE_UINT64, v->counts, 0, NULL);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	if(dp_nvals > 0) {
+		// C's state once additions are merged
+		GrB_Matrix C_add;
+		info = GrB_Matrix_dup(&C_add, C_del);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_eWiseAdd_BinaryOp(C_add, NULL, NULL,
+				GrB_FIRST_UINT64, C_add, DP, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		_AlgebraicView_ApplyDelta(v, g, C, DP, C_del, C_add, GrB_PLUS_UINT64);
+
+		GrB_free(&C_add);
+	}
+
+	if(C_del != M) GrB_free(&C_del);
+
+	_AlgebraicView_UnlockOperands(v, g, C);
+
+	_AlgebraicView_RefreshStructure(v);
+}
+
+// invoked whenever a view operand merges its pending changes
+static void _AlgebraicView_OnSync
+(
+	const RG_Matrix C,
+	void *pdata
+) {
+	Graph *g = (Graph *)pdata;
+
+	uint view_count = array_len(g->views);
+	for(uint i = 0; i < view_count; i++) {
+		AlgebraicView *v = g->views[i];
+		for(uint j = 0; j < v->op_count; j++) {
+			if(AlgebraicView_OperandMatrix(v, g, j) != C) continue;
+
+			pthread_mutex_lock(&v->mutex);
+			_AlgebraicView_Update(v, g, C);
+			pthread_mutex_unlock(&v->mutex);
+			break;
+		}
+	}
+}
+
+// retrieve operand matrix, synchronizing it
+static RG_Matrix _AlgebraicView_SyncOperand
+(
+	const AlgebraicView *v,
+	const Graph *g,
+	uint idx
+) {
+	const AlgebraicViewOperand *op = v->ops + idx;
+	return (op->diagonal) ?
+		Graph_GetLabelMatrix(g, op->id) :
+		Graph_GetRelationMatrix(g, op->id, false);
+}
+
+RG_Matrix AlgebraicView_Matrix
+(
+	AlgebraicView *v,
+	Graph *g
+) {
+	ASSERT(v != NULL);
+	ASSERT(g != NULL);
+
+	// merging pending changes updates the view
+	for(uint i = 0; i < v->op_count; i++) {
+		RG_Matrix M = _AlgebraicView_SyncOperand(v, g, i);
+		if(!RG_Matrix_Synced(M)) return NULL;
+	}
+
+	// once synced, operands are not modified while the graph is read locked
+	pthread_mutex_lock(&v->mutex);
+
+	GrB_Index nrows;
+	GrB_Index n = Graph_RequiredMatrixDim(g);
+	GrB_Matrix_nrows(&nrows, v->counts);
+
+	if(v->stale) {
+		_AlgebraicView_Compute(v, g);
+	} else if(nrows != n) {
+		GrB_Info info = GrB_Matrix_resize(v->counts, n, n);
+		ASSERT(info == GrB_SUCCESS);
+		UNUSED(info);
+		_AlgebraicView_RefreshStructure(v);
+	}
+
+	pthread_mutex_unlock(&v->mutex);
+
+	return v->V;
+}
+
+void AlgebraicView_Free
+(
+	AlgebraicView *v
+) {
+	ASSERT(v != NULL);
+
+	if(v->V != NULL) RG_Matrix_free(&v->V);
+	if(v->counts != NULL) GrB_free(&v->counts);
+
+	pthread_mutex_destroy(&v->mutex);
+
+	rm_free(v->ops);
+	rm_free(v->name);
+	rm_free(v);
+}
+
+//------------------------------------------------------------------------------
+// graph view registry
+//------------------------------------------------------------------------------
+
+// checks if M is an operand of any graph view
+static bool _Graph_ViewOperand
+(
+	const Graph *g,
+	const RG_Matrix M
+) {
+	uint view_count = array_len(g->views);
+	for(uint i = 0; i < view_count; i++) {
+		AlgebraicView *v = g->views[i];
+		for(uint j = 0; j < v->op_count; j++) {
+			if(AlgebraicView_OperandMatrix(v, g, j) == M) return true;
+		}
+	}
+	return false;
+}
+
+void Graph_AddView
+(
+	Graph *g,
+	AlgebraicView *v
+) {
+	ASSERT(g != NULL);
+	ASSERT(v != NULL);
+	ASSERT(Graph_GetView(g, v->name) == NULL);
+
+	if(g->views == NULL) g->views = array_new(AlgebraicView *, 1);
+
+	// views track merged matrices, merge all pending changes
+	// from now on operands are kept fully synced
+	for(uint i = 0; i < v->op_count; i++) {
+		RG_Matrix M = _AlgebraicView_SyncOperand(v, g, i);
+		GrB_Info info = RG_Matrix_wait(M, true);
+		ASSERT(info == GrB_SUCCESS);
+		UNUSED(info);
+		RG_Matrix_setSyncCallback(M, _AlgebraicView_OnSync, g);
+	}
+
+	_AlgebraicView_Compute(v, g);
+	array_append(g->views, v);
+}
+
+bool Graph_RemoveView
+(
+	Graph *g,
+	const char *name
+) {
+	ASSERT(g    != NULL);
+	ASSERT(name != NULL);
+
+	uint view_count = array_len(g->views);
+	for(uint i = 0; i < view_count; i++) {
+		AlgebraicView *v = g->views[i];
+		if(strcmp(v->name, name) != 0) continue;
+
+		array_del(g->views, i);
+
+		// stop observing matrices no longer used by any view
+		for(uint j = 0; j < v->op_count; j++) {
+			RG_Matrix M = AlgebraicView_OperandMatrix(v, g, j);
+			if(!_Graph_ViewOperand(g, M)) {
+				RG_Matrix_setSyncCallback(M, NULL, NULL);
+			}
+		}
+
+		AlgebraicView_Free(v);
+		return true;
+	}
+
+	return false;
+}
+
+AlgebraicView *Graph_GetView
+(
+	const Graph *g,
+	const char *name
+) {
+	ASSERT(g    != NULL);
+	ASSERT(name != NULL);
+
+	uint view_count = array_len(g->views);
+	for(uint i = 0; i < view_count; i++) {
+		if(strcmp(g->views[i]->name, name) == 0) return g->views[i];
+	}
+
+	return NULL;
+}
+
+uint Graph_ViewCount
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+	return array_len(g->views);
+}
+
+AlgebraicView *Graph_GetViewAt
+(
+	const Graph *g,
+	uint idx
+) {
+	ASSERT(g != NULL);
+	ASSERT(idx < array_len(g->views));
+	return g->views[idx];
+}
+
+void Graph_FreeViews
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+
+	if(g->views == NULL) return;
+
+	uint view_count = array_len(g->views);
+	for(uint i = 0; i < view_count; i++) {
+		AlgebraicView *v = g->views[i];
+		for(uint j = 0; j < v->op_count; j++) {
+			RG_Matrix M = AlgebraicView_OperandMatrix(v, g, j);
+			RG_Matrix_setSyncCallback(M, NULL, NULL);
+		}
+		AlgebraicView_Free(v);
+	}
+
+	array_free(g->views);
+	g->views = NULL;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include "graph.h"
+
+// a materialized algebraic view stores the result of a chain of
+// label diagonals and relationship matrices, e.g.
+// L_Person * KNOWS * L_Person * WORKS_AT
+//
+// the view holds the number of paths connecting each pair of nodes
+// which allows it to be maintained incrementally as its operands
+// merge their pending additions and deletions
+
+// view operand
+typedef struct {
+	int id;         // label or relationship type id
+	bool diagonal;  // label diagonal or relationship matrix
+} AlgebraicViewOperand;
+
+struct AlgebraicView {
+	char *name;                     // view name
+	AlgebraicViewOperand *ops;      // chain operands
+	uint op_count;                  // number of operands
+	GrB_Matrix counts;              // number of paths between node pairs
+	RG_Matrix V;                    // structure of counts
+	volatile bool stale;            // view requires recomputation
+	pthread_mutex_t mutex;          // guards view maintenance
+};
+
+// create a new view
+// 'labels' holds hops + 1 label ids, GRAPH_NO_LABEL for unlabeled nodes
+// 'relations' holds hops relationship type ids
+AlgebraicView *AlgebraicView_New
+(
+	const char *name,      // view name
+	const int *labels,     // node labels
+	const int *relations,  // relationship types
+	uint hops              // number of relationships
+);
+
+// returns view's operand matrix at position 'idx'
+RG_Matrix AlgebraicView_OperandMatrix
+(
+	const AlgebraicView *v,  // view
+	const Graph *g,          // graph
+	uint idx                 // operand position
+);
+
+// returns the number of node pairs connected by the view
+uint64_t AlgebraicView_EntryCount
+(
+	const AlgebraicView *v
+);
+
+// returns the view's matrix, bringing it up to date
+// returns NULL if the view can't be used as some of its operands
+// hold changes which were not merged yet
+RG_Matrix AlgebraicView_Matrix
+(
+	AlgebraicView *v,  // view
+	Graph *g           // graph
+);
+
+// free view
+void AlgebraicView_Free
+(
+	AlgebraicView *v
+);
+
+//------------------------------------------------------------------------------
+// graph view registry
+//------------------------------------------------------------------------------
+
+// register view with graph and compute its content
+// expecting graph to be write locked
+void Graph_AddView
+(
+	Graph *g,
+	AlgebraicView *v
+);
+
+// removes and frees view, returns false if view doesn't exist
+// expecting graph to be write locked
+bool Graph_RemoveView
+(
+	Graph *g,
+	const char *name
+);
+
+// returns view by name, NULL if view doesn't exist
+AlgebraicView *Graph_GetView
+(
+	const Graph *g,
+	const char *name
+);
+
+// returns number of views
+uint Graph_ViewCount
+(
+	const Graph *g
+);
+
+// returns view at position 'idx'
+AlgebraicView *Graph_GetViewAt
+(
+	const Graph *g,
+	uint idx
+);
+
+// free all graph views
+void Graph_FreeViews
+(
+	Graph *g
+);
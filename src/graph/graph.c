@@ -6,8 +6,10 @@
 
 #include "RG.h"
 #include "graph.h"
+#include "algebraic_view.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
+#include "../configuration/config.h"
 #include "../util/datablock/oo_datablock.h"
 #include "../graph/rg_matrix/rg_matrix_iter.h"
 
@@ -1139,6 +1141,11 @@ int Graph_AddRelationType
 
 	RG_Matrix_new(&m, GrB_UINT64, n, n);
 
+	// new relationship types follow the configured transpose policy
+	uint64_t policy;
+	Config_Option_get(Config_TRANSPOSE_POLICY, &policy);
+	if(policy != RG_TRANSPOSE_ALWAYS) RG_Matrix_setTransposePolicy(m, policy);
+
 	array_append(g->relations, m);
 
 	// adding a new relationship type, update the stats structures to support it
@@ -1268,6 +1275,9 @@ static void _Graph_Free
 	AttributeSet *set;
 	DataBlockIterator *it;
 
+	// free views prior to their operands
+	Graph_FreeViews(g);
+
 	RG_Matrix_free(&g->_zero_matrix);
 	RG_Matrix_free(&g->adjacency_matrix);
 
@@ -40,6 +40,8 @@ typedef enum {
 
 // forward declaration of Graph struct
 typedef struct Graph Graph;
+// forward declaration of materialized algebraic view
+typedef struct AlgebraicView AlgebraicView;
 // typedef for synchronization function pointer
 typedef void (*SyncMatrixFunc)(const Graph *, RG_Matrix);
 
@@ -55,6 +57,7 @@ struct Graph {
 	bool _writelocked;                  // true if the read-write lock was acquired by a writer
 	SyncMatrixFunc SynchronizeMatrix;   // function pointer to matrix synchronization routine
 	GraphStatistics stats;              // graph related statistics
+	AlgebraicView **views;              // materialized algebraic views
 };
 
 // graph synchronization functions
@@ -0,0 +1,514 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "graph_memory.h"
+#include "algebraic_view.h"
+#include "../util/arr.h"
+#include "../datatypes/map.h"
+#include "../util/rmalloc.h"
+#include "rg_matrix/rg_matrix_iter.h"
+
+// number of row ranges sampled matrices are split into
+// spreading samples across the entire matrix
+#define SAMPLE_WINDOWS 16
+
+// number of bytes used by value's heap allocation
+static size_t _SIValue_MemoryUsage
+(
+	SIValue v
+) {
+	size_t size = 0;
+
+	switch(SI_TYPE(v)) {
+		case T_STRING:
+			if(v.allocation == M_SELF) size = strlen(v.stringval) + 1;
+			break;
+		case T_ARRAY:
+			size = array_sizeof(array_hdr(v.array));
+			for(uint i = 0; i < array_len(v.array); i++) {
+				size += _SIValue_MemoryUsage(v.array[i]);
+			}
+			break;
+		case T_MAP:
+			size = array_sizeof(array_hdr(v.map));
+			for(uint i = 0; i < array_len(v.map); i++) {
+				size += _SIValue_MemoryUsage(v.map[i].key);
+				size += _SIValue_MemoryUsage(v.map[i].val);
+			}
+			break;
+		default:
+			break;
+	}
+
+	return size;
+}
+
+// number of bytes used by the attribute set stored in a datablock slot
+static size_t _AttributeSet_MemoryUsage
+(
+	const AttributeSet *item  // datablock item, NULL if deleted
+) {
+	if(item == NULL || *item == NULL) return 0;
+
+	AttributeSet set = *item;
+	size_t size = sizeof(_AttributeSet) + set->attr_count * sizeof(Attribute);
+
+	for(ushort i = 0; i < set->attr_count; i++) {
+		size += _SIValue_MemoryUsage(set->attributes[i].value);
+	}
+
+	return size;
+}
+
+// number of bytes used by a matrix's maintained transpose and transposed view
+static size_t _TransposeMemoryUsage
+(
+	const RG_Matrix M
+) {
+	size_t size  = 0;
+	size_t t_size;
+
+	if(M->transposed != NULL) {
+		RG_Matrix_memoryUsage(&t_size, M->transposed);
+		size += t_size;
+	}
+
+	if(M->transposed_view != NULL) {
+		RG_Matrix_memoryUsage(&t_size, M->transposed_view);
+		size += t_size;
+	}
+
+	return size;
+}
+
+// number of bytes used by index
+static size_t _Index_MemoryUsage
+(
+	const Index *idx
+) {
+	if(idx == NULL) return 0;
+
+	size_t size = sizeof(Index);
+
+	if(idx->idx != NULL) {
+		RSIdxInfo info = { .version = RS_INFO_CURRENT_VERSION };
+		RediSearch_IndexInfo(idx->idx, &info);
+
+		size += info.docTableSize + info.sortablesSize + info.docTrieSize +
+			info.invertedSize + info.skipIndexesSize + info.scoreIndexesSize +
+			info.offsetVecsSize + info.termsSize;
+
+		RediSearch_IndexInfoFree(&info);
+	}
+
+	uint field_count = array_len(idx->fields);
+	for(uint i = 0; i < field_count; i++) {
+		const IndexField *f = idx->fields + i;
+		size += sizeof(IndexField) + strlen(f->name) + 1;
+		if(f->geo != NULL) size += GeoIndex_MemoryUsage(f->geo);
+	}
+
+	return size;
+}
+
+// visits matrix entries, either all of them or a sample drawn from
+// SAMPLE_WINDOWS row ranges evenly spread across the matrix
+// returns the ratio between the matrix entry count and the number of
+// visited entries, used to extrapolate sampled costs
+static double _Matrix_Visit
+(
+	RG_Matrix M,            // matrix to visit
+	bool multi_edge,        // UINT64 relationship matrix
+	uint64_t samples,       // max entries to visit, 0 for all entries
+	void (*visit)(uint64_t v, void *pdata),
+	void *pdata
+) {
+	GrB_Index nrows;
+	GrB_Index nvals;
+	RG_Matrix_nrows(&nrows, M);
+	RG_Matrix_nvals(&nvals, M);
+
+	if(nvals == 0 || nrows == 0) return 0;
+
+	bool     exact   = (samples == 0 || samples >= nvals);
+	uint     windows = exact ? 1 : SAMPLE_WINDOWS;
+	uint64_t quota   = exact ? nvals : (samples / windows);
+	if(quota == 0) quota = 1;
+
+	uint64_t visited = 0;
+	RG_MatrixTupleIter it = {0};
+	RG_MatrixTupleIter_attach(&it, M);
+
+	for(uint w = 0; w < windows; w++) {
+		GrB_Index start = (w * nrows) / windows;
+		GrB_Index end   = ((w + 1) * nrows) / windows;
+		if(start == end) continue;
+
+		RG_MatrixTupleIter_iterate_range(&it, start, end - 1);
+
+		GrB_Index row;
+		uint64_t  v;
+		bool      b;
+		for(uint64_t n = 0; n < quota; n++) {
+			GrB_Info info = multi_edge ?
+				RG_MatrixTupleIter_next_UINT64(&it, NULL, NULL, &v) :
+				RG_MatrixTupleIter_next_BOOL(&it, &row, NULL, &b);
+			if(info != GrB_SUCCESS) break;
+
+			// label matrices are diagonal, row is the node ID
+			visit(multi_edge ? v : row, pdata);
+			visited++;
+		}
+	}
+
+	RG_MatrixTupleIter_detach(&it);
+
+	return (visited == 0) ? 0 : (double)nvals / visited;
+}
+
+typedef struct {
+	const Graph *g;
+	SchemaMemoryUsage *usage;
+} _VisitCtx;
+
+// accumulates attribute set of node
+static void _VisitNode
+(
+	uint64_t id,
+	void *pdata
+) {
+	_VisitCtx *ctx = pdata;
+	ctx->usage->attributes +=
+		_AttributeSet_MemoryUsage(DataBlock_GetItem(ctx->g->nodes, id));
+}
+
+// accumulates attribute sets and multi-edge array of relation entry
+static void _VisitEdges
+(
+	uint64_t entry,
+	void *pdata
+) {
+	_VisitCtx *ctx = pdata;
+	DataBlock *edges = ctx->g->edges;
+
+	if(SINGLE_EDGE(entry)) {
+		ctx->usage->attributes +=
+			_AttributeSet_MemoryUsage(DataBlock_GetItem(edges, entry));
+		return;
+	}
+
+	EdgeID *ids = (EdgeID *)(CLEAR_MSB(entry));
+	uint n = array_len(ids);
+	ctx->usage->multi_edge += array_sizeof(array_hdr(ids));
+	for(uint i = 0; i < n; i++) {
+		ctx->usage->attributes +=
+			_AttributeSet_MemoryUsage(DataBlock_GetItem(edges, ids[i]));
+	}
+}
+
+// computes memory used by label or relationship type
+static void _Schema_MemoryUsage
+(
+	SchemaMemoryUsage *usage,  // [output] memory usage
+	GraphContext *gc,          // graph context
+	SchemaType t,              // label or relationship type
+	int id,                    // schema id
+	uint64_t samples           // max entries to sample, 0 for all
+) {
+	Graph *g = gc->g;
+	bool relation = (t == SCHEMA_EDGE);
+	RG_Matrix M = relation ?
+		Graph_GetRelationMatrix(g, id, false) :
+		Graph_GetLabelMatrix(g, id);
+
+	memset(usage, 0, sizeof(SchemaMemoryUsage));
+
+	usage->entities = relation ?
+		Graph_RelationEdgeCount(g, id) :
+		Graph_LabeledNodeCount(g, id);
+
+	RG_Matrix_memoryUsage(&usage->matrix, M);
+	usage->transposed = _TransposeMemoryUsage(M);
+
+	Schema *s = GraphContext_GetSchemaByID(gc, id, t);
+	if(s != NULL) {
+		usage->indices = _Index_MemoryUsage(s->index) +
+			_Index_MemoryUsage(s->fulltextIdx);
+	}
+
+	// attribute sets and multi-edge arrays
+	_VisitCtx ctx = { .g = g, .usage = usage };
+	double scale = _Matrix_Visit(M, relation, samples,
+			relation ? _VisitEdges : _VisitNode, &ctx);
+
+	usage->attributes = (size_t)(usage->attributes * scale);
+	usage->multi_edge = (size_t)(usage->multi_edge * scale);
+}
+
+// computes node attribute sets memory from the node datablock
+static size_t _NodeAttributes_MemoryUsage
+(
+	const Graph *g,
+	uint64_t samples  // max nodes to sample, 0 for all
+) {
+	const DataBlock *nodes = g->nodes;
+	uint64_t count = DataBlock_ItemCount(nodes);
+	uint64_t range = count + DataBlock_DeletedItemsCount(nodes);
+
+	if(count == 0) return 0;
+
+	// systematic sample, evenly spaced node IDs
+	uint64_t step = (samples == 0 || samples >= range) ? 1 : range / samples;
+
+	size_t   size    = 0;
+	uint64_t visited = 0;
+	for(uint64_t id = 0; id < range; id += step) {
+		AttributeSet *set = DataBlock_GetItem(nodes, id);
+		if(set == NULL) continue;  // deleted node
+
+		size += _AttributeSet_MemoryUsage(set);
+		visited++;
+	}
+
+	return (visited == 0) ? 0 : (size_t)((double)size * count / visited);
+}
+
+// number of bytes used by materialized algebraic views
+static size_t _Views_MemoryUsage
+(
+	const Graph *g
+) {
+	size_t size = 0;
+	uint n = Graph_ViewCount(g);
+
+	for(uint i = 0; i < n; i++) {
+		size_t m_size;
+		AlgebraicView *v = Graph_GetViewAt(g, i);
+
+		size += sizeof(AlgebraicView) + strlen(v->name) + 1 +
+			v->op_count * sizeof(AlgebraicViewOperand);
+
+		GxB_Matrix_memoryUsage(&m_size, v->counts);
+		size += m_size;
+		RG_Matrix_memoryUsage(&m_size, v->V);
+		size += m_size;
+	}
+
+	return size;
+}
+
+GraphMemoryUsage *GraphMemoryUsage_New
+(
+	GraphContext *gc,
+	bool exact,
+	uint64_t samples
+) {
+	ASSERT(gc != NULL);
+	ASSERT(exact || samples > 0);
+
+	Graph *g = gc->g;
+	if(exact) samples = 0;
+
+	GraphMemoryUsage *usage = rm_calloc(1, sizeof(GraphMemoryUsage));
+	usage->exact   = exact;
+	usage->samples = samples;
+
+	//--------------------------------------------------------------------------
+	// structural components
+	//--------------------------------------------------------------------------
+
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+	RG_Matrix_memoryUsage(&usage->adjacency, adj);
+	usage->adjacency += _TransposeMemoryUsage(adj);
+
+	RG_Matrix_memoryUsage(&usage->node_labels, Graph_GetNodeLabelMatrix(g));
+
+	usage->node_block = DataBlock_MemoryUsage(g->nodes);
+	usage->edge_block = DataBlock_MemoryUsage(g->edges);
+
+	//--------------------------------------------------------------------------
+	// per label and relationship type
+	//--------------------------------------------------------------------------
+
+	int label_count    = Graph_LabelTypeCount(g);
+	int relation_count = Graph_RelationTypeCount(g);
+
+	usage->labels    = array_new(SchemaMemoryUsage, label_count);
+	usage->relations = array_new(SchemaMemoryUsage, relation_count);
+
+	for(int i = 0; i < label_count; i++) {
+		SchemaMemoryUsage l;
+		_Schema_MemoryUsage(&l, gc, SCHEMA_NODE, i, samples);
+		array_append(usage->labels, l);
+
+		usage->label_matrices += l.matrix + l.transposed;
+		usage->indices        += l.indices;
+	}
+
+	for(int i = 0; i < relation_count; i++) {
+		SchemaMemoryUsage r;
+		_Schema_MemoryUsage(&r, gc, SCHEMA_EDGE, i, samples);
+		array_append(usage->relations, r);
+
+		// an edge is of a single relationship type
+		usage->relation_matrices += r.matrix + r.transposed;
+		usage->edge_attributes   += r.attributes;
+		usage->multi_edge        += r.multi_edge;
+		usage->indices           += r.indices;
+	}
+
+	// nodes may carry multiple labels or none at all
+	// count node attributes independently of labels
+	usage->node_attributes = _NodeAttributes_MemoryUsage(g, samples);
+
+	//--------------------------------------------------------------------------
+	// auxiliary structures
+	//--------------------------------------------------------------------------
+
+	usage->views      = _Views_MemoryUsage(g);
+	usage->plan_cache = Cache_MemoryUsage(GraphContext_GetCache(gc));
+	usage->slowlog    = SlowLog_MemoryUsage(GraphContext_GetSlowLog(gc));
+
+	usage->total = usage->adjacency + usage->node_labels + usage->node_block +
+		usage->edge_block + usage->node_attributes + usage->edge_attributes +
+		usage->label_matrices + usage->relation_matrices + usage->multi_edge +
+		usage->indices + usage->views + usage->plan_cache + usage->slowlog;
+
+	return usage;
+}
+
+static void _SchemaMemoryUsage_Reply
+(
+	const SchemaMemoryUsage *usage,
+	const char *name,
+	bool relation,
+	RedisModuleCtx *ctx
+) {
+	RedisModule_ReplyWithArray(ctx, relation ? 14 : 12);
+
+	RedisModule_ReplyWithStringBuffer(ctx, "name", 4);
+	RedisModule_ReplyWithStringBuffer(ctx, name, strlen(name));
+	RedisModule_ReplyWithStringBuffer(ctx, "entities", 8);
+	RedisModule_ReplyWithLongLong(ctx, usage->entities);
+	RedisModule_ReplyWithStringBuffer(ctx, "matrix", 6);
+	RedisModule_ReplyWithLongLong(ctx, usage->matrix);
+	RedisModule_ReplyWithStringBuffer(ctx, "transposed", 10);
+	RedisModule_ReplyWithLongLong(ctx, usage->transposed);
+	RedisModule_ReplyWithStringBuffer(ctx, "attributes", 10);
+	RedisModule_ReplyWithLongLong(ctx, usage->attributes);
+	if(relation) {
+		RedisModule_ReplyWithStringBuffer(ctx, "multi_edge", 10);
+		RedisModule_ReplyWithLongLong(ctx, usage->multi_edge);
+	}
+	RedisModule_ReplyWithStringBuffer(ctx, "indices", 7);
+	RedisModule_ReplyWithLongLong(ctx, usage->indices);
+}
+
+// replies with a flat array of alternating component names and byte counts
+// followed by per label and per relationship type breakdowns
+void GraphMemoryUsage_Reply
+(
+	const GraphMemoryUsage *usage,
+	const GraphContext *gc,
+	RedisModuleCtx *ctx
+) {
+	ASSERT(gc    != NULL);
+	ASSERT(ctx   != NULL);
+	ASSERT(usage != NULL);
+
+	uint label_count    = array_len(usage->labels);
+	uint relation_count = array_len(usage->relations);
+
+	RedisModule_ReplyWithArray(ctx, 36);
+
+	RedisModule_ReplyWithStringBuffer(ctx, "mode", 4);
+	if(usage->exact) RedisModule_ReplyWithStringBuffer(ctx, "exact", 5);
+	else RedisModule_ReplyWithStringBuffer(ctx, "sampled", 7);
+	RedisModule_ReplyWithStringBuffer(ctx, "samples", 7);
+	RedisModule_ReplyWithLongLong(ctx, usage->samples);
+	RedisModule_ReplyWithStringBuffer(ctx, "total", 5);
+	RedisModule_ReplyWithLongLong(ctx, usage->total);
+
+	RedisModule_ReplyWithStringBuffer(ctx, "adjacency_matrix", 16);
+	RedisModule_ReplyWithLongLong(ctx, usage->adjacency);
+	RedisModule_ReplyWithStringBuffer(ctx, "node_labels_matrix", 18);
+	RedisModule_ReplyWithLongLong(ctx, usage->node_labels);
+	RedisModule_ReplyWithStringBuffer(ctx, "label_matrices", 14);
+	RedisModule_ReplyWithLongLong(ctx, usage->label_matrices);
+	RedisModule_ReplyWithStringBuffer(ctx, "relation_matrices", 17);
+	RedisModule_ReplyWithLongLong(ctx, usage->relation_matrices);
+	RedisModule_ReplyWithStringBuffer(ctx, "node_block", 10);
+	RedisModule_ReplyWithLongLong(ctx, usage->node_block);
+	RedisModule_ReplyWithStringBuffer(ctx, "edge_block", 10);
+	RedisModule_ReplyWithLongLong(ctx, usage->edge_block);
+	RedisModule_ReplyWithStringBuffer(ctx, "node_attributes", 15);
+	RedisModule_ReplyWithLongLong(ctx, usage->node_attributes);
+	RedisModule_ReplyWithStringBuffer(ctx, "edge_attributes", 15);
+	RedisModule_ReplyWithLongLong(ctx, usage->edge_attributes);
+	RedisModule_ReplyWithStringBuffer(ctx, "multi_edge", 10);
+	RedisModule_ReplyWithLongLong(ctx, usage->multi_edge);
+	RedisModule_ReplyWithStringBuffer(ctx, "indices", 7);
+	RedisModule_ReplyWithLongLong(ctx, usage->indices);
+	RedisModule_ReplyWithStringBuffer(ctx, "views", 5);
+	RedisModule_ReplyWithLongLong(ctx, usage->views);
+	RedisModule_ReplyWithStringBuffer(ctx, "plan_cache", 10);
+	RedisModule_ReplyWithLongLong(ctx, usage->plan_cache);
+	RedisModule_ReplyWithStringBuffer(ctx, "slowlog", 7);
+	RedisModule_ReplyWithLongLong(ctx, usage->slowlog);
+
+	RedisModule_ReplyWithStringBuffer(ctx, "labels", 6);
+	RedisModule_ReplyWithArray(ctx, label_count);
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_NODE);
+		_SchemaMemoryUsage_Reply(usage->labels + i, s->name, false, ctx);
+	}
+
+	RedisModule_ReplyWithStringBuffer(ctx, "relationship_types", 18);
+	RedisModule_ReplyWithArray(ctx, relation_count);
+	for(uint i = 0; i < relation_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_EDGE);
+		_SchemaMemoryUsage_Reply(usage->relations + i, s->name, true, ctx);
+	}
+}
+
+void GraphMemoryUsage_Info
+(
+	const GraphMemoryUsage *usage,
+	const GraphContext *gc,
+	RedisModuleInfoCtx *ctx
+) {
+	ASSERT(gc    != NULL);
+	ASSERT(ctx   != NULL);
+	ASSERT(usage != NULL);
+
+	RedisModule_InfoBeginDictField(ctx, gc->graph_name);
+	RedisModule_InfoAddFieldULongLong(ctx, "total", usage->total);
+	RedisModule_InfoAddFieldULongLong(ctx, "matrices", usage->adjacency +
+			usage->node_labels + usage->label_matrices +
+			usage->relation_matrices);
+	RedisModule_InfoAddFieldULongLong(ctx, "datablocks", usage->node_block +
+			usage->edge_block);
+	RedisModule_InfoAddFieldULongLong(ctx, "attributes",
+			usage->node_attributes + usage->edge_attributes);
+	RedisModule_InfoAddFieldULongLong(ctx, "multi_edge", usage->multi_edge);
+	RedisModule_InfoAddFieldULongLong(ctx, "indices", usage->indices);
+	RedisModule_InfoAddFieldULongLong(ctx, "views", usage->views);
+	RedisModule_InfoAddFieldULongLong(ctx, "plan_cache", usage->plan_cache);
+	RedisModule_InfoAddFieldULongLong(ctx, "slowlog", usage->slowlog);
+	RedisModule_InfoEndDictField(ctx);
+}
+
+void GraphMemoryUsage_Free
+(
+	GraphMemoryUsage *usage
+) {
+	ASSERT(usage != NULL);
+
+	array_free(usage->labels);
+	array_free(usage->relations);
+	rm_free(usage);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "graphcontext.h"
+
+// default number of entities sampled per component in sampled mode
+#define GRAPH_MEMORY_DEFAULT_SAMPLES 1024
+
+// memory used by a single label or relationship type
+typedef struct {
+	uint64_t entities;     // number of entities
+	size_t matrix;         // label / relation matrix, pending changes included
+	size_t transposed;     // transposed matrix and on-demand transposed view
+	size_t attributes;     // attribute sets and their heap allocated values
+	size_t multi_edge;     // multi-edge arrays, relationship types only
+	size_t indices;        // exact-match, full-text and spatial indices
+} SchemaMemoryUsage;
+
+// graph memory breakdown
+// in sampled mode per entity costs, e.g. attributes and multi-edge arrays
+// are extrapolated from a sample of entities, structural costs such as
+// matrices and datablocks are always reported exactly
+struct GraphMemoryUsage {
+	bool exact;                    // exact or sampled report
+	uint64_t samples;              // max entities sampled per component
+	size_t adjacency;              // adjacency matrix and its transpose
+	size_t node_labels;            // node labels matrix
+	size_t node_block;             // node datablock
+	size_t edge_block;             // edge datablock
+	size_t node_attributes;        // node attribute sets
+	size_t edge_attributes;        // edge attribute sets
+	size_t label_matrices;         // sum of label matrices
+	size_t relation_matrices;      // sum of relation matrices and transposes
+	size_t multi_edge;             // multi-edge arrays
+	size_t indices;                // sum of indices
+	size_t views;                  // materialized algebraic views
+	size_t plan_cache;             // execution plan cache keys and entries
+	size_t slowlog;                // slowlog
+	size_t total;                  // sum of all components
+	SchemaMemoryUsage *labels;     // per label usage
+	SchemaMemoryUsage *relations;  // per relationship type usage
+};
+
+// computes graph memory usage
+// when 'exact' is false attribute and multi-edge costs are extrapolated
+// from up to 'samples' entities per component
+// expecting graph to be read locked
+GraphMemoryUsage *GraphMemoryUsage_New
+(
+	GraphContext *gc,  // graph to inspect
+	bool exact,        // inspect every entity
+	uint64_t samples   // number of entities to sample
+);
+
+// reply with memory usage
+void GraphMemoryUsage_Reply
+(
+	const GraphMemoryUsage *usage,  // memory usage
+	const GraphContext *gc,         // inspected graph
+	RedisModuleCtx *ctx             // redis context
+);
+
+// add memory usage to INFO as a dictionary field named after the graph
+void GraphMemoryUsage_Info
+(
+	const GraphMemoryUsage *usage,  // memory usage
+	const GraphContext *gc,         // inspected graph
+	RedisModuleInfoCtx *ctx         // info context
+);
+
+// free memory usage
+void GraphMemoryUsage_Free
+(
+	GraphMemoryUsage *usage
+);
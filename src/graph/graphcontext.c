@@ -7,6 +7,7 @@
 #include <sys/param.h>
 #include <pthread.h>
 #include "graphcontext.h"
+#include "graph_memory.h"
 #include "../RG.h"
 #include "../util/arr.h"
 #include "../util/uuid.h"
@@ -92,6 +93,11 @@ GraphContext *GraphContext_New
 	gc->string_mapping   = array_new(char *, 64);
 	gc->encoding_context = GraphEncodeContext_New();
 	gc->decoding_context = GraphDecodeContext_New();
+	gc->memory_usage     = NULL;  // memory usage wasn't computed
+	gc->rankings         = raxNew();
+	gc->pending_writes   = array_new(void *, 0);
+
+	gc->pending_writes_scheduled = false;
 
 	// read NODE_CREATION_BUFFER size from configuration
 	// this value controls how much extra room we're willing to spend for:
@@ -112,6 +118,12 @@ GraphContext *GraphContext_New
 	// initialize the read-write lock to protect access to the attributes rax
 	assert(pthread_rwlock_init(&gc->_attribute_rwlock, NULL) == 0);
 
+	// initialize the mutex to protect access to the rankings rax
+	assert(pthread_mutex_init(&gc->_rankings_mutex, NULL) == 0);
+
+	// initialize the mutex to protect access to the pending writes queue
+	assert(pthread_mutex_init(&gc->_pending_writes_mutex, NULL) == 0);
+
 	// build the execution plans cache
 	uint64_t cache_size;
 	Config_Option_get(Config_CACHE_SIZE, &cache_size);
@@ -572,6 +584,104 @@ Cache *GraphContext_GetCache(const GraphContext *gc) {
 	return gc->cache;
 }
 
+//------------------------------------------------------------------------------
+// Rankings API
+//------------------------------------------------------------------------------
+
+static void _GraphContext_FreeRanking(void *ranking) {
+	GrB_Vector v = (GrB_Vector)ranking;
+	GrB_Vector_free(&v);
+}
+
+GrB_Vector GraphContext_GetRanking(GraphContext *gc, const char *key) {
+	ASSERT(gc  != NULL);
+	ASSERT(key != NULL);
+
+	GrB_Vector ranking = NULL;
+
+	pthread_mutex_lock(&gc->_rankings_mutex);
+
+	void *v = raxFind(gc->rankings, (unsigned char *)key, strlen(key));
+	if(v != raxNotFound) {
+		GrB_Info info = GrB_Vector_dup(&ranking, (GrB_Vector)v);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	pthread_mutex_unlock(&gc->_rankings_mutex);
+
+	return ranking;
+}
+
+void GraphContext_SetRanking(GraphContext *gc, const char *key,
+		GrB_Vector ranking) {
+	ASSERT(gc      != NULL);
+	ASSERT(key     != NULL);
+	ASSERT(ranking != NULL);
+
+	void *old = NULL;
+
+	pthread_mutex_lock(&gc->_rankings_mutex);
+	raxInsert(gc->rankings, (unsigned char *)key, strlen(key), ranking, &old);
+	pthread_mutex_unlock(&gc->_rankings_mutex);
+
+	if(old != NULL) _GraphContext_FreeRanking(old);
+}
+
+//------------------------------------------------------------------------------
+// Pending writes API
+//------------------------------------------------------------------------------
+
+bool GraphContext_EnqueueWrite
+(
+	GraphContext *gc,
+	void *query
+) {
+	ASSERT(gc    != NULL);
+	ASSERT(query != NULL);
+
+	bool schedule;
+
+	pthread_mutex_lock(&gc->_pending_writes_mutex);
+
+	array_append(gc->pending_writes, query);
+	schedule = !gc->pending_writes_scheduled;
+	gc->pending_writes_scheduled = true;
+
+	pthread_mutex_unlock(&gc->_pending_writes_mutex);
+
+	return schedule;
+}
+
+uint GraphContext_DequeueWrites
+(
+	GraphContext *gc,
+	void **queries,
+	uint max
+) {
+	ASSERT(gc      != NULL);
+	ASSERT(queries != NULL);
+	ASSERT(max     > 0);
+
+	pthread_mutex_lock(&gc->_pending_writes_mutex);
+
+	uint n = MIN(max, array_len(gc->pending_writes));
+	if(n > 0) {
+		// dequeue in arrival order
+		uint len = array_len(gc->pending_writes);
+		memcpy(queries, gc->pending_writes, sizeof(void *) * n);
+		memmove(gc->pending_writes, gc->pending_writes + n,
+				sizeof(void *) * (len - n));
+		gc->pending_writes = array_trimm_len(gc->pending_writes, len - n);
+	} else {
+		// queue depleted, next enqueue schedules a new job
+		gc->pending_writes_scheduled = false;
+	}
+
+	pthread_mutex_unlock(&gc->_pending_writes_mutex);
+
+	return n;
+}
+
 //------------------------------------------------------------------------------
 // Free routine
 //------------------------------------------------------------------------------
@@ -651,6 +761,18 @@ static void _GraphContext_Free(void *arg) {
 
 	if(gc->cache) Cache_Free(gc->cache);
 
+	if(gc->memory_usage) GraphMemoryUsage_Free(gc->memory_usage);
+
+	if(gc->rankings) {
+		raxFreeWithCallback(gc->rankings, _GraphContext_FreeRanking);
+		pthread_mutex_destroy(&gc->_rankings_mutex);
+	}
+
+	// queued write queries hold a reference to the graph
+	ASSERT(array_len(gc->pending_writes) == 0);
+	array_free(gc->pending_writes);
+	pthread_mutex_destroy(&gc->_pending_writes_mutex);
+
 	GraphEncodeContext_Free(gc->encoding_context);
 	GraphDecodeContext_Free(gc->decoding_context);
 	rm_free(gc->graph_name);
@@ -15,6 +15,9 @@
 #include "../serializers/decode_context.h"
 #include "../util/cache/cache.h"
 
+// forward declaration of graph memory usage report
+typedef struct GraphMemoryUsage GraphMemoryUsage;
+
 // GraphContext holds refrences to various elements of a graph object
 // It is the value sitting behind a Redis graph key
 //
@@ -40,6 +43,12 @@ typedef struct {
 	GraphDecodeContext *decoding_context;   // decode context of the graph
 	Cache *cache;                           // global cache of execution plans
 	XXH32_hash_t version;                   // graph version
+	GraphMemoryUsage *memory_usage;         // last computed memory usage
+	rax *rankings;                          // persisted rankings, e.g. pagerank
+	pthread_mutex_t _rankings_mutex;        // guards access to rankings
+	void **pending_writes;                  // write queries awaiting group commit
+	bool pending_writes_scheduled;          // a group commit job is scheduled
+	pthread_mutex_t _pending_writes_mutex;  // guards access to pending writes
 } GraphContext;
 
 //------------------------------------------------------------------------------
@@ -302,3 +311,54 @@ Cache *GraphContext_GetCache
 	const GraphContext *gc
 );
 
+//------------------------------------------------------------------------------
+// Rankings API
+//------------------------------------------------------------------------------
+
+// rankings are FP32 vectors indexed by node ID, persisted between
+// invocations of ranking algorithms so later runs can start from them
+// rankings are kept in memory only, they're not replicated nor persisted
+// to RDB
+
+// retrieve a copy of the ranking stored under 'key'
+// returns NULL if no such ranking exists
+GrB_Vector GraphContext_GetRanking
+(
+	GraphContext *gc,
+	const char *key
+);
+
+// store ranking under 'key', replacing previous ranking
+// graph context takes ownership over 'ranking'
+void GraphContext_SetRanking
+(
+	GraphContext *gc,
+	const char *key,
+	GrB_Vector ranking
+);
+
+//------------------------------------------------------------------------------
+// Pending writes API
+//------------------------------------------------------------------------------
+
+// write queries delegated to the writer thread are queued per graph
+// a single writer job drains the queue in arrival order, committing
+// queued queries in groups
+
+// enqueue write query
+// returns true if the caller is expected to schedule a job draining the queue
+bool GraphContext_EnqueueWrite
+(
+	GraphContext *gc,
+	void *query
+);
+
+// dequeue up to 'max' write queries into 'queries'
+// returns the number of dequeued queries
+// once 0 is returned the draining job is considered done
+uint GraphContext_DequeueWrites
+(
+	GraphContext *gc,
+	void **queries,
+	uint max
+);
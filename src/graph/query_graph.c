@@ -250,6 +250,7 @@ QueryGraph *QueryGraph_New
 	qg->nodes = array_new(QGNode *, node_cap);
 	qg->edges = array_new(QGEdge *, edge_cap);
 	qg->unknown_reltype_ids = false;
+	qg->ref_count = 1;
 
 	return qg;
 }
@@ -564,6 +565,16 @@ QueryGraph *QueryGraph_Clone
 	return clone;
 }
 
+QueryGraph *QueryGraph_Share
+(
+	QueryGraph *qg
+) {
+	ASSERT(qg != NULL);
+
+	__atomic_fetch_add(&qg->ref_count, 1, __ATOMIC_RELAXED);
+	return qg;
+}
+
 QGNode *QueryGraph_RemoveNode
 (
 	QueryGraph *qg,
@@ -802,6 +813,9 @@ void QueryGraph_Free
 ) {
 	if(qg == NULL) return;
 
+	// graph is still in use by other owners
+	if(__atomic_sub_fetch(&qg->ref_count, 1, __ATOMIC_ACQ_REL) > 0) return;
+
 	// free QueryGraph nodes
 	uint nodeCount = QueryGraph_NodeCount(qg);
 	for(uint i = 0; i < nodeCount; i++) {
@@ -19,6 +19,7 @@ typedef struct {
 	QGNode **nodes;             // Nodes contained in QueryGraph
 	QGEdge **edges;             // Edges contained in QueryGraph
 	bool unknown_reltype_ids;   // Indicates if the query graph contains unknown relationship ids.
+	uint ref_count;             // Number of owners, e.g. execution plans sharing the graph.
 } QueryGraph;
 
 typedef enum {
@@ -70,6 +71,11 @@ void QueryGraph_ResolveUnknownRelIDs(QueryGraph *g);
 /* Performs deep copy of input query graph. */
 QueryGraph *QueryGraph_Clone(const QueryGraph *g);
 
+/* Adds an owner to the query graph and returns it.
+ * A shared query graph must not be structurally modified,
+ * it is freed once all of its owners freed it. */
+QueryGraph *QueryGraph_Share(QueryGraph *g);
+
 /* Remove given node from query graph. */
 QGNode *QueryGraph_RemoveNode(QueryGraph *g, QGNode *n);
 
@@ -93,6 +99,6 @@ GrB_Matrix QueryGraph_MatrixRepresentation(const QueryGraph *qg);
  * http://viz-js.com/ */
 void QueryGraph_Print(const QueryGraph *qg);
 
-/* Frees entire graph */
+/* Frees entire graph, once its last owner frees it */
 void QueryGraph_Free(QueryGraph *qg);
 
@@ -6,6 +6,7 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
+#include "../../util/thread_budget.h"
 
 GrB_Info RG_eWiseAdd                // C = A + B
 (
@@ -37,9 +38,10 @@ GrB_Info RG_eWiseAdd                // C = A + B
 
 	// TODO: check A, B and C are compatible
 
+	// frozen matrices keep M compressed, operate on an exported copy
 	GrB_Matrix_nvals(&DM_nvals, ADM);
 	GrB_Matrix_nvals(&DP_nvals, ADP);
-	if(DM_nvals > 0 || DP_nvals > 0) {
+	if(DM_nvals > 0 || DP_nvals > 0 || A->compressed != NULL) {
 		info = RG_Matrix_export(&_A, A);
 		ASSERT(info == GrB_SUCCESS);
 	} else {
@@ -48,7 +50,7 @@ GrB_Info RG_eWiseAdd                // C = A + B
 
 	GrB_Matrix_nvals(&DM_nvals, BDM);
 	GrB_Matrix_nvals(&DP_nvals, BDP);
-	if(DM_nvals > 0 || DP_nvals > 0) {
+	if(DM_nvals > 0 || DP_nvals > 0 || B->compressed != NULL) {
 		info = RG_Matrix_export(&_B, B);
 		ASSERT(info == GrB_SUCCESS);
 	} else {
@@ -59,7 +61,8 @@ GrB_Info RG_eWiseAdd                // C = A + B
 	// C = A + B
 	//--------------------------------------------------------------------------
 
-	info = GrB_Matrix_eWiseAdd_Semiring(_C, NULL, NULL, semiring, _A, _B, NULL);
+	info = GrB_Matrix_eWiseAdd_Semiring(_C, NULL, NULL, semiring, _A, _B,
+			ThreadBudget_Descriptor(NULL));
 	ASSERT(info == GrB_SUCCESS);
 
 	if(_A != AM) GrB_free(&_A);
@@ -0,0 +1,507 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rg_compress.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+
+// growable byte buffer holding encoded rows
+typedef struct {
+	uint8_t *data;  // encoded bytes
+	size_t size;    // number of bytes used
+	size_t cap;     // number of bytes allocated
+} _EncodeBuffer;
+
+static inline void _write_varint
+(
+	_EncodeBuffer *b,
+	uint64_t v
+) {
+	// a varint is at most 10 bytes long
+	if(b->size + 10 > b->cap) {
+		b->cap = (b->cap == 0) ? 4096 : b->cap * 2;
+		b->data = rm_realloc(b->data, b->cap);
+	}
+
+	uint8_t *p = b->data + b->size;
+	while(v >= 0x80) {
+		*p++ = (uint8_t)(v | 0x80);
+		v >>= 7;
+	}
+	*p++ = (uint8_t)v;
+
+	b->size = p - b->data;
+}
+
+static inline const uint8_t *_read_varint
+(
+	const uint8_t *p,
+	uint64_t *v
+) {
+	uint64_t x     = 0;
+	uint     shift = 0;
+
+	while(*p & 0x80) {
+		x |= (uint64_t)(*p & 0x7F) << shift;
+		shift += 7;
+		p++;
+	}
+	x |= (uint64_t)(*p) << shift;
+
+	*v = x;
+	return p + 1;
+}
+
+// skip over n varints without decoding them
+static inline const uint8_t *_skip_varints
+(
+	const uint8_t *p,
+	uint64_t n
+) {
+	while(n > 0) {
+		if(!(*p & 0x80)) n--;
+		p++;
+	}
+	return p;
+}
+
+static inline uint64_t _zigzag
+(
+	int64_t v
+) {
+	return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t _unzigzag
+(
+	uint64_t v
+) {
+	return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+// encode a relation value, single edge IDs are delta encoded against
+// the previous single edge ID within the row, multi-edge arrays are
+// kept as is and referenced by pointer
+static inline void _write_value
+(
+	_EncodeBuffer *b,
+	uint64_t x,
+	uint64_t *edge
+) {
+	if(SINGLE_EDGE(x)) {
+		_write_varint(b, _zigzag((int64_t)(x - *edge)) << 1);
+		*edge = x;
+	} else {
+		_write_varint(b, ((CLEAR_MSB(x)) << 1) | 1);
+	}
+}
+
+// advance cursor to the next encoded row
+static inline bool _next_row
+(
+	RG_CompressedCursor *cursor
+) {
+	if(cursor->pos >= cursor->end) return false;
+
+	uint64_t v;
+	cursor->pos = _read_varint(cursor->pos, &v);
+
+	// first row of a block is absolute
+	if(cursor->block_rows == 0) {
+		cursor->row = v;
+		cursor->block_rows = RG_COMPRESSED_BLOCK_ROWS;
+	} else {
+		cursor->row += v;
+	}
+	cursor->block_rows--;
+
+	cursor->pos  = _read_varint(cursor->pos, &cursor->remaining);
+	cursor->col  = 0;
+	cursor->edge = 0;
+
+	return true;
+}
+
+RG_CompressedMatrix *RG_CompressedMatrix_new
+(
+	GrB_Matrix M
+) {
+	ASSERT(M != NULL);
+
+	GrB_Info info;
+	GrB_Type t;
+	UNUSED(info);
+
+	RG_CompressedMatrix *C = rm_calloc(1, sizeof(RG_CompressedMatrix));
+
+	info = GxB_Matrix_type(&t, M);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_nvals(&C->nvals, M);
+	ASSERT(info == GrB_SUCCESS);
+
+	C->values = (t == GrB_UINT64);
+	if(C->nvals == 0) return C;
+
+	_EncodeBuffer  b          = {0};
+	GrB_Index      block_cap  = 0;
+	uint           block_rows = 0;
+	GrB_Index      prev_row   = 0;
+	GrB_Index     *cols       = array_new(GrB_Index, 16);
+	uint64_t      *vals       = array_new(uint64_t, 16);
+
+	struct GB_Iterator_opaque _it;
+	GxB_Iterator it = &_it;
+
+	info = GxB_rowIterator_attach(it, M, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_rowIterator_seekRow(it, 0);
+	while(info != GxB_EXHAUSTED) {
+		// empty row of a sparse matrix
+		if(info == GrB_NO_VALUE) {
+			info = GxB_rowIterator_nextRow(it);
+			continue;
+		}
+
+		GrB_Index row = GxB_rowIterator_getRowIndex(it);
+
+		// collect row, entries are sorted by column
+		array_clear(cols);
+		array_clear(vals);
+		do {
+			array_append(cols, GxB_rowIterator_getColIndex(it));
+			if(C->values) array_append(vals, GxB_Iterator_get_UINT64(it));
+		} while(GxB_rowIterator_nextCol(it) == GrB_SUCCESS);
+
+		// row header
+		if(block_rows == 0) {
+			// start a new block
+			if(C->nblocks == block_cap) {
+				block_cap = (block_cap == 0) ? 64 : block_cap * 2;
+				C->block_row = rm_realloc(C->block_row,
+						block_cap * sizeof(GrB_Index));
+				C->block_offset = rm_realloc(C->block_offset,
+						block_cap * sizeof(uint64_t));
+			}
+			C->block_row[C->nblocks]    = row;
+			C->block_offset[C->nblocks] = b.size;
+			C->nblocks++;
+
+			_write_varint(&b, row);
+			block_rows = RG_COMPRESSED_BLOCK_ROWS;
+		} else {
+			_write_varint(&b, row - prev_row);
+		}
+		block_rows--;
+		prev_row = row;
+
+		uint n = array_len(cols);
+		_write_varint(&b, n);
+
+		// row entries
+		GrB_Index col  = 0;
+		uint64_t  edge = 0;
+		for(uint i = 0; i < n; i++) {
+			_write_varint(&b, cols[i] - col);
+			col = cols[i];
+			if(C->values) _write_value(&b, vals[i], &edge);
+		}
+
+		info = GxB_rowIterator_nextRow(it);
+	}
+
+	array_free(cols);
+	array_free(vals);
+
+	// trim allocations
+	C->size         = b.size;
+	C->data         = rm_realloc(b.data, b.size);
+	C->block_row    = rm_realloc(C->block_row, C->nblocks * sizeof(GrB_Index));
+	C->block_offset = rm_realloc(C->block_offset,
+			C->nblocks * sizeof(uint64_t));
+
+	return C;
+}
+
+void RG_CompressedMatrix_decompress
+(
+	GrB_Matrix M,
+	const RG_CompressedMatrix *C
+) {
+	ASSERT(M != NULL);
+	ASSERT(C != NULL);
+
+	GrB_Info info;
+	UNUSED(info);
+
+#ifdef RG_DEBUG
+	GrB_Index nvals;
+	GrB_Matrix_nvals(&nvals, M);
+	ASSERT(nvals == 0);
+#endif
+
+	GrB_Index n = C->nvals;
+	if(n == 0) return;
+
+	GrB_Index *I = rm_malloc(n * sizeof(GrB_Index));
+	GrB_Index *J = rm_malloc(n * sizeof(GrB_Index));
+	uint64_t  *X = rm_malloc(n * sizeof(uint64_t));
+
+	RG_CompressedCursor cursor;
+	RG_CompressedCursor_attach(&cursor, C, 0, UINT64_MAX);
+
+	GrB_Index k = 0;
+	while(RG_CompressedCursor_next(&cursor, I + k, J + k, X + k)) k++;
+	ASSERT(k == n);
+
+	if(C->values) {
+		info = GrB_Matrix_build_UINT64(M, I, J, X, n, GrB_FIRST_UINT64);
+	} else {
+		info = GrB_Matrix_build_BOOL(M, I, J, (bool *)memset(X, 1, n), n,
+				GrB_FIRST_BOOL);
+	}
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_wait(M, GrB_MATERIALIZE);
+	ASSERT(info == GrB_SUCCESS);
+
+	rm_free(I);
+	rm_free(J);
+	rm_free(X);
+}
+
+bool RG_CompressedMatrix_extract
+(
+	const RG_CompressedMatrix *C,
+	GrB_Index i,
+	GrB_Index j,
+	uint64_t *x
+) {
+	ASSERT(C != NULL);
+
+	GrB_Index           col;
+	uint64_t            v;
+	RG_CompressedCursor cursor;
+
+	RG_CompressedCursor_attach(&cursor, C, i, i);
+	while(RG_CompressedCursor_next(&cursor, NULL, &col, &v)) {
+		if(col < j) continue;
+		if(col > j) break;
+
+		if(x) *x = v;
+		return true;
+	}
+
+	return false;
+}
+
+size_t RG_CompressedMatrix_memoryUsage
+(
+	const RG_CompressedMatrix *C
+) {
+	ASSERT(C != NULL);
+
+	return sizeof(RG_CompressedMatrix) + C->size +
+		C->nblocks * (sizeof(GrB_Index) + sizeof(uint64_t));
+}
+
+void RG_CompressedMatrix_free
+(
+	RG_CompressedMatrix **C,
+	bool free_multi_edge
+) {
+	ASSERT(C != NULL && *C != NULL);
+
+	RG_CompressedMatrix *c = *C;
+
+	if(free_multi_edge && c->values) {
+		uint64_t            x;
+		RG_CompressedCursor cursor;
+
+		RG_CompressedCursor_attach(&cursor, c, 0, UINT64_MAX);
+		while(RG_CompressedCursor_next(&cursor, NULL, NULL, &x)) {
+			if(!(SINGLE_EDGE(x))) array_free((uint64_t *)(CLEAR_MSB(x)));
+		}
+	}
+
+	if(c->data != NULL)         rm_free(c->data);
+	if(c->block_row != NULL)    rm_free(c->block_row);
+	if(c->block_offset != NULL) rm_free(c->block_offset);
+	rm_free(c);
+
+	*C = NULL;
+}
+
+void RG_CompressedCursor_attach
+(
+	RG_CompressedCursor *cursor,
+	const RG_CompressedMatrix *C,
+	GrB_Index min_row,
+	GrB_Index max_row
+) {
+	ASSERT(C      != NULL);
+	ASSERT(cursor != NULL);
+
+	cursor->C          = C;
+	cursor->max_row    = max_row;
+	cursor->remaining  = 0;
+	cursor->block_rows = 0;
+	cursor->depleted   = true;
+
+	if(C->nblocks == 0 || min_row > max_row) return;
+
+	// locate the last block starting at or before min_row
+	GrB_Index lo = 0;
+	GrB_Index hi = C->nblocks;
+	while(hi - lo > 1) {
+		GrB_Index mid = lo + (hi - lo) / 2;
+		if(C->block_row[mid] <= min_row) lo = mid;
+		else hi = mid;
+	}
+
+	cursor->pos      = C->data + C->block_offset[lo];
+	cursor->end      = C->data + C->size;
+	cursor->depleted = false;
+
+	// skip rows preceding min_row
+	uint64_t entry_varints = C->values ? 2 : 1;
+	while(_next_row(cursor)) {
+		if(cursor->row >= min_row) {
+			if(cursor->row <= max_row) return;
+			break;
+		}
+		cursor->pos = _skip_varints(cursor->pos,
+				cursor->remaining * entry_varints);
+	}
+
+	cursor->remaining = 0;
+	cursor->depleted  = true;
+}
+
+bool RG_CompressedCursor_next
+(
+	RG_CompressedCursor *cursor,
+	GrB_Index *row,
+	GrB_Index *col,
+	uint64_t *val
+) {
+	ASSERT(cursor != NULL);
+
+	if(cursor->depleted) return false;
+
+	while(cursor->remaining == 0) {
+		if(!_next_row(cursor) || cursor->row > cursor->max_row) {
+			cursor->depleted = true;
+			return false;
+		}
+	}
+
+	uint64_t v;
+	uint64_t x = true;
+
+	cursor->pos = _read_varint(cursor->pos, &v);
+	cursor->col += v;
+
+	if(cursor->C->values) {
+		cursor->pos = _read_varint(cursor->pos, &v);
+		if(v & 1) {
+			// multi-edge array
+			x = (SET_MSB(v >> 1));
+		} else {
+			cursor->edge += (uint64_t)_unzigzag(v >> 1);
+			x = cursor->edge;
+		}
+	}
+
+	cursor->remaining--;
+
+	if(row) *row = cursor->row;
+	if(col) *col = cursor->col;
+	if(val) *val = x;
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// RG_Matrix compressed storage
+//------------------------------------------------------------------------------
+
+void RG_Matrix_compressM
+(
+	RG_Matrix C
+) {
+	ASSERT(C != NULL);
+	ASSERT(C->compressed == NULL);
+	ASSERT(RG_Matrix_Synced(C));
+
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Matrix m = RG_MATRIX_M(C);
+
+	info = GrB_wait(m, GrB_MATERIALIZE);
+	ASSERT(info == GrB_SUCCESS);
+
+	C->compressed = RG_CompressedMatrix_new(m);
+
+	// multi-edge arrays are now owned by the compressed matrix
+	info = GrB_Matrix_clear(m);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+void RG_Matrix_decompressM
+(
+	RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
+	if(C->compressed == NULL) return;
+
+	RG_CompressedMatrix_decompress(RG_MATRIX_M(C), C->compressed);
+
+	// multi-edge arrays moved back to M
+	RG_CompressedMatrix_free(&C->compressed, false);
+}
+
+GrB_Info RG_Matrix_freeze
+(
+	RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
+	// views observing C or its transpose read their M directly
+	if(C->on_sync != NULL) return GrB_INVALID_VALUE;
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C) && C->transposed->on_sync != NULL) {
+		return GrB_INVALID_VALUE;
+	}
+
+	C->frozen = true;
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) C->transposed->frozen = true;
+
+	// merge pending changes, compressing M
+	return RG_Matrix_wait(C, true);
+}
+
+void RG_Matrix_thaw
+(
+	RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) RG_Matrix_thaw(C->transposed);
+
+	C->frozen = false;
+	RG_Matrix_decompressM(C);
+}
+
+bool RG_Matrix_isFrozen
+(
+	const RG_Matrix C
+) {
+	ASSERT(C != NULL);
+	return C->frozen;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "rg_matrix.h"
+
+// number of rows between consecutive skip index entries
+#define RG_COMPRESSED_BLOCK_ROWS 16
+
+// compressed, read only representation of a frozen matrix's M
+//
+// non-empty rows are encoded back to back, each row as:
+//   varint  row delta, absolute for the first row of a block
+//   varint  number of entries
+//   per entry:
+//     varint  column delta, the first column of a row is absolute
+//     varint  value, UINT64 matrices only
+//             zigzag(edge id - previous edge id) << 1 for a single edge
+//             (multi-edge array pointer << 1) | 1 for a multi-edge
+//
+// every RG_COMPRESSED_BLOCK_ROWS rows the skip index records the block's
+// first row and byte offset, a row is located by a binary search over
+// the skip index followed by a short scan within its block
+struct RG_CompressedMatrix {
+	bool values;             // entries carry UINT64 values
+	GrB_Index nvals;         // number of entries
+	GrB_Index nblocks;       // number of skip index entries
+	GrB_Index *block_row;    // first row of each block
+	uint64_t *block_offset;  // byte offset of each block
+	uint8_t *data;           // encoded rows
+	size_t size;             // number of encoded bytes
+};
+
+// cursor decoding a compressed matrix row by row
+typedef struct {
+	const RG_CompressedMatrix *C;  // matrix decoded
+	const uint8_t *pos;            // next byte to decode
+	const uint8_t *end;            // end of encoded rows
+	GrB_Index max_row;             // last row to decode
+	GrB_Index row;                 // current row
+	GrB_Index remaining;           // entries left in current row
+	GrB_Index col;                 // last decoded column
+	uint64_t edge;                 // last decoded single edge id
+	uint block_rows;               // rows left in current block
+	bool depleted;                 // no entries left within range
+} RG_CompressedCursor;
+
+// compress M, M is expected to be materialized
+RG_CompressedMatrix *RG_CompressedMatrix_new
+(
+	GrB_Matrix M
+);
+
+// populate the empty matrix M with C's entries
+void RG_CompressedMatrix_decompress
+(
+	GrB_Matrix M,
+	const RG_CompressedMatrix *C
+);
+
+// x = C(i,j), returns false if C(i,j) doesn't exist
+bool RG_CompressedMatrix_extract
+(
+	const RG_CompressedMatrix *C,
+	GrB_Index i,
+	GrB_Index j,
+	uint64_t *x
+);
+
+// number of bytes used by C
+size_t RG_CompressedMatrix_memoryUsage
+(
+	const RG_CompressedMatrix *C
+);
+
+// free C, multi-edge arrays are freed when 'free_multi_edge' is set
+// otherwise their ownership is expected to have moved to M
+void RG_CompressedMatrix_free
+(
+	RG_CompressedMatrix **C,
+	bool free_multi_edge
+);
+
+// position cursor at the first entry within rows [min_row, max_row]
+void RG_CompressedCursor_attach
+(
+	RG_CompressedCursor *cursor,
+	const RG_CompressedMatrix *C,
+	GrB_Index min_row,
+	GrB_Index max_row
+);
+
+// decode next entry, returns false once depleted
+bool RG_CompressedCursor_next
+(
+	RG_CompressedCursor *cursor,
+	GrB_Index *row,               // optional output row index
+	GrB_Index *col,               // optional output column index
+	uint64_t *val                 // optional output value
+);
+
+// move C's M into compressed form
+// C is expected to be synced
+void RG_Matrix_compressM
+(
+	RG_Matrix C
+);
+
+// restore C's M from its compressed form
+void RG_Matrix_decompressM
+(
+	RG_Matrix C
+);
@@ -7,6 +7,7 @@
 #include "RG.h"
 #include "rg_utils.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 #include "../../util/rmalloc.h"
 
 static void _copyMatrix
@@ -47,7 +48,12 @@ GrB_Info RG_Matrix_copy
 	GrB_Matrix  out_delta_plus   =  RG_MATRIX_DELTA_PLUS(C);
 	GrB_Matrix  out_delta_minus  =  RG_MATRIX_DELTA_MINUS(C);
 
-	_copyMatrix(in_m, out_m);
+	if(A->compressed != NULL) {
+		GrB_Matrix_clear(out_m);
+		RG_CompressedMatrix_decompress(out_m, A->compressed);
+	} else {
+		_copyMatrix(in_m, out_m);
+	}
 	_copyMatrix(in_delta_plus, out_delta_plus);
 	_copyMatrix(in_delta_minus, out_delta_minus);
 
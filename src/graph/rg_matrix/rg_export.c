@@ -6,6 +6,7 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 #include "../../util/rmalloc.h"
 
 GrB_Info RG_Matrix_export
@@ -60,7 +61,13 @@ GrB_Info RG_Matrix_export
 	// in case there are items to delete use mask otherwise just copy
 	GrB_Matrix mask = deletions ? dm : NULL;
 	GrB_Descriptor desc = deletions ? GrB_DESC_RSCT0 : GrB_DESC_RT0;
-	info = GrB_transpose(a, mask, NULL, m, desc);
+	if(C->compressed != NULL) {
+		// decompress M into 'a' and drop its deleted entries
+		RG_CompressedMatrix_decompress(a, C->compressed);
+		if(deletions) info = GrB_transpose(a, mask, NULL, a, desc);
+	} else {
+		info = GrB_transpose(a, mask, NULL, m, desc);
+	}
 	ASSERT(info == GrB_SUCCESS);
 	
 	//--------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 
 GrB_Info RG_Matrix_extractElement_BOOL     // x = A(i,j)
 (
@@ -36,6 +37,14 @@ GrB_Info RG_Matrix_extractElement_BOOL     // x = A(i,j)
 	}
 
 	// entry isn't marked for deletion, see if it exists in 'm'
+	if(A->compressed != NULL) {
+		if(!RG_CompressedMatrix_extract(A->compressed, i, j, NULL)) {
+			return GrB_NO_VALUE;
+		}
+		*x = true;
+		return GrB_SUCCESS;
+	}
+
 	info = GrB_Matrix_extractElement(x, m, i, j);
 	return info;
 }
@@ -69,6 +78,11 @@ GrB_Info RG_Matrix_extractElement_UINT64   // x = A(i,j)
 	}
 
 	// entry isn't marked for deletion, see if it exists in 'm'
+	if(A->compressed != NULL) {
+		return RG_CompressedMatrix_extract(A->compressed, i, j, x) ?
+			GrB_SUCCESS : GrB_NO_VALUE;
+	}
+
 	info = GrB_Matrix_extractElement(x, m, i, j);
 	return info;
 }
@@ -6,6 +6,7 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 #include "../entities/graph_entity.h"
@@ -42,10 +43,14 @@ void RG_Matrix_free
 	UNUSED(info);
 
 	if(RG_MATRIX_MAINTAIN_TRANSPOSE(M)) RG_Matrix_free(&M->transposed);
+	if(M->transposed_view != NULL) RG_Matrix_free(&M->transposed_view);
 
 	GrB_Matrix m  = RG_MATRIX_M(M);
 	GrB_Matrix dp = RG_MATRIX_DELTA_PLUS(M);
 
+	// free compressed M and the multi-edge arrays it owns
+	if(M->compressed != NULL) RG_CompressedMatrix_free(&M->compressed, true);
+
 	// free edges
 	if(RG_MATRIX_MULTI_EDGE(M)) {
 		if(free_multi_edge_op == NULL) {
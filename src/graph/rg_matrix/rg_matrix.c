@@ -6,6 +6,7 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 #include "../../util/rmalloc.h"
 
 void RG_Matrix_setDirty
@@ -15,14 +16,8 @@ void RG_Matrix_setDirty
 	ASSERT(C);
 	C->dirty = true;
 	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) C->transposed->dirty = true;
-}
-
-RG_Matrix RG_Matrix_getTranspose
-(
-	const RG_Matrix C
-) {
-	ASSERT(C != NULL);
-	return C->transposed;
+	// on-demand transposed view no longer reflects C
+	if(C->transposed_view != NULL) C->view_stale = true;
 }
 
 bool RG_Matrix_isDirty
@@ -69,6 +64,21 @@ bool RG_Matrix_Synced
 	return ((dp_nvals + dm_nvals) == 0);
 }
 
+void RG_Matrix_setSyncCallback
+(
+	RG_Matrix C,
+	RG_MatrixSyncCB cb,
+	void *pdata
+) {
+	ASSERT(C != NULL);
+
+	// observers read C's M directly
+	if(cb != NULL && C->frozen) RG_Matrix_thaw(C);
+
+	C->on_sync       = cb;
+	C->on_sync_pdata = pdata;
+}
+
 // locks the matrix
 void RG_Matrix_Lock
 (
@@ -78,6 +88,15 @@ void RG_Matrix_Lock
 	pthread_mutex_lock(&C->mutex);
 }
 
+// tries to lock the matrix, returns false if the matrix is already locked
+bool RG_Matrix_TryLock
+(
+	RG_Matrix C
+) {
+	ASSERT(C);
+	return (pthread_mutex_trylock(&C->mutex) == 0);
+}
+
 // unlocks the matrix
 void RG_Matrix_Unlock
 (
@@ -141,6 +160,8 @@ GrB_Info RG_Matrix_nvals    // get the number of entries in a matrix
 	info = GrB_Matrix_nvals(&dm_nvals, dm);
 	ASSERT(info == GrB_SUCCESS);
 
+	if(A->compressed != NULL) m_nvals += A->compressed->nvals;
+
 	*nvals = m_nvals + dp_nvals - dm_nvals;
 	return info;
 }
@@ -165,8 +186,11 @@ GrB_Info RG_Matrix_clear
 	info = GrB_Matrix_clear(m);
 	ASSERT(info == GrB_SUCCESS);
 
+	if(A->compressed != NULL) RG_CompressedMatrix_free(&A->compressed, true);
+
 	A->dirty = false;
 	if(RG_MATRIX_MAINTAIN_TRANSPOSE(A)) A->transposed->dirty = false;
+	if(A->transposed_view != NULL) A->view_stale = true;
 
 	return info;
 }
@@ -184,3 +208,31 @@ GrB_Info RG_Matrix_type
 	ASSERT(info == GrB_SUCCESS)
 	return info;
 }
+
+GrB_Info RG_Matrix_memoryUsage
+(
+	size_t *size,
+	const RG_Matrix A
+) {
+	ASSERT(A    != NULL);
+	ASSERT(size != NULL);
+
+	size_t   m_size  = 0;
+	size_t   dp_size = 0;
+	size_t   dm_size = 0;
+	GrB_Info info;
+
+	info = GxB_Matrix_memoryUsage(&m_size, RG_MATRIX_M(A));
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_memoryUsage(&dp_size, RG_MATRIX_DELTA_PLUS(A));
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_memoryUsage(&dm_size, RG_MATRIX_DELTA_MINUS(A));
+	ASSERT(info == GrB_SUCCESS);
+
+	if(A->compressed != NULL) {
+		m_size += RG_CompressedMatrix_memoryUsage(A->compressed);
+	}
+
+	*size = sizeof(_RG_Matrix) + m_size + dp_size + dm_size;
+	return info;
+}
@@ -13,6 +13,9 @@
 typedef struct _RG_Matrix _RG_Matrix;
 typedef _RG_Matrix *RG_Matrix;
 
+// compressed representation of a frozen matrix's M, see rg_compress.h
+typedef struct RG_CompressedMatrix RG_CompressedMatrix;
+
 // Mask with most significant bit on 10000...
 #define MSB_MASK (1UL << (sizeof(uint64_t) * 8 - 1))
 // Mask complement 01111...
@@ -32,7 +35,14 @@ typedef _RG_Matrix *RG_Matrix;
 #define RG_MATRIX_TDELTA_PLUS(C) (C)->transposed->delta_plus
 #define RG_MATRIX_TDELTA_MINUS(C) (C)->transposed->delta_minus
 
-#define RG_MATRIX_MAINTAIN_TRANSPOSE(C) (C)->transposed != NULL
+#define RG_MATRIX_MAINTAIN_TRANSPOSE(C) ((C)->transposed != NULL)
+
+// transposed matrix maintenance policy of a UINT64 (relationship) matrix
+typedef enum {
+	RG_TRANSPOSE_ALWAYS = 0,  // transpose is maintained alongside the matrix
+	RG_TRANSPOSE_LAZY   = 1,  // transpose is built on first use, then maintained
+	RG_TRANSPOSE_NEVER  = 2,  // transpose is built on demand, discarded by writes
+} RG_TransposePolicy;
 
 #define RG_MATRIX_MULTI_EDGE(M) __extension__({ \
 	GrB_Type t;                    \
@@ -124,12 +134,23 @@ typedef _RG_Matrix *RG_Matrix;
 //
 //------------------------------------------------------------------------------
 
+// invoked prior to merging C's pending changes into its underlying matrix
+// at which point RG_MATRIX_M(C) holds C's previous state
+typedef void (*RG_MatrixSyncCB)(const RG_Matrix C, void *pdata);
+
 struct _RG_Matrix {
 	volatile bool dirty;                // Indicates if matrix requires sync
 	GrB_Matrix matrix;                  // Underlying GrB_Matrix
 	GrB_Matrix delta_plus;              // Pending additions
 	GrB_Matrix delta_minus;             // Pending deletions
 	RG_Matrix transposed;               // Transposed matrix
+	RG_Matrix transposed_view;          // On-demand transpose, never maintained
+	volatile bool view_stale;           // Transposed view requires rebuild
+	RG_TransposePolicy policy;          // Transposed matrix maintenance policy
+	bool frozen;                        // M is kept compressed
+	RG_CompressedMatrix *compressed;    // Compressed M, NULL when thawed
+	RG_MatrixSyncCB on_sync;            // Sync callback
+	void *on_sync_pdata;                // Sync callback private data
 	pthread_mutex_t mutex;              // Lock
 };
 
@@ -142,11 +163,57 @@ GrB_Info RG_Matrix_new
 );
 
 // returns transposed matrix of C
+// depending on C's transpose policy the transpose might be built on demand
+// returns NULL if C doesn't support transposition
 RG_Matrix RG_Matrix_getTranspose
 (
 	const RG_Matrix C
 );
 
+// set C's transpose policy
+// dropping or building C's transposed matrix accordingly
+// C must not be accessed concurrently
+void RG_Matrix_setTransposePolicy
+(
+	RG_Matrix C,
+	RG_TransposePolicy policy
+);
+
+// returns C's transpose policy
+RG_TransposePolicy RG_Matrix_getTransposePolicy
+(
+	const RG_Matrix C
+);
+
+// freeze C, C's M is kept in a compressed read only form
+// new entries keep landing in delta-plus and deletions in delta-minus
+// both are compacted into the compressed form whenever C is synced
+// C's maintained transpose is frozen as well
+// returns GrB_INVALID_VALUE if C is observed by a sync callback
+GrB_Info RG_Matrix_freeze
+(
+	RG_Matrix C
+);
+
+// thaw C and its maintained transpose, decompressing their M
+void RG_Matrix_thaw
+(
+	RG_Matrix C
+);
+
+// returns true if C is frozen
+bool RG_Matrix_isFrozen
+(
+	const RG_Matrix C
+);
+
+// estimated number of bytes saved by not maintaining C's transpose
+// 0 if C's transpose is maintained
+size_t RG_Matrix_transposeMemorySaved
+(
+	const RG_Matrix C
+);
+
 // mark matrix as dirty
 void RG_Matrix_setDirty
 (
@@ -158,6 +225,17 @@ bool RG_Matrix_isDirty
 	const RG_Matrix C
 );
 
+// sets a callback to be invoked whenever C's pending changes are merged
+// a matrix with a sync callback is always fully synced by RG_Matrix_wait
+// and is thawed if frozen
+// pass NULL to remove the callback
+void RG_Matrix_setSyncCallback
+(
+	RG_Matrix C,         // matrix to observe
+	RG_MatrixSyncCB cb,  // callback
+	void *pdata          // callback private data
+);
+
 // checks if C is fully synced
 // a synced delta matrix does not contains any entries in
 // either its delta-plus and delta-minus internal matrices
@@ -172,6 +250,12 @@ void RG_Matrix_Lock
 	RG_Matrix C
 );
 
+// tries to lock the matrix, returns false if the matrix is already locked
+bool RG_Matrix_TryLock
+(
+	RG_Matrix C
+);
+
 // unlocks the matrix
 void RG_Matrix_Unlock
 (
@@ -312,6 +396,14 @@ GrB_Info RG_Matrix_type
 	RG_Matrix A
 );
 
+// number of bytes used by M, its compressed form, delta-plus and delta-minus
+// transposed matrices are not accounted for
+GrB_Info RG_Matrix_memoryUsage
+(
+	size_t *size,       // [output] number of bytes used
+	const RG_Matrix A   // matrix to query
+);
+
 void RG_Matrix_free
 (
 	RG_Matrix *C
@@ -47,6 +47,21 @@ static inline void _set_iter_range
 	}
 }
 
+// position compressed cursor at the iterator's range
+static inline void _set_cursor_range
+(
+	RG_MatrixTupleIter *iter
+) {
+	const RG_CompressedMatrix *C = iter->A->compressed ;
+
+	if(C == NULL) {
+		iter->c_it.depleted = true ;
+	} else {
+		RG_CompressedCursor_attach(&iter->c_it, C, iter->min_row,
+				iter->max_row) ;
+	}
+}
+
 static inline void _init_iter
 (
 	GxB_Iterator it,
@@ -81,6 +96,7 @@ GrB_Info RG_MatrixTupleIter_iterate_row
 	iter->max_row = rowIdx ;
 
 	_set_iter_range(&iter->m_it, iter->min_row, iter->max_row, &iter->m_depleted) ;
+	_set_cursor_range(iter) ;
 	_set_iter_range(&iter->dp_it, iter->min_row, iter->max_row, &iter->dp_depleted) ;
 
 	return GrB_SUCCESS ;
@@ -98,6 +114,7 @@ GrB_Info RG_MatrixTupleIter_iterate_range
 	iter->max_row = endRowIdx ;
 
 	_set_iter_range(&iter->m_it, iter->min_row, iter->max_row, &iter->m_depleted) ;
+	_set_cursor_range(iter) ;
 	_set_iter_range(&iter->dp_it, iter->min_row, iter->max_row, &iter->dp_depleted) ;
 
 	return GrB_SUCCESS ;
@@ -166,6 +183,40 @@ static GrB_Info _next_m_iter_bool
 	return GrB_SUCCESS ;
 }
 
+// iterate over compressed M matrix
+static GrB_Info _next_compressed_iter
+(
+	RG_MatrixTupleIter *iter,  // iterator scanning compressed M
+	const GrB_Matrix DM,       // delta-minus, masked entries
+	GrB_Index *row,            // optional extracted row index
+	GrB_Index *col,            // optional extracted column index
+	uint64_t *val              // optional extracted value
+) {
+	ASSERT(iter != NULL) ;
+	ASSERT(DM   != NULL) ;
+
+	GrB_Index  _row ;
+	GrB_Index  _col ;
+	uint64_t   _val ;
+
+	do {
+		// cursor depleted, return
+		if(!RG_CompressedCursor_next(&iter->c_it, &_row, &_col, &_val)) {
+			return GrB_NO_VALUE ;
+		}
+
+		bool x ;
+		GrB_Info delete_info = GrB_Matrix_extractElement_BOOL(&x, DM, _row, _col) ;
+		if(delete_info == GrB_NO_VALUE) break ; // entry isn't deleted, return
+	} while (true) ;
+
+	if(row) *row = _row ;
+	if(col) *col = _col ;
+	if(val) *val = _val ;
+
+	return GrB_SUCCESS ;
+}
+
 // advance iterator
 GrB_Info RG_MatrixTupleIter_next_BOOL
 (
@@ -185,6 +236,14 @@ GrB_Info RG_MatrixTupleIter_next_BOOL
 		if(info == GrB_SUCCESS) return GrB_SUCCESS ;
 	}
 
+	if(!iter->c_it.depleted) {
+		info = _next_compressed_iter(iter, DM, row, col, NULL) ;
+		if(info == GrB_SUCCESS) {
+			if(val) *val = true ;
+			return GrB_SUCCESS ;
+		}
+	}
+
 	if(iter->dp_depleted) {
 		return GxB_EXHAUSTED ;
 	}
@@ -259,6 +318,11 @@ GrB_Info RG_MatrixTupleIter_next_UINT64
 		if(info == GrB_SUCCESS) return GrB_SUCCESS ;
 	}
 
+	if(!iter->c_it.depleted) {
+		info = _next_compressed_iter(iter, DM, row, col, val) ;
+		if(info == GrB_SUCCESS) return GrB_SUCCESS ;
+	}
+
 	if(iter->dp_depleted) {
 		return GxB_EXHAUSTED ;
 	}
@@ -283,6 +347,7 @@ GrB_Info RG_MatrixTupleIter_reset
 	if(IS_DETACHED(iter)) return GrB_NULL_POINTER ;
 
 	_set_iter_range(&iter->m_it, iter->min_row, iter->max_row, &iter->m_depleted) ;
+	_set_cursor_range(iter) ;
 	_set_iter_range(&iter->dp_it, iter->min_row, iter->max_row, &iter->dp_depleted) ;
 
 	return info ;
@@ -328,6 +393,7 @@ GrB_Info RG_MatrixTupleIter_AttachRange
 	iter->max_row = max_row ;
 
 	_init_iter(&iter->m_it, M, iter->min_row, iter->max_row, &iter->m_depleted) ;
+	_set_cursor_range(iter) ;
 	_init_iter(&iter->dp_it, DP, iter->min_row, iter->max_row, &iter->dp_depleted) ;
 
 	return GrB_SUCCESS ;
@@ -343,6 +409,7 @@ GrB_Info RG_MatrixTupleIter_detach
 	iter->A           = NULL ;
 	iter->m_depleted  = true ;
 	iter->dp_depleted = true ;
+	iter->c_it.depleted = true ;
 
 	return GrB_SUCCESS ;
 }
@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include "./rg_matrix.h"
+#include "./rg_compress.h"
 #include "../../deps/GraphBLAS/Include/GraphBLAS.h"
 
 #define RG_ITER_MIN_ROW 0
@@ -20,6 +21,7 @@ typedef struct
 	RG_Matrix A;                      // matrix iterated
 	struct GB_Iterator_opaque m_it;   // internal m iterator
 	struct GB_Iterator_opaque dp_it;  // internal delta plus iterator
+	RG_CompressedCursor c_it;         // compressed m cursor, frozen matrices
 	bool m_depleted;                  // is m iterator depleted
 	bool dp_depleted;                 // is dp iterator depleted
 	GrB_Index min_row;                // minimum row for iteration
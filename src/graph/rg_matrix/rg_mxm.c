@@ -6,6 +6,95 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+#include "../../util/thread_budget.h"
+
+// decompress the rows of B's M referenced by A's entries
+// rows no entry of A refers to are left empty, such that memory is bound by
+// the entries reachable from A rather than by B's dimensions
+static GrB_Matrix _decompress_referenced_rows
+(
+	const GrB_Matrix A,  // first input:  matrix A
+	const RG_Matrix B    // second input: matrix B, compressed
+) {
+	ASSERT(A != NULL);
+	ASSERT(B != NULL);
+	ASSERT(B->compressed != NULL);
+
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Type   t;
+	GrB_Index  n;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Vector rows;
+	GrB_Matrix _B;
+
+	const RG_CompressedMatrix *C = B->compressed;
+
+	RG_Matrix_nrows(&nrows, B);
+	RG_Matrix_ncols(&ncols, B);
+
+	// rows[k] is set if any entry A(i,k) exists
+	info = GrB_Vector_new(&rows, GrB_BOOL, nrows);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_reduce_Monoid(rows, NULL, NULL, GxB_ANY_BOOL_MONOID, A,
+			ThreadBudget_Descriptor(GrB_DESC_T0));
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_nvals(&n, rows);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Index *K = rm_malloc(n * sizeof(GrB_Index));
+	info = GrB_Vector_extractTuples_BOOL(K, NULL, &n, rows);
+	ASSERT(info == GrB_SUCCESS);
+	GrB_free(&rows);
+
+	GrB_Index *I = array_new(GrB_Index, 0);
+	GrB_Index *J = array_new(GrB_Index, 0);
+	uint64_t  *X = array_new(uint64_t, 0);
+
+	// decode referenced rows
+	GrB_Index i;
+	GrB_Index j;
+	uint64_t  x;
+	RG_CompressedCursor cursor;
+	for(GrB_Index k = 0; k < n; k++) {
+		RG_CompressedCursor_attach(&cursor, C, K[k], K[k]);
+		while(RG_CompressedCursor_next(&cursor, &i, &j, &x)) {
+			array_append(I, i);
+			array_append(J, j);
+			array_append(X, x);
+		}
+	}
+	rm_free(K);
+
+	info = GxB_Matrix_type(&t, RG_MATRIX_M(B));
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&_B, t, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	// rows are decoded once, entries are unique
+	n = array_len(I);
+	if(C->values) {
+		info = GrB_Matrix_build_UINT64(_B, I, J, X, n, GrB_FIRST_UINT64);
+	} else {
+		info = GrB_Matrix_build_BOOL(_B, I, J, (bool *)memset(X, 1, n), n,
+				GrB_FIRST_BOOL);
+	}
+	ASSERT(info == GrB_SUCCESS);
+
+	array_free(I);
+	array_free(J);
+	array_free(X);
+
+	return _B;
+}
 
 GrB_Info RG_mxm                     // C = A * B
 (
@@ -22,6 +111,9 @@ GrB_Info RG_mxm                     // C = A * B
 	// A * B
 	// where A is fully synced!
 	//
+	// frozen A is exported, of frozen B only the rows referenced by A
+	// are decompressed
+	//
 	// it is possible for either 'delta-plus' or 'delta-minus' to be empty
 	// this operation performs: A * B by computing:
 	// (A * (M + 'delta-plus'))<!'delta-minus'>
@@ -51,12 +143,19 @@ GrB_Info RG_mxm                     // C = A * B
 	GrB_Matrix_nvals(&dp_nvals, dp);
 	GrB_Matrix_nvals(&dm_nvals, dm);
 
+	// A is synced, exporting merely decompresses its M
+	if(A->compressed != NULL) {
+		info = RG_Matrix_export(&_A, A);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
 	if(dm_nvals > 0) {
 		// compute A * 'delta-minus'
 		info = GrB_Matrix_new(&mask, GrB_BOOL, nrows, ncols);
 		ASSERT(info == GrB_SUCCESS);
 
-		info = GrB_mxm(mask, NULL, NULL, GxB_ANY_PAIR_BOOL, _A, dm, NULL);
+		info = GrB_mxm(mask, NULL, NULL, GxB_ANY_PAIR_BOOL, _A, dm,
+				ThreadBudget_Descriptor(NULL));
 		ASSERT(info == GrB_SUCCESS);
 
 		// update 'dm_nvals'
@@ -69,7 +168,8 @@ GrB_Info RG_mxm                     // C = A * B
 		info = GrB_Matrix_new(&accum, GrB_BOOL, nrows, ncols);
 		ASSERT(info == GrB_SUCCESS);
 
-		info = GrB_mxm(accum, NULL, NULL, semiring, _A, dp, NULL);
+		info = GrB_mxm(accum, NULL, NULL, semiring, _A, dp,
+				ThreadBudget_Descriptor(NULL));
 		ASSERT(info == GrB_SUCCESS);
 
 		// update 'dp_nvals'
@@ -88,18 +188,26 @@ GrB_Info RG_mxm                     // C = A * B
 		mask = NULL;
 	}
 
+	// compressed B, decompress the rows of its M referenced by A
+	if(B->compressed != NULL) _B = _decompress_referenced_rows(_A, B);
+
 	// compute (A * B)<!mask>
-	info = GrB_mxm(_C, mask, NULL, semiring, _A, _B, desc);
+	// restrict number of threads to the query's budget
+	info = GrB_mxm(_C, mask, NULL, semiring, _A, _B,
+			ThreadBudget_Descriptor(desc));
 	ASSERT(info == GrB_SUCCESS);
 
 	if(additions) {
-		info = GrB_eWiseAdd(_C, NULL, NULL, GxB_ANY_PAIR_BOOL, _C, accum, NULL);
+		info = GrB_eWiseAdd(_C, NULL, NULL, GxB_ANY_PAIR_BOOL, _C, accum,
+				ThreadBudget_Descriptor(NULL));
 		ASSERT(info == GrB_SUCCESS);
 	}
 
 	// clean up
 	if(mask)  GrB_free(&mask);
 	if(accum) GrB_free(&accum);
+	if(_A != RG_MATRIX_M(A)) GrB_free(&_A);
+	if(_B != RG_MATRIX_M(B)) GrB_free(&_B);
 
 	return info;
 }
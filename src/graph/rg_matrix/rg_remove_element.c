@@ -7,6 +7,7 @@
 #include "RG.h"
 #include "rg_matrix.h"
 #include "rg_utils.h"
+#include "rg_compress.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 
@@ -43,7 +44,8 @@ GrB_Info RG_Matrix_removeElement_BOOL
 	}
 
 	info = GrB_Matrix_extractElement(&m_x, m, i, j);
-	in_m = (info == GrB_SUCCESS);
+	in_m = (info == GrB_SUCCESS) || (C->compressed != NULL &&
+		RG_CompressedMatrix_extract(C->compressed, i, j, NULL));
 
 	info = GrB_Matrix_extractElement(&dp_x, dp, i, j);
 	in_dp = (info == GrB_SUCCESS);
@@ -121,7 +123,8 @@ GrB_Info RG_Matrix_removeElement_UINT64
 	}
 
 	info = GrB_Matrix_extractElement(&m_x, m, i, j);
-	in_m = (info == GrB_SUCCESS);
+	in_m = (info == GrB_SUCCESS) || (C->compressed != NULL &&
+		RG_CompressedMatrix_extract(C->compressed, i, j, &m_x));
 
 	info = GrB_Matrix_extractElement(&dp_x, dp, i, j);
 	in_dp = (info == GrB_SUCCESS);
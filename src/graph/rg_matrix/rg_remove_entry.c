@@ -7,6 +7,7 @@
 #include "RG.h"
 #include "rg_utils.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 
@@ -104,7 +105,8 @@ GrB_Info RG_Matrix_removeEntry
 	// entry should exists in either delta-plus or main
 	// locate entry
 	info = GrB_Matrix_extractElement(&m_x, m, i, j);
-	in_m = (info == GrB_SUCCESS);
+	in_m = (info == GrB_SUCCESS) || (C->compressed != NULL &&
+		RG_CompressedMatrix_extract(C->compressed, i, j, &m_x));
 
 	info = GrB_Matrix_extractElement(&dp_x, dp, i, j);
 	in_dp = (info == GrB_SUCCESS);
@@ -128,12 +130,20 @@ GrB_Info RG_Matrix_removeEntry
 	//--------------------------------------------------------------------------
 
 	if(in_m) {
+		// multi-edge arrays of a compressed M can't be updated in place
+		// decompress M, it is compressed again once C is synced
+		if(!(SINGLE_EDGE(m_x)) && C->compressed != NULL) {
+			RG_Matrix_decompressM(C);
+		}
+
 		if(SINGLE_EDGE(m_x)) {
 			// mark deletion in delta minus
 			info = GrB_Matrix_setElement(dm, true, i, j);
 			ASSERT(info == GrB_SUCCESS);
-			info = RG_Matrix_removeElement_BOOL(C->transposed, j, i);
-			ASSERT(info == GrB_SUCCESS)
+			if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+				info = RG_Matrix_removeElement_BOOL(C->transposed, j, i);
+				ASSERT(info == GrB_SUCCESS)
+			}
 			RG_Matrix_setDirty(C);
 		} else {
 			info = _removeElementMultiVal(m, i, j, v);
@@ -149,8 +159,10 @@ GrB_Info RG_Matrix_removeEntry
 		if(SINGLE_EDGE(dp_x)) {
 			info = GrB_Matrix_removeElement(dp, i, j);
 			ASSERT(info == GrB_SUCCESS);
-			info = RG_Matrix_removeElement_BOOL(C->transposed, j, i);
-			ASSERT(info == GrB_SUCCESS)
+			if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+				info = RG_Matrix_removeElement_BOOL(C->transposed, j, i);
+				ASSERT(info == GrB_SUCCESS)
+			}
 			RG_Matrix_setDirty(C);
 		} else {
 			info = _removeElementMultiVal(dp, i, j, v);
@@ -21,6 +21,9 @@ GrB_Info RG_Matrix_resize       // change the size of a matrix
 		ASSERT(info == GrB_SUCCESS);
 	}
 
+	// transposed view is rebuilt with the new dimensions
+	if(C->transposed_view != NULL) C->view_stale = true;
+
 	GrB_Matrix  m            =  RG_MATRIX_M(C);
 	GrB_Matrix  delta_plus   =  RG_MATRIX_DELTA_PLUS(C);
 	GrB_Matrix  delta_minus  =  RG_MATRIX_DELTA_MINUS(C);
@@ -7,6 +7,7 @@
 #include "RG.h"
 #include "rg_utils.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 
 GrB_Info RG_Matrix_setElement_BOOL      // C (i,j) = x
 (
@@ -42,7 +43,8 @@ GrB_Info RG_Matrix_setElement_BOOL      // C (i,j) = x
 		ASSERT(info == GrB_SUCCESS);
 	} else {
 		info = GrB_Matrix_extractElement(&v, m, i, j);
-		already_allocated = (info == GrB_SUCCESS);
+		already_allocated = (info == GrB_SUCCESS) || (C->compressed != NULL &&
+			RG_CompressedMatrix_extract(C->compressed, i, j, NULL));
 
 		if(!already_allocated) {
 			// update entry to dp[i, j]
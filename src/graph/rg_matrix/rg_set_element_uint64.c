@@ -7,6 +7,7 @@
 #include "RG.h"
 #include "rg_utils.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 #include "../../util/arr.h"
 
 static GrB_BinaryOp _graph_edge_accum = NULL;
@@ -79,6 +80,13 @@ GrB_Info RG_Matrix_setElement_UINT64    // C (i,j) = x
 		}
 	}
 
+	// entries of a compressed M can't be updated in place
+	// decompress M, it is compressed again once C is synced
+	if(C->compressed != NULL &&
+	   RG_CompressedMatrix_extract(C->compressed, i, j, NULL)) {
+		RG_Matrix_decompressM(C);
+	}
+
 	GrB_Matrix m   = RG_MATRIX_M(C);
 	GrB_Matrix dp  = RG_MATRIX_DELTA_PLUS(C);
 	GrB_Matrix dm  = RG_MATRIX_DELTA_MINUS(C);
@@ -0,0 +1,161 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rg_matrix.h"
+#include "../../util/rmalloc.h"
+
+// populate T with the transpose of C
+// T is created if NULL, otherwise its content is replaced
+static RG_Matrix _RG_Matrix_buildTranspose
+(
+	const RG_Matrix C,
+	RG_Matrix T
+) {
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Matrix A = NULL;
+
+	UNUSED(info);
+
+	// A = M + DP - DM
+	info = RG_Matrix_export(&A, C);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_nrows(&nrows, A);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(T == NULL) {
+		info = RG_Matrix_new(&T, GrB_BOOL, ncols, nrows);
+		ASSERT(info == GrB_SUCCESS);
+	} else {
+		info = RG_Matrix_resize(T, ncols, nrows);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// T = A', edge IDs are replaced by true
+	info = GrB_Matrix_apply(RG_MATRIX_M(T), NULL, NULL, GxB_ONE_BOOL, A,
+			GrB_DESC_RT0);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_wait(RG_MATRIX_M(T), GrB_MATERIALIZE);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix_free(&A);
+
+	return T;
+}
+
+RG_Matrix RG_Matrix_getTranspose
+(
+	const RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
+	// maintained transpose
+	// a lazy transpose may be published concurrently by another reader
+	RG_Matrix T = __atomic_load_n(&C->transposed, __ATOMIC_ACQUIRE);
+	if(T != NULL) return T;
+
+	// only relationship matrices are transposed on demand
+	if(!RG_MATRIX_MULTI_EDGE(C)) return NULL;
+
+	// multiple readers might request the transpose concurrently
+	RG_Matrix_Lock(C);
+
+	if(C->policy == RG_TRANSPOSE_LAZY) {
+		// first use, from now on the transpose is maintained
+		if(C->transposed == NULL) {
+			// build and freeze before publishing, readers may access
+			// the transpose as soon as it is set
+			RG_Matrix TC = _RG_Matrix_buildTranspose(C, NULL);
+			if(C->frozen) RG_Matrix_freeze(TC);
+			__atomic_store_n(&C->transposed, TC, __ATOMIC_RELEASE);
+		}
+		T = C->transposed;
+	} else {
+		// rebuild view if C was modified since it was last built
+		// the view is reused in place, as the graph write lock guarantees
+		// no reader holds it while C is modified
+		if(C->transposed_view == NULL || C->view_stale) {
+			C->transposed_view =
+				_RG_Matrix_buildTranspose(C, C->transposed_view);
+			C->view_stale = false;
+		}
+		T = C->transposed_view;
+	}
+
+	RG_Matrix_Unlock(C);
+
+	return T;
+}
+
+void RG_Matrix_setTransposePolicy
+(
+	RG_Matrix C,
+	RG_TransposePolicy policy
+) {
+	ASSERT(C != NULL);
+	ASSERT(RG_MATRIX_MULTI_EDGE(C));
+	ASSERT(policy >= RG_TRANSPOSE_ALWAYS && policy <= RG_TRANSPOSE_NEVER);
+
+	C->policy = policy;
+
+	// drop cached view
+	if(C->transposed_view != NULL) RG_Matrix_free(&C->transposed_view);
+	C->view_stale = false;
+
+	if(policy == RG_TRANSPOSE_ALWAYS) {
+		if(!RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+			RG_Matrix TC = _RG_Matrix_buildTranspose(C, NULL);
+			if(C->frozen) RG_Matrix_freeze(TC);
+			C->transposed = TC;
+		}
+	} else if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		// a lazy transpose is rebuilt on its next use
+		RG_Matrix_free(&C->transposed);
+	}
+}
+
+RG_TransposePolicy RG_Matrix_getTransposePolicy
+(
+	const RG_Matrix C
+) {
+	ASSERT(C != NULL);
+	return C->policy;
+}
+
+size_t RG_Matrix_transposeMemorySaved
+(
+	const RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) return 0;
+	if(!RG_MATRIX_MULTI_EDGE(C)) return 0;
+
+	GrB_Index nvals;
+	GrB_Index ncols;
+	RG_Matrix_nvals(&nvals, C);
+	RG_Matrix_ncols(&ncols, C);
+
+	// a maintained transpose is a sparse boolean matrix with
+	// an entry per edge and a row pointer per column of C
+	size_t saved = nvals * (sizeof(GrB_Index) + sizeof(bool)) +
+		(ncols + 1) * sizeof(GrB_Index);
+
+	// deduct the transposed view currently held
+	if(C->transposed_view != NULL) {
+		size_t view_size = 0;
+		GxB_Matrix_memoryUsage(&view_size, RG_MATRIX_M(C->transposed_view));
+		saved = (view_size < saved) ? saved - view_size : 0;
+	}
+
+	return saved;
+}
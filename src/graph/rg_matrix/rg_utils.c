@@ -6,6 +6,7 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 
 // check if i and j are within matrix boundries
 // i < nrows
@@ -86,7 +87,8 @@ void RG_Matrix_validateState
 	UNUSED(pending_addition);
 	UNUSED(pending_deletion);
 
-	existing_entry    =  info_m  == GrB_SUCCESS;
+	existing_entry    =  info_m  == GrB_SUCCESS || (C->compressed != NULL &&
+		RG_CompressedMatrix_extract(C->compressed, i, j, NULL));
 	pending_addition  =  info_dp == GrB_SUCCESS;
 	pending_deletion  =  info_dm == GrB_SUCCESS;
 
@@ -6,6 +6,7 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
+#include "rg_compress.h"
 #include "../../util/rmalloc.h"
 #include "configuration/config.h"
 
@@ -48,6 +49,11 @@ static GrB_Info RG_Matrix_sync
 	bool  additions  =  dp_nvals  >  0;
 	bool  deletions  =  dm_nvals  >  0;
 
+	// notify observer prior to merging changes
+	if(C->on_sync != NULL && (additions || deletions)) {
+		C->on_sync(C, C->on_sync_pdata);
+	}
+
 	//--------------------------------------------------------------------------
 	// perform deletions
 	//--------------------------------------------------------------------------
@@ -128,8 +134,20 @@ GrB_Info RG_Matrix_wait
 	Config_Option_get(Config_DELTA_MAX_PENDING_CHANGES,
 			&delta_max_pending_changes);
 
-	if(force_sync ||
-	   delta_plus_nvals + delta_minus_nvals >= delta_max_pending_changes) {
+	GrB_Index pending = delta_plus_nvals + delta_minus_nvals;
+
+	// observed matrices are always fully synced
+	bool sync = force_sync || A->on_sync != NULL ||
+		pending >= delta_max_pending_changes;
+
+	if(A->frozen && ((sync && pending > 0) || A->compressed == NULL)) {
+		// compact pending changes into the compressed M
+		// a frozen matrix decompressed by an in place update is compressed
+		// again regardless of its number of pending changes
+		RG_Matrix_decompressM(A);
+		info = RG_Matrix_sync(A);
+		RG_Matrix_compressM(A);
+	} else if(sync) {
 		info = RG_Matrix_sync(A);
 	} else {
 		// wait on 'm', in most cases 'm' won't contain any pending work
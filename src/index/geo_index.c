@@ -0,0 +1,507 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "geo_index.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../util/rax_extensions.h"
+#include "../datatypes/point.h"
+#include <math.h>
+
+#define GEO_STEPS 32        // number of bits used to encode each coordinate
+#define GEO_KEY_LEN 16      // geohash followed by entity ID, both big endian
+#define GEO_LAT_MIN -90.0
+#define GEO_LAT_MAX 90.0
+#define GEO_LON_MIN -180.0
+#define GEO_LON_MAX 180.0
+
+// computed distances are single precision, expand searched area
+// such that points on the edge of a radius query are not missed
+#define GEO_RADIUS_SLACK 1.01
+#define GEO_DEGREE_SLACK 0.001
+
+#define RadiansToDegrees(r) ((r) * 180.0 / M_PI)
+
+// coordinates box, latitude and longitude ranges are inclusive
+typedef struct {
+	double lat_min;
+	double lat_max;
+	double lon_min;
+	double lon_max;
+} GeoBox;
+
+// indexed entity, collected during scan
+typedef struct {
+	EntityID id;
+	SIValue point;
+} GeoEntry;
+
+//------------------------------------------------------------------------------
+// encoding
+//------------------------------------------------------------------------------
+
+// map coordinate to [0, 2^GEO_STEPS)
+static uint32_t _quantize
+(
+	double v,
+	double min,
+	double max
+) {
+	double f = (v - min) / (max - min);
+	if(f <= 0) return 0;
+	if(f >= 1) return UINT32_MAX;
+	return (uint32_t)(f * 4294967296.0);
+}
+
+// spread bits of v such that there's a zero bit between every two bits
+static uint64_t _spread
+(
+	uint32_t v
+) {
+	uint64_t x = v;
+	x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+	x = (x | (x << 8))  & 0x00FF00FF00FF00FFULL;
+	x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+	x = (x | (x << 2))  & 0x3333333333333333ULL;
+	x = (x | (x << 1))  & 0x5555555555555555ULL;
+	return x;
+}
+
+// interleave latitude and longitude cells into a Z-order code
+static inline uint64_t _interleave
+(
+	uint32_t lat,
+	uint32_t lon
+) {
+	return (_spread(lat) << 1) | _spread(lon);
+}
+
+static uint64_t _geohash
+(
+	SIValue point
+) {
+	uint32_t lat = _quantize(Point_lat(point), GEO_LAT_MIN, GEO_LAT_MAX);
+	uint32_t lon = _quantize(Point_lon(point), GEO_LON_MIN, GEO_LON_MAX);
+	return _interleave(lat, lon);
+}
+
+static void _encode_u64
+(
+	unsigned char *buf,
+	uint64_t v
+) {
+	for(int i = 0; i < 8; i++) buf[i] = (v >> (56 - 8 * i)) & 0xFF;
+}
+
+static uint64_t _decode_u64
+(
+	const unsigned char *buf
+) {
+	uint64_t v = 0;
+	for(int i = 0; i < 8; i++) v = (v << 8) | buf[i];
+	return v;
+}
+
+// tree key, ordered by geohash, entity ID breaks ties
+static inline void _encode_key
+(
+	unsigned char *key,
+	uint64_t hash,
+	EntityID id
+) {
+	_encode_u64(key, hash);
+	_encode_u64(key + 8, id);
+}
+
+// coordinates are stored within the tree value pointer
+static inline void *_pack
+(
+	SIValue point
+) {
+	float lat = Point_lat(point);
+	float lon = Point_lon(point);
+	uint32_t a;
+	uint32_t b;
+	memcpy(&a, &lat, sizeof(float));
+	memcpy(&b, &lon, sizeof(float));
+	return (void *)(((uintptr_t)a << 32) | b);
+}
+
+static inline SIValue _unpack
+(
+	void *v
+) {
+	float lat;
+	float lon;
+	uint32_t a = (uintptr_t)v >> 32;
+	uint32_t b = (uintptr_t)v & 0xFFFFFFFF;
+	memcpy(&lat, &a, sizeof(float));
+	memcpy(&lon, &b, sizeof(float));
+	return SI_Point(lat, lon);
+}
+
+//------------------------------------------------------------------------------
+// scan
+//------------------------------------------------------------------------------
+
+static inline bool _box_contains
+(
+	const GeoBox *box,
+	SIValue point
+) {
+	double lat = Point_lat(point);
+	double lon = Point_lon(point);
+	return (lat >= box->lat_min && lat <= box->lat_max &&
+			lon >= box->lon_min && lon <= box->lon_max);
+}
+
+// scan all tree keys with geohash within [start, end]
+// collecting entities located within box
+static void _scan_range
+(
+	const GeoIndex *idx,
+	uint64_t start,
+	uint64_t end,
+	const GeoBox *box,
+	GeoEntry **entries
+) {
+	unsigned char key[GEO_KEY_LEN];
+	_encode_key(key, start, 0);
+
+	raxIterator it;
+	raxStart(&it, idx->tree);
+	raxSeek(&it, ">=", key, GEO_KEY_LEN);
+
+	while(raxNext(&it)) {
+		ASSERT(it.key_len == GEO_KEY_LEN);
+		if(_decode_u64(it.key) > end) break;
+
+		SIValue point = _unpack(it.data);
+		if(box != NULL && !_box_contains(box, point)) continue;
+
+		GeoEntry e = {.id = _decode_u64(it.key + 8), .point = point};
+		array_append(*entries, e);
+	}
+
+	raxStop(&it);
+}
+
+// collect entities located within box
+// box must not cross the antimeridian
+static void _scan_box
+(
+	const GeoIndex *idx,
+	const GeoBox *box,
+	GeoEntry **entries
+) {
+	double lat_span = box->lat_max - box->lat_min;
+	double lon_span = box->lon_max - box->lon_min;
+
+	// pick the finest cell level in which a cell is larger than the box
+	// then go one level finer, the box is then covered by at most 3x3 cells
+	uint level = 0;
+	while(level < GEO_STEPS &&
+		  (GEO_LAT_MAX - GEO_LAT_MIN) / (double)(1ULL << (level + 1)) >= lat_span &&
+		  (GEO_LON_MAX - GEO_LON_MIN) / (double)(1ULL << (level + 1)) >= lon_span) {
+		level++;
+	}
+	if(level < GEO_STEPS) level++;
+
+	uint shift = GEO_STEPS - level;
+	uint64_t lat_lo = _quantize(box->lat_min, GEO_LAT_MIN, GEO_LAT_MAX) >> shift;
+	uint64_t lat_hi = _quantize(box->lat_max, GEO_LAT_MIN, GEO_LAT_MAX) >> shift;
+	uint64_t lon_lo = _quantize(box->lon_min, GEO_LON_MIN, GEO_LON_MAX) >> shift;
+	uint64_t lon_hi = _quantize(box->lon_max, GEO_LON_MIN, GEO_LON_MAX) >> shift;
+
+	// each cell maps to a contiguous geohash range
+	uint range_bits = 2 * shift;
+	uint64_t mask = (range_bits == 64) ? UINT64_MAX : (1ULL << range_bits) - 1;
+	for(uint64_t lat = lat_lo; lat <= lat_hi; lat++) {
+		for(uint64_t lon = lon_lo; lon <= lon_hi; lon++) {
+			uint64_t prefix = _interleave(lat, lon);
+			uint64_t start = (range_bits == 64) ? 0 : prefix << range_bits;
+			_scan_range(idx, start, start | mask, box, entries);
+		}
+	}
+}
+
+// splits a box crossing the antimeridian into two boxes
+// returns number of boxes
+static uint _split_box
+(
+	GeoBox box,
+	GeoBox *boxes
+) {
+	if(box.lon_min > box.lon_max) {
+		boxes[0] = box;
+		boxes[1] = box;
+		boxes[0].lon_max = GEO_LON_MAX;
+		boxes[1].lon_min = GEO_LON_MIN;
+		return 2;
+	}
+
+	boxes[0] = box;
+	return 1;
+}
+
+// bounding box of a circle, the box crosses the antimeridian
+// if the circle does
+static GeoBox _circle_box
+(
+	SIValue center,
+	double radius
+) {
+	double lat = Point_lat(center);
+	double lon = Point_lon(center);
+	double dlat = RadiansToDegrees(radius / EARTH_RADIUS) * GEO_RADIUS_SLACK +
+		GEO_DEGREE_SLACK;
+
+	GeoBox box = {
+		.lat_min = lat - dlat,
+		.lat_max = lat + dlat,
+		.lon_min = GEO_LON_MIN,
+		.lon_max = GEO_LON_MAX
+	};
+
+	// circle contains a pole, all longitudes are covered
+	if(box.lat_min <= GEO_LAT_MIN || box.lat_max >= GEO_LAT_MAX) {
+		box.lat_min = fmax(box.lat_min, GEO_LAT_MIN);
+		box.lat_max = fmin(box.lat_max, GEO_LAT_MAX);
+		return box;
+	}
+
+	// longitude span grows as we get closer to the poles
+	double extreme_lat = fmax(fabs(box.lat_min), fabs(box.lat_max));
+	double dlon = dlat / cos(DegreeToRadians(extreme_lat));
+	if(dlon >= GEO_LON_MAX) return box;
+
+	box.lon_min = lon - dlon;
+	box.lon_max = lon + dlon;
+	if(box.lon_min < GEO_LON_MIN) box.lon_min += 360.0;
+	if(box.lon_max > GEO_LON_MAX) box.lon_max -= 360.0;
+
+	return box;
+}
+
+static int _result_cmp
+(
+	const void *a,
+	const void *b
+) {
+	const GeoIndexResult *ra = a;
+	const GeoIndexResult *rb = b;
+
+	if(ra->distance < rb->distance) return -1;
+	if(ra->distance > rb->distance) return 1;
+	// break ties by ID, keeping order deterministic
+	if(ra->id < rb->id) return -1;
+	if(ra->id > rb->id) return 1;
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// API
+//------------------------------------------------------------------------------
+
+GeoIndex *GeoIndex_New(void) {
+	GeoIndex *idx = rm_malloc(sizeof(GeoIndex));
+
+	idx->tree     = raxNew();
+	idx->entities = raxNew();
+
+	return idx;
+}
+
+void GeoIndex_Insert
+(
+	GeoIndex *idx,
+	EntityID id,
+	SIValue point
+) {
+	ASSERT(idx != NULL);
+	ASSERT(SI_TYPE(point) == T_POINT);
+
+	// remove previous location
+	GeoIndex_Remove(idx, id);
+
+	uint64_t hash = _geohash(point);
+	unsigned char key[GEO_KEY_LEN];
+	_encode_key(key, hash, id);
+
+	raxInsert(idx->tree, key, GEO_KEY_LEN, _pack(point), NULL);
+	raxInsert(idx->entities, (unsigned char *)&id, sizeof(EntityID),
+			(void *)(uintptr_t)hash, NULL);
+}
+
+bool GeoIndex_Remove
+(
+	GeoIndex *idx,
+	EntityID id
+) {
+	ASSERT(idx != NULL);
+
+	void *hash = NULL;
+	if(!raxRemove(idx->entities, (unsigned char *)&id, sizeof(EntityID),
+				&hash)) {
+		return false;
+	}
+
+	unsigned char key[GEO_KEY_LEN];
+	_encode_key(key, (uintptr_t)hash, id);
+	int removed = raxRemove(idx->tree, key, GEO_KEY_LEN, NULL);
+	ASSERT(removed == 1);
+	UNUSED(removed);
+
+	return true;
+}
+
+bool GeoIndex_Contains
+(
+	const GeoIndex *idx,
+	EntityID id
+) {
+	ASSERT(idx != NULL);
+
+	return raxFind(idx->entities, (unsigned char *)&id, sizeof(EntityID))
+		!= raxNotFound;
+}
+
+uint64_t GeoIndex_Size
+(
+	const GeoIndex *idx
+) {
+	ASSERT(idx != NULL);
+
+	return raxSize(idx->entities);
+}
+
+size_t GeoIndex_MemoryUsage
+(
+	const GeoIndex *idx
+) {
+	ASSERT(idx != NULL);
+
+	// coordinates are packed within the tree's value pointers
+	return sizeof(GeoIndex) +
+		raxMemoryUsage(idx->tree) +
+		raxMemoryUsage(idx->entities);
+}
+
+GeoIndexResult *GeoIndex_Radius
+(
+	const GeoIndex *idx,
+	SIValue center,
+	double radius,
+	bool inclusive
+) {
+	ASSERT(idx != NULL);
+	ASSERT(SI_TYPE(center) == T_POINT);
+
+	GeoIndexResult *results = array_new(GeoIndexResult, 0);
+	if(radius < 0) return results;
+
+	// scan circle bounding box
+	GeoBox boxes[2];
+	GeoEntry *entries = array_new(GeoEntry, 0);
+	uint box_count = _split_box(_circle_box(center, radius), boxes);
+	for(uint i = 0; i < box_count; i++) _scan_box(idx, boxes + i, &entries);
+
+	// discard entities outside of circle
+	uint n = array_len(entries);
+	for(uint i = 0; i < n; i++) {
+		double d = Point_Distance(center, entries[i].point);
+		if(d < radius || (inclusive && d == radius)) {
+			GeoIndexResult r = {.id = entries[i].id, .distance = d};
+			array_append(results, r);
+		}
+	}
+	array_free(entries);
+
+	qsort(results, array_len(results), sizeof(GeoIndexResult), _result_cmp);
+	return results;
+}
+
+EntityID *GeoIndex_BoundingBox
+(
+	const GeoIndex *idx,
+	SIValue lower_left,
+	SIValue upper_right
+) {
+	ASSERT(idx != NULL);
+	ASSERT(SI_TYPE(lower_left)  == T_POINT);
+	ASSERT(SI_TYPE(upper_right) == T_POINT);
+
+	EntityID *ids = array_new(EntityID, 0);
+	if(Point_lat(lower_left) > Point_lat(upper_right)) return ids;
+
+	GeoBox box = {
+		.lat_min = Point_lat(lower_left),
+		.lat_max = Point_lat(upper_right),
+		.lon_min = Point_lon(lower_left),
+		.lon_max = Point_lon(upper_right)
+	};
+
+	GeoBox boxes[2];
+	GeoEntry *entries = array_new(GeoEntry, 0);
+	uint box_count = _split_box(box, boxes);
+	for(uint i = 0; i < box_count; i++) _scan_box(idx, boxes + i, &entries);
+
+	uint n = array_len(entries);
+	for(uint i = 0; i < n; i++) array_append(ids, entries[i].id);
+	array_free(entries);
+
+	return ids;
+}
+
+GeoIndexResult *GeoIndex_Nearest
+(
+	const GeoIndex *idx,
+	SIValue center,
+	uint64_t k
+) {
+	ASSERT(idx != NULL);
+	ASSERT(SI_TYPE(center) == T_POINT);
+
+	uint64_t size = GeoIndex_Size(idx);
+	double max_radius = M_PI * EARTH_RADIUS;  // half the circumference
+
+	if(k == 0 || size == 0) return array_new(GeoIndexResult, 0);
+
+	// initial radius assumes points are uniformly spread across the globe
+	// the radius grows until it contains at least k points
+	// at which point it must contain the k nearest points
+	double radius = 2 * EARTH_RADIUS * sqrt((double)k / size);
+	if(radius < 1) radius = 1;
+
+	GeoIndexResult *results = NULL;
+	while(true) {
+		if(k >= size || radius >= max_radius) {
+			// every indexed entity is a candidate
+			radius = max_radius * GEO_RADIUS_SLACK;
+		}
+
+		results = GeoIndex_Radius(idx, center, radius, true);
+		if(array_len(results) >= k || radius > max_radius) break;
+
+		array_free(results);
+		radius *= 4;
+	}
+
+	if(array_len(results) > k) results = array_trimm_len(results, k);
+	return results;
+}
+
+void GeoIndex_Free
+(
+	GeoIndex *idx
+) {
+	ASSERT(idx != NULL);
+
+	raxFree(idx->tree);
+	raxFree(idx->entities);
+	rm_free(idx);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "rax.h"
+#include "../value.h"
+#include "../graph/entities/graph_entity.h"
+
+// native spatial index over point values
+// entities are kept in a radix tree ordered by the geohash (Z-order)
+// of their location, nearby points share key prefixes such that
+// spatial queries are answered by scanning a small number of key ranges
+typedef struct {
+	rax *tree;      // geohash | entity ID -> packed coordinates
+	rax *entities;  // entity ID -> geohash
+} GeoIndex;
+
+// spatial query result
+typedef struct {
+	EntityID id;      // entity ID
+	double distance;  // distance in meters from query center
+} GeoIndexResult;
+
+// create a new empty spatial index
+GeoIndex *GeoIndex_New(void);
+
+// index entity location, replacing previous location if exists
+void GeoIndex_Insert
+(
+	GeoIndex *idx,  // index to update
+	EntityID id,    // entity ID
+	SIValue point   // entity location
+);
+
+// remove entity from index
+// returns true if entity was indexed
+bool GeoIndex_Remove
+(
+	GeoIndex *idx,  // index to update
+	EntityID id     // entity to remove
+);
+
+// returns true if entity is indexed
+bool GeoIndex_Contains
+(
+	const GeoIndex *idx,  // index to query
+	EntityID id           // entity to look for
+);
+
+// returns number of indexed entities
+uint64_t GeoIndex_Size
+(
+	const GeoIndex *idx
+);
+
+// estimated number of bytes used by index
+size_t GeoIndex_MemoryUsage
+(
+	const GeoIndex *idx
+);
+
+// collect entities within 'radius' meters of 'center'
+// results are ordered by ascending distance
+// caller is responsible for freeing returned array
+GeoIndexResult *GeoIndex_Radius
+(
+	const GeoIndex *idx,  // index to query
+	SIValue center,       // query center
+	double radius,        // radius in meters
+	bool inclusive        // include entities exactly 'radius' away
+);
+
+// collect entities within a bounding box
+// the box crosses the antimeridian if lower left longitude
+// is greater than upper right longitude
+// results are ordered by geohash
+// caller is responsible for freeing returned array
+EntityID *GeoIndex_BoundingBox
+(
+	const GeoIndex *idx,   // index to query
+	SIValue lower_left,    // south-west corner
+	SIValue upper_right    // north-east corner
+);
+
+// collect the 'k' entities nearest to 'center'
+// results are ordered by ascending distance
+// caller is responsible for freeing returned array
+GeoIndexResult *GeoIndex_Nearest
+(
+	const GeoIndex *idx,  // index to query
+	SIValue center,       // query center
+	uint64_t k            // number of entities to return
+);
+
+// free spatial index
+void GeoIndex_Free
+(
+	GeoIndex *idx
+);
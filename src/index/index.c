@@ -4,6 +4,7 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
+#include <ctype.h>
 #include "RG.h"
 #include "index.h"
 #include "../value.h"
@@ -13,11 +14,48 @@
 #include "../datatypes/point.h"
 #include "../graph/graphcontext.h"
 #include "../graph/entities/node.h"
+#include "../configuration/config.h"
 #include "../graph/rg_matrix/rg_matrix_iter.h"
+#include "../../deps/rax/rax.h"
 
 extern void populateEdgeIndex(Index *idx, Graph *g); 
 extern void populateNodeIndex(Index *idx, Graph *g);
 
+// index the trigrams of a string value under the field's trigram field
+static void _Index_AddTrigrams
+(
+	RSDoc *doc,              // document to populate
+	const char *field_name,  // indexed field
+	const char *s            // indexed string
+) {
+	char **trigrams = Index_Trigrams(s);
+	uint trigram_count = array_len(trigrams);
+
+	if(trigram_count > 0) {
+		// concat all trigrams
+		size_t len = trigram_count * (INDEX_TRIGRAM_LEN + 1);
+		char *tags = rm_malloc(sizeof(char) * len);
+
+		len = 0;
+		for(uint i = 0; i < trigram_count; i++) {
+			if(i > 0) tags[len++] = INDEX_SEPARATOR;
+			memcpy(tags + len, trigrams[i], INDEX_TRIGRAM_LEN);
+			len += INDEX_TRIGRAM_LEN;
+		}
+
+		char trigram_field[strlen(INDEX_FIELD_TRIGRAMS_PREFIX) +
+			strlen(field_name) + 1];
+		sprintf(trigram_field, INDEX_FIELD_TRIGRAMS_PREFIX "%s", field_name);
+
+		RediSearch_DocumentAddFieldString(doc, trigram_field, tags, len,
+				RSFLDTYPE_TAG);
+
+		rm_free(tags);
+	}
+
+	array_free_cb(trigrams, rm_free);
+}
+
 RSDoc *Index_IndexGraphEntity
 (
 	Index *idx,
@@ -79,6 +117,7 @@ RSDoc *Index_IndexGraphEntity
 			if(t == T_STRING) {
 				RediSearch_DocumentAddFieldString(doc, field_name, v->stringval,
 						strlen(v->stringval), RSFLDTYPE_TAG);
+				if(idx->trigrams) _Index_AddTrigrams(doc, field_name, v->stringval);
 			} else if(t & (SI_NUMERIC | T_BOOL)) {
 				double d = SI_GET_NUMERIC(*v);
 				RediSearch_DocumentAddFieldNumber(doc, field_name, d,
@@ -143,6 +182,7 @@ void IndexField_New
 	field->weight   = weight;
 	field->nostem   = nostem;
 	field->phonetic = rm_strdup(phonetic);
+	field->geo      = NULL;
 }
 
 void IndexField_Free
@@ -153,6 +193,7 @@ void IndexField_Free
 
 	rm_free(field->name);
 	rm_free(field->phonetic);
+	if(field->geo != NULL) GeoIndex_Free(field->geo);
 }
 
 // create a new index
@@ -173,6 +214,12 @@ Index *Index_New
 	idx->language      =  NULL;
 	idx->stopwords     =  NULL;
 	idx->entity_type   =  entity_type;
+	idx->trigrams      =  false;
+
+	// trigrams are only maintained by exact-match indices
+	if(type == IDX_EXACT_MATCH) {
+		Config_Option_get(Config_INDEX_TRIGRAMS, &idx->trigrams);
+	}
 
 	return idx;
 }
@@ -191,6 +238,14 @@ void Index_AddField
 		return;
 	}
 
+	// node exact-match fields maintain a spatial index over point values
+	// created along with the field, such that plans built before any point
+	// is indexed make use of it
+	if(idx->type == IDX_EXACT_MATCH && idx->entity_type == GETYPE_NODE &&
+	   field->geo == NULL) {
+		field->geo = GeoIndex_New();
+	}
+
 	array_append(idx->fields, *field);
 }
 
@@ -280,6 +335,20 @@ void Index_Construct
 
 			RediSearch_TagFieldSetSeparator(rsIdx, fieldID, INDEX_SEPARATOR);
 			RediSearch_TagFieldSetCaseSensitive(rsIdx, fieldID, 1);
+
+			if(!idx->trigrams) continue;
+
+			// introduce a tag field holding the trigrams of string values
+			char trigram_field[strlen(INDEX_FIELD_TRIGRAMS_PREFIX) +
+				strlen(field->name) + 1];
+			sprintf(trigram_field, INDEX_FIELD_TRIGRAMS_PREFIX "%s",
+					field->name);
+
+			fieldID = RediSearch_CreateField(rsIdx, trigram_field,
+					RSFLDTYPE_TAG, RSFLDOPT_NONE);
+
+			RediSearch_TagFieldSetSeparator(rsIdx, fieldID, INDEX_SEPARATOR);
+			RediSearch_TagFieldSetCaseSensitive(rsIdx, fieldID, 1);
 		}
 
 		// for none indexable types e.g. Array introduce an additional field
@@ -310,6 +379,50 @@ RSResultsIterator *Index_Query
 	return RediSearch_IterateQuery(idx->idx, query, strlen(query), err);
 }
 
+bool Index_ContainsTrigrams
+(
+	const Index *idx
+) {
+	ASSERT(idx != NULL);
+
+	return idx->trigrams;
+}
+
+char **Index_Trigrams
+(
+	const char *s
+) {
+	ASSERT(s != NULL);
+
+	char **trigrams = array_new(char *, 0);
+	size_t len = strlen(s);
+	if(len < INDEX_TRIGRAM_LEN) return trigrams;
+
+	rax *seen = raxNew();
+	for(size_t i = 0; i + INDEX_TRIGRAM_LEN <= len; i++) {
+		const char *t = s + i;
+
+		// RediSearch splits tags on the separator and trims their whitespaces
+		// skip trigrams which would not be indexed as is
+		if(memchr(t, INDEX_SEPARATOR, INDEX_TRIGRAM_LEN) != NULL) continue;
+		if(isspace((unsigned char)t[0]) ||
+		   isspace((unsigned char)t[INDEX_TRIGRAM_LEN - 1])) {
+			continue;
+		}
+
+		// skip duplicates
+		if(!raxTryInsert(seen, (unsigned char *)t, INDEX_TRIGRAM_LEN, NULL,
+					NULL)) {
+			continue;
+		}
+
+		array_append(trigrams, rm_strndup(t, INDEX_TRIGRAM_LEN));
+	}
+	raxFree(seen);
+
+	return trigrams;
+}
+
 // returns number of fields indexed
 uint Index_FieldsCount
 (
@@ -348,6 +461,24 @@ bool Index_ContainsAttribute
 	return false;
 }
 
+GeoIndex *Index_GetGeoIndex
+(
+	const Index *idx,
+	Attribute_ID attribute_id
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->type != IDX_EXACT_MATCH) return NULL;
+
+	uint fields_count = array_len(idx->fields);
+	for(uint i = 0; i < fields_count; i++) {
+		IndexField *field = idx->fields + i;
+		if(field->id == attribute_id) return field->geo;
+	}
+
+	return NULL;
+}
+
 int Index_GetLabelID
 (
 	const Index *idx
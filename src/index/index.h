@@ -10,12 +10,15 @@
 #include "../graph/entities/edge.h"
 #include "../graph/entities/graph_entity.h"
 #include "../graph/graph.h"
+#include "geo_index.h"
 #include "redisearch_api.h"
 
 #define INDEX_OK 1
 #define INDEX_FAIL 0
 #define INDEX_SEPARATOR '\1'  // can't use '\0', RediSearch will terminate on \0
 #define INDEX_FIELD_NONE_INDEXED "NONE_INDEXABLE_FIELDS"
+#define INDEX_FIELD_TRIGRAMS_PREFIX "TRIGRAMS:"  // prefix of trigram fields
+#define INDEX_TRIGRAM_LEN 3                      // length of an indexed trigram
 
 #define INDEX_FIELD_DEFAULT_WEIGHT 1.0
 #define INDEX_FIELD_DEFAULT_NOSTEM false
@@ -49,6 +52,7 @@ typedef struct {
 	double weight;     // the importance of text
 	bool nostem;       // disable stemming of the text
 	char *phonetic;    // phonetic search of text
+	GeoIndex *geo;     // spatial index over point values, node exact-match only
 } IndexField;
 
 typedef struct {
@@ -59,6 +63,7 @@ typedef struct {
 	char **stopwords;             // stopwords
 	GraphEntityType entity_type;  // entity type (node/edge) indexed
 	IndexType type;               // index type exact-match / fulltext
+	bool trigrams;                // string trigrams are indexed
 	RSIndex *idx;                 // rediSearch index
 } Index;
 
@@ -142,6 +147,20 @@ RSResultsIterator *Index_Query
 	char **err          // [optional] report back error
 );
 
+// returns true if string trigrams are indexed
+// allowing substring and suffix searches
+bool Index_ContainsTrigrams
+(
+	const Index *idx
+);
+
+// returns the distinct trigrams of 's' which can be indexed
+// caller is responsible for freeing the returned array and its elements
+char **Index_Trigrams
+(
+	const char *s
+);
+
 // returns number of fields indexed
 uint Index_FieldsCount
 (
@@ -161,6 +180,14 @@ bool Index_ContainsAttribute
 	Attribute_ID attribute_id  // attribute id to search
 );
 
+// returns spatial index of attribute
+// NULL if attribute isn't indexed or no point value was indexed
+GeoIndex *Index_GetGeoIndex
+(
+	const Index *idx,
+	Attribute_ID attribute_id  // indexed attribute
+);
+
 // returns indexed label ID
 int Index_GetLabelID
 (
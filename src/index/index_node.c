@@ -8,12 +8,38 @@
 #include "index.h"
 #include "../value.h"
 #include "../query_ctx.h"
+#include "../util/arr.h"
 #include "../graph/graphcontext.h"
 #include "../graph/rg_matrix/rg_matrix_iter.h"
 
 extern RSDoc *Index_IndexGraphEntity(Index *idx,const GraphEntity *e,
 		const void *key, size_t key_len, uint *doc_field_count);
 
+// maintain spatial indices of node point attributes
+static void _Index_IndexNodeLocation
+(
+	Index *idx,
+	const Node *n
+) {
+	if(idx->type != IDX_EXACT_MATCH) return;
+
+	EntityID id = ENTITY_GET_ID(n);
+	uint fields_count = array_len(idx->fields);
+	for(uint i = 0; i < fields_count; i++) {
+		IndexField *field = idx->fields + i;
+		SIValue *v = GraphEntity_GetProperty((const GraphEntity *)n, field->id);
+
+		ASSERT(field->geo != NULL);
+
+		if(v != ATTRIBUTE_NOTFOUND && SI_TYPE(*v) == T_POINT) {
+			GeoIndex_Insert(field->geo, id, *v);
+		} else {
+			// attribute was removed or is no longer a point
+			GeoIndex_Remove(field->geo, id);
+		}
+	}
+}
+
 void Index_IndexNode
 (
 	Index *idx,
@@ -31,6 +57,8 @@ void Index_IndexNode
 			idx, (const GraphEntity *)n, (const void *)&key, key_len,
 			&doc_field_count);
 
+	_Index_IndexNodeLocation(idx, n);
+
 	if(doc_field_count > 0) {
 		RediSearch_SpecAddDocument(rsIdx, doc);
 	} else {
@@ -76,5 +104,11 @@ void Index_RemoveNode
 
 	EntityID id = ENTITY_GET_ID(n);
 	RediSearch_DeleteDocument(idx->idx, &id, sizeof(EntityID));
+
+	uint fields_count = array_len(idx->fields);
+	for(uint i = 0; i < fields_count; i++) {
+		IndexField *field = idx->fields + i;
+		if(field->geo != NULL) GeoIndex_Remove(field->geo, id);
+	}
 }
 
@@ -17,6 +17,8 @@
 #include "arithmetic/funcs.h"
 #include "commands/commands.h"
 #include "util/thpool/pools.h"
+#include "util/thpool/affinity.h"
+#include "util/thread_budget.h"
 #include "graph/graphcontext.h"
 #include "util/redis_version.h"
 #include "configuration/config.h"
@@ -124,6 +126,11 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 	RedisModule_Log(ctx, "notice", "Thread pool created, using %d threads.",
 			ThreadPools_ReadersCount());
 
+	// graphs are loaded by the main thread, apply configured memory policy
+	if(!Affinity_SetMemoryPolicy()) {
+		RedisModule_Log(ctx, "warning", "Failed to apply memory policy");
+	}
+
 	int ompThreadCount;
 	Config_Option_get(Config_OPENMP_NTHREAD, &ompThreadCount);
 
@@ -133,6 +140,9 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 	}
 	RedisModule_Log(ctx, "notice", "Maximum number of OpenMP threads set to %d", ompThreadCount);
 
+	// split OpenMP threads between concurrent queries
+	ThreadBudget_Init(ompThreadCount);
+
 	// initialize array of command contexts
 	command_ctxs = calloc(ThreadPools_ThreadCount() + 1, sizeof(CommandCtx *));
 
@@ -173,6 +183,16 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 		return REDISMODULE_ERR;
 	}
 
+	if(RedisModule_CreateCommand(ctx, "graph.MEMORY", Graph_Memory, "readonly", 1, 1,
+								 1) == REDISMODULE_ERR) {
+		return REDISMODULE_ERR;
+	}
+
+	if(RedisModule_CreateCommand(ctx, "graph.EXPORT", Graph_Export, "admin", 1, 1,
+								 1) == REDISMODULE_ERR) {
+		return REDISMODULE_ERR;
+	}
+
 	if(RedisModule_CreateCommand(ctx, "graph.CONFIG", Graph_Config, "readonly", 0, 0,
 								 0) == REDISMODULE_ERR) {
 		return REDISMODULE_ERR;
@@ -0,0 +1,293 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_algebraic_view.h"
+#include "RG.h"
+#include "../value.h"
+#include "../errors.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../datatypes/array.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+#include "../graph/algebraic_view.h"
+
+//------------------------------------------------------------------------------
+// create view
+//------------------------------------------------------------------------------
+
+// pattern alternates node labels and relationship types
+// a NULL label denotes an unlabeled node, the last node might be omitted
+//
+// CALL db.algebraicView.create(name, pattern)
+// CALL db.algebraicView.create('colleagues', ['Person', 'KNOWS', 'Person', 'WORKS_AT'])
+
+ProcedureResult Proc_AlgebraicViewCreateInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+	if(SI_TYPE(args[0]) != T_STRING || SI_TYPE(args[1]) != T_ARRAY) {
+		ErrorCtx_SetError("View name must be a string and pattern a list");
+		return PROCEDURE_ERR;
+	}
+
+	const char *name = args[0].stringval;
+	SIValue pattern = args[1];
+	uint len = SIArray_Length(pattern);
+
+	if(len < 2) {
+		ErrorCtx_SetError("View pattern must contain at least one relationship type");
+		return PROCEDURE_ERR;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Graph *g = gc->g;
+
+	if(Graph_GetView(g, name) != NULL) {
+		ErrorCtx_SetError("View '%s' already exists", name);
+		return PROCEDURE_ERR;
+	}
+
+	uint hops = len / 2;
+	int *labels = rm_malloc(sizeof(int) * (hops + 1));
+	int *relations = rm_malloc(sizeof(int) * hops);
+	labels[hops] = GRAPH_NO_LABEL;
+
+	ProcedureResult res = PROCEDURE_OK;
+	for(uint i = 0; i < len; i++) {
+		SIValue elem = SIArray_Get(pattern, i);
+		bool node = (i % 2 == 0);
+
+		if(node && SIValue_IsNull(elem)) {
+			labels[i / 2] = GRAPH_NO_LABEL;
+			continue;
+		}
+
+		if(SI_TYPE(elem) != T_STRING) {
+			ErrorCtx_SetError("View pattern elements must be strings");
+			res = PROCEDURE_ERR;
+			break;
+		}
+
+		SchemaType t = node ? SCHEMA_NODE : SCHEMA_EDGE;
+		Schema *s = GraphContext_GetSchema(gc, elem.stringval, t);
+		if(s == NULL) {
+			ErrorCtx_SetError("%s '%s' does not exist",
+					node ? "Label" : "Relationship type", elem.stringval);
+			res = PROCEDURE_ERR;
+			break;
+		}
+
+		if(node) labels[i / 2] = Schema_GetID(s);
+		else relations[i / 2] = Schema_GetID(s);
+	}
+
+	if(res == PROCEDURE_OK) {
+		AlgebraicView *v = AlgebraicView_New(name, labels, relations, hops);
+		Graph_AddView(g, v);
+	}
+
+	rm_free(labels);
+	rm_free(relations);
+
+	return res;
+}
+
+SIValue *Proc_AlgebraicViewCreateStep
+(
+	ProcedureCtx *ctx
+) {
+	return NULL;
+}
+
+ProcedureResult Proc_AlgebraicViewCreateFree
+(
+	ProcedureCtx *ctx
+) {
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_AlgebraicViewCreateGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.algebraicView.create",
+								   2,
+								   output,
+								   Proc_AlgebraicViewCreateStep,
+								   Proc_AlgebraicViewCreateInvoke,
+								   Proc_AlgebraicViewCreateFree,
+								   privateData,
+								   false);
+	return ctx;
+}
+
+//------------------------------------------------------------------------------
+// drop view
+//------------------------------------------------------------------------------
+
+// CALL db.algebraicView.drop(name)
+
+ProcedureResult Proc_AlgebraicViewDropInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 1) return PROCEDURE_ERR;
+	if(SI_TYPE(args[0]) != T_STRING) {
+		ErrorCtx_SetError("View name must be a string");
+		return PROCEDURE_ERR;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	if(!Graph_RemoveView(gc->g, args[0].stringval)) {
+		ErrorCtx_SetError("View '%s' does not exist", args[0].stringval);
+		return PROCEDURE_ERR;
+	}
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_AlgebraicViewDropStep
+(
+	ProcedureCtx *ctx
+) {
+	return NULL;
+}
+
+ProcedureResult Proc_AlgebraicViewDropFree
+(
+	ProcedureCtx *ctx
+) {
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_AlgebraicViewDropGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.algebraicView.drop",
+								   1,
+								   output,
+								   Proc_AlgebraicViewDropStep,
+								   Proc_AlgebraicViewDropInvoke,
+								   Proc_AlgebraicViewDropFree,
+								   privateData,
+								   false);
+	return ctx;
+}
+
+//------------------------------------------------------------------------------
+// list views
+//------------------------------------------------------------------------------
+
+// CALL db.algebraicViews() YIELD name, pattern, entries
+
+typedef struct {
+	uint view_idx;      // current view index
+	GraphContext *gc;   // graph context
+	SIValue pattern;    // current view pattern
+	SIValue *output;    // output record
+} AlgebraicViewsContext;
+
+ProcedureResult Proc_AlgebraicViewsInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 0) return PROCEDURE_ERR;
+
+	AlgebraicViewsContext *pdata = rm_malloc(sizeof(AlgebraicViewsContext));
+
+	pdata->view_idx  =  0;
+	pdata->gc        =  QueryCtx_GetGraphCtx();
+	pdata->pattern   =  SI_NullVal();
+	pdata->output    =  array_new(SIValue, 3);
+
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_AlgebraicViewsStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData != NULL);
+
+	AlgebraicViewsContext *pdata = ctx->privateData;
+	GraphContext *gc = pdata->gc;
+
+	// depleted?
+	if(pdata->view_idx >= Graph_ViewCount(gc->g)) return NULL;
+
+	AlgebraicView *v = Graph_GetViewAt(gc->g, pdata->view_idx++);
+
+	// bring view up to date
+	AlgebraicView_Matrix(v, gc->g);
+
+	// rebuild pattern from view operands
+	SIValue_Free(pdata->pattern);
+	pdata->pattern = SI_Array(v->op_count);
+	bool expect_label = true;
+	for(uint i = 0; i < v->op_count; i++) {
+		AlgebraicViewOperand *op = v->ops + i;
+		if(!op->diagonal && expect_label) {
+			// unlabeled node
+			SIArray_Append(&pdata->pattern, SI_NullVal());
+		}
+
+		SchemaType t = op->diagonal ? SCHEMA_NODE : SCHEMA_EDGE;
+		Schema *s = GraphContext_GetSchemaByID(gc, op->id, t);
+		SIArray_Append(&pdata->pattern, SI_ConstStringVal(Schema_GetName(s)));
+		expect_label = !op->diagonal;
+	}
+
+	array_clear(pdata->output);
+	array_append(pdata->output, SI_ConstStringVal(v->name));
+	array_append(pdata->output, pdata->pattern);
+	array_append(pdata->output, SI_LongVal(AlgebraicView_EntryCount(v)));
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_AlgebraicViewsFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(ctx->privateData) {
+		AlgebraicViewsContext *pdata = ctx->privateData;
+		SIValue_Free(pdata->pattern);
+		array_free(pdata->output);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_AlgebraicViewsGen() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 3);
+	ProcedureOutput out_name = {.name = "name", .type = T_STRING};
+	ProcedureOutput out_pattern = {.name = "pattern", .type = T_ARRAY};
+	ProcedureOutput out_entries = {.name = "entries", .type = T_INT64};
+	array_append(outputs, out_name);
+	array_append(outputs, out_pattern);
+	array_append(outputs, out_entries);
+
+	ProcedureCtx *ctx = ProcCtxNew("db.algebraicViews",
+								   0,
+								   outputs,
+								   Proc_AlgebraicViewsStep,
+								   Proc_AlgebraicViewsInvoke,
+								   Proc_AlgebraicViewsFree,
+								   privateData,
+								   true);
+	return ctx;
+}
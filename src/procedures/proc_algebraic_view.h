@@ -0,0 +1,18 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "proc_ctx.h"
+
+// CALL db.algebraicView.create(name, pattern)
+ProcedureCtx *Proc_AlgebraicViewCreateGen();
+
+// CALL db.algebraicView.drop(name)
+ProcedureCtx *Proc_AlgebraicViewDropGen();
+
+// CALL db.algebraicViews()
+ProcedureCtx *Proc_AlgebraicViewsGen();
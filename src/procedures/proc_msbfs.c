@@ -0,0 +1,259 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "proc_msbfs.h"
+#include "../value.h"
+#include "../errors.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/array.h"
+#include "../algorithms/msbfs.h"
+#include "../graph/graphcontext.h"
+
+// The MSBFS procedure performs a BFS scan from multiple sources at once
+// it's inputs are:
+// 1. list of source nodes to traverse from
+// 2. depth, how deep should the procedure traverse (0 no limit)
+// 3. relationship type to traverse, (NULL for edge type agnostic)
+//
+// output, one record per source:
+// 1. source - the source node
+// 2. nodes - an array of nodes reachable from source
+// 3. levels - an array of hops separating source from each reachable node
+//
+// MATCH (a:User) WITH collect(a) AS sources
+// CALL algo.MSBFS(sources, 2, 'FOLLOWS') YIELD source, nodes, levels
+
+typedef struct {
+	Graph *g;              // graph scanned
+	GrB_Index k;           // number of sources
+	GrB_Index i;           // current source
+	NodeID *sources;       // source node IDs
+	GrB_Matrix levels;     // levels[i, j] hops from source i to node j
+	GxB_Iterator it;       // levels row iterator
+	SIValue *output;       // array with a maximum of 3 entries
+	SIValue *yield_source; // yield source node
+	SIValue *yield_nodes;  // yield reachable nodes
+	SIValue *yield_levels; // yield levels of reachable nodes
+} MSBFSCtx;
+
+static void _process_yield
+(
+	MSBFSCtx *ctx,
+	const char **yield
+) {
+	ctx->yield_source = NULL;
+	ctx->yield_nodes  = NULL;
+	ctx->yield_levels = NULL;
+
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("source", yield[i]) == 0) {
+			ctx->yield_source = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("nodes", yield[i]) == 0) {
+			ctx->yield_nodes = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("levels", yield[i]) == 0) {
+			ctx->yield_levels = ctx->output + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+static ProcedureResult Proc_MSBFS_Invoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// validate inputs
+	ASSERT(ctx   !=  NULL);
+	ASSERT(args  !=  NULL);
+
+	if(array_len((SIValue *)args) != 3) return PROCEDURE_ERR;
+	if(SI_TYPE(args[0]) != T_ARRAY                ||   // source nodes
+	   SI_TYPE(args[1]) != T_INT64                ||   // max level to iterate to, unlimited if 0
+	   !(SI_TYPE(args[2]) & (T_NULL | T_STRING)))      // relationship type to traverse if not NULL
+		return PROCEDURE_ERR;
+
+	if(args[1].longval < 0) {
+		ErrorCtx_SetError("algo.MSBFS max level must be a non-negative integer");
+		return PROCEDURE_ERR;
+	}
+
+	SIValue sources = args[0];
+	uint32_t k = SIArray_Length(sources);
+	for(uint32_t i = 0; i < k; i++) {
+		if(SI_TYPE(SIArray_Get(sources, i)) != T_NODE) {
+			ErrorCtx_SetError("algo.MSBFS expects a list of source nodes");
+			return PROCEDURE_ERR;
+		}
+	}
+
+	MSBFSCtx *bfs_ctx = ctx->privateData;
+	_process_yield(bfs_ctx, yield);
+
+	//--------------------------------------------------------------------------
+	// Process inputs
+	//--------------------------------------------------------------------------
+
+	int64_t max_level = args[1].longval;
+	const char *reltype = SIValue_IsNull(args[2]) ? NULL : args[2].stringval;
+
+	bfs_ctx->k = k;
+	bfs_ctx->sources = rm_malloc(sizeof(NodeID) * k);
+	for(uint32_t i = 0; i < k; i++) {
+		Node *n = SIArray_Get(sources, i).ptrval;
+		bfs_ctx->sources[i] = ENTITY_GET_ID(n);
+	}
+
+	// get edge matrix
+	GrB_Matrix    R    =  NULL;
+	GraphContext  *gc  =  QueryCtx_GetGraphCtx();
+
+	if(reltype == NULL) {
+		RG_Matrix_export(&R, Graph_GetAdjacencyMatrix(gc->g, false));
+	} else {
+		Schema *s = GraphContext_GetSchema(gc, reltype, SCHEMA_EDGE);
+		// unknown relationship type, sources reach nothing
+		if(s != NULL) {
+			RG_Matrix_export(&R, Graph_GetRelationMatrix(gc->g, s->id, false));
+		} else {
+			GrB_Index n = Graph_RequiredMatrixDim(gc->g);
+			GrB_Matrix_new(&R, GrB_BOOL, n, n);
+		}
+	}
+
+	GrB_Info res = MSBFS(&bfs_ctx->levels, R, bfs_ctx->sources, k, max_level);
+	UNUSED(res);
+	ASSERT(res == GrB_SUCCESS);
+
+	res = GxB_Iterator_new(&bfs_ctx->it);
+	ASSERT(res == GrB_SUCCESS);
+	res = GxB_rowIterator_attach(bfs_ctx->it, bfs_ctx->levels, NULL);
+	ASSERT(res == GrB_SUCCESS);
+
+	GrB_Matrix_free(&R);
+
+	return PROCEDURE_OK;
+}
+
+static SIValue *Proc_MSBFS_Step
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData);
+
+	MSBFSCtx *bfs_ctx = (MSBFSCtx *)ctx->privateData;
+
+	// all sources emitted
+	if(bfs_ctx->i >= bfs_ctx->k) return NULL;
+
+	GrB_Index i = bfs_ctx->i++;
+	bool yield_nodes  = (bfs_ctx->yield_nodes  != NULL);
+	bool yield_levels = (bfs_ctx->yield_levels != NULL);
+
+	SIValue nodes;
+	SIValue levels;
+	if(yield_nodes)  nodes  = SI_Array(0);
+	if(yield_levels) levels = SI_Array(0);
+
+	// scan source's row, each entry is a reachable node
+	GxB_Iterator it = bfs_ctx->it;
+	GrB_Info res = GxB_rowIterator_seekRow(it, i);
+	if(res != GxB_EXHAUSTED && GxB_rowIterator_getRowIndex(it) != i) {
+		// row is empty, iterator landed on a later row
+		res = GxB_EXHAUSTED;
+	}
+
+	while(res == GrB_SUCCESS) {
+		if(yield_nodes) {
+			Node n = GE_NEW_NODE();
+			Graph_GetNode(bfs_ctx->g, GxB_rowIterator_getColIndex(it), &n);
+			SIArray_Append(&nodes, SI_Node(&n));
+		}
+
+		if(yield_levels) {
+			SIArray_Append(&levels, SI_LongVal(GxB_Iterator_get_INT64(it)));
+		}
+
+		res = GxB_rowIterator_nextCol(it);
+	}
+
+	// populate output
+	if(bfs_ctx->yield_source) {
+		Node source = GE_NEW_NODE();
+		Graph_GetNode(bfs_ctx->g, bfs_ctx->sources[i], &source);
+		*bfs_ctx->yield_source = SI_Node(&source);
+	}
+	if(yield_nodes)  *bfs_ctx->yield_nodes  = nodes;
+	if(yield_levels) *bfs_ctx->yield_levels = levels;
+
+	return bfs_ctx->output;
+}
+
+static ProcedureResult Proc_MSBFS_Free
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx != NULL);
+
+	// free private data
+	MSBFSCtx *pdata = ctx->privateData;
+
+	if(pdata->it       !=  NULL)  GxB_Iterator_free(&pdata->it);
+	if(pdata->output   !=  NULL)  array_free(pdata->output);
+	if(pdata->levels   !=  NULL)  GrB_Matrix_free(&pdata->levels);
+	if(pdata->sources  !=  NULL)  rm_free(pdata->sources);
+
+	rm_free(ctx->privateData);
+
+	return PROCEDURE_OK;
+}
+
+static MSBFSCtx *_Build_Private_Data() {
+	// set up the MSBFS context
+	MSBFSCtx *pdata = rm_calloc(1, sizeof(MSBFSCtx));
+
+	pdata->g       =  QueryCtx_GetGraph();
+	pdata->output  =  array_new(SIValue, 3);
+
+	return pdata;
+}
+
+ProcedureCtx *Proc_MSBFS_Ctx() {
+	// Construct procedure private data.
+	void *privdata = _Build_Private_Data();
+
+	// Declare possible outputs.
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 3);
+	ProcedureOutput out_source = {.name = "source", .type = T_NODE};
+	ProcedureOutput out_nodes  = {.name = "nodes",  .type = T_ARRAY};
+	ProcedureOutput out_levels = {.name = "levels", .type = T_ARRAY};
+	array_append(outputs, out_source);
+	array_append(outputs, out_nodes);
+	array_append(outputs, out_levels);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.MSBFS",
+								   3,
+								   outputs,
+								   Proc_MSBFS_Step,
+								   Proc_MSBFS_Invoke,
+								   Proc_MSBFS_Free,
+								   privdata,
+								   true);
+	return ctx;
+}
@@ -5,11 +5,15 @@
  */
 
 #include "proc_pagerank.h"
+#include <limits.h>
 #include "../RG.h"
 #include "../value.h"
 #include "../util/arr.h"
 #include "../query_ctx.h"
 #include "../util/rmalloc.h"
+#include "../errors.h"
+#include "../datatypes/map.h"
+#include "../datatypes/array.h"
 #include "../graph/graphcontext.h"
 #include "../algorithms/pagerank.h"
 
@@ -17,6 +21,13 @@
 // CALL algo.pageRank('Page', NULL)    YIELD node, score
 // CALL algo.pageRank(NULL, 'LINKS')   YIELD node, score
 // CALL algo.pageRank('Page', 'LINKS') YIELD node, score
+// CALL algo.pageRank('Page', 'LINKS', {tolerance: 0.001, maxIterations: 20})
+// CALL algo.pageRank('Page', 'LINKS', {sourceNodes: [n]}) YIELD node, score
+// CALL algo.pageRank('Page', 'LINKS', {warmStart: true})
+
+// pagerank config defaults
+#define PAGERANK_DEFAULT_TOLERANCE 1e-4
+#define PAGERANK_DEFAULT_MAX_ITERATIONS 100
 
 typedef struct {
 	int n;                          // number of nodes to rank
@@ -51,14 +62,187 @@ static void _process_yield
 	}
 }
 
+typedef struct {
+	double tol;         // stop when norm (r-rnew,2) < tol
+	int itermax;        // max number of iterations
+	SIValue sources;    // personalization, array of nodes
+	bool warm_start;    // start from, and persist, last ranking
+} PagerankConfig;
+
+// parse pagerank configuration map
+// returns false and sets an error if the configuration is invalid
+static bool _parse_config
+(
+	SIValue map,
+	PagerankConfig *config
+) {
+	config->tol        = PAGERANK_DEFAULT_TOLERANCE;
+	config->itermax    = PAGERANK_DEFAULT_MAX_ITERATIONS;
+	config->sources    = SI_NullVal();
+	config->warm_start = false;
+
+	if(SI_TYPE(map) == T_NULL) return true;
+
+	uint key_count = Map_KeyCount(map);
+	for(uint i = 0; i < key_count; i++) {
+		SIValue key;
+		SIValue val;
+		Map_GetIdx(map, i, &key, &val);
+		const char *k = key.stringval;
+
+		if(strcmp(k, "tolerance") == 0) {
+			if(!(SI_TYPE(val) & SI_NUMERIC) || SI_GET_NUMERIC(val) <= 0) {
+				ErrorCtx_SetError("tolerance must be a positive number");
+				return false;
+			}
+			config->tol = SI_GET_NUMERIC(val);
+		} else if(strcmp(k, "maxIterations") == 0) {
+			if(SI_TYPE(val) != T_INT64 || val.longval <= 0 ||
+					val.longval > INT_MAX) {
+				ErrorCtx_SetError("maxIterations must be a positive integer");
+				return false;
+			}
+			config->itermax = val.longval;
+		} else if(strcmp(k, "sourceNodes") == 0) {
+			bool valid = SI_TYPE(val) == T_ARRAY;
+			uint32_t l = valid ? SIArray_Length(val) : 0;
+			for(uint32_t j = 0; j < l && valid; j++) {
+				valid = SI_TYPE(SIArray_Get(val, j)) == T_NODE;
+			}
+			if(!valid) {
+				ErrorCtx_SetError("sourceNodes must be a list of nodes");
+				return false;
+			}
+			config->sources = val;
+		} else if(strcmp(k, "warmStart") == 0) {
+			if(SI_TYPE(val) != T_BOOL) {
+				ErrorCtx_SetError("warmStart must be a boolean");
+				return false;
+			}
+			config->warm_start = val.longval;
+		} else {
+			ErrorCtx_SetError("Unknown pageRank configuration key '%s'", k);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// rankings are persisted per (label, relation) pair
+static char *_ranking_key
+(
+	const char *label,
+	const char *relation
+) {
+	char *key;
+	asprintf(&key, "pagerank|%s|%s", (label) ? label : "",
+			(relation) ? relation : "");
+	return key;
+}
+
+// build personalization vector, 1 for each source node within the ranked set
+static GrB_Vector _personalization
+(
+	SIValue sources,           // array of nodes
+	const GrB_Index *mapping,  // sorted ranked node ids, NULL for all nodes
+	GrB_Index n                // number of ranked nodes
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Vector p;
+	info = GrB_Vector_new(&p, GrB_FP32, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	uint32_t l = SIArray_Length(sources);
+	for(uint32_t i = 0; i < l; i++) {
+		SIValue v = SIArray_Get(sources, i);
+		GrB_Index id = ENTITY_GET_ID((Node *)v.ptrval);
+
+		if(mapping == NULL) {
+			// node outside of the ranked set
+			if(id >= n) continue;
+		} else {
+			// binary search node id within mapping
+			GrB_Index lo = 0;
+			GrB_Index hi = n;
+			while(lo < hi) {
+				GrB_Index mid = lo + (hi - lo) / 2;
+				if(mapping[mid] < id) lo = mid + 1;
+				else hi = mid;
+			}
+			// node outside of the ranked set
+			if(lo == n || mapping[lo] != id) continue;
+			id = lo;
+		}
+
+		info = GrB_Vector_setElement_FP32(p, 1, id);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	return p;
+}
+
+// initial ranking for a warm start from a ranking indexed by node id
+static GrB_Vector _warm_start
+(
+	GrB_Vector stored,         // persisted ranking
+	const GrB_Index *mapping,  // ranked node ids, NULL for all nodes
+	GrB_Index n,               // number of ranked nodes
+	GrB_Index node_count       // graph's node id range
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	// nodes created since the ranking was stored have no initial rank
+	info = GxB_Vector_resize(stored, node_count);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(mapping == NULL) return stored;
+
+	GrB_Vector r0;
+	info = GrB_Vector_new(&r0, GrB_FP32, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_extract(r0, NULL, NULL, stored, mapping, n, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&stored);
+	return r0;
+}
+
+// map ranking of ranked nodes back to node ids
+static GrB_Vector _ranking_by_node_id
+(
+	GrB_Vector rank,           // ranking of ranked nodes
+	const GrB_Index *mapping,  // ranked node ids, NULL for all nodes
+	GrB_Index n,               // number of ranked nodes
+	GrB_Index node_count       // graph's node id range
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	if(mapping == NULL) return rank;
+
+	GrB_Vector v;
+	info = GrB_Vector_new(&v, GrB_FP32, node_count);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_assign(v, NULL, NULL, rank, mapping, n, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&rank);
+	return v;
+}
+
 ProcedureResult Proc_PagerankInvoke
 (
 	ProcedureCtx *ctx,
 	const SIValue *args,
 	const char **yield
 ) {
-	// expecting 2 arguments
-	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+	// expecting 2 or 3 arguments
+	uint argc = array_len((SIValue *)args);
+	if(argc < 2 || argc > 3) return PROCEDURE_ERR;
 
 	// arg0 and arg1 can be either String or NULL
 	SIType arg0_t = SI_TYPE(args[0]);
@@ -66,6 +250,13 @@ ProcedureResult Proc_PagerankInvoke
 	if(!(arg0_t & (T_STRING | T_NULL))) return PROCEDURE_ERR;
 	if(!(arg1_t & (T_STRING | T_NULL))) return PROCEDURE_ERR;
 
+	// arg2 is an optional configuration map
+	SIValue arg2 = (argc == 3) ? args[2] : SI_NullVal();
+	if(!(SI_TYPE(arg2) & (T_MAP | T_NULL))) {
+		ErrorCtx_SetError("pageRank configuration must be a map");
+		return PROCEDURE_ERR;
+	}
+
 	// read arguments
 	const char *label = NULL;    // node filter
 	const char *relation = NULL; // edge filter
@@ -74,8 +265,8 @@ ProcedureResult Proc_PagerankInvoke
 
 	// pagerank config arguments
 	int iters;               // iterations performed
-	const double tol = 1e-4; // tolerance
-	const int itermax = 100; // max iterations
+	PagerankConfig config;
+	if(!_parse_config(arg2, &config)) return PROCEDURE_ERR;
 
 	GrB_Info info;
 	UNUSED(info);
@@ -86,10 +277,14 @@ ProcedureResult Proc_PagerankInvoke
 	Schema *s = NULL;
 	GrB_Matrix l = NULL;           // label matrix
 	GrB_Matrix r = NULL;           // relation matrix
+	GrB_Vector p = NULL;           // personalization
+	GrB_Vector r0 = NULL;          // initial ranking
+	GrB_Vector rank = NULL;        // computed ranking
 	GrB_Index *mapping = NULL;     // mapping, array for returning row indices of tuples
 	Graph *g = QueryCtx_GetGraph();
 	LAGraph_PageRank *ranking = NULL;
 	GraphContext *gc = QueryCtx_GetGraphCtx();
+	GrB_Index node_count = Graph_UncompactedNodeCount(g);
 
 	// setup context
 	PagerankContext *pdata = rm_malloc(sizeof(PagerankContext));
@@ -116,7 +311,10 @@ ProcedureResult Proc_PagerankInvoke
 	if(relation) {
 		s = GraphContext_GetSchema(gc, relation, SCHEMA_EDGE);
 		// unknown relation, quickly return
-		if(!s) return PROCEDURE_OK;
+		if(!s) {
+			if(l) GrB_free(&l);
+			return PROCEDURE_OK;
+		}
 		RG_Matrix_export(&r, Graph_GetRelationMatrix(g, s->id, false));
 
 		// convert the values to true
@@ -155,7 +353,7 @@ ProcedureResult Proc_PagerankInvoke
 		r = reduced;
 	} else {
 		// resize to remove unused rows
-		n = Graph_UncompactedNodeCount(g);
+		n = node_count;
 		GxB_Matrix_resize(r, n, n);
 	}
 
@@ -164,8 +362,31 @@ ProcedureResult Proc_PagerankInvoke
 	ASSERT(info == GrB_SUCCESS);
 
 	if(nvals > 0) {
-		info = Pagerank(&ranking, r, itermax, tol, &iters);
+		char *key = NULL;
+		bool personalized = SI_TYPE(config.sources) == T_ARRAY;
+		if(personalized) p = _personalization(config.sources, mapping, n);
+
+		// warm start from the last non personalized ranking
+		if(config.warm_start) {
+			key = _ranking_key(label, relation);
+			GrB_Vector stored = GraphContext_GetRanking(gc, key);
+			if(stored != NULL) {
+				r0 = _warm_start(stored, mapping, n, node_count);
+			}
+		}
+
+		info = Pagerank_Personalized(&ranking, &rank, r, r0, p,
+				config.itermax, config.tol, &iters);
 		ASSERT(info == GrB_SUCCESS);
+
+		// persist ranking for future warm starts
+		if(config.warm_start && !personalized) {
+			rank = _ranking_by_node_id(rank, mapping, n, node_count);
+			GraphContext_SetRanking(gc, key, rank);
+			rank = NULL;
+		}
+
+		if(key) free(key);
 	}
 
 	// clean up
@@ -173,6 +394,9 @@ ProcedureResult Proc_PagerankInvoke
 	if(label) {
 		GrB_free(&l);
 	}
+	if(p)    GrB_free(&p);
+	if(r0)   GrB_free(&r0);
+	if(rank) GrB_free(&rank);
 
 	// update context
 	pdata->n        =  n;
@@ -228,7 +452,7 @@ ProcedureCtx *Proc_PagerankCtx() {
 	array_append(outputs, output_score);
 
 	ProcedureCtx *ctx = ProcCtxNew("algo.pageRank",
-								   2,
+								   PROCEDURE_VARIABLE_ARG_COUNT,
 								   outputs,
 								   Proc_PagerankStep,
 								   Proc_PagerankInvoke,
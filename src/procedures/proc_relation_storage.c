@@ -0,0 +1,202 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_relation_storage.h"
+#include "RG.h"
+#include "../value.h"
+#include "../errors.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+
+#define STORAGE_UNCOMPRESSED "uncompressed"
+#define STORAGE_COMPRESSED   "compressed"
+
+//------------------------------------------------------------------------------
+// set relation storage
+//------------------------------------------------------------------------------
+
+// CALL db.relationshipTypes.setStorage(relationshipType, storage)
+// CALL db.relationshipTypes.setStorage('TRANSACTION', 'compressed')
+
+ProcedureResult Proc_SetRelationStorageInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+	if(!(SI_TYPE(args[0]) & SI_TYPE(args[1]) & T_STRING)) {
+		ErrorCtx_SetError("Relationship type and storage must be strings");
+		return PROCEDURE_ERR;
+	}
+
+	const char *relation = args[0].stringval;
+	const char *storage  = args[1].stringval;
+
+	bool compress;
+	if(strcasecmp(storage, STORAGE_COMPRESSED) == 0) {
+		compress = true;
+	} else if(strcasecmp(storage, STORAGE_UNCOMPRESSED) == 0) {
+		compress = false;
+	} else {
+		ErrorCtx_SetError("Storage must be either 'compressed' or 'uncompressed'");
+		return PROCEDURE_ERR;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, relation, SCHEMA_EDGE);
+	if(s == NULL) {
+		ErrorCtx_SetError("Relationship type '%s' does not exist", relation);
+		return PROCEDURE_ERR;
+	}
+
+	RG_Matrix R = Graph_GetRelationMatrix(gc->g, Schema_GetID(s), false);
+
+	if(!compress) {
+		RG_Matrix_thaw(R);
+		return PROCEDURE_OK;
+	}
+
+	if(RG_Matrix_freeze(R) != GrB_SUCCESS) {
+		ErrorCtx_SetError("Relationship type '%s' is used by an algebraic view",
+				relation);
+		return PROCEDURE_ERR;
+	}
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_SetRelationStorageStep
+(
+	ProcedureCtx *ctx
+) {
+	return NULL;
+}
+
+ProcedureResult Proc_SetRelationStorageFree
+(
+	ProcedureCtx *ctx
+) {
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_SetRelationStorageGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.relationshipTypes.setStorage",
+								   2,
+								   output,
+								   Proc_SetRelationStorageStep,
+								   Proc_SetRelationStorageInvoke,
+								   Proc_SetRelationStorageFree,
+								   privateData,
+								   false);
+	return ctx;
+}
+
+//------------------------------------------------------------------------------
+// list relation storage
+//------------------------------------------------------------------------------
+
+// CALL db.relationshipTypes.storage()
+// YIELD relationshipType, storage, memoryUsage
+
+typedef struct {
+	uint schema_id;     // current schema ID
+	GraphContext *gc;   // graph context
+	SIValue *output;    // output record
+} RelationStorageContext;
+
+ProcedureResult Proc_RelationStorageInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 0) return PROCEDURE_ERR;
+
+	RelationStorageContext *pdata = rm_malloc(sizeof(RelationStorageContext));
+
+	pdata->schema_id  =  0;
+	pdata->gc         =  QueryCtx_GetGraphCtx();
+	pdata->output     =  array_new(SIValue, 3);
+
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_RelationStorageStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData != NULL);
+
+	RelationStorageContext *pdata = ctx->privateData;
+
+	// depleted?
+	if(pdata->schema_id >= GraphContext_SchemaCount(pdata->gc, SCHEMA_EDGE)) {
+		return NULL;
+	}
+
+	int id = pdata->schema_id++;
+	Schema *s = GraphContext_GetSchemaByID(pdata->gc, id, SCHEMA_EDGE);
+	RG_Matrix R = Graph_GetRelationMatrix(pdata->gc->g, id, false);
+
+	// relation matrix and its maintained transpose
+	size_t size   = 0;
+	size_t t_size = 0;
+	RG_Matrix_memoryUsage(&size, R);
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(R)) {
+		RG_Matrix_memoryUsage(&t_size, R->transposed);
+	}
+
+	const char *storage = RG_Matrix_isFrozen(R) ?
+		STORAGE_COMPRESSED : STORAGE_UNCOMPRESSED;
+
+	array_clear(pdata->output);
+	array_append(pdata->output, SI_ConstStringVal(Schema_GetName(s)));
+	array_append(pdata->output, SI_ConstStringVal(storage));
+	array_append(pdata->output, SI_LongVal(size + t_size));
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_RelationStorageFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(ctx->privateData) {
+		RelationStorageContext *pdata = ctx->privateData;
+		array_free(pdata->output);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_RelationStorageGen() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 3);
+	ProcedureOutput out_relation = {.name = "relationshipType", .type = T_STRING};
+	ProcedureOutput out_storage = {.name = "storage", .type = T_STRING};
+	ProcedureOutput out_memory = {.name = "memoryUsage", .type = T_INT64};
+	array_append(outputs, out_relation);
+	array_append(outputs, out_storage);
+	array_append(outputs, out_memory);
+
+	ProcedureCtx *ctx = ProcCtxNew("db.relationshipTypes.storage",
+								   0,
+								   outputs,
+								   Proc_RelationStorageStep,
+								   Proc_RelationStorageInvoke,
+								   Proc_RelationStorageFree,
+								   privateData,
+								   true);
+	return ctx;
+}
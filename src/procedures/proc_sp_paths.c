@@ -171,7 +171,7 @@ static void SinglePairCtx_New
 	ctx->relationIDs    =  relationIDs;
 	ctx->relationCount  =  relationCount;
 	ctx->levels         =  array_new(LevelConnection *, 1);
-	ctx->path           =  Path_New(1);
+	ctx->path           =  Path_New(g, 1);
 	ctx->neighbors      =  array_new(Edge, 32);
 	ctx->dst            =  dst;
 
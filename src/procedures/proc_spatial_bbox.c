@@ -0,0 +1,140 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_spatial_bbox.h"
+#include "RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../index/index.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+
+//------------------------------------------------------------------------------
+// spatial withinBBox
+//------------------------------------------------------------------------------
+
+// CALL db.idx.spatial.withinBBox(label, property, lowerLeft, upperRight)
+
+typedef struct {
+	Node n;
+	Graph *g;
+	SIValue *output;
+	EntityID *ids;         // nodes within bounding box
+	uint64_t idx;          // next node to produce
+	SIValue *yield_node;   // yield node
+} BBoxContext;
+
+static void _process_yield
+(
+	BBoxContext *ctx,
+	const char **yield
+) {
+	ctx->yield_node = NULL;
+
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("node", yield[i]) == 0) {
+			ctx->yield_node = ctx->output;
+			continue;
+		}
+	}
+}
+
+ProcedureResult Proc_SpatialBBoxInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 4) return PROCEDURE_ERR;
+	if(!(SI_TYPE(args[0]) & SI_TYPE(args[1]) & T_STRING)) return PROCEDURE_ERR;
+	if(!(SI_TYPE(args[2]) & SI_TYPE(args[3]) & T_POINT)) return PROCEDURE_ERR;
+
+	ctx->privateData = NULL;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	const char *label     = args[0].stringval;
+	const char *attribute = args[1].stringval;
+
+	// get spatial index from schema
+	Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+	if(s == NULL) return PROCEDURE_OK;
+
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attribute);
+	if(attr_id == ATTRIBUTE_ID_NONE) return PROCEDURE_OK;
+
+	Index *idx = Schema_GetIndex(s, &attr_id, IDX_EXACT_MATCH);
+	if(idx == NULL) return PROCEDURE_ERR;
+
+	GeoIndex *geo = Index_GetGeoIndex(idx, attr_id);
+	// no point values were indexed
+	if(geo == NULL) return PROCEDURE_OK;
+
+	ctx->privateData = rm_malloc(sizeof(BBoxContext));
+	BBoxContext *pdata = ctx->privateData;
+
+	pdata->g      = gc->g;
+	pdata->n      = GE_NEW_NODE();
+	pdata->idx    = 0;
+	pdata->ids    = GeoIndex_BoundingBox(geo, args[2], args[3]);
+	pdata->output = array_new(SIValue, 1);
+
+	_process_yield(pdata, yield);
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_SpatialBBoxStep
+(
+	ProcedureCtx *ctx
+) {
+	if(!ctx->privateData) return NULL; // no index was attached to this procedure
+
+	BBoxContext *pdata = (BBoxContext *)ctx->privateData;
+
+	// depleted
+	if(pdata->idx == array_len(pdata->ids)) return NULL;
+
+	// get node
+	Node *n = &pdata->n;
+	Graph_GetNode(pdata->g, pdata->ids[pdata->idx++], n);
+
+	if(pdata->yield_node) *pdata->yield_node = SI_Node(n);
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_SpatialBBoxFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(!ctx->privateData) return PROCEDURE_OK;
+
+	BBoxContext *pdata = ctx->privateData;
+	array_free(pdata->ids);
+	array_free(pdata->output);
+	rm_free(pdata);
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_SpatialBBoxGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output  = array_new(ProcedureOutput, 1);
+	ProcedureOutput out_node = {.name = "node", .type = T_NODE};
+	array_append(output, out_node);
+
+	ProcedureCtx *ctx = ProcCtxNew("db.idx.spatial.withinBBox",
+								   4,
+								   output,
+								   Proc_SpatialBBoxStep,
+								   Proc_SpatialBBoxInvoke,
+								   Proc_SpatialBBoxFree,
+								   privateData,
+								   true);
+	return ctx;
+}
@@ -168,7 +168,7 @@ static void SingleSourceCtx_New
 	ctx->relationIDs    =  relationIDs;
 	ctx->relationCount  =  relationCount;
 	ctx->levels         =  array_new(LevelConnection *, 1);
-	ctx->path           =  Path_New(1);
+	ctx->path           =  Path_New(g, 1);
 	ctx->neighbors      =  array_new(Edge, 32);
 
 	_SingleSourceCtx_EnsureLevelArrayCap(ctx, 0, 1);
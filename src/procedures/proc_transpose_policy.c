@@ -0,0 +1,188 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_transpose_policy.h"
+#include "RG.h"
+#include "../value.h"
+#include "../errors.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+
+static const char *_policy_names[] = {"always", "lazy", "never"};
+
+//------------------------------------------------------------------------------
+// set transpose policy
+//------------------------------------------------------------------------------
+
+// CALL db.relationshipTypes.setTransposePolicy(relationshipType, policy)
+// CALL db.relationshipTypes.setTransposePolicy('KNOWS', 'never')
+
+ProcedureResult Proc_SetTransposePolicyInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+	if(!(SI_TYPE(args[0]) & SI_TYPE(args[1]) & T_STRING)) {
+		ErrorCtx_SetError("Relationship type and policy must be strings");
+		return PROCEDURE_ERR;
+	}
+
+	const char *relation = args[0].stringval;
+	const char *policy_name = args[1].stringval;
+
+	int policy = -1;
+	for(int i = RG_TRANSPOSE_ALWAYS; i <= RG_TRANSPOSE_NEVER; i++) {
+		if(strcasecmp(policy_name, _policy_names[i]) == 0) {
+			policy = i;
+			break;
+		}
+	}
+
+	if(policy == -1) {
+		ErrorCtx_SetError("Transpose policy must be one of 'always', 'lazy' or 'never'");
+		return PROCEDURE_ERR;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, relation, SCHEMA_EDGE);
+	if(s == NULL) {
+		ErrorCtx_SetError("Relationship type '%s' does not exist", relation);
+		return PROCEDURE_ERR;
+	}
+
+	RG_Matrix R = Graph_GetRelationMatrix(gc->g, Schema_GetID(s), false);
+	RG_Matrix_setTransposePolicy(R, policy);
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_SetTransposePolicyStep
+(
+	ProcedureCtx *ctx
+) {
+	return NULL;
+}
+
+ProcedureResult Proc_SetTransposePolicyFree
+(
+	ProcedureCtx *ctx
+) {
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_SetTransposePolicyGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.relationshipTypes.setTransposePolicy",
+								   2,
+								   output,
+								   Proc_SetTransposePolicyStep,
+								   Proc_SetTransposePolicyInvoke,
+								   Proc_SetTransposePolicyFree,
+								   privateData,
+								   false);
+	return ctx;
+}
+
+//------------------------------------------------------------------------------
+// list transpose policies
+//------------------------------------------------------------------------------
+
+// CALL db.relationshipTypes.transposePolicies()
+// YIELD relationshipType, policy, maintained, memorySaved
+
+typedef struct {
+	uint schema_id;     // current schema ID
+	GraphContext *gc;   // graph context
+	SIValue *output;    // output record
+} TransposePoliciesContext;
+
+ProcedureResult Proc_TransposePoliciesInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 0) return PROCEDURE_ERR;
+
+	TransposePoliciesContext *pdata = rm_malloc(sizeof(TransposePoliciesContext));
+
+	pdata->schema_id  =  0;
+	pdata->gc         =  QueryCtx_GetGraphCtx();
+	pdata->output     =  array_new(SIValue, 4);
+
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_TransposePoliciesStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData != NULL);
+
+	TransposePoliciesContext *pdata = ctx->privateData;
+
+	// depleted?
+	if(pdata->schema_id >= GraphContext_SchemaCount(pdata->gc, SCHEMA_EDGE)) {
+		return NULL;
+	}
+
+	int id = pdata->schema_id++;
+	Schema *s = GraphContext_GetSchemaByID(pdata->gc, id, SCHEMA_EDGE);
+	RG_Matrix R = Graph_GetRelationMatrix(pdata->gc->g, id, false);
+	RG_TransposePolicy policy = RG_Matrix_getTransposePolicy(R);
+
+	array_clear(pdata->output);
+	array_append(pdata->output, SI_ConstStringVal(Schema_GetName(s)));
+	array_append(pdata->output, SI_ConstStringVal(_policy_names[policy]));
+	array_append(pdata->output, SI_BoolVal(RG_MATRIX_MAINTAIN_TRANSPOSE(R)));
+	array_append(pdata->output,
+			SI_LongVal(RG_Matrix_transposeMemorySaved(R)));
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_TransposePoliciesFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(ctx->privateData) {
+		TransposePoliciesContext *pdata = ctx->privateData;
+		array_free(pdata->output);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_TransposePoliciesGen() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 4);
+	ProcedureOutput out_relation = {.name = "relationshipType", .type = T_STRING};
+	ProcedureOutput out_policy = {.name = "policy", .type = T_STRING};
+	ProcedureOutput out_maintained = {.name = "maintained", .type = T_BOOL};
+	ProcedureOutput out_saved = {.name = "memorySaved", .type = T_INT64};
+	array_append(outputs, out_relation);
+	array_append(outputs, out_policy);
+	array_append(outputs, out_maintained);
+	array_append(outputs, out_saved);
+
+	ProcedureCtx *ctx = ProcCtxNew("db.relationshipTypes.transposePolicies",
+								   0,
+								   outputs,
+								   Proc_TransposePoliciesStep,
+								   Proc_TransposePoliciesInvoke,
+								   Proc_TransposePoliciesFree,
+								   privateData,
+								   true);
+	return ctx;
+}
@@ -31,9 +31,17 @@ void Proc_Register() {
 	_procRegister("db.propertyKeys", Proc_PropKeysCtx);
 	_procRegister("dbms.procedures", Proc_ProceduresCtx);
 	_procRegister("db.relationshipTypes", Proc_RelationsCtx);
+	_procRegister("db.relationshipTypes.transposePolicies", Proc_TransposePoliciesGen);
+	_procRegister("db.relationshipTypes.setTransposePolicy", Proc_SetTransposePolicyGen);
+	_procRegister("db.relationshipTypes.storage", Proc_RelationStorageGen);
+	_procRegister("db.relationshipTypes.setStorage", Proc_SetRelationStorageGen);
+	_procRegister("db.algebraicViews", Proc_AlgebraicViewsGen);
+	_procRegister("db.algebraicView.drop", Proc_AlgebraicViewDropGen);
+	_procRegister("db.algebraicView.create", Proc_AlgebraicViewCreateGen);
 
 	// Register graph algorithms.
 	_procRegister("algo.BFS", Proc_BFS_Ctx);
+	_procRegister("algo.MSBFS", Proc_MSBFS_Ctx);
 	_procRegister("algo.pageRank", Proc_PagerankCtx);
 	_procRegister("algo.SPpaths", Proc_SPpathCtx);
 	_procRegister("algo.SSpaths", Proc_SSpathCtx);
@@ -42,6 +50,9 @@ void Proc_Register() {
 	_procRegister("db.idx.fulltext.drop", Proc_FulltextDropIdxGen);
 	_procRegister("db.idx.fulltext.queryNodes", Proc_FulltextQueryNodeGen);
 	_procRegister("db.idx.fulltext.createNodeIndex", Proc_FulltextCreateNodeIdxGen);
+
+	// Register spatial index generator.
+	_procRegister("db.idx.spatial.withinBBox", Proc_SpatialBBoxGen);
 }
 
 ProcedureCtx *ProcCtxNew(const char *name,
@@ -7,14 +7,19 @@
 #pragma once
 
 #include "proc_bfs.h"
+#include "proc_msbfs.h"
 #include "proc_labels.h"
 #include "proc_pagerank.h"
 #include "proc_sp_paths.h"
 #include "proc_ss_paths.h"
 #include "proc_relations.h"
 #include "proc_procedures.h"
+#include "proc_relation_storage.h"
 #include "proc_list_indexes.h"
 #include "proc_property_keys.h"
+#include "proc_spatial_bbox.h"
+#include "proc_algebraic_view.h"
+#include "proc_transpose_policy.h"
 #include "proc_fulltext_query.h"
 #include "proc_fulltext_drop_index.h"
 #include "proc_fulltext_create_index.h"
@@ -91,6 +91,11 @@ void QueryCtx_SetParams(rax *params) {
 	ctx->query_data.params = params;
 }
 
+void QueryCtx_SetPlanHints(rax *hints) {
+	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
+	ctx->query_data.plan_hints = hints;
+}
+
 AST *QueryCtx_GetAST(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	ASSERT(ctx != NULL);
@@ -103,6 +108,12 @@ rax *QueryCtx_GetParams(void) {
 	return ctx->query_data.params;
 }
 
+rax *QueryCtx_GetPlanHints(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+	return ctx->query_data.plan_hints;
+}
+
 GraphContext *QueryCtx_GetGraphCtx(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	ASSERT(ctx && ctx->gc);
@@ -205,6 +216,22 @@ static void _QueryCtx_UnlockCommit(QueryCtx *ctx) {
 	_QueryCtx_ThreadSafeContextUnlock(ctx);
 }
 
+void QueryCtx_ShareCommitLock
+(
+	const QueryCtx *owner
+) {
+	ASSERT(owner != NULL);
+	ASSERT(owner->gc == QueryCtx_GetGraphCtx());
+	ASSERT(owner->internal_exec_ctx.locked_for_commit);
+
+	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
+	ASSERT(!ctx->internal_exec_ctx.locked_for_commit);
+
+	ctx->internal_exec_ctx.key                = NULL;
+	ctx->internal_exec_ctx.locked_for_commit  = true;
+	ctx->internal_exec_ctx.commit_lock_shared = true;
+}
+
 // replicate command
 void QueryCtx_Replicate
 (
@@ -227,6 +254,13 @@ void QueryCtx_UnlockCommit() {
 	// already unlocked?
 	if(!ctx->internal_exec_ctx.locked_for_commit) return;
 
+	// locks are released by their owner
+	if(ctx->internal_exec_ctx.commit_lock_shared) {
+		ctx->internal_exec_ctx.locked_for_commit  = false;
+		ctx->internal_exec_ctx.commit_lock_shared = false;
+		return;
+	}
+
 	_QueryCtx_UnlockCommit(ctx);
 }
 
@@ -21,6 +21,7 @@ extern pthread_key_t _tlsQueryCtxKey;  // Thread local storage query context key
 typedef struct {
 	AST *ast;                     // The scoped AST associated with this query.
 	rax *params;                  // Query parameters.
+	rax *plan_hints;              // Aliases whose filters were observed to be non-selective.
 	const char *query;            // Query string.
 	const char *query_no_params;  // Query string without parameters part.
 } QueryCtx_QueryData;
@@ -30,6 +31,7 @@ typedef struct {
 	RedisModuleKey *key;        // Saves an open key value, for later extraction and closing.
 	ResultSet *result_set;      // Save the execution result set.
 	bool locked_for_commit;     // Indicates if a call for QueryCtx_LockForCommit issued before.
+	bool commit_lock_shared;    // Indicates commit locks are held by another query.
 } QueryCtx_InternalExecCtx;
 
 typedef struct {
@@ -72,12 +74,16 @@ void QueryCtx_SetGraphCtx(GraphContext *gc);
 void QueryCtx_SetResultSet(ResultSet *result_set);
 /* Set the parameters map. */
 void QueryCtx_SetParams(rax *params);
+/* Set the plan hints used while building an execution plan, NULL clears them. */
+void QueryCtx_SetPlanHints(rax *hints);
 
 /* Getters */
 /* Retrieve the AST. */
 AST *QueryCtx_GetAST(void);
 /* Retrieve the query parameters values map. */
 rax *QueryCtx_GetParams(void);
+/* Retrieve the plan hints, NULL if none were set. */
+rax *QueryCtx_GetPlanHints(void);
 /* Retrieve the Graph object. */
 Graph *QueryCtx_GetGraph(void);
 /* Retrieve the GraphCtx. */
@@ -115,6 +121,14 @@ bool QueryCtx_LockForCommit(void);
  * 4. Unlock GIL */
 void QueryCtx_UnlockCommit();
 
+// share the commit locks held by 'owner' with this thread's query
+// the query commits under the owner's locks without acquiring its own
+// shared locks are released only by their owner
+void QueryCtx_ShareCommitLock
+(
+	const QueryCtx *owner
+);
+
 // replicate command to AOF/Replicas
 void QueryCtx_Replicate
 (
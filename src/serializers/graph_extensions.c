@@ -141,7 +141,7 @@ static void _OptimizedSingleEdgeFormConnection
 	RG_Matrix  M      =  Graph_GetRelationMatrix(g, r, false);
 	RG_Matrix  adj    =  Graph_GetAdjacencyMatrix(g, false);
 	GrB_Matrix m      =  RG_MATRIX_M(M);
-	GrB_Matrix tm     =  RG_MATRIX_TM(M);
+	GrB_Matrix tm     =  RG_MATRIX_MAINTAIN_TRANSPOSE(M) ? RG_MATRIX_TM(M) : NULL;
 	GrB_Matrix adj_m  =  RG_MATRIX_M(adj);
 	GrB_Matrix adj_tm =  RG_MATRIX_TM(adj);
 
@@ -172,8 +172,11 @@ static void _OptimizedSingleEdgeFormConnection
 
 	info = GrB_Matrix_setElement_UINT64(m, edge_id, src, dest);
 	ASSERT(info == GrB_SUCCESS);
-	info = GrB_Matrix_setElement_BOOL(tm, true, dest, src);
-	ASSERT(info == GrB_SUCCESS);
+	// relationship transpose might not be maintained
+	if(tm != NULL) {
+		info = GrB_Matrix_setElement_BOOL(tm, true, dest, src);
+		ASSERT(info == GrB_SUCCESS);
+	}
 
 	// an edge of type r has just been created, update statistics
 	// TODO: stats->edge_count[relation_idx] += nvals;
@@ -11,6 +11,7 @@
 #include "../util/arr.h"
 #include "../query_ctx.h"
 #include "../util/rmalloc.h"
+#include "../util/rax_extensions.h"
 #include "../util/thpool/pools.h"
 
 // redis prints doubles with up to 17 digits of precision, which captures
@@ -311,6 +312,49 @@ void SlowLog_Replay
 	SlowLog_Free(aggregated_slowlog);
 }
 
+size_t SlowLog_MemoryUsage
+(
+	SlowLog *slowlog
+) {
+	ASSERT(slowlog != NULL);
+
+	int my_t_id = ThreadPools_GetThreadID();
+	size_t size = sizeof(SlowLog) + slowlog->count *
+		(sizeof(pthread_mutex_t) + sizeof(rax *) + sizeof(heap_t *));
+
+	for(int t_id = 0; t_id < slowlog->count; t_id++) {
+		// don't lock ourselves
+		if(my_t_id != t_id) {
+			if(pthread_mutex_lock(slowlog->locks + t_id) != 0) {
+				// failed to lock, skip this thread slowlog entries
+				continue;
+			}
+		}
+		{
+			// critical section
+			rax *lookup = slowlog->lookup[t_id];
+			size += raxMemoryUsage(lookup);
+
+			raxIterator iter;
+			raxStart(&iter, lookup);
+			raxSeek(&iter, "^", NULL, 0);
+			while(raxNext(&iter)) {
+				SlowLogItem *item = iter.data;
+				// item, its heap slot and lookup key
+				size += sizeof(SlowLogItem) + sizeof(void *) + iter.key_len +
+					strlen(item->cmd) + strlen(item->query) + 2;
+			}
+			raxStop(&iter);
+			// end of critical section
+		}
+		if(my_t_id != t_id) {
+			pthread_mutex_unlock(slowlog->locks + t_id);
+		}
+	}
+
+	return size;
+}
+
 void SlowLog_Free(SlowLog *slowlog) {
 	for(int i = 0; i < slowlog->count; i++) {
 		rax *lookup = slowlog->lookup[i];
@@ -56,6 +56,12 @@ void SlowLog_Replay
 	RedisModuleCtx *ctx
 );
 
+// Returns the number of bytes used by slowlog.
+size_t SlowLog_MemoryUsage
+(
+	SlowLog *slowlog
+);
+
 // Free slowlog.
 void SlowLog_Free
 (
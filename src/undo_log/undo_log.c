@@ -10,6 +10,16 @@
 #include "../execution_plan/ops/shared/update_functions.h"
 #include "../execution_plan/ops/shared/create_functions.h"
 #include "../graph/entities/attribute_set.h"
+#include "../util/datablock/datablock.h"
+
+// number of undo operations in a chunk
+#define UNDO_CHUNK_SIZE 4096
+// arena block size in bytes
+#define UNDO_ARENA_BLOCK_SIZE 65536
+
+// access the i'th undo operation
+#define UNDO_OP(log, i) \
+	((log)->chunks[(i) / UNDO_CHUNK_SIZE] + ((i) % UNDO_CHUNK_SIZE))
 
 static void _index_node
 (
@@ -122,37 +132,58 @@ static void _UndoLog_Restore_Entity_Property
 static void _UndoLog_Rollback_Update_Entity
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
+	Graph *g = ctx->gc->g;
 	for(int i = seq_start; i > seq_end; --i) {
-		UndoOp *op = undo_list + i;
+		UndoOp *op = UNDO_OP(log, i);
 		UndoUpdateOp *update_op = &op->update_op;
 
+		GraphEntity *ge;
+		Node n;
+		Edge e;
+		if(update_op->entity_type == GETYPE_NODE) {
+			Graph_GetNode(g, update_op->id, &n);
+			ge = (GraphEntity *)&n;
+		} else {
+			UndoEdgeEnds *ends = ((UndoEdgeEnds *)update_op->attributes) - 1;
+			Graph_GetEdge(g, update_op->id, &e);
+			e.srcNodeID  = ends->src;
+			e.destNodeID = ends->dest;
+			e.relationID = ends->relationID;
+			ge = (GraphEntity *)&e;
+		}
+
+		for(uint j = 0; j < update_op->attr_count; j++) {
+			UndoAttribute *attr = update_op->attributes + j;
+			_UndoLog_Restore_Entity_Property(ge, attr->attr_id,
+					attr->orig_value);
+		}
+
 		// update indices
 		if(update_op->entity_type == GETYPE_NODE) {
-			_UndoLog_Restore_Entity_Property((GraphEntity *)&update_op->n, update_op->attr_id,
-				update_op->orig_value);
-			_index_node(ctx, &update_op->n);
+			_index_node(ctx, &n);
 		} else {
-			_UndoLog_Restore_Entity_Property((GraphEntity *)&update_op->e, update_op->attr_id,
-				update_op->orig_value);
-			_index_edge(ctx, &update_op->e);
+			_index_edge(ctx, &e);
 		}
+
+		// values are owned by the entity
+		update_op->attr_count = 0;
 	}
 }
 
 static void _UndoLog_Rollback_Set_Labels
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
 	for(int i = seq_start; i > seq_end; --i) {
 		Graph        *g                = QueryCtx_GetGraph();
-		UndoOp       *op               = undo_list + i;
+		UndoOp       *op               = UNDO_OP(log, i);
 		UndoLabelsOp *update_labels_op = &(op->labels_op);
 		uint         labels_count      = update_labels_op->labels_count;
 
@@ -161,21 +192,19 @@ static void _UndoLog_Rollback_Set_Labels
 				
 		_index_delete_node_with_labels(ctx, &(update_labels_op->node),
 				update_labels_op->label_lds, labels_count);
-
-		array_free(update_labels_op->label_lds);
 	}
 }
 
 static void _UndoLog_Rollback_Remove_Labels
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
 	for(int i = seq_start; i > seq_end; --i) {
 		Graph        *g                = QueryCtx_GetGraph();
-		UndoOp       *op               = undo_list + i;
+		UndoOp       *op               = UNDO_OP(log, i);
 		UndoLabelsOp *update_labels_op = &(op->labels_op);
 		uint         labels_count      = update_labels_op->labels_count;
 
@@ -184,23 +213,36 @@ static void _UndoLog_Rollback_Remove_Labels
 
 		_index_node_with_labels(ctx, &(update_labels_op->node),
 				update_labels_op->label_lds, labels_count);
-
-		array_free(update_labels_op->label_lds);
 	}
 }
 
+// reconstruct created edge
+static inline void _UndoLog_CreatedEdge
+(
+	Graph *g,
+	const UndoCreateOp *op,
+	Edge *e
+) {
+	Graph_GetEdge(g, op->id, e);
+	e->srcNodeID  = op->src;
+	e->destNodeID = op->dest;
+	e->relationID = op->relationID;
+}
+
 // undo node creation
 static void _UndoLog_Rollback_Create_Node
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
+	Graph *g = ctx->gc->g;
 	for(int i = seq_start; i > seq_end; --i) {
-		Node *n = &undo_list[i].create_op.n;
-		_index_delete_node(ctx, n);
-		Graph_DeleteNode(ctx->gc->g, n);
+		Node n;
+		Graph_GetNode(g, UNDO_OP(log, i)->create_op.id, &n);
+		_index_delete_node(ctx, &n);
+		Graph_DeleteNode(g, &n);
 	}
 }
 
@@ -208,14 +250,16 @@ static void _UndoLog_Rollback_Create_Node
 static void _UndoLog_Rollback_Create_Edge
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
+	Graph *g = ctx->gc->g;
 	for(int i = seq_start; i > seq_end; --i) {
-		Edge *e = &undo_list[i].create_op.e;
-		_index_delete_edge(ctx, e);
-		Graph_DeleteEdge(ctx->gc->g, e);
+		Edge e;
+		_UndoLog_CreatedEdge(g, &UNDO_OP(log, i)->create_op, &e);
+		_index_delete_edge(ctx, &e);
+		Graph_DeleteEdge(g, &e);
 	}
 }
 
@@ -223,23 +267,23 @@ static void _UndoLog_Rollback_Create_Edge
 static void _UndoLog_Rollback_Delete_Node
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
 	for(int i = seq_start; i > seq_end; --i) {
 		Node n;
-		UndoOp *op = undo_list + i;
+		UndoOp *op = UNDO_OP(log, i);
 		UndoDeleteNodeOp *delete_op = &(op->delete_node_op);
 
 		Graph_CreateNode(ctx->gc->g, &n, delete_op->labels,
 				delete_op->label_count);
 		*n.attributes = delete_op->set;
+		// attribute set is owned by the restored node
+		delete_op->set = NULL;
 
 		// re-introduce node to indices
 		_index_node(ctx, &n);
-		// Cleanup after undo rollback, as the op D'tor is not called.
-		rm_free(delete_op->labels);
 	}
 }
 
@@ -247,18 +291,20 @@ static void _UndoLog_Rollback_Delete_Node
 static void _UndoLog_Rollback_Delete_Edge
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
 	for(int i = seq_start; i > seq_end; --i) {
 		Edge e;
-		UndoOp *op = undo_list + i;
-		UndoDeleteEdgeOp delete_op = op->delete_edge_op;
+		UndoOp *op = UNDO_OP(log, i);
+		UndoDeleteEdgeOp *delete_op = &(op->delete_edge_op);
 
-		Graph_CreateEdge(ctx->gc->g, delete_op.srcNodeID, delete_op.destNodeID,
-				delete_op.relationID, &e);
-		*e.attributes = delete_op.set;
+		Graph_CreateEdge(ctx->gc->g, delete_op->srcNodeID,
+				delete_op->destNodeID, delete_op->relationID, &e);
+		*e.attributes = delete_op->set;
+		// attribute set is owned by the restored edge
+		delete_op->set = NULL;
 
 		_index_edge(ctx, &e);
 	}
@@ -268,13 +314,12 @@ static void _UndoLog_Rollback_Delete_Edge
 static void _UndoLog_Rollback_Add_Schema
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
 	for(int i = seq_start; i > seq_end; --i) {
-		Edge e;
-		UndoOp *op = undo_list + i;
+		UndoOp *op = UNDO_OP(log, i);
 		UndoAddSchemaOp schema_op = op->schema_op;
 		int schema_id = schema_op.schema_id;
 		int schema_count = GraphContext_SchemaCount(ctx->gc, schema_op.t);
@@ -292,33 +337,237 @@ static void _UndoLog_Rollback_Add_Schema
 static void _UndoLog_Rollback_Add_Attribute
 (
 	QueryCtx *ctx,
+	UndoLog log,
 	int seq_start,
 	int seq_end
 ) {
-	UndoOp *undo_list = ctx->undo_log;
 	for(int i = seq_start; i > seq_end; --i) {
-		Edge e;
-		UndoOp *op = undo_list + i;
+		UndoOp *op = UNDO_OP(log, i);
 		UndoAddAttributeOp attribute_op = op->attribute_op;
 		int attribute_id = attribute_op.attribute_id;
 		GraphContext_RemoveAttribute(ctx->gc, attribute_id);	
 	}
 }
 
+// checks if log holds nothing but creations
+// and that the created entities occupy the tail of the graph's datablocks
+// sets 'node_base' and 'edge_base' to the first created node and edge IDs
+static bool _UndoLog_CreateOnly
+(
+	UndoLog log,
+	const Graph *g,
+	NodeID *node_base,
+	EdgeID *edge_base
+) {
+	// datablocks high water marks
+	uint64_t node_end = DataBlock_ItemCount(g->nodes) +
+		DataBlock_DeletedItemsCount(g->nodes);
+	uint64_t edge_end = DataBlock_ItemCount(g->edges) +
+		DataBlock_DeletedItemsCount(g->edges);
+
+	uint64_t node_count = 0;
+	uint64_t edge_count = 0;
+
+	for(uint64_t i = 0; i < log->count; i++) {
+		UndoOp *op = UNDO_OP(log, i);
+		switch(op->type) {
+			case UNDO_CREATE_NODE:
+				// created IDs must be consecutive
+				if(node_count == 0) *node_base = op->create_op.id;
+				if(op->create_op.id != *node_base + node_count) return false;
+				node_count++;
+				break;
+			case UNDO_CREATE_EDGE:
+				if(edge_count == 0) *edge_base = op->create_op.id;
+				if(op->create_op.id != *edge_base + edge_count) return false;
+				edge_count++;
+				break;
+			case UNDO_ADD_SCHEMA:
+			case UNDO_ADD_ATTRIBUTE:
+				break;
+			default:
+				return false;
+		}
+	}
+
+	if(node_count == 0) *node_base = node_end;
+	if(edge_count == 0) *edge_base = edge_end;
+
+	// created entities must be the last ones allocated
+	return (*node_base + node_count == node_end &&
+			*edge_base + edge_count == edge_end);
+}
+
+// rollback a transaction which only created entities
+// created entities are detached from the graph's matrices and indices
+// and their datablock slots are truncated rather than marked as free
+static void _UndoLog_Rollback_Bulk_Create
+(
+	QueryCtx *ctx,
+	UndoLog log,
+	NodeID node_base,
+	EdgeID edge_base
+) {
+	Graph *g = ctx->gc->g;
+	bool indexed = GraphContext_HasIndices(ctx->gc);
+
+	// remove edges first, nodes must be detached before they're removed
+	for(int64_t i = log->count - 1; i >= 0; i--) {
+		UndoOp *op = UNDO_OP(log, i);
+		if(op->type != UNDO_CREATE_EDGE) continue;
+
+		Edge e;
+		_UndoLog_CreatedEdge(g, &op->create_op, &e);
+		if(indexed) _index_delete_edge(ctx, &e);
+		Graph_DeleteEdge(g, &e);
+	}
+
+	for(int64_t i = log->count - 1; i >= 0; i--) {
+		UndoOp *op = UNDO_OP(log, i);
+		if(op->type != UNDO_CREATE_NODE) continue;
+
+		Node n;
+		Graph_GetNode(g, op->create_op.id, &n);
+		if(indexed) _index_delete_node(ctx, &n);
+		Graph_DeleteNode(g, &n);
+	}
+
+	// release created entities slots
+	DataBlock_Truncate(g->edges, edge_base);
+	DataBlock_Truncate(g->nodes, node_base);
+
+	// finally remove added schemas and attributes
+	for(int64_t i = log->count - 1; i >= 0; i--) {
+		UndoOp *op = UNDO_OP(log, i);
+		if(op->type == UNDO_ADD_SCHEMA) {
+			_UndoLog_Rollback_Add_Schema(ctx, log, i, i - 1);
+		} else if(op->type == UNDO_ADD_ATTRIBUTE) {
+			_UndoLog_Rollback_Add_Attribute(ctx, log, i, i - 1);
+		}
+	}
+}
+
+// allocate 'size' bytes from log's arena
+static void *_UndoLog_Alloc
+(
+	UndoLog log,  // undo log
+	size_t size   // number of bytes to allocate
+) {
+	// keep allocations aligned
+	size = (size + 7) & ~((size_t)7);
+
+	uint block_count = array_len(log->blocks);
+	if(block_count == 0 || log->block_used + size > UNDO_ARENA_BLOCK_SIZE) {
+		// oversized allocations get a dedicated block
+		size_t block_size = (size > UNDO_ARENA_BLOCK_SIZE) ?
+			size : UNDO_ARENA_BLOCK_SIZE;
+		array_append(log->blocks, rm_malloc(block_size));
+		log->block_used = 0;
+		block_count++;
+	}
+
+	void *ptr = log->blocks[block_count - 1] + log->block_used;
+	log->block_used += size;
+	return ptr;
+}
+
+// grow update's attributes by doubling its capacity
+// in place if the attributes are the last arena allocation
+// otherwise the attributes are moved to a new allocation
+static void _UndoLog_GrowAttributes
+(
+	UndoLog log,
+	UndoUpdateOp *op
+) {
+	size_t prefix   = (op->entity_type == GETYPE_EDGE) ?
+		sizeof(UndoEdgeEnds) : 0;
+	size_t used     = sizeof(UndoAttribute) * op->attr_cap;
+	size_t addition = sizeof(UndoAttribute) * op->attr_cap;
+	char  *last     = log->blocks[array_len(log->blocks) - 1];
+
+	if((char *)(op->attributes + op->attr_cap) == last + log->block_used &&
+	   log->block_used + addition <= UNDO_ARENA_BLOCK_SIZE) {
+		log->block_used += addition;
+	} else {
+		char *src = ((char *)op->attributes) - prefix;
+		char *dst = _UndoLog_Alloc(log, prefix + used + addition);
+		memcpy(dst, src, prefix + used);
+		op->attributes = (UndoAttribute *)(dst + prefix);
+	}
+
+	op->attr_cap *= 2;
+}
+
 // add an operation to undo log
-static inline void _UndoLog_AddOperation
+static inline UndoOp *_UndoLog_AddOperation
 (
 	UndoLog *log,  // undo log
-	UndoOp *op     // undo operation
+	UndoOpType type
 ) {
-	ASSERT(op != NULL);
 	ASSERT(log != NULL && *log != NULL);
 
-	array_append(*log, *op);
+	UndoLog l = *log;
+	if(l->count % UNDO_CHUNK_SIZE == 0) {
+		array_append(l->chunks, rm_malloc(sizeof(UndoOp) * UNDO_CHUNK_SIZE));
+	}
+
+	UndoOp *op = UNDO_OP(l, l->count);
+	l->count++;
+
+	op->type = type;
+	return op;
+}
+
+// returns false if undo operations should not be recorded
+static inline bool _UndoLog_Capture
+(
+	UndoLog *log
+) {
+	ASSERT(log != NULL && *log != NULL);
+	return (*log)->capture;
 }
 
 UndoLog UndoLog_New(void) {
-	return (UndoLog)array_new(UndoOp, 0);
+	UndoLog log = rm_malloc(sizeof(_UndoLog));
+
+	log->count       = 0;
+	log->chunks      = array_new(UndoOp *, 0);
+	log->blocks      = array_new(char *, 0);
+	log->block_used  = 0;
+	log->capture     = true;
+	log->allow_final = true;
+
+	return log;
+}
+
+void UndoLog_AllowFinalCommit
+(
+	UndoLog *log,
+	bool allow
+) {
+	ASSERT(log != NULL && *log != NULL);
+	(*log)->allow_final = allow;
+}
+
+bool UndoLog_BeginFinalCommit
+(
+	UndoLog *log
+) {
+	ASSERT(log != NULL && *log != NULL);
+
+	UndoLog l = *log;
+	if(!l->allow_final) return false;
+
+	l->capture = false;
+	return true;
+}
+
+void UndoLog_EndFinalCommit
+(
+	UndoLog *log
+) {
+	ASSERT(log != NULL && *log != NULL);
+	(*log)->capture = true;
 }
 
 //------------------------------------------------------------------------------
@@ -331,14 +580,11 @@ void UndoLog_CreateNode
 	UndoLog *log,
 	Node *node             // node created
 ) {
-	ASSERT(log != NULL && *log != NULL);
-
-	UndoOp op;
-
-	op.type        = UNDO_CREATE_NODE;
-	op.create_op.n = *node;
+	ASSERT(node != NULL);
+	if(!_UndoLog_Capture(log)) return;
 
-	_UndoLog_AddOperation(log, &op);
+	UndoOp *op = _UndoLog_AddOperation(log, UNDO_CREATE_NODE);
+	op->create_op.id = ENTITY_GET_ID(node);
 }
 
 // undo edge creation
@@ -347,14 +593,14 @@ void UndoLog_CreateEdge
 	UndoLog *log,
 	Edge *edge             // edge created
 ) {
-	ASSERT(log != NULL && *log != NULL);
-
-	UndoOp op;
-
-	op.type        = UNDO_CREATE_EDGE;
-	op.create_op.e = *edge;
+	ASSERT(edge != NULL);
+	if(!_UndoLog_Capture(log)) return;
 
-	_UndoLog_AddOperation(log, &op);
+	UndoOp *op = _UndoLog_AddOperation(log, UNDO_CREATE_EDGE);
+	op->create_op.id         = ENTITY_GET_ID(edge);
+	op->create_op.src        = edge->srcNodeID;
+	op->create_op.dest       = edge->destNodeID;
+	op->create_op.relationID = edge->relationID;
 }
 
 // undo node deletion
@@ -363,23 +609,20 @@ void UndoLog_DeleteNode
 	UndoLog *log,      // undo log
 	Node *node         // node deleted
 ) {
-	ASSERT(log != NULL && *log != NULL);
 	ASSERT(node != NULL);
+	if(!_UndoLog_Capture(log)) return;
 
-	UndoOp op;
+	UndoOp *op = _UndoLog_AddOperation(log, UNDO_DELETE_NODE);
 
-	op.type                        =  UNDO_DELETE_NODE;
-	op.delete_node_op.id           =  node->id;
-	op.delete_node_op.set          =  AttributeSet_Clone(*node->attributes);
+	op->delete_node_op.id   =  node->id;
+	op->delete_node_op.set  =  AttributeSet_Clone(*node->attributes);
 
 	Graph *g = QueryCtx_GetGraph();
-	NODE_GET_LABELS(g, node, op.delete_node_op.label_count);
-	op.delete_node_op.labels = rm_malloc(sizeof(LabelID) * op.delete_node_op.label_count);
-	for (uint i = 0; i < op.delete_node_op.label_count; i++) {
-		op.delete_node_op.labels[i] = labels[i];
+	NODE_GET_LABELS(g, node, op->delete_node_op.label_count);
+	op->delete_node_op.labels = rm_malloc(sizeof(LabelID) * op->delete_node_op.label_count);
+	for (uint i = 0; i < op->delete_node_op.label_count; i++) {
+		op->delete_node_op.labels[i] = labels[i];
 	}
-
-	_UndoLog_AddOperation(log, &op);
 }
 
 // undo edge deletion
@@ -388,22 +631,20 @@ void UndoLog_DeleteEdge
 	UndoLog *log,  // undo log
 	Edge *edge      // edge deleted
 ) {
-	ASSERT(log != NULL && *log != NULL);
 	ASSERT(edge != NULL);
+	if(!_UndoLog_Capture(log)) return;
 
-	UndoOp op;
+	UndoOp *op = _UndoLog_AddOperation(log, UNDO_DELETE_EDGE);
 
-	op.type                       = UNDO_DELETE_EDGE;
-	op.delete_edge_op.id          = edge->id;
-	op.delete_edge_op.relationID  = edge->relationID;
-	op.delete_edge_op.srcNodeID   = edge->srcNodeID;
-	op.delete_edge_op.destNodeID  = edge->destNodeID;
-	op.delete_edge_op.set         = AttributeSet_Clone(*edge->attributes);
-
-	_UndoLog_AddOperation(log, &op);
+	op->delete_edge_op.id          = edge->id;
+	op->delete_edge_op.relationID  = edge->relationID;
+	op->delete_edge_op.srcNodeID   = edge->srcNodeID;
+	op->delete_edge_op.destNodeID  = edge->destNodeID;
+	op->delete_edge_op.set         = AttributeSet_Clone(*edge->attributes);
 }
 
 // undo entity update
+// updates of the entity logged last are added to its existing operation
 void UndoLog_UpdateEntity
 (
 	UndoLog *log,                // undo log
@@ -412,24 +653,58 @@ void UndoLog_UpdateEntity
 	SIValue orig_value,          // attribute original value
 	GraphEntityType entity_type  // entity type
 ) {
-	ASSERT(log != NULL && *log != NULL);
 	ASSERT(ge != NULL);
 	ASSERT(attr_id != ATTRIBUTE_ID_NONE && attr_id != ATTRIBUTE_ID_ALL);
+	if(!_UndoLog_Capture(log)) return;
+
+	UndoLog l = *log;
+	UndoUpdateOp *update_op = NULL;
+
+	// see if entity was the last one updated
+	if(l->count > 0) {
+		UndoOp *last = UNDO_OP(l, l->count - 1);
+		if(last->type == UNDO_UPDATE &&
+		   last->update_op.id == ENTITY_GET_ID(ge) &&
+		   last->update_op.entity_type == entity_type) {
+			update_op = &last->update_op;
+		}
+	}
 
-	UndoOp op;
+	if(update_op != NULL) {
+		// attribute's original value is already logged
+		for(uint i = 0; i < update_op->attr_count; i++) {
+			if(update_op->attributes[i].attr_id == attr_id) return;
+		}
+		if(update_op->attr_count == update_op->attr_cap) {
+			_UndoLog_GrowAttributes(l, update_op);
+		}
+	} else {
+		UndoOp *op = _UndoLog_AddOperation(log, UNDO_UPDATE);
+		update_op = &op->update_op;
 
-	op.type                  = UNDO_UPDATE;
-	op.update_op.attr_id     = attr_id;
-	op.update_op.orig_value  = SI_CloneValue(orig_value);
-	op.update_op.entity_type = entity_type;
+		update_op->id          = ENTITY_GET_ID(ge);
+		update_op->attr_cap    = 1;
+		update_op->attr_count  = 0;
+		update_op->entity_type = entity_type;
 
-	if(entity_type == GETYPE_NODE) {
-		op.update_op.n = *(Node *)ge;
-	} else {
-		op.update_op.e = *(Edge *)ge;
+		if(entity_type == GETYPE_NODE) {
+			update_op->attributes = _UndoLog_Alloc(l, sizeof(UndoAttribute));
+		} else {
+			// edges keep their endpoints for reindexing
+			Edge *e = (Edge *)ge;
+			UndoEdgeEnds *ends = _UndoLog_Alloc(l,
+					sizeof(UndoEdgeEnds) + sizeof(UndoAttribute));
+			ends->src             = e->srcNodeID;
+			ends->dest            = e->destNodeID;
+			ends->relationID      = e->relationID;
+			update_op->attributes = (UndoAttribute *)(ends + 1);
+		}
 	}
 
-	_UndoLog_AddOperation(log, &op);
+	UndoAttribute *attr = update_op->attributes + update_op->attr_count;
+	attr->attr_id    = attr_id;
+	attr->orig_value = SI_CloneValue(orig_value);
+	update_op->attr_count++;
 }
 
 // undo node add label
@@ -442,15 +717,14 @@ void UndoLog_AddLabels
 ) {
 	ASSERT(node != NULL);
 	ASSERT(label_ids != NULL);
+	if(!_UndoLog_Capture(log)) return;
 
-	UndoOp op;
+	UndoOp *op = _UndoLog_AddOperation(log, UNDO_SET_LABELS);
 
-	op.type = UNDO_SET_LABELS;
-	op.labels_op.node = *node;
-	op.labels_op.label_lds = array_new(int, labels_count);
-	memcpy(op.labels_op.label_lds, label_ids, sizeof(int)*labels_count);
-	op.labels_op.labels_count = labels_count;
-	_UndoLog_AddOperation(log, &op);
+	op->labels_op.node = *node;
+	op->labels_op.label_lds = array_new(int, labels_count);
+	memcpy(op->labels_op.label_lds, label_ids, sizeof(int)*labels_count);
+	op->labels_op.labels_count = labels_count;
 }
 
 // undo node remove label
@@ -463,15 +737,14 @@ void UndoLog_RemoveLabels
 ) {
 	ASSERT(node != NULL);
 	ASSERT(label_ids != NULL);
+	if(!_UndoLog_Capture(log)) return;
 
-	UndoOp op;
+	UndoOp *op = _UndoLog_AddOperation(log, UNDO_REMOVE_LABELS);
 
-	op.type = UNDO_REMOVE_LABELS;
-	op.labels_op.node = *node;
-	op.labels_op.label_lds = array_new(int, labels_count);
-	memcpy(op.labels_op.label_lds, label_ids, sizeof(int)*labels_count);
-	op.labels_op.labels_count = labels_count;
-	_UndoLog_AddOperation(log, &op);
+	op->labels_op.node = *node;
+	op->labels_op.label_lds = array_new(int, labels_count);
+	memcpy(op->labels_op.label_lds, label_ids, sizeof(int)*labels_count);
+	op->labels_op.labels_count = labels_count;
 }
 
 // undo schema addition
@@ -481,13 +754,12 @@ void UndoLog_AddSchema
 	int schema_id,               // id of the schema
 	SchemaType t                 // type of the schema
 ) {
-	ASSERT(log != NULL);
-	UndoOp op;
+	if(!_UndoLog_Capture(log)) return;
+
+	UndoOp *op = _UndoLog_AddOperation(log, UNDO_ADD_SCHEMA);
 
-	op.type = UNDO_ADD_SCHEMA;
-	op.schema_op.schema_id = schema_id;
-	op.schema_op.t = t;
-	_UndoLog_AddOperation(log, &op);
+	op->schema_op.schema_id = schema_id;
+	op->schema_op.t = t;
 }
 
 void UndoLog_AddAttribute
@@ -495,15 +767,12 @@ void UndoLog_AddAttribute
 	UndoLog *log,                // undo log
 	Attribute_ID attribute_id             // id of the attribute
 ) {
-	ASSERT(log != NULL);
-	UndoOp op;
+	if(!_UndoLog_Capture(log)) return;
 
-	op.type = UNDO_ADD_ATTRIBUTE;
-	op.attribute_op.attribute_id = attribute_id;
-	_UndoLog_AddOperation(log, &op);
+	UndoOp *op = _UndoLog_AddOperation(log, UNDO_ADD_ATTRIBUTE);
+	op->attribute_op.attribute_id = attribute_id;
 }
 
-
 //------------------------------------------------------------------------------
 // rollback
 //------------------------------------------------------------------------------
@@ -515,69 +784,80 @@ void UndoLog_Rollback
 	ASSERT(log != NULL);
 	
 	QueryCtx *ctx  = QueryCtx_GetQueryCtx();
-	uint64_t count = array_len(log);
+	uint64_t count = log->count;
 
 	if(count == 0) return;
 
+	// transactions which only created entities are reverted in bulk
+	NodeID node_base;
+	EdgeID edge_base;
+	if(_UndoLog_CreateOnly(log, ctx->gc->g, &node_base, &edge_base)) {
+		_UndoLog_Rollback_Bulk_Create(ctx, log, node_base, edge_base);
+		UndoLog_Clear(log);
+		return;
+	}
+
 	// apply undo operations in reverse order for rollback correctness
 	// find sequences of the same operation and rollback them as a bulk
 	int seq_end = count - 1;
 	while (seq_end >= 0) {
-		UndoOpType cur_type = log[seq_end].type;
+		UndoOpType cur_type = UNDO_OP(log, seq_end)->type;
 		int seq_start = seq_end;
 		seq_end--;
-		while(seq_end > 0 && log[seq_end].type == cur_type) {
+		while(seq_end > 0 && UNDO_OP(log, seq_end)->type == cur_type) {
 			seq_end--;
 		}
 
 		switch(cur_type) {
 			case UNDO_UPDATE:
-				_UndoLog_Rollback_Update_Entity(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Update_Entity(ctx, log, seq_start, seq_end);
 				break;
 			case UNDO_CREATE_NODE:
-				_UndoLog_Rollback_Create_Node(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Create_Node(ctx, log, seq_start, seq_end);
 				break;
 			case UNDO_CREATE_EDGE:
-				_UndoLog_Rollback_Create_Edge(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Create_Edge(ctx, log, seq_start, seq_end);
 				break;
 			case UNDO_DELETE_NODE:
-				_UndoLog_Rollback_Delete_Node(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Delete_Node(ctx, log, seq_start, seq_end);
 				break;
 			case UNDO_DELETE_EDGE:
-				_UndoLog_Rollback_Delete_Edge(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Delete_Edge(ctx, log, seq_start, seq_end);
 				break;
 			case UNDO_SET_LABELS:
-				_UndoLog_Rollback_Set_Labels(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Set_Labels(ctx, log, seq_start, seq_end);
 				break;
 			case UNDO_REMOVE_LABELS:
-				_UndoLog_Rollback_Remove_Labels(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Remove_Labels(ctx, log, seq_start, seq_end);
 				break;
 			case UNDO_ADD_SCHEMA:
-				_UndoLog_Rollback_Add_Schema(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Add_Schema(ctx, log, seq_start, seq_end);
 				break;
 			case UNDO_ADD_ATTRIBUTE:
-				_UndoLog_Rollback_Add_Attribute(ctx, seq_start, seq_end);
+				_UndoLog_Rollback_Add_Attribute(ctx, log, seq_start, seq_end);
 				break;
 			default:
 				ASSERT(false);
 		}
  	}
 
-	array_clear(log);
-
+	UndoLog_Clear(log);
 }
 
-void UndoLog_Free
+void UndoLog_Clear
 (
 	UndoLog log
 ) {
+	ASSERT(log != NULL);
+
 	// free each undo operation
-	uint count = array_len(log);
-	for (uint i = 0; i < count; i++) {
-		UndoOp *op = log + i;
+	for (uint64_t i = 0; i < log->count; i++) {
+		UndoOp *op = UNDO_OP(log, i);
 		switch(op->type) {
 			case UNDO_UPDATE:
-				SIValue_Free(op->update_op.orig_value);
+				for(uint j = 0; j < op->update_op.attr_count; j++) {
+					SIValue_Free(op->update_op.attributes[j].orig_value);
+				}
 				break;
 			case UNDO_CREATE_NODE:
 				break;
@@ -602,5 +882,25 @@ void UndoLog_Free
 		}
 	}
 
-	array_free(log);
+	uint chunk_count = array_len(log->chunks);
+	for(uint i = 0; i < chunk_count; i++) rm_free(log->chunks[i]);
+	array_clear(log->chunks);
+
+	uint block_count = array_len(log->blocks);
+	for(uint i = 0; i < block_count; i++) rm_free(log->blocks[i]);
+	array_clear(log->blocks);
+
+	log->count      = 0;
+	log->block_used = 0;
+}
+
+void UndoLog_Free
+(
+	UndoLog log
+) {
+	UndoLog_Clear(log);
+
+	array_free(log->chunks);
+	array_free(log->blocks);
+	rm_free(log);
 }
@@ -39,10 +39,10 @@ typedef enum {
 
 // undo node/edge creation
 typedef struct {
-	union {
-		Node n;
-		Edge e;
-	};
+	EntityID id;        // created entity ID
+	NodeID src;         // edge source node ID
+	NodeID dest;        // edge destination node ID
+	int relationID;     // edge relation ID
 } UndoCreateOp;
 
 // undo node deletion
@@ -56,27 +56,40 @@ typedef struct {
 // undo edge deletion
 typedef struct {
 	EntityID id;
-	int relationID;             // Relation ID
 	NodeID srcNodeID;           // Source node ID
 	NodeID destNodeID;          // Destination node ID
 	AttributeSet set;
+	int relationID;             // Relation ID
 } UndoDeleteEdgeOp;
 
+// attribute original value
+typedef struct {
+	Attribute_ID attr_id;  // updated attribute
+	SIValue orig_value;    // attribute original value
+} UndoAttribute;
+
+// edge endpoints, kept in front of an updated edge attributes
+typedef struct {
+	NodeID src;         // edge source node ID
+	NodeID dest;        // edge destination node ID
+	int relationID;     // edge relation ID
+} UndoEdgeEnds;
+
 // undo graph entity update
+// consecutive updates of the same entity are grouped into a single operation
+// holding the original value of each updated attribute once
 typedef struct {
-	union {
-		Node n;
-		Edge e;
-	};
+	EntityID id;                  // updated entity ID
+	UndoAttribute *attributes;    // original values, allocated from log arena
+	uint16_t attr_count;          // number of updated attributes
+	uint16_t attr_cap;            // attributes capacity
 	GraphEntityType entity_type;  // node/edge
-	Attribute_ID attr_id;         // attribute update
-	SIValue orig_value;           // attribute original value
 } UndoUpdateOp;
 
 typedef struct {
 	Node node;
 	int* label_lds;
-	size_t labels_count;
+	uint labels_count;
 } UndoLabelsOp;
 
 
@@ -103,8 +116,20 @@ typedef struct {
 	UndoOpType type;  // type of undo operation
 } UndoOp;
 
-// container for undo_list
-typedef UndoOp *UndoLog;
+// container for undo operations
+// operations are stored in fixed size chunks and attribute values
+// are bump allocated from an arena, the log never reallocates
+// and is released at once
+typedef struct {
+	UndoOp **chunks;    // chunks of undo operations
+	uint64_t count;     // number of undo operations
+	char **blocks;      // arena blocks
+	size_t block_used;  // number of bytes used in last arena block
+	bool capture;       // record operations, false during a final commit
+	bool allow_final;   // final commits may skip undo capture
+} _UndoLog;
+
+typedef _UndoLog *UndoLog;
 
 // create a new undo-log
 UndoLog UndoLog_New(void);
@@ -185,12 +210,41 @@ void UndoLog_AddAttribute
 );
 
 
+// allow or disallow final commits to skip undo capture
+// disallowed when the query might fail after its last commit
+// e.g. when it is subject to a timeout
+void UndoLog_AllowFinalCommit
+(
+	UndoLog *log,  // undo log
+	bool allow     // allow final commits
+);
+
+// begin a final commit, the last modification performed by a query
+// which no failing operation follows, as such it is never rolled back
+// returns true if undo capture is suspended until UndoLog_EndFinalCommit
+bool UndoLog_BeginFinalCommit
+(
+	UndoLog *log  // undo log
+);
+
+// end a final commit, resuming undo capture
+void UndoLog_EndFinalCommit
+(
+	UndoLog *log  // undo log
+);
+
 // rollback all modifications tracked by this undo log
 void UndoLog_Rollback
 (
 	UndoLog log
 );
 
+// discard all operations tracked by this undo log
+void UndoLog_Clear
+(
+	UndoLog log
+);
+
 // free UndoLog
 void UndoLog_Free
 (
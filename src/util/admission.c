@@ -0,0 +1,198 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "admission.h"
+#include <time.h>
+#include <pthread.h>
+
+// memory consumed by past executions of a query
+typedef struct {
+	uint64_t fingerprint;  // query fingerprint
+	size_t consumed;       // smoothed peak memory consumption
+} AdmissionHistory;
+
+static struct {
+	size_t budget;            // server wide memory budget
+	size_t reserved;          // memory reserved by in-flight queries
+	uint64_t in_flight;       // number of admitted queries
+	uint64_t admitted;        // total number of admitted queries
+	uint64_t queued;          // total number of queries which had to wait
+	uint64_t downgraded;      // total number of downgraded queries
+	uint64_t rejected;        // total number of rejected queries
+	pthread_mutex_t mutex;    // guards state
+	pthread_cond_t released;  // signaled when memory is released
+	AdmissionHistory history[ADMISSION_HISTORY_SIZE];  // per fingerprint history
+} _admission = {
+	.budget   = ADMISSION_BUDGET_UNLIMITED,
+	.mutex    = PTHREAD_MUTEX_INITIALIZER,
+	.released = PTHREAD_COND_INITIALIZER
+};
+
+void AdmissionControl_SetBudget
+(
+	size_t budget
+) {
+	pthread_mutex_lock(&_admission.mutex);
+	_admission.budget = budget;
+	// a larger budget might admit waiting queries
+	pthread_cond_broadcast(&_admission.released);
+	pthread_mutex_unlock(&_admission.mutex);
+}
+
+bool AdmissionControl_Enabled(void) {
+	return _admission.budget != ADMISSION_BUDGET_UNLIMITED;
+}
+
+// returns true if 'estimate' fits within the budget
+// a query is always admitted when no other query holds a reservation
+// expecting mutex to be held
+static inline bool _fits
+(
+	size_t estimate
+) {
+	return _admission.reserved == 0 ||
+		_admission.reserved + estimate <= _admission.budget;
+}
+
+AdmissionDecision AdmissionControl_Admit
+(
+	AdmissionTicket *ticket,
+	uint64_t fingerprint,
+	size_t estimate,
+	uint64_t wait_ms
+) {
+	ASSERT(ticket != NULL);
+
+	ticket->fingerprint = fingerprint;
+	ticket->reserved    = 0;
+	ticket->max_threads = 0;
+
+	if(!AdmissionControl_Enabled()) return ADMISSION_ADMITTED;
+
+	pthread_mutex_lock(&_admission.mutex);
+
+	// prefer the memory consumed by previous executions
+	AdmissionHistory *h =
+		_admission.history + (fingerprint % ADMISSION_HISTORY_SIZE);
+	if(h->fingerprint == fingerprint && h->consumed > 0) {
+		estimate = h->consumed;
+	}
+	if(estimate < ADMISSION_MIN_RESERVATION) {
+		estimate = ADMISSION_MIN_RESERVATION;
+	}
+
+	// queue until enough memory is released or wait time expires
+	if(!_fits(estimate) && wait_ms > 0) {
+		_admission.queued++;
+
+		struct timespec deadline;
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec  += wait_ms / 1000;
+		deadline.tv_nsec += (wait_ms % 1000) * 1000000;
+		if(deadline.tv_nsec >= 1000000000) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000;
+		}
+
+		int res = 0;
+		while(!_fits(estimate) && res == 0 && AdmissionControl_Enabled()) {
+			res = pthread_cond_timedwait(&_admission.released,
+					&_admission.mutex, &deadline);
+		}
+	}
+
+	AdmissionDecision decision;
+	if(!AdmissionControl_Enabled()) {
+		// admission control disabled while waiting
+		decision = ADMISSION_ADMITTED;
+	} else if(!_fits(estimate)) {
+		decision = ADMISSION_REJECTED;
+		_admission.rejected++;
+
+		// a rejected query doesn't execute and would never refresh its history
+		// decay it, such that an outdated estimate eventually fits again
+		if(h->fingerprint == fingerprint && h->consumed > 0) {
+			h->consumed /= 2;
+		}
+	} else {
+		decision = ADMISSION_ADMITTED;
+
+		// under pressure, keep the query's parallel workspace to a minimum
+		if(_admission.reserved + estimate >
+				_admission.budget * ADMISSION_PRESSURE) {
+			decision = ADMISSION_DOWNGRADED;
+			ticket->max_threads = 1;
+			_admission.downgraded++;
+		}
+
+		ticket->reserved = estimate;
+		_admission.reserved += estimate;
+		_admission.in_flight++;
+		_admission.admitted++;
+	}
+
+	pthread_mutex_unlock(&_admission.mutex);
+
+	return decision;
+}
+
+void AdmissionControl_Release
+(
+	AdmissionTicket *ticket,
+	size_t consumed
+) {
+	ASSERT(ticket != NULL);
+
+	// nothing to release nor learn from
+	if(ticket->reserved == 0 && consumed == 0) return;
+
+	pthread_mutex_lock(&_admission.mutex);
+
+	// learn query's memory consumption
+	if(consumed > 0) {
+		AdmissionHistory *h =
+			_admission.history + (ticket->fingerprint % ADMISSION_HISTORY_SIZE);
+		if(h->fingerprint == ticket->fingerprint && h->consumed > 0) {
+			// smooth over executions with different parameters
+			h->consumed = (h->consumed + consumed) / 2;
+		} else {
+			h->fingerprint = ticket->fingerprint;
+			h->consumed    = consumed;
+		}
+	}
+
+	if(ticket->reserved > 0) {
+		ASSERT(_admission.reserved >= ticket->reserved);
+		ASSERT(_admission.in_flight > 0);
+		_admission.reserved -= ticket->reserved;
+		_admission.in_flight--;
+		ticket->reserved = 0;
+		pthread_cond_broadcast(&_admission.released);
+	}
+
+	pthread_mutex_unlock(&_admission.mutex);
+}
+
+void AdmissionControl_Info
+(
+	RedisModuleInfoCtx *ctx
+) {
+	ASSERT(ctx != NULL);
+
+	pthread_mutex_lock(&_admission.mutex);
+
+	RedisModule_InfoAddSection(ctx, "admission");
+	RedisModule_InfoAddFieldULongLong(ctx, "budget",     _admission.budget);
+	RedisModule_InfoAddFieldULongLong(ctx, "reserved",   _admission.reserved);
+	RedisModule_InfoAddFieldULongLong(ctx, "in_flight",  _admission.in_flight);
+	RedisModule_InfoAddFieldULongLong(ctx, "admitted",   _admission.admitted);
+	RedisModule_InfoAddFieldULongLong(ctx, "queued",     _admission.queued);
+	RedisModule_InfoAddFieldULongLong(ctx, "downgraded", _admission.downgraded);
+	RedisModule_InfoAddFieldULongLong(ctx, "rejected",   _admission.rejected);
+
+	pthread_mutex_unlock(&_admission.mutex);
+}
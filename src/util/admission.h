@@ -0,0 +1,78 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "../redismodule.h"
+
+// admission control keeps the memory reserved by in-flight queries within a
+// server wide budget, each query reserves its estimated memory consumption
+// before it executes and releases it once done
+//
+// a query which doesn't fit the budget is queued until enough memory is
+// released, and rejected if it doesn't fit in time
+// queries admitted while the budget is under pressure run single threaded
+//
+// estimates are taken from the memory previously consumed by the same
+// query (fingerprint), falling back to the caller's estimate
+// the history of a rejected fingerprint decays with every rejection
+
+#define ADMISSION_BUDGET_UNLIMITED 0
+#define ADMISSION_MIN_RESERVATION  (64 * 1024)  // min bytes reserved per query
+#define ADMISSION_DEFAULT_WAIT     1000         // max ms a query waits in queue
+#define ADMISSION_PRESSURE         0.75         // budget fraction considered pressure
+#define ADMISSION_HISTORY_SIZE     4096         // number of tracked fingerprints
+
+typedef enum {
+	ADMISSION_ADMITTED,    // query admitted
+	ADMISSION_DOWNGRADED,  // query admitted with a reduced thread budget
+	ADMISSION_REJECTED     // query didn't fit within the budget
+} AdmissionDecision;
+
+// a query's admission
+typedef struct {
+	uint64_t fingerprint;  // query fingerprint
+	size_t reserved;       // bytes reserved on behalf of the query
+	int max_threads;       // thread limit imposed on the query, 0 no limit
+} AdmissionTicket;
+
+// set server wide memory budget in bytes
+// ADMISSION_BUDGET_UNLIMITED disables admission control
+void AdmissionControl_SetBudget
+(
+	size_t budget
+);
+
+// returns true if admission control is enabled
+bool AdmissionControl_Enabled(void);
+
+// admit query
+// 'estimate' is used when the query's fingerprint has no history
+// a query which doesn't fit the budget waits up to 'wait_ms' milliseconds
+AdmissionDecision AdmissionControl_Admit
+(
+	AdmissionTicket *ticket,  // [output] query admission
+	uint64_t fingerprint,     // query fingerprint
+	size_t estimate,          // estimated memory consumption
+	uint64_t wait_ms          // max time to wait, 0 don't wait
+);
+
+// release admitted query's reservation
+// 'consumed' is the query's peak memory consumption, 0 if unknown
+void AdmissionControl_Release
+(
+	AdmissionTicket *ticket,  // query admission
+	size_t consumed           // memory consumed by query
+);
+
+// add admission control statistics to INFO
+void AdmissionControl_Info
+(
+	RedisModuleInfoCtx *ctx
+);
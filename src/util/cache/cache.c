@@ -8,6 +8,7 @@
 #include "RG.h"
 #include "../rmalloc.h"
 #include "cache_array.h"
+#include "../rax_extensions.h"
 #include <pthread.h>
 
 static CacheEntry *_CacheEvictLRU(Cache *cache) {
@@ -145,6 +146,26 @@ void *Cache_SetGetValue(Cache *cache, const char *key, void *value) {
 	return value_to_return;
 }
 
+size_t Cache_MemoryUsage(Cache *cache) {
+	ASSERT(cache != NULL);
+
+	int res = pthread_rwlock_rdlock(&cache->_cache_rwlock);
+	UNUSED(res);
+	ASSERT(res == 0);
+
+	size_t size = sizeof(Cache) + cache->cap * sizeof(CacheEntry) +
+		raxMemoryUsage(cache->lookup);
+
+	for(uint i = 0; i < cache->size; i++) {
+		size += strlen(cache->arr[i].key) + 1;
+	}
+
+	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
+	ASSERT(res == 0);
+
+	return size;
+}
+
 void Cache_Free(Cache *cache) {
 	ASSERT(cache != NULL);
 
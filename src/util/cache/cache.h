@@ -60,6 +60,13 @@ void Cache_SetValue(Cache *cache, const char *key, void *item);
  */
 void *Cache_SetGetValue(Cache *cache, const char *key, void *value);
 
+/**
+ * @brief  Returns the number of bytes used by the cache's keys and bookkeeping.
+ * @note   Cached values are opaque to the cache and are not accounted for.
+ * @param  *cache: cache pointer
+ */
+size_t Cache_MemoryUsage(Cache *cache);
+
 /**
  * @brief  Destroys the cache and free all stored items.
  * @param  *cache: cache pointer
@@ -209,6 +209,37 @@ void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx) {
 	dataBlock->itemCount--;
 }
 
+void DataBlock_Truncate(DataBlock *dataBlock, uint64_t idx) {
+	ASSERT(dataBlock != NULL);
+
+	// position past the last allocated item
+	uint64_t end = dataBlock->itemCount + array_len(dataBlock->deletedIdx);
+	if(idx >= end) return;
+
+	// remove items within the truncated range
+	for(uint64_t i = idx; i < end; i++) {
+		DataBlockItemHeader *item_header = DataBlock_GetItemHeader(dataBlock, i);
+		if(IS_ITEM_DELETED(item_header)) continue;
+
+		if(dataBlock->destructor) {
+			unsigned char *item = ITEM_DATA(item_header);
+			dataBlock->destructor(item);
+		}
+
+		MARK_HEADER_AS_DELETED(item_header);
+		dataBlock->itemCount--;
+	}
+
+	// forget free indices within the truncated range
+	uint j = 0;
+	uint deleted_count = array_len(dataBlock->deletedIdx);
+	for(uint i = 0; i < deleted_count; i++) {
+		uint64_t pos = dataBlock->deletedIdx[i];
+		if(pos < idx) dataBlock->deletedIdx[j++] = pos;
+	}
+	dataBlock->deletedIdx = array_trimm_len(dataBlock->deletedIdx, j);
+}
+
 uint DataBlock_DeletedItemsCount(const DataBlock *dataBlock) {
 	return array_len(dataBlock->deletedIdx);
 }
@@ -218,6 +249,16 @@ inline bool DataBlock_ItemIsDeleted(void *item) {
 	return IS_ITEM_DELETED(header);
 }
 
+size_t DataBlock_MemoryUsage(const DataBlock *dataBlock) {
+	ASSERT(dataBlock != NULL);
+
+	size_t block_size = sizeof(Block) + dataBlock->blockCap * dataBlock->itemSize;
+
+	return sizeof(DataBlock) +
+		dataBlock->blockCount * (sizeof(Block *) + block_size) +
+		array_sizeof(array_hdr(dataBlock->deletedIdx));
+}
+
 //------------------------------------------------------------------------------
 // Out of order functionality
 //------------------------------------------------------------------------------
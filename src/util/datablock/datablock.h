@@ -91,12 +91,20 @@ void *DataBlock_AllocateItem(DataBlock *dataBlock, uint64_t *idx);
 // Removes item at position idx.
 void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx);
 
+// Removes all items at position idx and beyond, the block's next
+// allocation is at position idx, unlike DataBlock_DeleteItem
+// truncated positions are not recorded as free.
+void DataBlock_Truncate(DataBlock *dataBlock, uint64_t idx);
+
 // Returns the number of deleted items.
 uint DataBlock_DeletedItemsCount(const DataBlock *dataBlock);
 
 // Returns true if the given item has been deleted.
 bool DataBlock_ItemIsDeleted(void *item);
 
+// Returns the number of bytes allocated by the datablock, items included.
+size_t DataBlock_MemoryUsage(const DataBlock *dataBlock);
+
 // Free block.
 void DataBlock_Free(DataBlock *block);
 
@@ -86,3 +86,9 @@ unsigned char **raxKeys(rax *rax) {
 	return keys;
 }
 
+
+size_t raxMemoryUsage(const rax *rax) {
+	return sizeof(*rax) +
+		rax->numnodes * (sizeof(raxNode) + 1 + sizeof(raxNode *)) +
+		rax->numele * sizeof(void *);
+}
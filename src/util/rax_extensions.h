@@ -26,3 +26,8 @@ void **raxValues(rax *rax);
 // Collect all keys in a rax into an array.
 unsigned char **raxKeys(rax *rax);
 
+
+// Estimates the number of bytes used by a rax, excluding stored values.
+// Every node is assumed to hold a single key byte and a child pointer,
+// in addition to a value pointer per element.
+size_t raxMemoryUsage(const rax *rax);
@@ -18,7 +18,9 @@
 // actual allocated size from 'n_alloced' which can lead to negative values if
 // bytes requested < bytes allocated
 static __thread int64_t n_alloced; 
+static __thread int64_t n_alloced_peak;  // peak of 'n_alloced'
 static int64_t mem_capacity;  // maximum memory consumption for thread
+static bool mem_tracking;     // track memory consumption regardless of capacity
  
 // function pointers which hold the original address of RedisModule_Alloc*
 static void (*RedisModule_Free_Orig)(void *ptr);
@@ -29,6 +31,11 @@ static void * (*RedisModule_Calloc_Orig)(size_t nmemb, size_t size);
 
 void rm_reset_n_alloced() {
 	n_alloced = 0;
+	n_alloced_peak = 0;
+}
+
+int64_t rm_peak_n_alloced() {
+	return n_alloced_peak;
 }
 
 // removes n_bytes from thread memory consumption
@@ -39,8 +46,10 @@ static inline void _nmalloc_decrement(int64_t n_bytes) {
 // adds nbytes to thread memory consumption
 static inline void _nmalloc_increment(int64_t n_bytes) {
 	n_alloced += n_bytes;
+	if(n_alloced > n_alloced_peak) n_alloced_peak = n_alloced;
+
 	// check if capacity exceeded
-	if(n_alloced > mem_capacity) {
+	if(mem_capacity > 0 && n_alloced > mem_capacity) {
 		// set n_alloced to MIN to avoid further out of memory exceptions
 		// TODO: consider switching to double -inf
 		n_alloced = INT64_MIN;
@@ -83,16 +92,13 @@ void rm_free_with_capacity(void *ptr) {
 	RedisModule_Free_Orig(ptr);
 }
 
-void rm_set_mem_capacity(int64_t cap) {
-	bool is_capped = (mem_capacity > 0); // current allocator applies memory cap
-	bool should_cap = (cap > 0); // should we use a memory capped allocator
-	
-	// The local enforced capacity should be set
-	// before resetting function pointers
-	// for instance if we're switching to capped allocator
-	// we want the memory cap to be set
-	mem_capacity = cap; 
-	if(should_cap && !is_capped) {
+// switch between counting and plain allocators
+static void _rm_set_counting
+(
+	bool is_counting,   // current allocator counts allocations
+	bool should_count   // should allocations be counted
+) {
+	if(should_count && !is_counting) {
 		// store the function pointer original values and change them
 		// to the capped version
 		RedisModule_Free_Orig     =  RedisModule_Free;
@@ -105,7 +111,7 @@ void rm_set_mem_capacity(int64_t cap) {
 		RedisModule_Calloc        =  rm_calloc_with_capacity;
 		RedisModule_Strdup        =  rm_strdup_with_capacity;
 		RedisModule_Realloc       =  rm_realloc_with_capacity;
-	} else if(!should_cap && is_capped) {
+	} else if(!should_count && is_counting) {
 		// restore all function pointers to their original values
 		RedisModule_Free     =  RedisModule_Free_Orig;
 		RedisModule_Alloc    =  RedisModule_Alloc_Orig;
@@ -115,11 +121,36 @@ void rm_set_mem_capacity(int64_t cap) {
 	}
 }
 
+void rm_set_mem_capacity(int64_t cap) {
+	// current allocator counts allocations
+	bool is_counting = (mem_capacity > 0 || mem_tracking);
+
+	// The local enforced capacity should be set
+	// before resetting function pointers
+	// for instance if we're switching to capped allocator
+	// we want the memory cap to be set
+	mem_capacity = cap; 
+	_rm_set_counting(is_counting, mem_capacity > 0 || mem_tracking);
+}
+
+void rm_set_mem_tracking(bool track) {
+	bool is_counting = (mem_capacity > 0 || mem_tracking);
+	mem_tracking = track;
+	_rm_set_counting(is_counting, mem_capacity > 0 || mem_tracking);
+}
+
 #else
 
 void rm_reset_n_alloced() {
 }
 
+int64_t rm_peak_n_alloced() {
+	return 0;
+}
+
+void rm_set_mem_tracking(bool track) {
+}
+
 void rm_set_mem_capacity(int64_t cap) {
 }
 
@@ -2,6 +2,7 @@
 #define __REDISGRAPH_ALLOC__
 
 #include <stdlib.h>
+#include <stdbool.h>
 #include <string.h>
 #include "../redismodule.h"
 
@@ -15,9 +16,17 @@
 // the allocator function pointers might be updated
 void rm_set_mem_capacity(int64_t cap);
 
+// track thread memory consumption even when capacity is unlimited
+// tracking is implied by a memory capacity
+void rm_set_mem_tracking(bool track);
+
 // reset thread memory consumption counter to 0 (no memory consumed)
 void rm_reset_n_alloced();
 
+// peak thread memory consumption since last reset
+// 0 if memory consumption isn't tracked
+int64_t rm_peak_n_alloced();
+
 static inline void *rm_malloc(size_t n) {
 	return RedisModule_Alloc(n);
 }
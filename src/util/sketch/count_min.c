@@ -0,0 +1,68 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "count_min.h"
+#include "../rmalloc.h"
+
+// counter position of hash in row i
+// rows use independent hashes derived from a single 64 bit hash
+static inline uint32_t _CMS_Column
+(
+	uint64_t hash,
+	uint i
+) {
+	uint32_t h1 = (uint32_t)hash;
+	uint32_t h2 = (uint32_t)(hash >> 32);
+	return (h1 + i * h2) % CMS_WIDTH;
+}
+
+CountMinSketch *CMS_New(void) {
+	return rm_calloc(1, sizeof(CountMinSketch));
+}
+
+uint64_t CMS_Increment
+(
+	CountMinSketch *cms,
+	uint64_t hash
+) {
+	ASSERT(cms != NULL);
+
+	uint64_t estimate = UINT64_MAX;
+	for(uint i = 0; i < CMS_DEPTH; i++) {
+		uint32_t *counter = cms->counters[i] + _CMS_Column(hash, i);
+		if(*counter < UINT32_MAX) (*counter)++;
+		if(*counter < estimate) estimate = *counter;
+	}
+	cms->total++;
+
+	return estimate;
+}
+
+uint64_t CMS_Query
+(
+	const CountMinSketch *cms,
+	uint64_t hash
+) {
+	ASSERT(cms != NULL);
+
+	uint64_t estimate = UINT64_MAX;
+	for(uint i = 0; i < CMS_DEPTH; i++) {
+		uint32_t counter = cms->counters[i][_CMS_Column(hash, i)];
+		if(counter < estimate) estimate = counter;
+	}
+
+	return estimate;
+}
+
+void CMS_Free
+(
+	CountMinSketch *cms
+) {
+	ASSERT(cms != NULL);
+	rm_free(cms);
+}
+
@@ -0,0 +1,47 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+// count-min sketch dimensions
+// estimates exceed true frequencies by at most e/width of total count
+// with probability 1 - e^-depth
+#define CMS_WIDTH 2048
+#define CMS_DEPTH 4
+
+// count-min sketch, estimates frequency of hashes using fixed memory
+typedef struct {
+	uint64_t total;                           // total count
+	uint32_t counters[CMS_DEPTH][CMS_WIDTH];  // counters
+} CountMinSketch;
+
+// create a new count-min sketch
+CountMinSketch *CMS_New(void);
+
+// increment hash frequency by one
+// returns hash estimated frequency
+uint64_t CMS_Increment
+(
+	CountMinSketch *cms,
+	uint64_t hash
+);
+
+// estimated hash frequency
+uint64_t CMS_Query
+(
+	const CountMinSketch *cms,
+	uint64_t hash
+);
+
+// free count-min sketch
+void CMS_Free
+(
+	CountMinSketch *cms
+);
+
@@ -0,0 +1,66 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "hll.h"
+#include "../rmalloc.h"
+#include <math.h>
+
+HLL *HLL_New(void) {
+	return rm_calloc(1, sizeof(HLL));
+}
+
+void HLL_Add
+(
+	HLL *hll,
+	uint64_t hash
+) {
+	ASSERT(hll != NULL);
+
+	// first HLL_PRECISION bits select register
+	// rank is the position of the first set bit among the remaining bits
+	// the sentinel bit bounds rank when remaining bits are all zero
+	uint64_t idx = hash >> (64 - HLL_PRECISION);
+	uint64_t w = (hash << HLL_PRECISION) | (1ULL << (HLL_PRECISION - 1));
+	uint8_t rank = __builtin_clzll(w) + 1;
+
+	if(rank > hll->registers[idx]) hll->registers[idx] = rank;
+}
+
+uint64_t HLL_Count
+(
+	const HLL *hll
+) {
+	ASSERT(hll != NULL);
+
+	double m = HLL_REGISTERS;
+	double sum = 0;
+	uint zeros = 0;
+
+	for(uint i = 0; i < HLL_REGISTERS; i++) {
+		sum += ldexp(1.0, -hll->registers[i]);
+		if(hll->registers[i] == 0) zeros++;
+	}
+
+	double alpha = 0.7213 / (1 + 1.079 / m);
+	double estimate = alpha * m * m / sum;
+
+	// small cardinalities, use linear counting
+	if(estimate <= 2.5 * m && zeros > 0) {
+		estimate = m * log(m / zeros);
+	}
+
+	return (uint64_t)llround(estimate);
+}
+
+void HLL_Free
+(
+	HLL *hll
+) {
+	ASSERT(hll != NULL);
+	rm_free(hll);
+}
+
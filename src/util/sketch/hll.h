@@ -0,0 +1,42 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// number of index bits, HLL uses 2^HLL_PRECISION registers
+// standard error is 1.04 / sqrt(2^HLL_PRECISION) ~ 0.8%
+#define HLL_PRECISION 14
+#define HLL_REGISTERS (1 << HLL_PRECISION)
+
+// HyperLogLog, estimates number of distinct hashes using fixed memory
+typedef struct {
+	uint8_t registers[HLL_REGISTERS];  // max observed rank per register
+} HLL;
+
+// create a new HLL
+HLL *HLL_New(void);
+
+// add a 64 bit hash to HLL
+void HLL_Add
+(
+	HLL *hll,
+	uint64_t hash
+);
+
+// estimate number of distinct hashes added
+uint64_t HLL_Count
+(
+	const HLL *hll
+);
+
+// free HLL
+void HLL_Free
+(
+	HLL *hll
+);
+
@@ -0,0 +1,186 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "tdigest.h"
+#include "../rmalloc.h"
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+
+static int _centroid_cmp
+(
+	const void *a,
+	const void *b
+) {
+	double x = ((const TDigestCentroid *)a)->mean;
+	double y = ((const TDigestCentroid *)b)->mean;
+	return (x > y) - (x < y);
+}
+
+// t-digest k1 scale function, maps quantile q to centroid index space
+// k1 is steep at the tails and flat at the median, keeping extreme
+// quantiles accurate while bounding the number of centroids by compression
+static inline double _k
+(
+	double q,
+	double compression
+) {
+	return compression / (2 * M_PI) * asin(2 * q - 1);
+}
+
+// inverse of the k1 scale function
+static inline double _q
+(
+	double k,
+	double compression
+) {
+	if(k >= compression / 4) return 1;
+	return (sin(k * 2 * M_PI / compression) + 1) / 2;
+}
+
+// merge buffered samples into centroids
+// adjacent centroids are combined as long as the combined centroid spans
+// no more than a single unit of the scale function
+static void _TDigest_Compress
+(
+	TDigest *t
+) {
+	if(t->unmerged == 0) return;
+
+	uint n = t->merged + t->unmerged;
+	TDigestCentroid *c = t->centroids;
+	double total = t->merged_weight + t->unmerged_weight;
+
+	qsort(c, n, sizeof(TDigestCentroid), _centroid_cmp);
+
+	uint out = 0;
+	double weight_so_far = 0;
+	TDigestCentroid cur = c[0];
+	double q_limit = _q(_k(0, t->compression) + 1, t->compression);
+
+	for(uint i = 1; i < n; i++) {
+		double proposed = cur.count + c[i].count;
+
+		if((weight_so_far + proposed) / total <= q_limit) {
+			cur.mean += (c[i].mean - cur.mean) * c[i].count / proposed;
+			cur.count = proposed;
+		} else {
+			weight_so_far += cur.count;
+			c[out++] = cur;
+			cur = c[i];
+			q_limit = _q(_k(weight_so_far / total, t->compression) + 1,
+					t->compression);
+		}
+	}
+	c[out++] = cur;
+
+	t->merged          = out;
+	t->unmerged        = 0;
+	t->merged_weight   = total;
+	t->unmerged_weight = 0;
+}
+
+TDigest *TDigest_New
+(
+	double compression
+) {
+	ASSERT(compression > 0);
+
+	TDigest *t = rm_calloc(1, sizeof(TDigest));
+
+	t->compression = compression;
+	t->cap         = 6 * (uint)ceil(compression) + 10;
+	t->min         = DBL_MAX;
+	t->max         = -DBL_MAX;
+	t->centroids   = rm_malloc(sizeof(TDigestCentroid) * t->cap);
+
+	return t;
+}
+
+void TDigest_Add
+(
+	TDigest *t,
+	double v,
+	double weight
+) {
+	ASSERT(t != NULL);
+	ASSERT(weight > 0);
+
+	if(isnan(v)) return;
+
+	if(t->merged + t->unmerged == t->cap) _TDigest_Compress(t);
+
+	t->centroids[t->merged + t->unmerged].mean  = v;
+	t->centroids[t->merged + t->unmerged].count = weight;
+	t->unmerged++;
+	t->unmerged_weight += weight;
+
+	if(v < t->min) t->min = v;
+	if(v > t->max) t->max = v;
+}
+
+double TDigest_Count
+(
+	const TDigest *t
+) {
+	ASSERT(t != NULL);
+	return t->merged_weight + t->unmerged_weight;
+}
+
+double TDigest_Quantile
+(
+	TDigest *t,
+	double q
+) {
+	ASSERT(t != NULL);
+	ASSERT(q >= 0 && q <= 1);
+
+	_TDigest_Compress(t);
+
+	uint n = t->merged;
+	TDigestCentroid *c = t->centroids;
+
+	if(n == 0) return NAN;
+	if(n == 1 || q == 0) return (n == 1) ? c[0].mean : t->min;
+	if(q == 1) return t->max;
+
+	double index = q * t->merged_weight;
+
+	// left tail, interpolate between min and first centroid
+	double half = c[0].count / 2;
+	if(index < half) {
+		return t->min + (index / half) * (c[0].mean - t->min);
+	}
+
+	// interpolate between centroids surrounding index
+	// each centroid's weight is assumed to be centered at its mean
+	double weight_so_far = half;
+	for(uint i = 0; i < n - 1; i++) {
+		double dw = (c[i].count + c[i + 1].count) / 2;
+		if(weight_so_far + dw > index) {
+			double frac = (index - weight_so_far) / dw;
+			return c[i].mean + frac * (c[i + 1].mean - c[i].mean);
+		}
+		weight_so_far += dw;
+	}
+
+	// right tail, interpolate between last centroid and max
+	half = c[n - 1].count / 2;
+	double frac = fmin((index - weight_so_far) / half, 1);
+	return c[n - 1].mean + frac * (t->max - c[n - 1].mean);
+}
+
+void TDigest_Free
+(
+	TDigest *t
+) {
+	ASSERT(t != NULL);
+
+	rm_free(t->centroids);
+	rm_free(t);
+}
+
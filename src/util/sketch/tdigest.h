@@ -0,0 +1,69 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+
+// default t-digest compression
+// number of retained centroids is proportional to compression
+#define TDIGEST_DEFAULT_COMPRESSION 100
+
+typedef struct {
+	double mean;   // centroid mean
+	double count;  // number of samples represented by centroid
+} TDigestCentroid;
+
+// merging t-digest, estimates quantiles using bounded memory
+// added samples are buffered and periodically merged into centroids
+typedef struct {
+	double compression;          // accuracy / memory tradeoff
+	uint cap;                    // centroids capacity
+	uint merged;                 // number of merged centroids
+	uint unmerged;               // number of buffered samples
+	double merged_weight;        // weight of merged centroids
+	double unmerged_weight;      // weight of buffered samples
+	double min;                  // smallest sample
+	double max;                  // largest sample
+	TDigestCentroid *centroids;  // merged centroids followed by buffer
+} TDigest;
+
+// create a new t-digest
+TDigest *TDigest_New
+(
+	double compression  // compression factor
+);
+
+// add a sample to digest
+void TDigest_Add
+(
+	TDigest *t,    // digest
+	double v,      // sample value
+	double weight  // sample weight
+);
+
+// total weight of samples added to digest
+double TDigest_Count
+(
+	const TDigest *t
+);
+
+// estimate value at quantile q, q must be in the range [0, 1]
+// returns NAN if digest is empty
+double TDigest_Quantile
+(
+	TDigest *t,
+	double q
+);
+
+// free digest
+void TDigest_Free
+(
+	TDigest *t
+);
+
@@ -0,0 +1,182 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "affinity.h"
+#include "../../configuration/config.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+// max number of NUMA nodes addressed by a memory policy
+#define MAX_NUMA_NODES 64
+
+// callback invoked for each id in a sysfs list
+typedef void (*list_cb)(int id, void *arg);
+
+// parse a sysfs list, e.g. "0-7,16-23"
+// invokes 'cb' for each listed id
+static bool _parse_list
+(
+	const char *path,  // sysfs file to parse
+	list_cb cb,        // callback invoked for each id
+	void *arg          // callback argument
+) {
+	FILE *f = fopen(path, "r");
+	if(f == NULL) return false;
+
+	char buf[1024];
+	bool res = (fgets(buf, sizeof(buf), f) != NULL);
+	fclose(f);
+	if(!res) return false;
+
+	char *tok = buf;
+	while(*tok != '\0' && *tok != '\n') {
+		char *end;
+		long lo = strtol(tok, &end, 10);
+		if(end == tok) return false;
+
+		long hi = lo;
+		if(*end == '-') {
+			tok = end + 1;
+			hi = strtol(tok, &end, 10);
+			if(end == tok) return false;
+		}
+
+		for(long id = lo; id <= hi; id++) cb(id, arg);
+
+		tok = (*end == ',') ? end + 1 : end;
+	}
+
+	return true;
+}
+
+static void _add_cpu
+(
+	int id,
+	void *arg
+) {
+	if(id < CPU_SETSIZE) CPU_SET(id, (cpu_set_t *)arg);
+}
+
+static void _add_node
+(
+	int id,
+	void *arg
+) {
+	if(id < MAX_NUMA_NODES) *(unsigned long *)arg |= (1UL << id);
+}
+
+bool Affinity_PinThread(void) {
+	uint64_t cpu_mask;
+	int64_t numa_node;
+	Config_Option_get(Config_THREAD_CPU_MASK, &cpu_mask);
+	Config_Option_get(Config_THREAD_NUMA_NODE, &numa_node);
+
+	// no restriction
+	if(cpu_mask == 0 && numa_node == THREAD_NUMA_NODE_ANY) return true;
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+
+	if(numa_node != THREAD_NUMA_NODE_ANY) {
+		// restrict to NUMA node CPUs
+		char path[128];
+		snprintf(path, sizeof(path),
+				"/sys/devices/system/node/node%lld/cpulist", (long long)numa_node);
+		if(!_parse_list(path, _add_cpu, &set)) {
+			RedisModule_Log(NULL, "warning",
+					"Failed to read CPUs of NUMA node %lld", (long long)numa_node);
+			return false;
+		}
+	} else {
+		for(int i = 0; i < 64 && i < CPU_SETSIZE; i++) CPU_SET(i, &set);
+	}
+
+	// intersect with CPU mask
+	if(cpu_mask != 0) {
+		for(int i = 0; i < 64 && i < CPU_SETSIZE; i++) {
+			if(!(cpu_mask & (1ULL << i))) CPU_CLR(i, &set);
+		}
+	}
+
+	if(CPU_COUNT(&set) == 0 ||
+	   pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+		RedisModule_Log(NULL, "warning", "Failed to set thread CPU affinity");
+		return false;
+	}
+
+	return true;
+}
+
+bool Affinity_SetMemoryPolicy(void) {
+	uint64_t policy;
+	int64_t numa_node;
+	Config_Option_get(Config_MEMORY_POLICY, &policy);
+	Config_Option_get(Config_THREAD_NUMA_NODE, &numa_node);
+
+	int mode;
+	unsigned long nodes = 0;
+
+	switch(policy) {
+		case MEMORY_POLICY_DEFAULT:
+			return true;
+
+		case MEMORY_POLICY_LOCAL:
+			if(numa_node == THREAD_NUMA_NODE_ANY) {
+				// allocate on the node of the CPU the thread is running on
+				mode = MPOL_LOCAL;
+			} else {
+				// allocate on the configured node
+				mode = MPOL_PREFERRED;
+				_add_node(numa_node, &nodes);
+			}
+			break;
+
+		case MEMORY_POLICY_INTERLEAVE:
+			// spread pages across all nodes
+			mode = MPOL_INTERLEAVE;
+			if(!_parse_list("/sys/devices/system/node/has_memory", _add_node,
+						&nodes)) {
+				RedisModule_Log(NULL, "warning", "Failed to read NUMA nodes");
+				return false;
+			}
+			break;
+
+		default:
+			ASSERT(false && "unknown memory policy");
+			return false;
+	}
+
+	unsigned long *nodemask = (nodes != 0) ? &nodes : NULL;
+	unsigned long maxnode   = (nodes != 0) ? MAX_NUMA_NODES + 1 : 0;
+	if(syscall(SYS_set_mempolicy, mode, nodemask, maxnode) != 0) {
+		RedisModule_Log(NULL, "warning", "Failed to set memory policy");
+		return false;
+	}
+
+	return true;
+}
+
+#else
+
+bool Affinity_PinThread(void) {
+	return true;
+}
+
+bool Affinity_SetMemoryPolicy(void) {
+	return true;
+}
+
+#endif
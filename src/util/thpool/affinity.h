@@ -0,0 +1,25 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+// thread placement on multi-socket machines
+// threads can be restricted to a set of CPUs and / or to the CPUs of a
+// NUMA node, memory allocated by a thread can be either localized to its
+// NUMA node or interleaved across all NUMA nodes
+// placement is determined by the THREAD_CPU_MASK, THREAD_NUMA_NODE and
+// MEMORY_POLICY configurations, on non Linux systems these are no-ops
+
+// restrict the calling thread to the configured CPU set
+// returns false if the configured CPU set couldn't be applied
+bool Affinity_PinThread(void);
+
+// apply configured memory policy to the calling thread
+// affecting all future allocations made by the thread
+// returns false if policy couldn't be applied
+bool Affinity_SetMemoryPolicy(void);
@@ -4,9 +4,11 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
+#include <unistd.h>
 #include <pthread.h>
 #include "RG.h"
 #include "pools.h"
+#include "affinity.h"
 #include "../../configuration/config.h"
 
 //------------------------------------------------------------------------------
@@ -16,6 +18,24 @@
 static threadpool _readers_thpool = NULL;  // readers
 static threadpool _writers_thpool = NULL;  // writers
 
+// invoked by each reader thread on creation
+static void _reader_thread_init
+(
+	int id
+) {
+	Affinity_PinThread();
+}
+
+// invoked by each writer thread on creation
+// writers allocate graph entities, apply memory policy
+static void _writer_thread_init
+(
+	int id
+) {
+	Affinity_PinThread();
+	Affinity_SetMemoryPolicy();
+}
+
 int ThreadPools_Init
 (
 ) {
@@ -33,7 +53,12 @@ int ThreadPools_Init
 	config_read = Config_Option_get(Config_MAX_QUEUED_QUERIES, &max_queue_size);
 	ASSERT(config_read == true);
 
-	return ThreadPools_CreatePools(reader_count, writer_count, max_queue_size);
+	// readers pool may grow at run-time up to the number of cores
+	int cores = sysconf(_SC_NPROCESSORS_ONLN);
+	int reader_capacity = (cores > reader_count) ? cores : reader_count;
+
+	return ThreadPools_CreatePools(reader_count, reader_capacity, writer_count,
+			max_queue_size);
 }
 
 // set up thread pools  (readers and writers)
@@ -41,16 +66,19 @@ int ThreadPools_Init
 int ThreadPools_CreatePools
 (
 	uint reader_count,
+	uint reader_capacity,
 	uint writer_count,
 	uint64_t max_pending_work
 ) {
 	ASSERT(_readers_thpool == NULL);
 	ASSERT(_writers_thpool == NULL);
 
-	_readers_thpool = thpool_init(reader_count, "reader");
+	_readers_thpool = thpool_init(reader_count, reader_capacity, "reader",
+			_reader_thread_init);
 	if(_readers_thpool == NULL) return 0;
 
-	_writers_thpool = thpool_init(writer_count, "writer");
+	_writers_thpool = thpool_init(writer_count, writer_count, "writer",
+			_writer_thread_init);
 	if(_writers_thpool == NULL) return 0;
 
 	ThreadPools_SetMaxPendingWork(max_pending_work);
@@ -58,7 +86,7 @@ int ThreadPools_CreatePools
 	return 1;
 }
 
-// return number of threads in both the readers and writers pools
+// return max number of threads in both the readers and writers pools
 uint ThreadPools_ThreadCount
 (
 	void
@@ -67,8 +95,8 @@ uint ThreadPools_ThreadCount
 	ASSERT(_writers_thpool != NULL);
 
 	uint count = 0;
-	count += thpool_num_threads(_readers_thpool);
-	count += thpool_num_threads(_writers_thpool);
+	count += thpool_capacity(_readers_thpool);
+	count += thpool_capacity(_writers_thpool);
 
 	return count;
 }
@@ -81,9 +109,21 @@ uint ThreadPools_ReadersCount
 	return thpool_num_threads(_readers_thpool);
 }
 
+// resize READERS thread-pool
+// returns 1 if pool was resized, 0 otherwise
+// prior to pool creation (module load) the pool is sized from config
+// by ThreadPools_Init, nothing to resize
+int ThreadPools_SetReadersCount
+(
+	uint count
+) {
+	if(_readers_thpool == NULL) return 1;
+	return (thpool_resize(_readers_thpool, count) == 0);
+}
+
 // retrieve current thread id
 // 0         redis-main
-// 1..N + 1  readers
+// 1..N + 1  readers, N being the readers pool capacity
 // N + 2..   writers
 int ThreadPools_GetThreadID
 (
@@ -96,7 +136,7 @@ int ThreadPools_GetThreadID
 	// most likely Redis main thread
 	int thread_id;
 	pthread_t pthread = pthread_self();
-	int readers_count = thpool_num_threads(_readers_thpool);
+	int readers_count = thpool_capacity(_readers_thpool);
 
 	// search in writers
 	thread_id = thpool_get_thread_id(_writers_thpool, pthread);
@@ -19,12 +19,14 @@ int ThreadPools_Init
 // create both readers and writers thread pools
 int ThreadPools_CreatePools
 (
-	uint reader_count,
-	uint writer_count,
+	uint reader_count,     // number of reader threads
+	uint reader_capacity,  // max number of reader threads
+	uint writer_count,     // number of writer threads
 	uint64_t max_pending_work
 );
 
-// return number of threads in both the readers and writers pools
+// return max number of threads in both the readers and writers pools
+// thread ids are in the range 0..ThreadPools_ThreadCount()
 uint ThreadPools_ThreadCount
 (
 	void
@@ -36,9 +38,16 @@ uint ThreadPools_ReadersCount
 	void
 );
 
+// resize READERS thread-pool, up to its capacity
+// returns 1 if pool was resized, 0 otherwise
+int ThreadPools_SetReadersCount
+(
+	uint count
+);
+
 // retrieve current thread id
 // 0         redis-main
-// 1..N + 1  readers
+// 1..N + 1  readers, N being the readers pool capacity
 // N + 2..   writers
 int ThreadPools_GetThreadID
 (
@@ -78,10 +78,15 @@ typedef struct thread {
 typedef struct thpool_ {
 	thread **threads;                 /* pointer to threads        */
 	const char *name;                 /* name associated with pool */
+	int capacity;                     /* max number of threads     */
+	int num_threads_created;          /* threads created so far    */
 	volatile int num_threads_alive;   /* threads currently alive   */
+	volatile int num_threads_active;  /* threads serving jobs      */
 	volatile int num_threads_working; /* threads currently working */
 	pthread_mutex_t thcount_lock;     /* used for thread count etc */
 	pthread_cond_t threads_all_idle;  /* signal to thpool_wait     */
+	pthread_cond_t threads_resized;   /* signal to parked threads  */
+	void (*thread_init_cb)(int id);   /* invoked by each new thread*/
 	jobqueue jobqueue;                /* job queue                 */
 } thpool_;
 
@@ -89,6 +94,7 @@ typedef struct thpool_ {
 
 static int thread_init(thpool_* thpool_p, struct thread **thread_p, int id);
 static void *thread_do(struct thread *thread_p);
+static void thread_park(struct thread *thread_p);
 static void thread_hold(int sig_id);
 static void thread_destroy(struct thread *thread_p);
 
@@ -107,7 +113,8 @@ static void bsem_wait(struct bsem *bsem_p);
 /* ========================== THREADPOOL ============================ */
 
 /* Initialise thread pool */
-struct thpool_ *thpool_init(int num_threads, const char *name) {
+struct thpool_ *thpool_init(int num_threads, int capacity, const char *name,
+		void (*thread_init_cb)(int id)) {
 
 	threads_on_hold = 0;
 	threads_keepalive = 1;
@@ -115,6 +122,9 @@ struct thpool_ *thpool_init(int num_threads, const char *name) {
 	if(num_threads < 0) {
 		num_threads = 0;
 	}
+	if(capacity < num_threads) {
+		capacity = num_threads;
+	}
 
 	/* Make new thread pool */
 	thpool_* thpool_p;
@@ -129,7 +139,11 @@ struct thpool_ *thpool_init(int num_threads, const char *name) {
 	}
 
 	thpool_p->name = name;
+	thpool_p->capacity = capacity;
+	thpool_p->thread_init_cb = thread_init_cb;
 	thpool_p->num_threads_alive = 0;
+	thpool_p->num_threads_active = num_threads;
+	thpool_p->num_threads_created = num_threads;
 	thpool_p->num_threads_working = 0;
 
 	/* Initialise the job queue */
@@ -139,8 +153,8 @@ struct thpool_ *thpool_init(int num_threads, const char *name) {
 		return NULL;
 	}
 
-	/* Make threads in pool */
-	thpool_p->threads = (struct thread **)rm_calloc(num_threads, sizeof(struct thread *));
+	/* Make threads in pool, reserve room for the pool to grow */
+	thpool_p->threads = (struct thread **)rm_calloc(capacity, sizeof(struct thread *));
 	if(thpool_p->threads == NULL) {
 		err("thpool_init(): Could not allocate memory for threads\n");
 		jobqueue_destroy(&thpool_p->jobqueue);
@@ -150,6 +164,7 @@ struct thpool_ *thpool_init(int num_threads, const char *name) {
 
 	pthread_mutex_init(&(thpool_p->thcount_lock), NULL);
 	pthread_cond_init(&thpool_p->threads_all_idle, NULL);
+	pthread_cond_init(&thpool_p->threads_resized, NULL);
 
 	/* Thread init */
 	int n;
@@ -167,6 +182,34 @@ struct thpool_ *thpool_init(int num_threads, const char *name) {
 	return thpool_p;
 }
 
+/* Resize the number of threads serving jobs */
+int thpool_resize(thpool_* thpool_p, int num_threads) {
+	if(num_threads < 1 || num_threads > thpool_p->capacity) {
+		return -1;
+	}
+
+	pthread_mutex_lock(&thpool_p->thcount_lock);
+
+	/* Create missing threads, threads are never destroyed
+	 * keeping thread ids stable */
+	while(thpool_p->num_threads_created < num_threads) {
+		int id = thpool_p->num_threads_created;
+		if(thread_init(thpool_p, &thpool_p->threads[id], id) == -1) {
+			break;
+		}
+		thpool_p->num_threads_created++;
+	}
+
+	thpool_p->num_threads_active = thpool_p->num_threads_created < num_threads ?
+		thpool_p->num_threads_created : num_threads;
+
+	/* Wake parked threads which are now in range */
+	pthread_cond_broadcast(&thpool_p->threads_resized);
+	pthread_mutex_unlock(&thpool_p->thcount_lock);
+
+	return (thpool_p->num_threads_active == num_threads) ? 0 : -1;
+}
+
 /* Add work to the thread pool */
 int thpool_add_work(thpool_* thpool_p, void (*function_p)(void *), void *arg_p) {
 	job *newjob;
@@ -213,6 +256,9 @@ void thpool_destroy(thpool_* thpool_p) {
 	time(&start);
 	while(tpassed < TIMEOUT && thpool_p->num_threads_alive) {
 		bsem_post_all(thpool_p->jobqueue.has_jobs);
+		pthread_mutex_lock(&thpool_p->thcount_lock);
+		pthread_cond_broadcast(&thpool_p->threads_resized);
+		pthread_mutex_unlock(&thpool_p->thcount_lock);
 		time(&end);
 		tpassed = difftime(end, start);
 	}
@@ -263,11 +309,17 @@ int thpool_num_threads_working(thpool_* thpool_p) {
 }
 
 int thpool_num_threads(thpool_* thpool_p) {
-	return thpool_p->num_threads_alive;
+	return thpool_p->num_threads_active;
+}
+
+int thpool_capacity(thpool_* thpool_p) {
+	return thpool_p->capacity;
 }
 
 int thpool_get_thread_id(thpool_* thpool_p, pthread_t pthread) {
-	for(int i = 0; i < thpool_p->num_threads_alive; i++) {
+	/* Threads added by thpool_resize come alive asynchronously and out of
+	 * order, scan every created thread rather than the alive count */
+	for(int i = 0; i < thpool_p->num_threads_created; i++) {
 		thread *thread = thpool_p->threads[i];
 		if(thread->pthread == pthread) return thread->id;
 	}
@@ -300,7 +352,7 @@ void thpool_set_jobqueue_cap(thpool_* thpool_p, uint64_t val) {
 static int thread_init(thpool_* thpool_p, struct thread **thread_p, int id) {
 
 	*thread_p = (struct thread *)rm_calloc(1, sizeof(struct thread));
-	if(thread_p == NULL) {
+	if(*thread_p == NULL) {
 		err("thread_init(): Could not allocate memory for thread\n");
 		return -1;
 	}
@@ -313,6 +365,17 @@ static int thread_init(thpool_* thpool_p, struct thread **thread_p, int id) {
 	return 0;
 }
 
+/* Parks the calling thread while its id is beyond the number of active threads */
+static void thread_park(thread *thread_p) {
+	thpool_* thpool_p = thread_p->thpool_p;
+
+	pthread_mutex_lock(&thpool_p->thcount_lock);
+	while(threads_keepalive && thread_p->id >= thpool_p->num_threads_active) {
+		pthread_cond_wait(&thpool_p->threads_resized, &thpool_p->thcount_lock);
+	}
+	pthread_mutex_unlock(&thpool_p->thcount_lock);
+}
+
 /* Sets the calling thread on hold */
 static void thread_hold(int sig_id) {
 	(void)sig_id;
@@ -357,6 +420,11 @@ static void *thread_do(struct thread *thread_p) {
 		err("thread_do(): cannot handle SIGUSR1");
 	}
 
+	/* Apply thread placement, e.g. CPU affinity */
+	if(thpool_p->thread_init_cb != NULL) {
+		thpool_p->thread_init_cb(thread_p->id);
+	}
+
 	/* Mark thread as alive (initialized) */
 	pthread_mutex_lock(&thpool_p->thcount_lock);
 	thpool_p->num_threads_alive += 1;
@@ -364,8 +432,16 @@ static void *thread_do(struct thread *thread_p) {
 
 	while(threads_keepalive) {
 
+		thread_park(thread_p);
+
 		bsem_wait(thpool_p->jobqueue.has_jobs);
 
+		/* Pool shrunk while waiting, hand the wake-up over to an active thread */
+		if(thread_p->id >= thpool_p->num_threads_active) {
+			bsem_post(thpool_p->jobqueue.has_jobs);
+			continue;
+		}
+
 		if(threads_keepalive) {
 
 			pthread_mutex_lock(&thpool_p->thcount_lock);
@@ -33,12 +33,31 @@ typedef struct thpool_* threadpool;
  *    thpool = thpool_init(4);               //then we initialize it to 4 threads
  *    ..
  *
- * @param  num_threads   number of threads to be created in the threadpool
- * @param  name          name associated with pool
- * @return threadpool    created threadpool on success,
- *                       NULL on error
+ * @param  num_threads     number of threads to be created in the threadpool
+ * @param  capacity        max number of threads the pool can be resized to
+ * @param  name            name associated with pool
+ * @param  thread_init_cb  optional callback invoked by each new thread
+ *                         with its id, before it serves any job
+ * @return threadpool      created threadpool on success,
+ *                         NULL on error
  */
-threadpool thpool_init(int num_threads, const char *name);
+threadpool thpool_init(int num_threads, int capacity, const char *name,
+		void (*thread_init_cb)(int id));
+
+
+/**
+ * @brief Resize the number of threads serving jobs
+ *
+ * Growing the pool creates missing threads or wakes parked ones,
+ * shrinking parks threads with an id beyond the new size once they're
+ * done with their current job, threads are never destroyed such that
+ * thread ids remain stable.
+ *
+ * @param  threadpool    the threadpool to resize
+ * @param  num_threads   new number of threads, 1..capacity
+ * @return 0 on success, -1 otherwise
+ */
+int thpool_resize(threadpool, int num_threads);
 
 
 /**
@@ -187,14 +206,24 @@ int thpool_num_threads_working(threadpool);
 /**
  * @brief Returns number of threads in pool.
  *
- * Alive threads are the threads that are either performing work or are idle.
+ * Active threads are the threads that are either performing work or are idle,
+ * parked threads are excluded.
  *
  * @param threadpool     the threadpool of interest
- * @return integer       number of alive threads
+ * @return integer       number of active threads
  */
 int thpool_num_threads(threadpool);
 
 
+/**
+ * @brief Returns max number of threads in pool.
+ *
+ * @param threadpool     the threadpool of interest
+ * @return integer       pool capacity
+ */
+int thpool_capacity(threadpool);
+
+
 /**
  * @brief Returns friendly id associated with thread.
  *
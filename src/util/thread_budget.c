@@ -0,0 +1,131 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "thread_budget.h"
+#include <unistd.h>
+#include <pthread.h>
+
+static int _capacity = 1;  // total number of threads to split between queries
+static int _active   = 0;  // number of queries holding a budget
+
+// per thread state
+static __thread int _threads = 0;                 // granted threads
+static __thread GrB_Descriptor _desc = NULL;      // budget descriptor
+
+// frees a thread's descriptor when the thread exits
+static pthread_key_t _desc_key;
+
+static void _desc_free
+(
+	void *desc
+) {
+	GrB_Descriptor d = (GrB_Descriptor)desc;
+	GrB_Descriptor_free(&d);
+}
+
+void ThreadBudget_Init
+(
+	int omp_thread_count
+) {
+	// a lone query may use every core even if the configured
+	// OpenMP thread count is lower
+	int cores = sysconf(_SC_NPROCESSORS_ONLN);
+	_capacity = (cores > omp_thread_count) ? cores : omp_thread_count;
+	if(_capacity < 1) _capacity = 1;
+
+	int res = pthread_key_create(&_desc_key, _desc_free);
+	ASSERT(res == 0);
+	UNUSED(res);
+}
+
+int ThreadBudget_Acquire
+(
+	uint64_t work,
+	int max_threads
+) {
+	// a previous query on this thread failed to release its budget
+	if(_threads != 0) ThreadBudget_Release();
+
+	int active = __atomic_add_fetch(&_active, 1, __ATOMIC_RELAXED);
+
+	// fair share of the machine given current load
+	int threads = _capacity / active;
+	if(threads < 1) threads = 1;
+
+	// small workloads don't benefit from additional threads
+	uint64_t by_work = work / THREAD_BUDGET_WORK_PER_THREAD;
+	if(by_work < (uint64_t)threads) threads = (by_work > 0) ? by_work : 1;
+
+	// caller imposed limit, e.g. admission control under memory pressure
+	if(max_threads > 0 && threads > max_threads) threads = max_threads;
+
+	_threads = threads;
+	return threads;
+}
+
+void ThreadBudget_Release(void) {
+	if(_threads == 0) return;
+
+	__atomic_sub_fetch(&_active, 1, __ATOMIC_RELAXED);
+	_threads = 0;
+}
+
+int ThreadBudget_Threads(void) {
+	return _threads;
+}
+
+// copy descriptor field from src to dest
+static void _copy_field
+(
+	GrB_Descriptor dest,
+	GrB_Descriptor src,
+	GrB_Desc_Field field
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Desc_Value v = GxB_DEFAULT;
+	if(src != NULL) {
+		info = GxB_Desc_get(src, field, &v);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// mask field values are accumulated, reset before setting
+	info = GrB_Descriptor_set(dest, field, GxB_DEFAULT);
+	ASSERT(info == GrB_SUCCESS);
+	if(v != GxB_DEFAULT) {
+		info = GrB_Descriptor_set(dest, field, v);
+		ASSERT(info == GrB_SUCCESS);
+	}
+}
+
+GrB_Descriptor ThreadBudget_Descriptor
+(
+	GrB_Descriptor desc
+) {
+	if(_threads == 0) return desc;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	if(_desc == NULL) {
+		info = GrB_Descriptor_new(&_desc);
+		ASSERT(info == GrB_SUCCESS);
+		pthread_setspecific(_desc_key, _desc);
+	}
+
+	_copy_field(_desc, desc, GrB_OUTP);
+	_copy_field(_desc, desc, GrB_MASK);
+	_copy_field(_desc, desc, GrB_INP0);
+	_copy_field(_desc, desc, GrB_INP1);
+
+	info = GxB_Desc_set(_desc, GxB_NTHREADS, _threads);
+	ASSERT(info == GrB_SUCCESS);
+
+	return _desc;
+}
+
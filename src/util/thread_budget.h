@@ -0,0 +1,50 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// amount of matrix work (in entries) assigned to a single GraphBLAS thread
+#define THREAD_BUDGET_WORK_PER_THREAD 65536
+
+// the thread budget splits the machine's cores between concurrently
+// executing queries, each query is granted a number of GraphBLAS threads
+// according to the current load and its estimated matrix work
+// such that concurrent queries don't oversubscribe the machine
+// while a lone heavy query may use all idle cores
+
+// initialize thread budget
+void ThreadBudget_Init
+(
+	int omp_thread_count  // configured number of OpenMP threads
+);
+
+// acquire a GraphBLAS thread budget for the calling thread's query
+// returns the number of granted threads
+int ThreadBudget_Acquire
+(
+	uint64_t work,   // estimated matrix work, number of entries processed
+	int max_threads  // max number of threads to grant, 0 no limit
+);
+
+// release the calling thread's budget
+void ThreadBudget_Release(void);
+
+// number of threads granted to the calling thread's query
+// 0 if no budget was acquired
+int ThreadBudget_Threads(void);
+
+// returns a descriptor equivalent to 'desc' restricted to the calling
+// thread's budget, 'desc' is returned as is if no budget was acquired
+// the returned descriptor is owned by the calling thread and is only valid
+// until the next call
+GrB_Descriptor ThreadBudget_Descriptor
+(
+	GrB_Descriptor desc  // descriptor to apply budget to, may be NULL
+);
+
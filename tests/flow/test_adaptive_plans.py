@@ -0,0 +1,57 @@
+from common import *
+
+GRAPH_ID = "adaptive_plans"
+
+# number of B nodes, enough for filter selectivity to be observed
+B_COUNT = 2000
+# number of A nodes, each connected to a single B node
+A_COUNT = 10
+
+
+class testAdaptivePlans():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.graph = Graph(self.env.getConnection(), GRAPH_ID)
+        self.populate()
+
+    def populate(self):
+        self.graph.query("UNWIND range(1, $n) AS x CREATE (:B {v: 1, id: x})",
+                         {'n': B_COUNT - A_COUNT})
+        self.graph.query("UNWIND range(1, $n) AS x CREATE (:A)-[:R]->(:B {v: 1, id: -x})",
+                         {'n': A_COUNT})
+
+    def test01_nonselective_filter_replans(self):
+        q = "MATCH (a:A)-[:R]->(b:B) WHERE b.v = $v RETURN count(b)"
+
+        # filtered node is the traversal entry point
+        plan = self.graph.execution_plan(q, {'v': 1})
+        self.env.assertIn("Node By Label Scan | (b:B)", plan)
+
+        # filter passes every scanned record
+        res = self.graph.query(q, {'v': 1}).result_set
+        self.env.assertEquals(res[0][0], A_COUNT)
+
+        # plan re-optimized for these parameters, traversal starts at 'a'
+        plan = self.graph.execution_plan(q, {'v': 1})
+        self.env.assertIn("Node By Label Scan | (a:A)", plan)
+
+        res = self.graph.query(q, {'v': 1})
+        self.env.assertTrue(res.cached_execution)
+        self.env.assertEquals(res.result_set[0][0], A_COUNT)
+
+        # other parameters keep using the cached plan
+        plan = self.graph.execution_plan(q, {'v': 2})
+        self.env.assertIn("Node By Label Scan | (b:B)", plan)
+
+        res = self.graph.query(q, {'v': 2}).result_set
+        self.env.assertEquals(res[0][0], 0)
+
+    def test02_selective_filter_keeps_plan(self):
+        q = "MATCH (a:A)-[:R]->(b:B) WHERE b.id = $id RETURN count(b)"
+
+        for i in range(3):
+            plan = self.graph.execution_plan(q, {'id': -1})
+            self.env.assertIn("Node By Label Scan | (b:B)", plan)
+
+            res = self.graph.query(q, {'id': -1}).result_set
+            self.env.assertEquals(res[0][0], 1)
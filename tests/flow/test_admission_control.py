@@ -0,0 +1,107 @@
+from common import *
+from pathos.pools import ProcessPool as Pool
+
+# 1. test getting and setting the query memory budget
+# 2. test overflowing the server when there's no budget
+#    expect no errors
+# 3. test overflowing the server when there's a tight budget
+#    expect queries to be queued, downgraded and possibly rejected
+#    with a retryable error
+# 4. test reservations are released once queries are done
+
+GRAPH_NAME = "admission_control"
+SLOW_QUERY = "UNWIND range (0, 1000000) AS x WITH x WHERE (x / 2) = 50 RETURN x"
+
+# min reservation of a query, see ADMISSION_MIN_RESERVATION
+MIN_RESERVATION = 64 * 1024
+
+def issue_query(conn, q):
+    try:
+        conn.execute_command("GRAPH.QUERY", GRAPH_NAME, q)
+        return True
+    except Exception as e:
+        return "TRYAGAIN" in str(e)
+
+class testAdmissionControl():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs="THREAD_COUNT 4")
+        # skip test if we're running under Valgrind
+        if self.env.envRunner.debugger is not None or os.getenv('COV') == '1':
+            self.env.skip() # valgrind is not working correctly with multi process
+
+        self.conn = self.env.getConnection()
+
+    def stress_server(self):
+        threadpool_size = self.conn.execute_command("GRAPH.CONFIG", "GET", "THREAD_COUNT")[1]
+        thread_count = threadpool_size * 2
+        qs = [SLOW_QUERY] * thread_count
+        connections = []
+        pool = Pool(nodes=thread_count)
+
+        # init connections
+        for i in range(thread_count):
+            connections.append(self.env.getConnection())
+
+        # invoke queries
+        result = pool.map(issue_query, connections, qs)
+
+        pool.clear()
+
+        # all queries either succeeded or were rejected with a retryable error
+        self.env.assertTrue(all(result))
+
+    def admission_info(self):
+        return self.conn.info("graph_admission")
+
+    def test_01_query_mem_budget_config(self):
+        # read budget, expecting no budget by default
+        result = self.conn.execute_command("GRAPH.CONFIG", "GET", "QUERY_MEM_BUDGET")
+        self.env.assertEquals(result[1], 0)
+
+        # update configuration
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_BUDGET", 1024)
+
+        # re-read configuration
+        result = self.conn.execute_command("GRAPH.CONFIG", "GET", "QUERY_MEM_BUDGET")
+        self.env.assertEquals(result[1], 1024)
+        self.env.assertEquals(self.admission_info()['budget'], 1024)
+
+        # invalid budget
+        try:
+            self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_BUDGET", -1)
+            self.env.assertTrue(False)
+        except ResponseError:
+            pass
+
+    def test_02_overflow_no_budget(self):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_BUDGET", 0)
+        admitted = self.admission_info()['admitted']
+
+        self.stress_server()
+
+        # admission control is disabled
+        self.env.assertEquals(self.admission_info()['admitted'], admitted)
+
+    def test_03_overflow_with_budget(self):
+        # budget fits a single query
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_BUDGET", MIN_RESERVATION)
+
+        self.stress_server()
+
+        info = self.admission_info()
+        self.env.assertGreater(info['admitted'], 0)
+        # concurrent queries had to wait for their turn
+        self.env.assertGreater(info['queued'], 0)
+        # the budget is under pressure as soon as a query is admitted
+        self.env.assertEquals(info['downgraded'], info['admitted'])
+
+    def test_04_reservations_released(self):
+        info = self.admission_info()
+        self.env.assertEquals(info['reserved'], 0)
+        self.env.assertEquals(info['in_flight'], 0)
+
+        # a lone query is always admitted, even if it exceeds the budget
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_BUDGET", 1)
+        self.conn.execute_command("GRAPH.QUERY", GRAPH_NAME, "RETURN 1")
+
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_BUDGET", 0)
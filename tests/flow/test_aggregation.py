@@ -133,4 +133,61 @@ class testAggregations():
 
         query = 'MATCH (n:L) WHERE (null <> false) XOR true RETURN COUNT(n)'
         expected = [[0]]
-        self.get_res_and_assertAlmostEquals(query, expected)
\ No newline at end of file
+        self.get_res_and_assertAlmostEquals(query, expected)
+
+    def test10_percentileApprox(self):
+        # empty input
+        query = 'UNWIND [] AS x RETURN percentileApprox(x, 0.5)'
+        self.get_res_and_assertEquals(query, [[None]])
+
+        # small inputs are exact, matching percentileCont
+        for p in [0, 0.1, 0.33, 0.5, 1]:
+            query = f'UNWIND [2, 4, 6, 8, 10] AS x RETURN percentileApprox(x, {p})'
+            expected = graph.query(f'UNWIND [2, 4, 6, 8, 10] AS x RETURN percentileCont(x, {p})').result_set
+            self.get_res_and_assertAlmostEquals(query, expected)
+
+        # large input, estimate within 0.1% of rank
+        query = 'UNWIND range(0, 99999) AS x RETURN percentileApprox(x, 0.99)'
+        actual = graph.query(query).result_set[0][0]
+        self.env.assertTrue(abs(actual - 99000) <= 100)
+
+        # invalid percentile
+        try:
+            graph.query('UNWIND [1] AS x RETURN percentileApprox(x, 2)')
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("must be a number in the range 0.0 to 1.0", str(e))
+
+    def test11_approxCountDistinct(self):
+        query = 'UNWIND [] AS x RETURN approxCountDistinct(x)'
+        self.get_res_and_assertEquals(query, [[0]])
+
+        # nulls are ignored, duplicates counted once
+        query = 'UNWIND [1, 1, 2, null, "a", "a", [1]] AS x RETURN approxCountDistinct(x)'
+        self.get_res_and_assertEquals(query, [[4]])
+
+        query = 'UNWIND range(1, 100000) AS x RETURN approxCountDistinct(x % 50000)'
+        actual = graph.query(query).result_set[0][0]
+        self.env.assertTrue(abs(actual - 50000) <= 50000 * 0.03)
+
+    def test12_topK(self):
+        query = 'UNWIND [] AS x RETURN topK(x, 2)'
+        self.get_res_and_assertEquals(query, [[[]]])
+
+        # values are reported by descending frequency
+        query = """UNWIND ['a', 'b', 'b', 'c', 'c', 'c', null, null, null, null]
+                   AS x RETURN topK(x, 2)"""
+        self.get_res_and_assertEquals(query, [[['c', 'b']]])
+
+        # heavy hitters among many distinct values
+        query = """UNWIND range(1, 10000) AS x
+                   WITH CASE WHEN x % 10 = 0 THEN 'heavy' ELSE x END AS v
+                   RETURN topK(v, 1)"""
+        self.get_res_and_assertEquals(query, [[['heavy']]])
+
+        # invalid k
+        try:
+            graph.query('UNWIND [1] AS x RETURN topK(x, 0)')
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("must be a positive integer", str(e))
@@ -0,0 +1,91 @@
+from common import *
+
+GRAPH_ID = "algebraic_views"
+redis_graph = None
+
+class testAlgebraicViews():
+    def __init__(self):
+        global redis_graph
+        self.env = Env(decodeResponses=True)
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        redis_graph.query("""CREATE
+            (a:Person {name: 'a'}), (b:Person {name: 'b'}), (c:Person {name: 'c'}),
+            (r:Robot {name: 'r'}),
+            (x:Company {name: 'x'}), (y:Company {name: 'y'}),
+            (a)-[:KNOWS]->(b), (a)-[:KNOWS]->(r), (b)-[:KNOWS]->(c),
+            (b)-[:WORKS_AT]->(x), (c)-[:WORKS_AT]->(y), (r)-[:WORKS_AT]->(y)""")
+
+    def colleagues(self):
+        q = """MATCH (p:Person)-[:KNOWS]->(:Person)-[:WORKS_AT]->(c)
+               RETURN p.name, c.name ORDER BY p.name, c.name"""
+        return redis_graph.query(q).result_set
+
+    def views(self):
+        q = """CALL db.algebraicViews() YIELD name, pattern, entries
+               RETURN name, pattern, entries ORDER BY name"""
+        return redis_graph.query(q).result_set
+
+    def test01_create_view(self):
+        expected = self.colleagues()
+        self.env.assertEquals(expected, [["a", "x"], ["b", "y"]])
+
+        redis_graph.query("""CALL db.algebraicView.create('colleagues',
+                             [NULL, 'KNOWS', 'Person', 'WORKS_AT'])""")
+
+        self.env.assertEquals(self.views(),
+                [["colleagues", [None, "KNOWS", "Person", "WORKS_AT"], 2]])
+        self.env.assertEquals(self.colleagues(), expected)
+
+    def test02_view_maintenance(self):
+        # additions
+        redis_graph.query("""MATCH (c:Person {name: 'c'}), (x:Company {name: 'x'})
+                             CREATE (c)-[:WORKS_AT]->(x)""")
+        redis_graph.query("""MATCH (a:Person {name: 'a'}), (c:Person {name: 'c'})
+                             CREATE (a)-[:KNOWS]->(c)""")
+        self.env.assertEquals(self.colleagues(),
+                [["a", "x"], ["a", "y"], ["b", "x"], ["b", "y"]])
+        self.env.assertEquals(self.views()[0][2], 4)
+
+        # deletions, (a)->(x) is still reachable through c
+        redis_graph.query("""MATCH (:Person {name: 'a'})-[e:KNOWS]->(:Person {name: 'b'})
+                             DELETE e""")
+        self.env.assertEquals(self.colleagues(),
+                [["a", "x"], ["a", "y"], ["b", "x"], ["b", "y"]])
+        self.env.assertEquals(self.views()[0][2], 4)
+
+        redis_graph.query("""MATCH (:Person {name: 'c'})-[e:WORKS_AT]->(:Company {name: 'x'})
+                             DELETE e""")
+        self.env.assertEquals(self.colleagues(), [["a", "y"], ["b", "y"]])
+
+        # labels
+        redis_graph.query("MATCH (r:Robot) SET r:Person")
+        redis_graph.query("""MATCH (c:Person {name: 'c'}), (r:Robot)
+                             CREATE (c)-[:KNOWS]->(r)""")
+        self.env.assertEquals(self.colleagues(),
+                [["a", "y"], ["b", "y"], ["c", "y"]])
+
+        # c no longer an intermediate Person
+        redis_graph.query("MATCH (c:Person {name: 'c'}) REMOVE c:Person")
+        self.env.assertEquals(self.colleagues(), [["a", "y"]])
+
+    def test03_drop_view(self):
+        expected = self.colleagues()
+        redis_graph.query("CALL db.algebraicView.drop('colleagues')")
+        self.env.assertEquals(self.views(), [])
+        self.env.assertEquals(self.colleagues(), expected)
+
+    def test04_invalid_arguments(self):
+        queries = ["CALL db.algebraicView.create('v', ['Person'])",
+                   "CALL db.algebraicView.create('v', ['Person', 'LIKES'])",
+                   "CALL db.algebraicView.create('v', ['Alien', 'KNOWS'])",
+                   "CALL db.algebraicView.drop('v')"]
+        for q in queries:
+            try:
+                redis_graph.query(q)
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError:
+                pass
@@ -180,3 +180,52 @@ class testBFS(FlowTestsBase):
         actual_result = graph.query(query)
         expected_result = [[['b'], ['e']]]
         self.env.assertEquals(actual_result.result_set, expected_result)
+
+    # Test multi-source BFS, one record per source with levels.
+    def test08_msbfs(self):
+        query = """MATCH (s) WITH s ORDER BY s.v WITH collect(s) AS sources
+                   CALL algo.MSBFS(sources, 0, NULL) YIELD source, nodes, levels
+                   RETURN source.v, [n IN nodes | n.v], levels"""
+        actual_result = graph.query(query)
+        expected_result = {'a': {'b': 1, 'c': 2, 'd': 2, 'e': 3},
+                           'b': {'c': 1, 'd': 1, 'e': 2},
+                           'c': {},
+                           'd': {'e': 1},
+                           'e': {}}
+        self.env.assertEquals(len(actual_result.result_set), 5)
+        for row in actual_result.result_set:
+            self.env.assertEquals(dict(zip(row[1], row[2])), expected_result[row[0]])
+
+        # restricted relationship type and max depth agree with algo.BFS
+        for (depth, reltype) in [(1, 'NULL'), (0, "'E1'"), (2, "'E1'")]:
+            query = """MATCH (s) WITH collect(s) AS sources
+                       CALL algo.MSBFS(sources, %d, %s) YIELD source, nodes
+                       RETURN source.v, [n IN nodes | n.v] ORDER BY source.v""" % (depth, reltype)
+            msbfs = graph.query(query).result_set
+            for row in msbfs:
+                query = """MATCH (s {v: '%s'}) CALL algo.BFS(s, %d, %s) YIELD nodes
+                           RETURN [n IN nodes | n.v]""" % (row[0], depth, reltype)
+                bfs = graph.query(query).result_set
+                expected = bfs[0][0] if len(bfs) > 0 else []
+                self.compare_unsorted_arrays(row[1], expected)
+
+    def test09_msbfs_edge_cases(self):
+        # no sources
+        query = """CALL algo.MSBFS([], 0, NULL) YIELD source RETURN source"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [])
+
+        # missing relationship type, sources reach nothing
+        query = """MATCH (s {v: 'a'}) CALL algo.MSBFS([s, s], 0, 'NONE_EXISTING_RELATION')
+                   YIELD source, nodes RETURN source.v, nodes"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [['a', []], ['a', []]])
+
+        # invalid sources and depth
+        for query in ["CALL algo.MSBFS([1], 0, NULL) YIELD nodes RETURN nodes",
+                      "MATCH (s {v: 'a'}) CALL algo.MSBFS([s], -1, NULL) YIELD nodes RETURN nodes"]:
+            try:
+                graph.query(query)
+                self.env.assertTrue(False)
+            except ResponseError:
+                pass
@@ -24,8 +24,8 @@ class testConfig(FlowTestsBase):
         # Try reading all configurations
         config_name = "*"
         response = redis_con.execute_command("GRAPH.CONFIG GET " + config_name)
-        # 12 configurations should be reported
-        self.env.assertEquals(len(response), 13)
+        # 21 configurations should be reported
+        self.env.assertEquals(len(response), 21)
 
     def test02_config_get_invalid_name(self):
         global redis_graph
@@ -86,9 +86,9 @@ class testConfig(FlowTestsBase):
         prev_conf = redis_con.execute_command("GRAPH.CONFIG GET *")
 
         try:
-            # Set multiple configuration values, THREAD_COUNT is NOT
+            # Set multiple configuration values, CACHE_SIZE is NOT
             # a runtime configuration, expecting this command to fail
-            response = redis_con.execute_command("GRAPH.CONFIG SET QUERY_MEM_CAPACITY 150 THREAD_COUNT 40")
+            response = redis_con.execute_command("GRAPH.CONFIG SET QUERY_MEM_CAPACITY 150 CACHE_SIZE 40")
             assert(False)
         except redis.exceptions.ResponseError as e:
             # Expecting an error.
@@ -297,3 +297,65 @@ class testConfig(FlowTestsBase):
         expected_response = ["NODE_CREATION_BUFFER", 1024]
         self.env.assertEqual(creation_buffer_size, expected_response)
 
+
+    def test12_set_thread_count_at_runtime(self):
+        # flush and stop is needed for memcheck for clean shutdown
+        self.env.flush()
+        self.env.stop()
+
+        self.env = Env(decodeResponses=True, moduleArgs='THREAD_COUNT 1 MEMORY_POLICY 1')
+        global redis_con
+        redis_con = self.env.getConnection()
+        graph = Graph(redis_con, "config")
+
+        response = redis_con.execute_command("GRAPH.CONFIG GET MEMORY_POLICY")
+        self.env.assertEqual(response, ["MEMORY_POLICY", 1])
+
+        # resize readers pool, up to the number of cores
+        thread_count = os.cpu_count()
+        response = redis_con.execute_command("GRAPH.CONFIG SET THREAD_COUNT %d" % thread_count)
+        self.env.assertEqual(response, "OK")
+
+        response = redis_con.execute_command("GRAPH.CONFIG GET THREAD_COUNT")
+        self.env.assertEqual(response, ["THREAD_COUNT", thread_count])
+
+        result = graph.query("RETURN 1")
+        self.env.assertEqual(result.result_set, [[1]])
+
+        # shrink readers pool
+        response = redis_con.execute_command("GRAPH.CONFIG SET THREAD_COUNT 1")
+        self.env.assertEqual(response, "OK")
+
+        result = graph.query("RETURN 1")
+        self.env.assertEqual(result.result_set, [[1]])
+
+        # readers pool can't grow beyond the number of cores
+        try:
+            redis_con.execute_command("GRAPH.CONFIG SET THREAD_COUNT 100000")
+            assert(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("THREAD_COUNT can't exceed", str(e))
+
+        # thread placement is set at load-time
+        try:
+            redis_con.execute_command("GRAPH.CONFIG SET THREAD_NUMA_NODE 0")
+            assert(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("This configuration parameter cannot be set at run-time", str(e))
+
+    def test13_load_with_thread_count(self):
+        # flush and stop is needed for memcheck for clean shutdown
+        self.env.flush()
+        self.env.stop()
+
+        # THREAD_COUNT is applied while loading, before the pools exist
+        self.env = Env(decodeResponses=True, moduleArgs='THREAD_COUNT 2')
+        global redis_con
+        redis_con = self.env.getConnection()
+        graph = Graph(redis_con, "config")
+
+        response = redis_con.execute_command("GRAPH.CONFIG GET THREAD_COUNT")
+        self.env.assertEqual(response, ["THREAD_COUNT", 2])
+
+        result = graph.query("RETURN 1")
+        self.env.assertEqual(result.result_set, [[1]])
@@ -519,3 +519,38 @@ class testEdgeByIndexScanFlow(FlowTestsBase):
 
         result = redis_graph.query("MATCH (a:A)-[r:R]->(b:B) WHERE r.v > 0 RETURN count(r)")
         self.env.assertEquals(result.result_set[0][0], 500)
+
+    def test22_index_scan_mask(self):
+        # index hits are matched against resolved traversal sources
+        redis_graph = Graph(self.env.getConnection(), 'index_mask')
+
+        redis_graph.query("""UNWIND range(0, 19) AS i
+                             CREATE (a:A {id: i})
+                             WITH a, i
+                             UNWIND range(0, 4) AS j
+                             CREATE (a)-[:R {v: i * 5 + j, w: i * 5 + j}]->(:B {id: i * 5 + j})""")
+        # multiple edges connecting the same pair of nodes
+        redis_graph.query("MATCH (a:A {id: 0})-[:R]->(b) CREATE (a)-[:R {v: 1000 + b.id, w: 1000 + b.id}]->(b)")
+        redis_graph.query("CREATE INDEX FOR ()-[r:R]-() ON (r.v)")
+
+        queries = [
+            "MATCH (a:A)-[r:R]->(b) WHERE r.{0} > 50 RETURN a.id, r.{0}, b.id ORDER BY a.id, r.{0}",
+            "MATCH (a:A)-[r:R]->(b) WHERE r.{0} < 3 OR r.{0} >= 1002 RETURN a.id, r.{0}, b.id ORDER BY a.id, r.{0}",
+            "MATCH (b:B)<-[r:R]-(a) WHERE r.{0} < 10 RETURN a.id, r.{0}, b.id ORDER BY a.id, r.{0}",
+            "MATCH (a:A)-[r:R]->(b) WHERE r.{0} = $v RETURN a.id, r.{0}, b.id ORDER BY a.id, r.{0}",
+            # operation is reset for each input record
+            "UNWIND range(0, 3) AS x MATCH (a:A {{id: x}}) OPTIONAL MATCH (a)-[r:R]->(b) WHERE r.{0} >= 8 RETURN x, count(r) ORDER BY x",
+            # a modifying query queries the index per input record
+            "MATCH (a:A)-[r:R]->(b) WHERE r.{0} > 95 SET r.seen = true RETURN a.id, r.{0}, b.id ORDER BY a.id, r.{0}",
+        ]
+
+        for q in queries:
+            indexed = q.format('v')
+            plan = redis_graph.execution_plan(indexed, {'v': 42})
+            self.env.assertIn('Edge By Index Scan', plan)
+
+            # 'w' is not indexed
+            expected = redis_graph.query(q.format('w'), {'v': 42}).result_set
+            actual = redis_graph.query(indexed, {'v': 42}).result_set
+            self.env.assertEquals(actual, expected)
+            self.env.assertGreater(len(actual), 0)
@@ -0,0 +1,164 @@
+from common import *
+
+GRAPH_ID = "geo_index"
+redis_graph = None
+
+# a handful of european cities
+cities = [
+    ("London",    51.5074,  -0.1278),
+    ("Paris",     48.8566,   2.3522),
+    ("Brussels",  50.8503,   4.3517),
+    ("Amsterdam", 52.3676,   4.9041),
+    ("Berlin",    52.5200,  13.4050),
+    ("Madrid",    40.4168,  -3.7038),
+    ("Rome",      41.9028,  12.4964),
+    ("Dublin",    53.3498,  -6.2603),
+]
+
+class testGeoIndex():
+    def __init__(self):
+        global redis_graph
+        self.env = Env(decodeResponses=True)
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        for (name, lat, lon) in cities:
+            q = "CREATE (:City {name: '%s', loc: point({latitude: %f, longitude: %f})})" % (name, lat, lon)
+            redis_graph.query(q)
+
+        # city without a location
+        redis_graph.query("CREATE (:City {name: 'Atlantis'})")
+
+        redis_graph.query("CREATE INDEX ON :City(loc)")
+
+    def test01_radius_scan(self):
+        query = """MATCH (c:City)
+                   WHERE distance(c.loc, point({latitude: 51.5074, longitude: -0.1278})) < 400000
+                   RETURN c.name ORDER BY c.name"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Node By Geo Index Scan", plan)
+        self.env.assertNotIn("Filter", plan)
+
+        result = redis_graph.query(query)
+        expected = [["Amsterdam"], ["Brussels"], ["London"], ["Paris"]]
+        self.env.assertEquals(result.result_set, expected)
+
+        # radius bound on the left hand side
+        query = """MATCH (c:City)
+                   WHERE 400000 > distance(point({latitude: 51.5074, longitude: -0.1278}), c.loc)
+                   RETURN c.name ORDER BY c.name"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Node By Geo Index Scan", plan)
+
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set, expected)
+
+    def test02_nearest_neighbours(self):
+        query = """MATCH (c:City)
+                   RETURN c.name
+                   ORDER BY distance(c.loc, point({latitude: 50.8503, longitude: 4.3517}))
+                   LIMIT 3"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Node By Geo Index Scan", plan)
+        self.env.assertNotIn("Sort", plan)
+
+        result = redis_graph.query(query)
+        expected = [["Brussels"], ["Amsterdam"], ["Paris"]]
+        self.env.assertEquals(result.result_set, expected)
+
+    def test03_nearest_neighbours_projected_distance(self):
+        query = """MATCH (c:City)
+                   RETURN c.name, distance(c.loc, point({latitude: 41.9028, longitude: 12.4964})) AS d
+                   ORDER BY d
+                   SKIP 1
+                   LIMIT 2"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Node By Geo Index Scan", plan)
+        self.env.assertNotIn("Sort", plan)
+
+        result = redis_graph.query(query)
+        self.env.assertEquals(len(result.result_set), 2)
+        self.env.assertEquals(result.result_set[0][0], "Madrid")
+        self.env.assertLess(result.result_set[0][1], result.result_set[1][1])
+
+    def test04_nodes_without_location_ordered_last(self):
+        # request all nodes, including the one without a location
+        query = """MATCH (c:City)
+                   RETURN c.name
+                   ORDER BY distance(c.loc, point({latitude: 48.8566, longitude: 2.3522}))
+                   LIMIT 100"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Node By Geo Index Scan", plan)
+
+        result = redis_graph.query(query)
+        self.env.assertEquals(len(result.result_set), len(cities) + 1)
+        self.env.assertEquals(result.result_set[0][0], "Paris")
+        self.env.assertEquals(result.result_set[-1][0], "Atlantis")
+
+    def test05_index_updates(self):
+        # move Rome next to London
+        redis_graph.query("""MATCH (c:City {name: 'Rome'})
+                             SET c.loc = point({latitude: 51.5, longitude: -0.12})""")
+
+        query = """MATCH (c:City)
+                   WHERE distance(c.loc, point({latitude: 51.5074, longitude: -0.1278})) <= 1000
+                   RETURN c.name ORDER BY c.name"""
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set, [["London"], ["Rome"]])
+
+        # remove location
+        redis_graph.query("MATCH (c:City {name: 'Rome'}) SET c.loc = NULL")
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set, [["London"]])
+
+        # delete node
+        redis_graph.query("MATCH (c:City {name: 'London'}) DELETE c")
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set, [])
+
+    def test06_descending_order_not_reduced(self):
+        query = """MATCH (c:City)
+                   RETURN c.name
+                   ORDER BY distance(c.loc, point({latitude: 48.8566, longitude: 2.3522})) DESC
+                   LIMIT 2"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Sort", plan)
+
+    def test07_bounding_box(self):
+        query = """CALL db.idx.spatial.withinBBox('City', 'loc',
+                       point({latitude: 50.0, longitude: 3.0}),
+                       point({latitude: 53.0, longitude: 6.0}))
+                   YIELD node
+                   RETURN node.name ORDER BY node.name"""
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set, [["Amsterdam"], ["Brussels"]])
+
+        # box crossing the antimeridian contains none of the cities
+        query = """CALL db.idx.spatial.withinBBox('City', 'loc',
+                       point({latitude: -10.0, longitude: 170.0}),
+                       point({latitude: 10.0, longitude: -170.0}))
+                   YIELD node
+                   RETURN count(node)"""
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set, [[0]])
+
+    def test08_plan_cached_before_points_indexed(self):
+        g = Graph(self.env.getConnection(), "geo_index_empty")
+        g.query("CREATE INDEX ON :Port(loc)")
+
+        # plan and cache the query while no point is indexed
+        query = """MATCH (p:Port)
+                   WHERE distance(p.loc, point({latitude: 51.9, longitude: 4.5})) < 1000
+                   RETURN count(p)"""
+        plan = g.execution_plan(query)
+        self.env.assertIn("Node By Geo Index Scan", plan)
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [[0]])
+
+        # the cached plan observes points indexed later on
+        g.query("CREATE (:Port {loc: point({latitude: 51.9, longitude: 4.5})})")
+        result = g.query(query)
+        self.env.assertTrue(result.cached_execution)
+        self.env.assertEquals(result.result_set, [[1]])
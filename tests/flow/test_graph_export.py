@@ -0,0 +1,207 @@
+import os
+import glob
+import struct
+import shutil
+import tempfile
+from common import *
+
+GRAPH_ID = "export_test"
+
+BI_NULL = 0
+BI_BOOL = 1
+BI_DOUBLE = 2
+BI_STRING = 3
+BI_LONG = 4
+BI_ARRAY = 5
+BI_POINT = 6
+
+
+class Reader():
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        self.idx = 0
+
+    def done(self):
+        return self.idx == len(self.data)
+
+    def string(self):
+        end = self.data.index(b'\0', self.idx)
+        s = self.data[self.idx:end].decode()
+        self.idx = end + 1
+        return s
+
+    def unpack(self, fmt):
+        v = struct.unpack_from(fmt, self.data, self.idx)
+        self.idx += struct.calcsize(fmt)
+        return v[0] if len(v) == 1 else v
+
+    def value(self):
+        t = self.unpack('<B')
+        if t == BI_NULL:
+            return None
+        if t == BI_BOOL:
+            return self.unpack('<?')
+        if t == BI_DOUBLE:
+            return self.unpack('<d')
+        if t == BI_STRING:
+            return self.string()
+        if t == BI_LONG:
+            return self.unpack('<q')
+        if t == BI_ARRAY:
+            return [self.value() for _ in range(self.unpack('<q'))]
+        if t == BI_POINT:
+            return self.unpack('<dd')
+        raise Exception("unknown type %d" % t)
+
+
+# parse all exported files matching pattern
+# returns {name: {id: (endpoints, attributes)}}
+def read_export(dir, pattern, endpoints):
+    entities = {}
+    for path in glob.glob(os.path.join(dir, pattern)):
+        r = Reader(path)
+        name = r.string()
+        keys = [r.string() for _ in range(r.unpack('<I'))]
+        records = entities.setdefault(name, {})
+        while not r.done():
+            ids = [r.unpack('<Q') for _ in range(1 + endpoints)]
+            attrs = {}
+            for key in keys:
+                v = r.value()
+                if v is not None:
+                    attrs[key] = v
+            records[ids[0]] = (tuple(ids[1:]), attrs)
+    return entities
+
+
+class testGraphExportDisabled():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+
+    def test01_export_disabled(self):
+        Graph(self.redis_con, GRAPH_ID).query("CREATE ()")
+        try:
+            self.redis_con.execute_command("GRAPH.EXPORT", GRAPH_ID, "export")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("EXPORT_DIR", str(e))
+
+
+class testGraphExport():
+    def __init__(self):
+        self.dir = tempfile.mkdtemp()
+        self.env = Env(decodeResponses=True, moduleArgs='EXPORT_DIR ' + self.dir)
+        self.redis_con = self.env.getConnection()
+        self.redis_graph = Graph(self.redis_con, GRAPH_ID)
+
+    def __del__(self):
+        shutil.rmtree(self.dir, ignore_errors=True)
+
+    def export(self, name):
+        return self.redis_con.execute_command("GRAPH.EXPORT", GRAPH_ID, name)
+
+    def test01_invalid_usage(self):
+        # graph doesn't exists
+        try:
+            self.export("missing_graph")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Invalid graph operation on empty key", str(e))
+
+        self.redis_graph.query("CREATE ()")
+
+        # name must be a plain directory name
+        for name in ["", ".", "..", "../escape", "a/b", "/tmp"]:
+            try:
+                self.export(name)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("Invalid export name", str(e))
+
+        # existing exports are never overwritten
+        os.mkdir(os.path.join(self.dir, "existing"))
+        try:
+            self.export("existing")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Export already exists", str(e))
+        self.env.assertEquals(os.listdir(os.path.join(self.dir, "existing")), [])
+
+        # wrong arity
+        try:
+            self.redis_con.execute_command("GRAPH.EXPORT", GRAPH_ID)
+            self.env.assertTrue(False)
+        except ResponseError:
+            pass
+
+        self.redis_graph.delete()
+
+    def test02_export(self):
+        self.redis_graph.query("""CREATE
+            (a:Person {name: 'a', age: 30, scores: [1, 2.5, 'x'], loc: point({latitude: 32, longitude: 34})}),
+            (b:Person:Admin {name: 'b', active: true}),
+            (c {name: 'c'}),
+            (a)-[:KNOWS {since: 2000}]->(b),
+            (a)-[:KNOWS {since: 2010}]->(b),
+            (b)-[:KNOWS]->(c)""")
+
+        # deleted entities aren't exported
+        self.redis_graph.query("CREATE (:Person {name: 'd'})-[:KNOWS]->()")
+        self.redis_graph.query("MATCH (p:Person {name: 'd'})-[e]->(x) DELETE p, e, x")
+
+        res = self.export("export")
+        self.env.assertEquals(res, "3 nodes exported, 3 edges exported")
+
+        dir = os.path.join(self.dir, "export")
+        nodes = read_export(dir, "node_*.bin", 0)
+        people = {attrs['name']: attrs for _, attrs in nodes['Person'].values()}
+        self.env.assertEquals(sorted(people.keys()), ['a', 'b'])
+        self.env.assertEquals(people['a']['age'], 30)
+        self.env.assertEquals(people['a']['scores'], [1, 2.5, 'x'])
+        self.env.assertAlmostEqual(people['a']['loc'][0], 32, 1E-5)
+        self.env.assertAlmostEqual(people['a']['loc'][1], 34, 1E-5)
+        self.env.assertEquals(people['b']['active'], True)
+        self.env.assertNotIn('age', people['b'])
+
+        # multi-labeled node is exported under each of its labels
+        admins = [attrs['name'] for _, attrs in nodes['Admin'].values()]
+        self.env.assertEquals(admins, ['b'])
+
+        # unlabeled nodes
+        unlabeled = [attrs['name'] for _, attrs in nodes[''].values()]
+        self.env.assertEquals(unlabeled, ['c'])
+
+        # node IDs match the graph's
+        ids = self.redis_graph.query("MATCH (n) RETURN n.name, ID(n)").result_set
+        ids = {name: id for name, id in ids}
+        for label in nodes.values():
+            for id, (_, attrs) in label.items():
+                self.env.assertEquals(ids[attrs['name']], id)
+
+        # multi-edges are exported individually
+        edges = read_export(dir, "edge_*.bin", 2)['KNOWS']
+        self.env.assertEquals(len(edges), 3)
+        expected = self.redis_graph.query(
+            "MATCH (s)-[e]->(d) RETURN ID(e), ID(s), ID(d), e.since").result_set
+        for id, src, dest, since in expected:
+            endpoints, attrs = edges[id]
+            self.env.assertEquals(endpoints, (src, dest))
+            self.env.assertEquals(attrs.get('since'), since)
+
+    def test03_export_multiple_parts(self):
+        self.redis_graph.delete()
+        # enough nodes to span multiple parts
+        node_count = 300000
+        self.redis_graph.query("UNWIND range(1, $n) AS x CREATE (:N {v: x})",
+                               {'n': node_count})
+
+        res = self.export("parts")
+        self.env.assertEquals(res, "%d nodes exported, 0 edges exported" % node_count)
+
+        dir = os.path.join(self.dir, "parts")
+        self.env.assertGreater(len(glob.glob(os.path.join(dir, "node_*.bin"))), 1)
+        nodes = read_export(dir, "node_*.bin", 0)['N']
+        values = sorted(attrs['v'] for _, attrs in nodes.values())
+        self.env.assertEquals(values, list(range(1, node_count + 1)))
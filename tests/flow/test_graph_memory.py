@@ -0,0 +1,98 @@
+from common import *
+
+GRAPH_ID = "memory_test"
+
+def to_dict(reply):
+    return dict(zip(reply[::2], reply[1::2]))
+
+class testGraphMemory():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+        self.redis_graph = Graph(self.redis_con, GRAPH_ID)
+
+    def memory(self, *args):
+        reply = self.redis_con.execute_command("GRAPH.MEMORY", GRAPH_ID, *args)
+        report = to_dict(reply)
+        report['labels'] = {l['name']: l for l in map(to_dict, report['labels'])}
+        report['relationship_types'] = {r['name']: r for r in
+                map(to_dict, report['relationship_types'])}
+        return report
+
+    def test01_invalid_usage(self):
+        # graph doesn't exists
+        try:
+            self.redis_con.execute_command("GRAPH.MEMORY", "NONE_EXISTING_GRAPH")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Invalid graph operation on empty key", str(e))
+
+        self.redis_graph.query("CREATE ()")
+
+        for args in [["BLAH"], ["SAMPLES"], ["SAMPLES", 0], ["SAMPLES", "x"],
+                     ["EXACT", 1]]:
+            try:
+                self.redis_con.execute_command("GRAPH.MEMORY", GRAPH_ID, *args)
+                self.env.assertTrue(False)
+            except ResponseError:
+                pass
+
+    def test02_breakdown(self):
+        self.redis_graph.query("""UNWIND range(1, 500) AS x
+                                  CREATE (:Person {name: 'person_' + toString(x), tags: ['a', 'b']})""")
+        self.redis_graph.query("""MATCH (a:Person), (b:Person) WHERE b.name = 'person_1'
+                                  CREATE (a)-[:KNOWS {since: 2000}]->(b)""")
+        # multi-edge
+        self.redis_graph.query("""MATCH (a:Person {name: 'person_2'}), (b:Person {name: 'person_1'})
+                                  CREATE (a)-[:KNOWS]->(b)""")
+
+        exact = self.memory("EXACT")
+        self.env.assertEquals(exact['mode'], 'exact')
+        self.env.assertEquals(exact['samples'], 0)
+
+        components = ['adjacency_matrix', 'node_labels_matrix', 'label_matrices',
+                      'relation_matrices', 'node_block', 'edge_block',
+                      'node_attributes', 'edge_attributes', 'multi_edge',
+                      'indices', 'views', 'plan_cache', 'slowlog']
+        self.env.assertEquals(exact['total'], sum(exact[c] for c in components))
+
+        person = exact['labels']['Person']
+        self.env.assertEquals(person['entities'], 500)
+        self.env.assertGreater(person['matrix'], 0)
+        # every node carries a string and an array
+        self.env.assertGreater(person['attributes'], 500 * len('person_000'))
+        self.env.assertGreaterEqual(exact['node_attributes'], person['attributes'])
+
+        knows = exact['relationship_types']['KNOWS']
+        self.env.assertEquals(knows['entities'], 501)
+        self.env.assertGreater(knows['multi_edge'], 0)
+        self.env.assertEquals(exact['edge_attributes'], knows['attributes'])
+        self.env.assertEquals(exact['multi_edge'], knows['multi_edge'])
+
+        # sampled report measures structures exactly and extrapolates entities
+        sampled = self.memory("SAMPLES", 64)
+        self.env.assertEquals(sampled['mode'], 'sampled')
+        self.env.assertEquals(sampled['samples'], 64)
+        for c in ['adjacency_matrix', 'node_labels_matrix', 'label_matrices',
+                  'relation_matrices', 'node_block', 'edge_block']:
+            self.env.assertEquals(sampled[c], exact[c])
+
+        # uniform entities, extrapolation should be close
+        ratio = sampled['node_attributes'] / exact['node_attributes']
+        self.env.assertGreater(ratio, 0.9)
+        self.env.assertLess(ratio, 1.1)
+
+        # default mode is sampled
+        self.env.assertEquals(self.memory()['mode'], 'sampled')
+
+    def test03_indices(self):
+        before = self.memory("EXACT")['labels']['Person']['indices']
+        self.redis_graph.query("CREATE INDEX FOR (p:Person) ON (p.name)")
+        after = self.memory("EXACT")['labels']['Person']['indices']
+        self.env.assertGreater(after, before)
+
+    def test04_info(self):
+        report = self.memory("EXACT")
+        info = self.redis_con.info("graph_memory")
+        self.env.assertIn(GRAPH_ID, info)
+        self.env.assertEquals(info[GRAPH_ID]['total'], report['total'])
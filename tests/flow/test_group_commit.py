@@ -0,0 +1,134 @@
+from common import *
+from pathos.pools import ProcessPool as Pool
+from pathos.helpers import mp as pathos_multiprocess
+
+GRAPH_ID = "group_commit"
+CLIENT_COUNT = 16
+
+
+def run_query(query, barrier):
+    env = Env(decodeResponses=True)
+    conn = env.getConnection()
+    graph = Graph(conn, GRAPH_ID)
+
+    barrier.wait()
+
+    try:
+        return graph.query(query).nodes_created
+    except ResponseError as e:
+        return str(e)
+
+def run_concurrent(queries):
+    pool = Pool(nodes=CLIENT_COUNT)
+    manager = pathos_multiprocess.Manager()
+    barrier = manager.Barrier(len(queries))
+    return pool.map(run_query, queries, [barrier] * len(queries))
+
+
+class testGroupCommit(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True, env='oss', useSlaves=True)
+
+        # skip test if we're running under Valgrind
+        if self.env.envRunner.debugger is not None:
+            self.env.skip() # valgrind is not working correctly with multi processing
+
+        self.conn = self.env.getConnection()
+        self.replica_con = self.env.getSlaveConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.replica = Graph(self.replica_con, GRAPH_ID)
+
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "WRITE_GROUP_SIZE", 8)
+
+    def test01_config(self):
+        res = self.conn.execute_command("GRAPH.CONFIG", "GET", "WRITE_GROUP_SIZE")
+        self.env.assertEquals(res, ["WRITE_GROUP_SIZE", 8])
+
+        # a group holds at least one query
+        try:
+            self.conn.execute_command("GRAPH.CONFIG", "SET", "WRITE_GROUP_SIZE", 0)
+            self.env.assertTrue(False)
+        except ResponseError:
+            pass
+
+    def test02_concurrent_writes(self):
+        self.graph.query("CREATE (:N {v: -1})")
+
+        queries = ["CREATE (:N {v: %d})" % i for i in range(CLIENT_COUNT * 4)]
+        results = run_concurrent(queries)
+        self.env.assertEquals(results, [1] * len(queries))
+
+        res = self.graph.query("MATCH (n:N) RETURN count(n), sum(n.v)").result_set
+        expected = [[len(queries) + 1, sum(range(len(queries))) - 1]]
+        self.env.assertEquals(res, expected)
+
+        # writes were replicated
+        self.conn.execute_command("WAIT", "1", "0")
+        res = self.replica.query("MATCH (n:N) RETURN count(n), sum(n.v)").result_set
+        self.env.assertEquals(res, expected)
+
+    def test03_failed_query_isolation(self):
+        self.graph.query("CREATE INDEX FOR (m:M) ON (m.v)")
+
+        # every fourth query fails after creating a node
+        # its modifications are rolled back without affecting its group
+        queries = []
+        for i in range(CLIENT_COUNT * 2):
+            if i % 4 == 0:
+                queries.append("CREATE (m:M {v: %d}) WITH m RETURN 1 / 0" % i)
+            else:
+                queries.append("CREATE (:M {v: %d})" % i)
+
+        results = run_concurrent(queries)
+        for i, res in enumerate(results):
+            if i % 4 == 0:
+                self.env.assertIn("Division by zero", res)
+            else:
+                self.env.assertEquals(res, 1)
+
+        expected = [[i] for i in range(len(queries)) if i % 4 != 0]
+        res = self.graph.query("MATCH (m:M) RETURN m.v ORDER BY m.v").result_set
+        self.env.assertEquals(res, expected)
+
+        # index reflects rolled back queries
+        res = self.graph.query("MATCH (m:M) WHERE m.v = 0 RETURN m").result_set
+        self.env.assertEquals(res, [])
+
+        self.conn.execute_command("WAIT", "1", "0")
+        res = self.replica.query("MATCH (m:M) RETURN m.v ORDER BY m.v").result_set
+        self.env.assertEquals(res, expected)
+
+    def test04_mixed_writes(self):
+        self.graph.query("CREATE (:C {v: 0})")
+
+        # queries reading the graph interleave with plain creations
+        # each reads the modifications committed before it
+        queries = []
+        for i in range(CLIENT_COUNT * 2):
+            if i % 2 == 0:
+                queries.append("MATCH (c:C) SET c.v = c.v + 1")
+            else:
+                queries.append("CREATE (:E {v: %d})" % i)
+
+        results = run_concurrent(queries)
+        expected = [0 if i % 2 == 0 else 1 for i in range(len(queries))]
+        self.env.assertEquals(results, expected)
+
+        expected = [[CLIENT_COUNT, CLIENT_COUNT]]
+        q = "MATCH (c:C), (e:E) RETURN c.v, count(e)"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, expected)
+
+        self.conn.execute_command("WAIT", "1", "0")
+        res = self.replica.query(q).result_set
+        self.env.assertEquals(res, expected)
+
+    def test05_disable(self):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "WRITE_GROUP_SIZE", 1)
+
+        queries = ["CREATE (:D {v: %d})" % i for i in range(CLIENT_COUNT)]
+        results = run_concurrent(queries)
+        self.env.assertEquals(results, [1] * len(queries))
+
+        res = self.graph.query("MATCH (d:D) RETURN count(d)").result_set
+        self.env.assertEquals(res, [[len(queries)]])
@@ -714,3 +714,31 @@ class testIndexScanFlow():
 
         # expecting an no index scan operation
         self.env.assertNotIn('Node By Index Scan', plan)
+
+    def test_24_batched_index_probes(self):
+        g = Graph(self.env.getConnection(), 'batched_index_probes')
+        g.query("CREATE INDEX FOR (u:U) ON (u.id)")
+        g.query("UNWIND range(0, 499) AS x CREATE (:U {id: x})")
+        g.query("CREATE (:U {id: 2.0}), (:U {id: 'a'}), (:U {id: 'b'}), (:U {id: [1]})")
+
+        # index is probed for a batch of input records at once
+        # probed values include duplicates, misses and none indexable values
+        ids = list(range(600))[::-1] + [2, 2, 'a', 'c', None, [1]]
+        q = "UNWIND $ids AS x MATCH (u:U {id: x}) RETURN x, u.id"
+        plan = g.execution_plan(q, {'ids': ids})
+        self.env.assertIn('Node By Index Scan', plan)
+
+        expected = []
+        for x in ids:
+            if isinstance(x, int) and x < 500:
+                expected.append([x, x])
+                if x == 2:
+                    expected.append([x, 2.0])
+            elif x == 'a' or x == [1]:
+                expected.append([x, x])
+
+        res = g.query(q, {'ids': ids}).result_set
+
+        # records are emitted in input order
+        self.env.assertEquals([row[0] for row in res], [row[0] for row in expected])
+        self.env.assertEquals(sorted(map(str, res)), sorted(map(str, expected)))
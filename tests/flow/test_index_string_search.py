@@ -0,0 +1,135 @@
+from common import *
+
+GRAPH_ID = "string_search"
+TRIGRAMS_GRAPH_ID = "trigrams_string_search"
+
+NAMES = ["alpha", "alphabet", "alpine", "Alpha", "beta", "betamax", "gamma",
+         "al", "a", "xalpha", "zalphabeta", "al pha", "ümlaut", "ümlauts"]
+
+
+def populate(graph):
+    graph.query("CREATE INDEX FOR (p:Person) ON (p.name)")
+    graph.query("CREATE INDEX FOR ()-[r:KNOWS]-() ON (r.name)")
+    graph.query("UNWIND $names AS name CREATE (:Person {name: name})-[:KNOWS {name: name}]->()",
+                {'names': NAMES})
+
+
+class testIndexPrefixSearch():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.graph = Graph(self.env.getConnection(), GRAPH_ID)
+        populate(self.graph)
+
+    def expected(self, predicate):
+        return [[name] for name in sorted(NAMES) if predicate(name)]
+
+    def test01_prefix_index_scan(self):
+        for prefix in ["a", "al", "alp", "alpha", "Al", "bet", "ü", "zz", "al p"]:
+            q = "MATCH (p:Person) WHERE p.name STARTS WITH $prefix RETURN p.name ORDER BY p.name"
+            plan = self.graph.execution_plan(q, {'prefix': prefix})
+            self.env.assertIn("Node By Index Scan", plan)
+            # prefix is resolved by the index
+            self.env.assertNotIn("Filter", plan)
+
+            res = self.graph.query(q, {'prefix': prefix}).result_set
+            self.env.assertEquals(res, self.expected(lambda n: n.startswith(prefix)))
+
+    def test02_prefix_edge_index_scan(self):
+        q = "MATCH ()-[r:KNOWS]->() WHERE r.name STARTS WITH 'alp' RETURN r.name ORDER BY r.name"
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Edge By Index Scan", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, self.expected(lambda n: n.startswith("alp")))
+
+    def test03_prefix_combined_with_predicates(self):
+        q = """MATCH (p:Person)
+               WHERE p.name STARTS WITH 'alp' AND p.name < 'alphz' OR p.name = 'beta'
+               RETURN p.name ORDER BY p.name"""
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Node By Index Scan", plan)
+
+        res = self.graph.query(q).result_set
+        expected = self.expected(lambda n: (n.startswith("alp") and n < "alphz") or n == "beta")
+        self.env.assertEquals(res, expected)
+
+    def test04_prefix_index_not_utilized(self):
+        # empty prefix
+        q = "MATCH (p:Person) WHERE p.name STARTS WITH '' RETURN count(p)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Node By Index Scan", plan)
+
+        # prefix is not a known string
+        q = "MATCH (p:Person), (q:Person) WHERE p.name STARTS WITH q.name RETURN count(p)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Node By Index Scan", plan)
+
+        # attribute is the searched string
+        q = "MATCH (p:Person) WHERE 'alphabet' STARTS WITH p.name RETURN count(p)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Node By Index Scan", plan)
+
+        # substring search requires trigrams
+        q = "MATCH (p:Person) WHERE p.name CONTAINS 'pha' RETURN count(p)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Node By Index Scan", plan)
+
+
+class testIndexSubstringSearch():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs='INDEX_TRIGRAMS yes')
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, TRIGRAMS_GRAPH_ID)
+        populate(self.graph)
+
+    def expected(self, predicate):
+        return [[name] for name in sorted(NAMES) if predicate(name)]
+
+    def test01_config(self):
+        res = self.conn.execute_command("GRAPH.CONFIG", "GET", "INDEX_TRIGRAMS")
+        self.env.assertEquals(res, ["INDEX_TRIGRAMS", 1])
+
+    def test02_contains_index_scan(self):
+        for s in ["alp", "pha", "phab", "lph", "Alp", "mlau", "l p", "zzz"]:
+            q = "MATCH (p:Person) WHERE p.name CONTAINS $s RETURN p.name ORDER BY p.name"
+            plan = self.graph.execution_plan(q, {'s': s})
+            self.env.assertIn("Node By Index Scan", plan)
+
+            res = self.graph.query(q, {'s': s}).result_set
+            self.env.assertEquals(res, self.expected(lambda n: s in n))
+
+    def test03_ends_with_index_scan(self):
+        for s in ["pha", "beta", "uts", "max"]:
+            q = "MATCH (p:Person) WHERE p.name ENDS WITH $s RETURN p.name ORDER BY p.name"
+            plan = self.graph.execution_plan(q, {'s': s})
+            self.env.assertIn("Node By Index Scan", plan)
+
+            res = self.graph.query(q, {'s': s}).result_set
+            self.env.assertEquals(res, self.expected(lambda n: n.endswith(s)))
+
+        q = "MATCH ()-[r:KNOWS]->() WHERE r.name ENDS WITH 'bet' RETURN r.name ORDER BY r.name"
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Edge By Index Scan", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, self.expected(lambda n: n.endswith("bet")))
+
+    def test04_short_search_not_utilized(self):
+        # searched string is shorter than a trigram
+        q = "MATCH (p:Person) WHERE p.name CONTAINS 'al' RETURN p.name ORDER BY p.name"
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Node By Index Scan", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, self.expected(lambda n: "al" in n))
+
+    def test05_index_updates(self):
+        self.graph.query("MATCH (p:Person {name: 'gamma'}) SET p.name = 'gammaray'")
+        self.graph.query("MATCH (p:Person {name: 'beta'}) DETACH DELETE p")
+
+        q = "MATCH (p:Person) WHERE p.name CONTAINS 'mmar' OR p.name ENDS WITH 'eta' RETURN p.name ORDER BY p.name"
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Node By Index Scan", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [["gammaray"], ["zalphabeta"]])
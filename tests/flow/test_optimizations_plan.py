@@ -475,4 +475,116 @@ class testOptimizationsPlan(FlowTestsBase):
         self.env.assertEquals(res.result_set, [[1]])
 
         plan = graph.execution_plan(query)
-        self.env.assertIn("Node By Label Scan | (n:N)", plan)
\ No newline at end of file
+        self.env.assertIn("Node By Label Scan | (n:N)", plan)
+
+    # per node neighbors count should be computed by reducing relation matrix
+    # rows rather than by expanding and aggregating each traversed edge
+    def test30_reduce_degree(self):
+        self.env.flush()
+
+        graph.query("""CREATE (a:D {v:1}), (b:D {v:2}), (c:D {v:3}),
+                       (a)-[:R]->(b), (a)-[:R]->(b), (a)-[:R]->(c),
+                       (b)-[:R]->(c), (c)-[:S]->(a)""")
+
+        # distinct neighbors, multi-edge counted once
+        query = """MATCH (x:D)-[:R]->(y) WITH x, count(y) AS c
+                   RETURN x.v, c ORDER BY x.v"""
+        plan = graph.execution_plan(query)
+        self.env.assertIn("Degree", plan)
+        self.env.assertNotIn("Aggregate", plan)
+        res = graph.query(query)
+        self.env.assertEquals(res.result_set, [[1, 2], [2, 1]])
+
+        # edges, each multi-edge counted
+        query = """MATCH (x:D)-[e:R]->(y) WITH x, count(e) AS c
+                   RETURN x.v, c ORDER BY x.v"""
+        plan = graph.execution_plan(query)
+        self.env.assertIn("Degree", plan)
+        res = graph.query(query)
+        self.env.assertEquals(res.result_set, [[1, 3], [2, 1]])
+
+        # incoming edges and distinct neighbors
+        query = """MATCH (x:D)<-[e:R]-(y)
+                   WITH x, count(e) AS edges, count(DISTINCT y) AS neighbors
+                   RETURN x.v, edges, neighbors ORDER BY x.v"""
+        plan = graph.execution_plan(query)
+        self.env.assertIn("Degree", plan)
+        res = graph.query(query)
+        self.env.assertEquals(res.result_set, [[2, 2, 1], [3, 2, 2]])
+
+        # any relationship type
+        query = """MATCH (x:D)-[e]->(y) WITH x, count(e) AS c
+                   RETURN x.v, c ORDER BY x.v"""
+        plan = graph.execution_plan(query)
+        self.env.assertIn("Degree", plan)
+        res = graph.query(query)
+        self.env.assertEquals(res.result_set, [[1, 3], [2, 1], [3, 1]])
+
+        # aggregating over destination attributes can't be reduced
+        query = """MATCH (x:D)-[:R]->(y) WITH x, sum(y.v) AS s
+                   RETURN x.v, s ORDER BY x.v"""
+        plan = graph.execution_plan(query)
+        self.env.assertNotIn("Degree", plan)
+        self.env.assertIn("Aggregate", plan)
+        res = graph.query(query)
+        self.env.assertEquals(res.result_set, [[1, 5], [2, 3]])
+
+    # per node count over a two hop chain should be computed without
+    # materializing a record for each traversed path
+    def test31_reduce_degree_chain(self):
+        self.env.flush()
+
+        graph.query("""CREATE (a:D {v:1}), (b:D {v:2}), (c:D {v:3}), (d:D {v:4}),
+                       (a)-[:R]->(b), (a)-[:R]->(b), (a)-[:R]->(c),
+                       (b)-[:R]->(c), (b)-[:R]->(d), (c)-[:S]->(d),
+                       (c)-[:S]->(d)""")
+
+        queries = ["""MATCH (x:D)-[e:R]->(y)-[f:R]->(z) WITH x, count(f) AS c
+                      RETURN x.v, c ORDER BY x.v""",
+                   """MATCH (x:D)-[e:R]->(y)-[:R]->(z) WITH x, count(z) AS c
+                      RETURN x.v, c ORDER BY x.v""",
+                   """MATCH (x:D)-[e:R]->(y)-[f]->(z) WITH x, count(f) AS c
+                      RETURN x.v, c ORDER BY x.v"""]
+
+        # b reaches c and d, c has no outgoing R edges
+        expected = [[[1, 4]],
+                    [[1, 4]],
+                    [[1, 6], [2, 2]]]
+
+        for q, e in zip(queries, expected):
+            plan = graph.execution_plan(q)
+            self.env.assertIn("Degree", plan)
+            self.env.assertNotIn("Conditional Traverse", plan)
+            res = graph.query(q)
+            self.env.assertEquals(res.result_set, e)
+
+        # distinct count over a chain can't be factorized
+        query = """MATCH (x:D)-[e:R]->(y)-[f:R]->(z)
+                   WITH x, count(DISTINCT z) AS c
+                   RETURN x.v, c ORDER BY x.v"""
+        plan = graph.execution_plan(query)
+        self.env.assertNotIn("Degree", plan)
+        res = graph.query(query)
+        self.env.assertEquals(res.result_set, [[1, 2]])
+
+    # factorized evaluation is limited to per source counts over one or two
+    # hops, other aggregations and longer chains expand to a record per path
+    def test32_reduce_degree_chain_scope(self):
+        # three hop chain
+        query = """MATCH (x:D)-[e:R]->(y)-[f:R]->(z)-[g:S]->(w)
+                   WITH x, count(g) AS c
+                   RETURN x.v, c ORDER BY x.v"""
+        plan = graph.execution_plan(query)
+        self.env.assertNotIn("Degree", plan)
+        res = graph.query(query)
+        self.env.assertEquals(res.result_set, [[1, 4]])
+
+        # aggregations other than count
+        query = """MATCH (x:D)-[e:R]->(y)-[f:R]->(z)
+                   RETURN x.v, collect(z.v) ORDER BY x.v"""
+        plan = graph.execution_plan(query)
+        self.env.assertNotIn("Degree", plan)
+        res = graph.query(query)
+        self.env.assertEquals(len(res.result_set), 1)
+        self.env.assertEquals(res.result_set[0][0], 1)
+        self.env.assertEquals(sorted(res.result_set[0][1]), [3, 3, 4, 4])
@@ -104,3 +104,99 @@ class testPagerankFlow(FlowTestsBase):
             self.env.assertAlmostEqual(resultset[0][1], 0.777813196182251, 0.0001)
             self.env.assertEqual(resultset[1][0], 1)
             self.env.assertAlmostEqual(resultset[1][1], 0.22218681871891, 0.0001)
+
+    def test_pagerank_config_validation(self):
+        self.env.cmd('flushall')
+        redis_graph.query("CREATE (a:L {v:1})-[:R]->(b:L {v:2})")
+
+        configs = ["{tolerance: 0}",
+                   "{tolerance: 'a'}",
+                   "{maxIterations: 0}",
+                   "{maxIterations: 1.5}",
+                   "{sourceNodes: [1]}",
+                   "{warmStart: 1}",
+                   "{unknown: 1}",
+                   "'config'"]
+        for config in configs:
+            q = "CALL algo.pageRank('L', 'R', %s) YIELD node, score RETURN node.v, score" % config
+            try:
+                redis_graph.query(q)
+                self.env.assertTrue(False)
+            except ResponseError:
+                pass
+
+    def test_pagerank_config(self):
+        self.env.cmd('flushall')
+        redis_graph.query("CREATE (a:L {v:1})-[:R]->(b:L {v:2})")
+
+        # explicit defaults produce the same ranking
+        q = """CALL algo.pageRank('L', 'R', {tolerance: 0.0001, maxIterations: 100})
+               YIELD node, score RETURN node.v, score"""
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(len(resultset), 2)
+        self.env.assertEqual(resultset[0][0], 2)
+        self.env.assertAlmostEqual(resultset[0][1], 0.777813196182251, 0.0001)
+        self.env.assertEqual(resultset[1][0], 1)
+        self.env.assertAlmostEqual(resultset[1][1], 0.22218681871891, 0.0001)
+
+    def test_pagerank_personalized(self):
+        self.env.cmd('flushall')
+        # a -> b -> c, c -> a
+        redis_graph.query("""CREATE (a:L {v:0})-[:R]->(b:L {v:1})-[:R]->(c:L {v:2}),
+                             (c)-[:R]->(a), (:X {v:3})-[:R]->(a)""")
+
+        # uniform ranking of a cycle is uniform
+        q = "CALL algo.pageRank('L', 'R') YIELD node, score RETURN node.v, score"
+        uniform = redis_graph.query(q).result_set
+        for row in uniform:
+            self.env.assertAlmostEqual(row[1], 1/3, 0.0001)
+
+        # seeding 'b' ranks 'b' highest, followed by its successor
+        q = """MATCH (s:L {v:1})
+               CALL algo.pageRank('L', 'R', {sourceNodes: [s]}) YIELD node, score
+               RETURN node.v, score"""
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(len(resultset), 3)
+        self.env.assertEqual([row[0] for row in resultset], [1, 2, 0])
+
+        # seeds outside of the ranked set are ignored
+        q = """MATCH (s:X)
+               CALL algo.pageRank('L', 'R', {sourceNodes: [s]}) YIELD node, score
+               RETURN node.v, score"""
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(len(resultset), 3)
+        for row in resultset:
+            self.env.assertAlmostEqual(row[1], 1/3, 0.0001)
+
+    def test_pagerank_warm_start(self):
+        self.env.cmd('flushall')
+        redis_graph.query("""CREATE (a:L {v:0})-[:R]->(b:L {v:1})-[:R]->(c:L {v:2}),
+                             (a)-[:R]->(c)""")
+
+        q = """CALL algo.pageRank('L', 'R', {tolerance: 0.000001}) YIELD node, score
+               RETURN node.v, score"""
+        cold = redis_graph.query(q).result_set
+
+        # first warm run has nothing to start from, the second reuses the
+        # stored ranking, both converge to the same ranking
+        q = """CALL algo.pageRank('L', 'R', {tolerance: 0.000001, warmStart: true})
+               YIELD node, score RETURN node.v, score"""
+        for _ in range(2):
+            warm = redis_graph.query(q).result_set
+            self.env.assertEqual(len(warm), len(cold))
+            for w, c in zip(warm, cold):
+                self.env.assertEqual(w[0], c[0])
+                self.env.assertAlmostEqual(w[1], c[1], 0.0001)
+
+        # graph changes, warm start from the now stale ranking
+        redis_graph.query("MATCH (c:L {v:2}), (a:L {v:0}) CREATE (c)-[:R]->(a), (:L {v:3})-[:R]->(a)")
+        q = """CALL algo.pageRank('L', 'R', {tolerance: 0.000001})
+               YIELD node, score RETURN node.v, score"""
+        cold = redis_graph.query(q).result_set
+        q = """CALL algo.pageRank('L', 'R', {tolerance: 0.000001, warmStart: true})
+               YIELD node, score RETURN node.v, score"""
+        warm = redis_graph.query(q).result_set
+        self.env.assertEqual(len(warm), 4)
+        for w, c in zip(warm, cold):
+            self.env.assertEqual(w[0], c[0])
+            self.env.assertAlmostEqual(w[1], c[1], 0.0001)
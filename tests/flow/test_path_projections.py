@@ -104,4 +104,34 @@ class testPathProjections():
         actual_result = redis_graph.query(query)
         traversal = [nodes[2], nodes[3]]
         expected_result = [[nodes[1], traversal]]
-        self.env.assertEqual(actual_result.result_set, expected_result)
\ No newline at end of file
+        self.env.assertEqual(actual_result.result_set, expected_result)
+
+    def test07_path_entities_hydration(self):
+        # paths hold entity IDs, attributes are retrieved on access
+        query = """MATCH p=(a {v: 0})-[*]->(b)
+                   RETURN DISTINCT length(p), nodes(p)[-1].v AS v,
+                   [r IN relationships(p) | r.connects]
+                   ORDER BY v"""
+        actual_result = redis_graph.query(query)
+        expected_result = [[1, 1, ["01"]],
+                           [2, 2, ["01", "12"]],
+                           [3, 3, ["01", "12", "23"]],
+                           [1, 4, ["04"]]]
+        self.env.assertEqual(actual_result.result_set, expected_result)
+
+        # paths built separately over the same nodes and edges
+        # are equal and deduplicated by entity IDs
+        query = """MATCH p=(a {v: 0})-[]->(b {v: 1})
+                   MATCH q=(c {v: 0})-[]->(d {v: 1})
+                   UNWIND [p, q] AS x
+                   RETURN p = q, count(DISTINCT x)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEqual(actual_result.result_set, [[True, 1]])
+
+        # paths sharing a prefix are distinct
+        query = """MATCH p=(a {v: 0})-[]->(b {v: 1})
+                   MATCH q=(a)-[*]->(c {v: 2})
+                   UNWIND [p, q] AS x
+                   RETURN p = q, count(DISTINCT x)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEqual(actual_result.result_set, [[False, 2]])
@@ -361,15 +361,24 @@ class testProcedures(FlowTestsBase):
         actual_resultset = redis_graph.query("CALL dbms.procedures() YIELD mode, name RETURN mode, name ORDER BY name").result_set
 
         expected_result = [["READ", "algo.BFS"],
+                           ["READ", "algo.MSBFS"],
                            ['READ', 'algo.SPpaths'],
                            ['READ', 'algo.SSpaths'],
                            ["READ", "algo.pageRank"],
+                           ["WRITE", "db.algebraicView.create"],
+                           ["WRITE", "db.algebraicView.drop"],
+                           ["READ", "db.algebraicViews"],
                            ["WRITE", "db.idx.fulltext.createNodeIndex"],
                            ["WRITE", "db.idx.fulltext.drop"],
                            ["READ", "db.idx.fulltext.queryNodes"],
+                           ["READ", "db.idx.spatial.withinBBox"],
                            ["READ", "db.indexes"],
                            ["READ", "db.labels"],
                            ["READ", "db.propertyKeys"],
                            ["READ", "db.relationshipTypes"],
+                           ["WRITE", "db.relationshipTypes.setStorage"],
+                           ["WRITE", "db.relationshipTypes.setTransposePolicy"],
+                           ["READ", "db.relationshipTypes.storage"],
+                           ["READ", "db.relationshipTypes.transposePolicies"],
                            ["READ", "dbms.procedures"]]
         self.env.assertEquals(actual_resultset, expected_result)
@@ -39,3 +39,15 @@ class testProfile(FlowTestsBase):
         self.env.assertIn("Update | Records produced: 0", profile)
         self.env.assertIn("Conditional Variable Length Traverse | (a:L)-[@anon_1*1..INF]->(@anon_0) | Records produced: 0", profile)
         self.env.assertIn("Node By Label Scan | (a:L) | Records produced: 0", profile)
+
+    def test03_profile_graphblas_threads(self):
+        # algebraic operations report the number of threads they were allowed to use
+        q = """MATCH (a:Person)-[:R]->(b) RETURN count(b)"""
+        profile = redis_con.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        traverse = [x for x in profile if x.strip().startswith("Conditional Traverse")]
+        self.env.assertEquals(len(traverse), 1)
+        self.env.assertIn("GraphBLAS threads: 1", traverse[0])
+
+        # non algebraic operations don't report threads
+        scan = [x for x in profile if x.strip().startswith("Node By Label Scan")]
+        self.env.assertNotIn("GraphBLAS threads", scan[0])
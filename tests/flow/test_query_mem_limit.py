@@ -136,3 +136,25 @@ class testQueryMemoryLimit():
             queries.append((q, should_fail))
 
         self.stress_server(queries)
+
+    def test_06_overflow_during_update(self):
+        # populate graph without a memory limit
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_CAPACITY", 0)
+        g = Graph(self.conn, GRAPH_NAME)
+        g.query("UNWIND range(0, 1000) AS x CREATE (:N {id: x})")
+
+        # set query memory limit to 1MB
+        limit = 1024*1024
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_CAPACITY", limit)
+
+        # each node is assigned a large list, exceeding the limit while updating
+        try:
+            g.query("MATCH (n:N) SET n.v = range(0, 1000)")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Query's mem consumption exceeded capacity", str(e))
+
+        # the failed update must be rolled back entirely
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_CAPACITY", 0)
+        res = g.query("MATCH (n:N) WHERE n.v IS NOT NULL RETURN count(n)")
+        self.env.assertEquals(res.result_set, [[0]])
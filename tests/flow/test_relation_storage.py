@@ -0,0 +1,113 @@
+from common import *
+
+GRAPH_ID = "relation_storage"
+redis_graph = None
+
+class testRelationStorage():
+    def __init__(self):
+        global redis_graph
+        self.env = Env(decodeResponses=True)
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # every node is connected to the following 10 nodes
+        redis_graph.query("""UNWIND range(0, 999) AS i CREATE (:N {v: i})""")
+        redis_graph.query("""MATCH (a:N), (b:N) WHERE b.v > a.v AND b.v <= a.v + 10
+                             CREATE (a)-[:R {v: a.v * 1000 + b.v}]->(b)""")
+        # multi-edge
+        redis_graph.query("""MATCH (a:N {v: 0}), (b:N {v: 1}) CREATE (a)-[:R {v: -1}]->(b)""")
+
+    def storage(self):
+        q = """CALL db.relationshipTypes.storage()
+               YIELD relationshipType, storage, memoryUsage
+               RETURN relationshipType, storage, memoryUsage"""
+        return redis_graph.query(q).result_set
+
+    def set_storage(self, storage):
+        redis_graph.query("CALL db.relationshipTypes.setStorage('R', '%s')" % storage)
+
+    def traversals(self):
+        queries = ["MATCH (a:N)-[:R]->(b) RETURN count(b), sum(b.v)",
+                   "MATCH (a:N {v: 500})-[e:R]->(b) RETURN b.v, e.v ORDER BY b.v, e.v",
+                   "MATCH (a:N {v: 500})<-[e:R]-(b) RETURN b.v, e.v ORDER BY b.v, e.v",
+                   "MATCH (a:N {v: 0})-[e:R]->(b:N {v: 1}) RETURN e.v ORDER BY e.v",
+                   "MATCH (a:N {v: 0})-[:R*3]->(b) RETURN count(DISTINCT b)",
+                   "MATCH (a:N {v: 990})-[:R]->()-[:R]->(b) RETURN b.v ORDER BY b.v",
+                   "MATCH (a:N {v: 10}) RETURN size((a)-[:R]->()), size((a)<-[:R]-())"]
+        return [redis_graph.query(q).result_set for q in queries]
+
+    def test01_default_storage(self):
+        res = self.storage()
+        self.env.assertEquals(res[0][0], "R")
+        self.env.assertEquals(res[0][1], "uncompressed")
+
+    def test02_compress(self):
+        expected = self.traversals()
+        uncompressed = self.storage()[0][2]
+
+        self.set_storage("compressed")
+
+        res = self.storage()
+        self.env.assertEquals(res[0][1], "compressed")
+        # compressed rows take a fraction of the uncompressed matrix
+        self.env.assertLess(res[0][2] * 2, uncompressed)
+
+        # traversals are unaffected
+        self.env.assertEquals(self.traversals(), expected)
+
+    def test03_modify_compressed(self):
+        # new edges
+        redis_graph.query("""MATCH (a:N {v: 500}), (b:N {v: 0}) CREATE (a)-[:R {v: 7}]->(b)""")
+        # additional edge between already connected nodes
+        redis_graph.query("""MATCH (a:N {v: 500}), (b:N {v: 501}) CREATE (a)-[:R {v: 8}]->(b)""")
+        # delete single edge and a member of a multi-edge
+        redis_graph.query("""MATCH (:N {v: 500})-[e:R]->(:N {v: 502}) DELETE e""")
+        redis_graph.query("""MATCH (:N {v: 0})-[e:R {v: -1}]->(:N {v: 1}) DELETE e""")
+
+        res = redis_graph.query("""MATCH (a:N {v: 500})-[e:R]->(b)
+                                   RETURN b.v, e.v ORDER BY b.v, e.v""").result_set
+        expected = [[0, 7], [501, 8], [501, 500501]] + \
+                   [[i, 500000 + i] for i in range(503, 511)]
+        self.env.assertEquals(res, expected)
+
+        res = redis_graph.query("""MATCH (a:N {v: 0})-[e:R]->(b:N {v: 1})
+                                   RETURN e.v""").result_set
+        self.env.assertEquals(res, [[1]])
+
+        res = redis_graph.query("""MATCH (a:N {v: 502})<-[e:R]-(b)
+                                   RETURN b.v ORDER BY b.v""").result_set
+        self.env.assertEquals(res, [[i] for i in range(492, 502) if i != 500])
+
+        # relation remains compressed
+        self.env.assertEquals(self.storage()[0][1], "compressed")
+
+    def test04_uncompress(self):
+        expected = self.traversals()
+        self.set_storage("uncompressed")
+        self.env.assertEquals(self.storage()[0][1], "uncompressed")
+        self.env.assertEquals(self.traversals(), expected)
+
+    def test05_algebraic_view(self):
+        redis_graph.query("CALL db.algebraicView.create('v', [NULL, 'R', NULL])")
+        try:
+            self.set_storage("compressed")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("algebraic view", str(e))
+        redis_graph.query("CALL db.algebraicView.drop('v')")
+
+        self.set_storage("compressed")
+        self.env.assertEquals(self.storage()[0][1], "compressed")
+
+    def test06_invalid_arguments(self):
+        queries = ["CALL db.relationshipTypes.setStorage('Z', 'compressed')",
+                   "CALL db.relationshipTypes.setStorage('R', 'zipped')",
+                   "CALL db.relationshipTypes.setStorage('R', 1)"]
+        for q in queries:
+            try:
+                redis_graph.query(q)
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError:
+                pass
@@ -135,3 +135,42 @@ class testShortestPath(FlowTestsBase):
         # The longer traversal will be found
         expected_result = [[1], [2], [3], [4]]
         self.env.assertEqual(actual_result.result_set, expected_result)
+
+    def test07_pending_modifications(self):
+        # edges created and deleted by recent queries are still held in
+        # the matrices' delta, searches should observe them
+        redis_graph.query("""MATCH (a {v: 1}), (b {v: 4}) CREATE (a)-[:E3]->(b)""")
+
+        query = """MATCH (a {v: 1}), (b {v: 4}) WITH shortestPath((a)-[*]->(b)) AS p UNWIND nodes(p) AS n RETURN n.v"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEqual(actual_result.result_set, [[1], [4]])
+
+        redis_graph.query("""MATCH (a {v: 1})-[e:E3]->(b {v: 4}) DELETE e""")
+
+        actual_result = redis_graph.query(query)
+        self.env.assertEqual(actual_result.result_set, [[1], [5], [4]])
+
+    def test08_long_chain(self):
+        # create a chain of 100 nodes, with a shortcut halfway
+        redis_graph.query("""UNWIND range(0, 99) AS x CREATE (:C {v: x})""")
+        redis_graph.query("""MATCH (a:C), (b:C) WHERE b.v = a.v + 1 CREATE (a)-[:NEXT]->(b)""")
+        redis_graph.query("""MATCH (a:C {v: 10}), (b:C {v: 60}) CREATE (a)-[:NEXT]->(b)""")
+
+        query = """MATCH (a:C {v: 0}), (b:C {v: 99}) WITH shortestPath((a)-[:NEXT*]->(b)) AS p RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEqual(actual_result.result_set, [[50]])
+
+        # path shorter than maximum hops
+        query = """MATCH (a:C {v: 0}), (b:C {v: 99}) WITH shortestPath((a)-[:NEXT*..50]->(b)) AS p RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEqual(actual_result.result_set, [[50]])
+
+        # path longer than maximum hops
+        query = """MATCH (a:C {v: 0}), (b:C {v: 99}) WITH shortestPath((a)-[:NEXT*..49]->(b)) AS p RETURN p"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEqual(actual_result.result_set, [[None]])
+
+        # edges are traversed in their direction only
+        query = """MATCH (a:C {v: 99}), (b:C {v: 0}) WITH shortestPath((a)-[:NEXT*]->(b)) AS p RETURN p"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEqual(actual_result.result_set, [[None]])
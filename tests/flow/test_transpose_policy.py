@@ -0,0 +1,82 @@
+from common import *
+
+GRAPH_ID = "transpose_policy"
+redis_graph = None
+
+class testTransposePolicy():
+    def __init__(self):
+        global redis_graph
+        self.env = Env(decodeResponses=True)
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # (0)->(1)->(2)->...->(9)
+        redis_graph.query("""UNWIND range(0, 9) AS i CREATE (:N {v: i})""")
+        redis_graph.query("""MATCH (a:N), (b:N) WHERE b.v = a.v + 1
+                             CREATE (a)-[:R]->(b)""")
+
+    def policies(self):
+        q = """CALL db.relationshipTypes.transposePolicies()
+               YIELD relationshipType, policy, maintained, memorySaved
+               RETURN relationshipType, policy, maintained, memorySaved"""
+        return redis_graph.query(q).result_set
+
+    def incoming(self, v):
+        q = """MATCH (a:N {v: %d})<-[:R]-(b) RETURN b.v ORDER BY b.v""" % v
+        return redis_graph.query(q).result_set
+
+    def test01_default_policy(self):
+        res = self.policies()
+        self.env.assertEquals(res, [["R", "always", True, 0]])
+
+    def test02_never(self):
+        redis_graph.query("CALL db.relationshipTypes.setTransposePolicy('R', 'never')")
+
+        res = self.policies()
+        self.env.assertEquals(res[0][1], "never")
+        self.env.assertFalse(res[0][2])
+        self.env.assertGreater(res[0][3], 0)
+
+        self.env.assertEquals(self.incoming(5), [[4]])
+
+        # modifications invalidate the transposed view
+        redis_graph.query("""MATCH (a:N {v: 0}), (b:N {v: 5}) CREATE (a)-[:R]->(b)""")
+        self.env.assertEquals(self.incoming(5), [[0], [4]])
+
+        redis_graph.query("""MATCH (:N {v: 4})-[e:R]->(:N {v: 5}) DELETE e""")
+        self.env.assertEquals(self.incoming(5), [[0]])
+
+        # transpose is never maintained
+        self.env.assertFalse(self.policies()[0][2])
+
+    def test03_lazy(self):
+        redis_graph.query("CALL db.relationshipTypes.setTransposePolicy('R', 'lazy')")
+        res = self.policies()
+        self.env.assertEquals(res[0][1], "lazy")
+        self.env.assertFalse(res[0][2])
+
+        # first incoming traversal builds the transpose
+        self.env.assertEquals(self.incoming(5), [[0]])
+        self.env.assertTrue(self.policies()[0][2])
+
+        # from now on the transpose is maintained
+        redis_graph.query("""MATCH (a:N {v: 9}), (b:N {v: 5}) CREATE (a)-[:R]->(b)""")
+        self.env.assertEquals(self.incoming(5), [[0], [9]])
+
+    def test04_always(self):
+        redis_graph.query("CALL db.relationshipTypes.setTransposePolicy('R', 'always')")
+        res = self.policies()
+        self.env.assertEquals(res, [["R", "always", True, 0]])
+        self.env.assertEquals(self.incoming(5), [[0], [9]])
+
+    def test05_invalid_arguments(self):
+        queries = ["CALL db.relationshipTypes.setTransposePolicy('Z', 'never')",
+                   "CALL db.relationshipTypes.setTransposePolicy('R', 'sometimes')"]
+        for q in queries:
+            try:
+                redis_graph.query(q)
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError:
+                pass
@@ -492,3 +492,63 @@ class testUndoLog():
         result = self.graph.query("MATCH (n:L4) RETURN labels(n)")
         self.env.assertEquals(len(result.result_set), 1)
         self.env.assertEquals(["L4"], result.result_set[0][0])
+
+    def test20_undo_grouped_updates(self):
+        self.graph.query("CREATE (:N {a: 1, b: 2}), (:N {a: 3, b: 4})")
+        try:
+            # replace attribute-set then update the same entities again
+            self.graph.query("""MATCH (n:N)
+                                SET n = {a: 10, c: 11}
+                                SET n.a = n.a + 1, n.b = 5
+                                WITH n
+                                RETURN 1 * n""")
+            # we're not supposed to be here, expecting query to fail
+            self.env.assertTrue(False)
+        except:
+            pass
+
+        # expecting the original attributes to be restored
+        result = self.graph.query("MATCH (n:N) RETURN n.a, n.b, n.c ORDER BY n.a")
+        self.env.assertEquals(result.result_set, [[1, 2, None], [3, 4, None]])
+
+    def test21_undo_bulk_create(self):
+        self.graph.query("CREATE (:N {v: 0})")
+        try:
+            self.graph.query("""UNWIND range(1, 100) AS x
+                                CREATE (n:N {v: x})-[:R]->(:M)
+                                WITH n
+                                RETURN 1 * n""")
+            # we're not supposed to be here, expecting query to fail
+            self.env.assertTrue(False)
+        except:
+            pass
+
+        # created entities should be removed
+        result = self.graph.query("MATCH (n) RETURN count(n)")
+        self.env.assertEquals(result.result_set[0][0], 1)
+        result = self.graph.query("MATCH ()-[r]->() RETURN count(r)")
+        self.env.assertEquals(result.result_set[0][0], 0)
+
+        # node IDs are allocated right after the remaining node
+        result = self.graph.query("CREATE (n:N), (m:N) RETURN id(n), id(m)")
+        self.env.assertEquals(result.result_set, [[1, 2]])
+
+    def test22_final_update(self):
+        # update which isn't followed by any other operation
+        self.graph.query("UNWIND range(1, 10) AS x CREATE (:N {v: x})")
+        result = self.graph.query("MATCH (n:N) SET n.v = n.v * 2")
+        self.env.assertEquals(result.properties_set, 10)
+
+        result = self.graph.query("MATCH (n:N) RETURN sum(n.v)")
+        self.env.assertEquals(result.result_set[0][0], 110)
+
+        # failure while evaluating updates leaves the graph untouched
+        try:
+            self.graph.query("MATCH (n:N) SET n.v = CASE n.v WHEN 20 THEN n.v * 'a' ELSE 0 END")
+            # we're not supposed to be here, expecting query to fail
+            self.env.assertTrue(False)
+        except:
+            pass
+
+        result = self.graph.query("MATCH (n:N) RETURN sum(n.v)")
+        self.env.assertEquals(result.result_set[0][0], 110)
@@ -675,6 +675,97 @@ TEST_F(AlgebraicExpressionTest, Exp_OP_MUL) {
 	AlgebraicExpression_Free(exp);
 }
 
+TEST_F(AlgebraicExpressionTest, Exp_OP_MUL_Chain_Order) {
+	// Exp = A * B * C
+	// A is dense while B * C is tiny, evaluated as A * (B * C)
+	RG_Matrix A;
+	RG_Matrix B;
+	RG_Matrix C;
+	RG_Matrix res;
+
+	GrB_Index n = 4;
+	RG_Matrix_new(&A, GrB_BOOL, n, n);
+	RG_Matrix_new(&B, GrB_BOOL, n, n);
+	RG_Matrix_new(&C, GrB_BOOL, n, n);
+
+	// A
+	// 1 1 1 1
+	// 1 1 1 1
+	// 1 1 1 1
+	// 1 1 1 1
+	for(GrB_Index i = 0; i < n; i++) {
+		for(GrB_Index j = 0; j < n; j++) {
+			RG_Matrix_setElement_BOOL(A, i, j);
+		}
+	}
+
+	// B
+	// 0 1 0 0
+	// 0 0 0 0
+	// 0 0 0 0
+	// 0 0 0 0
+	RG_Matrix_setElement_BOOL(B, 0, 1);
+
+	// C
+	// 0 0 0 0
+	// 0 0 1 0
+	// 0 0 0 0
+	// 0 0 0 0
+	RG_Matrix_setElement_BOOL(C, 1, 2);
+
+	RG_Matrix_wait(A, true); // force flush
+	RG_Matrix_wait(B, true); // force flush
+
+	rax *matrices = raxNew();
+	raxInsert(matrices, (unsigned char *)"A", strlen("A"), A, NULL);
+	raxInsert(matrices, (unsigned char *)"B", strlen("B"), B, NULL);
+	raxInsert(matrices, (unsigned char *)"C", strlen("C"), C, NULL);
+	AlgebraicExpression *exp = AlgebraicExpression_FromString("A*B*C", matrices);
+
+	RG_Matrix_new(&res, GrB_BOOL, n, n);
+	AlgebraicExpression_Eval(exp, res);
+
+	// every row reaches column 2
+	GrB_Matrix expected;
+	GrB_Matrix_new(&expected, GrB_BOOL, n, n);
+	for(GrB_Index i = 0; i < n; i++) {
+		GrB_Matrix_setElement_BOOL(expected, true, i, 2);
+	}
+	ASSERT_TRUE(_compare_matrices(expected, res));
+
+	// B * C is computed first
+	char *order = AlgebraicExpression_MulOrder(exp);
+	ASSERT_STREQ(order, "(A * (B * C))");
+	rm_free(order);
+	AlgebraicExpression_Free(exp);
+
+	// A, B and C hold a single entry each
+	// both orders cost the same, evaluated left to right
+	RG_Matrix_clear(A);
+	RG_Matrix_setElement_BOOL(A, 0, 0);
+	RG_Matrix_clear(B);
+	RG_Matrix_setElement_BOOL(B, 0, 0);
+	RG_Matrix_clear(C);
+	RG_Matrix_setElement_BOOL(C, 0, 0);
+
+	RG_Matrix_wait(A, true); // force flush
+	RG_Matrix_wait(B, true); // force flush
+	RG_Matrix_wait(C, true); // force flush
+
+	exp = AlgebraicExpression_FromString("A*B*C", matrices);
+	order = AlgebraicExpression_MulOrder(exp);
+	ASSERT_STREQ(order, "((A * B) * C)");
+	rm_free(order);
+
+	raxFree(matrices);
+	RG_Matrix_free(&A);
+	RG_Matrix_free(&B);
+	RG_Matrix_free(&C);
+	RG_Matrix_free(&res);
+	GrB_Matrix_free(&expected);
+	AlgebraicExpression_Free(exp);
+}
+
 TEST_F(AlgebraicExpressionTest, Exp_OP_ADD_Transpose) {
 	// Exp = A + Transpose(A)
 	RG_Matrix res;
@@ -82,8 +82,7 @@ class AllPathsTest : public ::testing::Test {
 			}
 			bool arrayContainsPath = true;
 			for(int j = 1; j <= expectedPathLen; j++) {
-				Node n = path->nodes[j - 1];
-				if(ENTITY_GET_ID(&n) != expectedPath[j]) {
+				if(Path_GetNodeID(path, j - 1) != expectedPath[j]) {
 					arrayContainsPath = false;
 					break;
 				}
@@ -202,8 +201,7 @@ TEST_F(AllPathsTest, UpToThreeLegsPaths) {
 
 			int j = 0;
 			for(; j < expectedPathLen; j++) {
-				Node n = path->nodes[j];
-				if(ENTITY_GET_ID(&n) != expectedPath[j]) break;
+				if(Path_GetNodeID(path, j) != expectedPath[j]) break;
 			}
 			if(j == expectedPathLen) {
 				expectedPathFound = true;
@@ -255,8 +253,7 @@ TEST_F(AllPathsTest, TwoLegPaths) {
 			NodeID *expectedPath = expectedPaths[i];
 			int j;
 			for(j = 0; j < 3; j++) {
-				Node n = path->nodes[j];
-				if(ENTITY_GET_ID(&n) != expectedPath[j]) break;
+				if(Path_GetNodeID(path, j) != expectedPath[j]) break;
 			}
 			expectedPathFound = (j == 3);
 			if(expectedPathFound) break;
@@ -194,6 +194,52 @@ TEST_F(DataBlockTest, RemoveItem) {
 	DataBlock_Free(dataBlock);
 }
 
+TEST_F(DataBlockTest, Truncate) {
+	DataBlock *dataBlock = DataBlock_New(DATABLOCK_BLOCK_CAP, 1024, sizeof(int), NULL);
+	uint itemCount = 32;
+
+	// Set items.
+	for(int i = 0 ; i < itemCount; i++) {
+		int *item = (int *)DataBlock_AllocateItem(dataBlock, NULL);
+		*item = i;
+	}
+
+	// Delete items on both sides of the truncation point.
+	DataBlock_DeleteItem(dataBlock, 4);
+	DataBlock_DeleteItem(dataBlock, 20);
+	ASSERT_EQ(dataBlock->itemCount, itemCount - 2);
+	ASSERT_EQ(array_len(dataBlock->deletedIdx), 2);
+
+	// Truncate items at position 16 and beyond.
+	DataBlock_Truncate(dataBlock, 16);
+	ASSERT_EQ(dataBlock->itemCount, 15);
+	ASSERT_EQ(array_len(dataBlock->deletedIdx), 1);
+	ASSERT_EQ(dataBlock->deletedIdx[0], 4);
+	ASSERT_TRUE(DataBlock_GetItem(dataBlock, 16) == NULL);
+	ASSERT_TRUE(DataBlock_GetItem(dataBlock, 31) == NULL);
+	ASSERT_EQ(*(int *)DataBlock_GetItem(dataBlock, 15), 15);
+
+	// Truncating beyond the last item is a no-op.
+	DataBlock_Truncate(dataBlock, 100);
+	ASSERT_EQ(dataBlock->itemCount, 15);
+
+	// Free index is reused first, then allocation resumes at the truncation point.
+	uint64_t idx;
+	DataBlock_AllocateItem(dataBlock, &idx);
+	ASSERT_EQ(idx, 4);
+	DataBlock_AllocateItem(dataBlock, &idx);
+	ASSERT_EQ(idx, 16);
+
+	DataBlockIterator *it = DataBlock_Scan(dataBlock);
+	uint counter = 0;
+	while(DataBlockIterator_Next(it, NULL)) counter++;
+	ASSERT_EQ(counter, 17);
+	DataBlockIterator_Free(it);
+
+	// Cleanup.
+	DataBlock_Free(dataBlock);
+}
+
 TEST_F(DataBlockTest, OutOfOrderBuilding) {
 	// This test checks for a fragmented, data block out of order re-construction.
 	DataBlock *dataBlock = DataBlock_New(DATABLOCK_BLOCK_CAP, 1, sizeof(int), NULL);
@@ -254,3 +254,31 @@ TEST_F(ExecutionPlanCloneTest, TestUnion) {
 	array_free(queries);
 }
 
+
+TEST_F(ExecutionPlanCloneTest, TestSharedQueryGraph) {
+	AST *ast = NULL;
+	ExecutionPlan *plan = NULL;
+	build_ast_and_plan("MATCH (a:N)-[:R]->(b) RETURN a, b", &ast, &plan);
+	ASSERT_TRUE(plan->query_graph != NULL);
+
+	ExecutionPlan *clone_a = ExecutionPlan_Clone(plan);
+	ExecutionPlan *clone_b = ExecutionPlan_Clone(plan);
+
+	// clones share the template's query graph
+	// connected components aren't carried over
+	ASSERT_EQ(clone_a->query_graph, plan->query_graph);
+	ASSERT_EQ(clone_b->query_graph, plan->query_graph);
+	ASSERT_EQ(plan->query_graph->ref_count, 3);
+	ASSERT_TRUE(clone_a->connected_components == NULL);
+
+	// clones outlive their template
+	ExecutionPlan_Free(plan);
+	ASSERT_EQ(clone_a->query_graph->ref_count, 2);
+	ASSERT_TRUE(QueryGraph_GetNodeByAlias(clone_a->query_graph, "a") != NULL);
+	ASSERT_EQ(QueryGraph_EdgeCount(clone_b->query_graph), 1);
+
+	ExecutionPlan_Free(clone_a);
+	ASSERT_EQ(clone_b->query_graph->ref_count, 1);
+	ExecutionPlan_Free(clone_b);
+	AST_Free(ast);
+}
@@ -86,3 +86,72 @@ TEST_F(PagerankTest, Pagerank) {
 
 	GrB_finalize();
 }
+
+TEST_F(PagerankTest, PagerankWarmStart) {
+	GrB_init(GrB_NONBLOCKING);
+
+	GrB_Matrix A;
+	GrB_Vector rank;
+	double tol = 1e-6 ;
+	int cold_iters, warm_iters, itermax = 100 ;
+	LAGraph_PageRank *cold;
+	LAGraph_PageRank *warm;
+
+	// cycle 0 -> 1 -> 2 -> 0 with a shortcut 0 -> 2
+	GrB_Matrix_new(&A, GrB_BOOL, 3, 3);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 1);
+	GrB_Matrix_setElement_BOOL(A, true, 1, 2);
+	GrB_Matrix_setElement_BOOL(A, true, 2, 0);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 2);
+
+	Pagerank_Personalized(&cold, &rank, A, NULL, NULL, itermax, tol,
+			&cold_iters);
+
+	// starting from the converged ranking takes fewer iterations
+	Pagerank_Personalized(&warm, NULL, A, rank, NULL, itermax, tol,
+			&warm_iters);
+	ASSERT_LT(warm_iters, cold_iters);
+
+	for(int i = 0; i < 3; i++) {
+		ASSERT_EQ(warm[i].page, cold[i].page);
+		ASSERT_NEAR(warm[i].pagerank, cold[i].pagerank, 0.0001);
+	}
+
+	rm_free(cold);
+	rm_free(warm);
+	GrB_free(&rank);
+	GrB_free(&A);
+	GrB_finalize();
+}
+
+TEST_F(PagerankTest, PagerankPersonalized) {
+	GrB_init(GrB_NONBLOCKING);
+
+	GrB_Matrix A;
+	GrB_Vector p;
+	double tol = 1e-4 ;
+	int iters, itermax = 100 ;
+	LAGraph_PageRank *ranking;
+
+	// cycle 0 -> 1 -> 2 -> 0, uniform ranking when not personalized
+	GrB_Matrix_new(&A, GrB_BOOL, 3, 3);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 1);
+	GrB_Matrix_setElement_BOOL(A, true, 1, 2);
+	GrB_Matrix_setElement_BOOL(A, true, 2, 0);
+
+	// teleport only to node 1
+	GrB_Vector_new(&p, GrB_FP32, 3);
+	GrB_Vector_setElement_FP32(p, 1, 1);
+
+	Pagerank_Personalized(&ranking, NULL, A, NULL, p, itermax, tol, &iters);
+
+	// seed ranks highest, followed by its successors
+	ASSERT_EQ(ranking[0].page, 1);
+	ASSERT_EQ(ranking[1].page, 2);
+	ASSERT_EQ(ranking[2].page, 0);
+
+	rm_free(ranking);
+	GrB_free(&p);
+	GrB_free(&A);
+	GrB_finalize();
+}
@@ -13,6 +13,7 @@ extern "C" {
 #include "../../src/util/rmalloc.h"
 #include "../../src/configuration/config.h"
 #include "../../src/graph/rg_matrix/rg_matrix.h"
+#include "../../src/graph/rg_matrix/rg_matrix_iter.h"
 #include <time.h>
 
 #ifdef __cplusplus
@@ -1539,6 +1540,191 @@ TEST_F(RGMatrixTest, RGMatrix_resize) {
 	ASSERT_EQ(T_ncols, nrows);
 }
 
+// test frozen matrix, compressed M is decoded by extract, iterator and mxm
+TEST_F(RGMatrixTest, RGMatrix_freeze) {
+	GrB_Type    t      =  GrB_UINT64;
+	RG_Matrix   A      =  NULL;
+	RG_Matrix   F      =  NULL;
+	RG_Matrix   B      =  NULL;
+	RG_Matrix   C      =  NULL;
+	RG_Matrix   D      =  NULL;
+	GrB_Matrix  M      =  NULL;
+	GrB_Matrix  E      =  NULL;
+	GrB_Matrix  N      =  NULL;
+	GrB_Info    info   =  GrB_SUCCESS;
+	GrB_Index   nvals  =  0;
+	GrB_Index   nrows  =  1000;
+	GrB_Index   ncols  =  1000;
+	GrB_Index   row;
+	GrB_Index   col;
+	uint64_t    x;
+
+	info = RG_Matrix_new(&A, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_new(&F, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	// each row i is connected to the following 5 rows
+	// edge IDs are not ordered by column
+	for(GrB_Index i = 0; i < nrows; i += 3) {
+		for(GrB_Index j = i + 1; j <= i + 5 && j < ncols; j++) {
+			x = (j * 7919) % 100003;
+			RG_Matrix_setElement_UINT64(A, x, i, j);
+			RG_Matrix_setElement_UINT64(F, x, i, j);
+		}
+	}
+
+	// multi-edge
+	RG_Matrix_setElement_UINT64(A, 1, 0, 1);
+	RG_Matrix_setElement_UINT64(F, 1, 0, 1);
+
+	RG_Matrix_wait(A, true);
+
+	info = RG_Matrix_freeze(F);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_TRUE(RG_Matrix_isFrozen(F));
+	ASSERT_TRUE(RG_Matrix_isFrozen(F->transposed));
+
+	// M is compressed
+	M = RG_MATRIX_M(F);
+	M_EMPTY();
+
+	RG_Matrix_nvals(&nvals, F);
+	ASSERT_EQ(nvals, 1663);
+
+	// compressed form is smaller than M
+	size_t a_size;
+	size_t f_size;
+	RG_Matrix_memoryUsage(&a_size, A);
+	RG_Matrix_memoryUsage(&f_size, F);
+	ASSERT_LT(f_size * 2, a_size);
+
+	//--------------------------------------------------------------------------
+	// extract
+	//--------------------------------------------------------------------------
+
+	info = RG_Matrix_extractElement_UINT64(&x, F, 3, 7);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_EQ(x, (7 * 7919) % 100003);
+
+	info = RG_Matrix_extractElement_UINT64(&x, F, 3, 9);
+	ASSERT_EQ(info, GrB_NO_VALUE);
+
+	info = RG_Matrix_extractElement_UINT64(&x, F, 0, 1);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_FALSE(SINGLE_EDGE(x));
+
+	bool b;
+	info = RG_Matrix_extractElement_BOOL(&b, F->transposed, 7, 3);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	//--------------------------------------------------------------------------
+	// pending changes
+	//--------------------------------------------------------------------------
+
+	// addition lands in delta-plus
+	RG_Matrix_setElement_UINT64(A, 5, 1, 0);
+	RG_Matrix_setElement_UINT64(F, 5, 1, 0);
+	ASSERT_TRUE(F->compressed != NULL);
+
+	// deletion of a compressed entry lands in delta-minus
+	RG_Matrix_removeElement_UINT64(A, 3, 4);
+	RG_Matrix_removeElement_UINT64(F, 3, 4);
+	ASSERT_TRUE(F->compressed != NULL);
+
+	info = RG_Matrix_extractElement_UINT64(&x, F, 3, 4);
+	ASSERT_EQ(info, GrB_NO_VALUE);
+
+	RG_Matrix_nvals(&nvals, F);
+	ASSERT_EQ(nvals, 1663);
+
+	//--------------------------------------------------------------------------
+	// iterate
+	//--------------------------------------------------------------------------
+
+	RG_MatrixTupleIter it;
+	GrB_Index count = 0;
+
+	RG_MatrixTupleIter_attach(&it, F);
+	while(RG_MatrixTupleIter_next_UINT64(&it, &row, &col, &x) == GrB_SUCCESS) {
+		uint64_t y;
+		info = RG_Matrix_extractElement_UINT64(&y, A, row, col);
+		ASSERT_EQ(info, GrB_SUCCESS);
+		// multi-edge arrays differ between A and F
+		if(SINGLE_EDGE(x)) ASSERT_EQ(x, y);
+		count++;
+	}
+	ASSERT_EQ(count, 1663);
+
+	RG_MatrixTupleIter_iterate_row(&it, 3);
+	count = 0;
+	while(RG_MatrixTupleIter_next_UINT64(&it, &row, &col, NULL) == GrB_SUCCESS) {
+		ASSERT_EQ(row, 3);
+		count++;
+	}
+	ASSERT_EQ(count, 4);
+
+	//--------------------------------------------------------------------------
+	// mxm
+	//--------------------------------------------------------------------------
+
+	info = RG_Matrix_new(&B, GrB_BOOL, nrows, nrows);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_new(&C, GrB_BOOL, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_new(&D, GrB_BOOL, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	for(GrB_Index i = 0; i < nrows; i += 2) {
+		RG_Matrix_setElement_BOOL(B, i, (i * 3) % nrows);
+	}
+	RG_Matrix_wait(B, true);
+
+	info = RG_mxm(C, GxB_ANY_PAIR_BOOL, B, A);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_mxm(D, GxB_ANY_PAIR_BOOL, B, F);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	ASSERT_GrB_Matrices_EQ(RG_MATRIX_M(C), RG_MATRIX_M(D));
+
+	//--------------------------------------------------------------------------
+	// compaction
+	//--------------------------------------------------------------------------
+
+	// adding an edge to a compressed entry decompresses M
+	RG_Matrix_setElement_UINT64(A, 9, 6, 7);
+	RG_Matrix_setElement_UINT64(F, 9, 6, 7);
+	ASSERT_TRUE(F->compressed == NULL);
+
+	// sync compresses M
+	RG_Matrix_wait(A, true);
+	RG_Matrix_wait(F, false);
+	ASSERT_TRUE(F->compressed != NULL);
+	ASSERT_TRUE(RG_Matrix_Synced(F));
+
+	info = RG_Matrix_export(&E, A);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_export(&N, F);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_GrB_Matrices_EQ(E, N);
+	GrB_Matrix_free(&N);
+
+	// thaw restores M
+	RG_Matrix_thaw(F);
+	ASSERT_FALSE(RG_Matrix_isFrozen(F));
+	ASSERT_TRUE(F->compressed == NULL);
+	ASSERT_GrB_Matrices_EQ(E, RG_MATRIX_M(F));
+
+	// clean up
+	GrB_Matrix_free(&E);
+	RG_Matrix_free(&A);
+	RG_Matrix_free(&F);
+	RG_Matrix_free(&B);
+	RG_Matrix_free(&C);
+	RG_Matrix_free(&D);
+	ASSERT_TRUE(F == NULL);
+}
+
 //#ifndef RG_DEBUG
 //// test RGMatrix_pending
 //// if RG_DEBUG is defined, each call to setElement will flush all 3 matrices
@@ -0,0 +1,134 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "../../src/util/rmalloc.h"
+#include "../../src/util/sketch/hll.h"
+#include "../../src/util/sketch/tdigest.h"
+#include "../../src/util/sketch/count_min.h"
+#include <math.h>
+#ifdef __cplusplus
+}
+#endif
+
+// spread sequential integers over the 64 bit hash space
+static uint64_t _hash(uint64_t x) {
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+class SketchTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+	}
+};
+
+//------------------------------------------------------------------------------
+// t-digest
+//------------------------------------------------------------------------------
+
+TEST_F(SketchTest, TDigestEmpty) {
+	TDigest *t = TDigest_New(TDIGEST_DEFAULT_COMPRESSION);
+
+	ASSERT_EQ(TDigest_Count(t), 0);
+	ASSERT_TRUE(isnan(TDigest_Quantile(t, 0.5)));
+
+	TDigest_Free(t);
+}
+
+TEST_F(SketchTest, TDigestSmallInputIsExact) {
+	TDigest *t = TDigest_New(TDIGEST_DEFAULT_COMPRESSION);
+
+	for(int i = 1; i <= 10; i++) TDigest_Add(t, i, 1);
+
+	ASSERT_EQ(TDigest_Count(t), 10);
+	ASSERT_EQ(TDigest_Quantile(t, 0), 1);
+	ASSERT_EQ(TDigest_Quantile(t, 1), 10);
+	ASSERT_EQ(TDigest_Quantile(t, 0.5), 5.5);
+
+	TDigest_Free(t);
+}
+
+TEST_F(SketchTest, TDigestLargeInput) {
+	TDigest *t = TDigest_New(TDIGEST_DEFAULT_COMPRESSION);
+
+	int n = 1000000;
+	for(int i = 0; i < n; i++) TDigest_Add(t, i, 1);
+	ASSERT_EQ(TDigest_Count(t), n);
+
+	// memory is bounded by compression
+	ASSERT_LT(t->merged, t->cap);
+
+	double qs[5] = {0.001, 0.01, 0.5, 0.99, 0.999};
+	for(int i = 0; i < 5; i++) {
+		double expected = qs[i] * n;
+		ASSERT_NEAR(TDigest_Quantile(t, qs[i]), expected, n * 0.001);
+	}
+
+	TDigest_Free(t);
+}
+
+//------------------------------------------------------------------------------
+// HyperLogLog
+//------------------------------------------------------------------------------
+
+TEST_F(SketchTest, HLLCount) {
+	HLL *hll = HLL_New();
+	ASSERT_EQ(HLL_Count(hll), 0);
+
+	// duplicates don't affect estimate
+	for(int j = 0; j < 3; j++) {
+		for(int i = 0; i < 100; i++) HLL_Add(hll, _hash(i));
+	}
+	ASSERT_NEAR(HLL_Count(hll), 100, 1);
+
+	HLL_Free(hll);
+}
+
+TEST_F(SketchTest, HLLLargeInput) {
+	HLL *hll = HLL_New();
+
+	int n = 1000000;
+	for(int i = 0; i < n; i++) HLL_Add(hll, _hash(i));
+	// overlapping values
+	for(int i = 0; i < n / 2; i++) HLL_Add(hll, _hash(i));
+
+	ASSERT_NEAR(HLL_Count(hll), n, n * 0.03);
+
+	HLL_Free(hll);
+}
+
+//------------------------------------------------------------------------------
+// Count-min sketch
+//------------------------------------------------------------------------------
+
+TEST_F(SketchTest, CMSFrequency) {
+	CountMinSketch *cms = CMS_New();
+
+	// value i appears i times
+	for(int i = 1; i <= 100; i++) {
+		for(int j = 0; j < i; j++) CMS_Increment(cms, _hash(i));
+	}
+
+	ASSERT_EQ(cms->total, 5050);
+
+	// estimates never underestimate
+	for(int i = 1; i <= 100; i++) {
+		ASSERT_GE(CMS_Query(cms, _hash(i)), i);
+		ASSERT_LE(CMS_Query(cms, _hash(i)), i + 5050 * M_E / CMS_WIDTH + 1);
+	}
+
+	CMS_Free(cms);
+}
+
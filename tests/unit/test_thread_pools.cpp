@@ -11,6 +11,7 @@ extern "C" {
 #endif
 
 #include "assert.h"
+#include <unistd.h>
 #include "../../src/util/rmalloc.h"
 #include "../../src/util/thpool/pools.h"
 #include "../../src/configuration/config.h"
@@ -20,6 +21,7 @@ extern "C" {
 #endif
 
 #define READER_COUNT 4
+#define READER_CAPACITY 4
 #define WRITER_COUNT 1
 
 class ThreadPoolsTest: public ::testing::Test {
@@ -27,13 +29,19 @@ class ThreadPoolsTest: public ::testing::Test {
 	// Use the malloc family for allocations
 	static void SetUpTestCase() {
 		Alloc_Reset();
-		ThreadPools_CreatePools(READER_COUNT, WRITER_COUNT, UINT64_MAX);
+		ThreadPools_CreatePools(READER_COUNT, READER_CAPACITY, WRITER_COUNT,
+				UINT64_MAX);
 	}
 
 	static void get_thread_friendly_id(void *arg) {
 		int *threadID = (int*)arg;
 		*threadID = ThreadPools_GetThreadID();	
 	}
+
+	static void get_thread_friendly_id_slow(void *arg) {
+		get_thread_friendly_id(arg);
+		usleep(1000);
+	}
 };
 
 TEST_F(ThreadPoolsTest, ThreadPools_ThreadID) {
@@ -83,3 +91,40 @@ TEST_F(ThreadPoolsTest, ThreadPools_ThreadID) {
 	}
 }
 
+
+TEST_F(ThreadPoolsTest, ThreadPools_Resize) {
+	const int job_count = 64;
+	int thread_ids[job_count];
+
+	// can't grow beyond capacity
+	ASSERT_EQ(0, ThreadPools_SetReadersCount(READER_CAPACITY + 1));
+	ASSERT_EQ(0, ThreadPools_SetReadersCount(0));
+	ASSERT_EQ(READER_COUNT, ThreadPools_ReadersCount());
+
+	// shrink readers pool
+	ASSERT_EQ(1, ThreadPools_SetReadersCount(2));
+	ASSERT_EQ(2, ThreadPools_ReadersCount());
+
+	// thread ids are stable, thread count reflects capacity
+	ASSERT_EQ(READER_CAPACITY + WRITER_COUNT, ThreadPools_ThreadCount());
+
+	for(int i = 0; i < job_count; i++) thread_ids[i] = -1;
+	for(int i = 0; i < job_count; i++) {
+		ASSERT_EQ(0, ThreadPools_AddWorkReader(get_thread_friendly_id_slow,
+					thread_ids + i));
+	}
+
+	for(int i = 0; i < job_count; i++) {
+		while(__atomic_load_n(thread_ids + i, __ATOMIC_RELAXED) == -1) {}
+	}
+
+	// only the first two readers serve jobs
+	for(int i = 0; i < job_count; i++) {
+		ASSERT_GE(thread_ids[i], 1);
+		ASSERT_LE(thread_ids[i], 2);
+	}
+
+	// grow readers pool back
+	ASSERT_EQ(1, ThreadPools_SetReadersCount(READER_CAPACITY));
+	ASSERT_EQ(READER_CAPACITY, ThreadPools_ReadersCount());
+}
@@ -349,7 +349,7 @@ TEST_F(ValueTest, TestSet) {
 }
 
 TEST_F(ValueTest, TestPath) {
-	Path *path = Path_New(3);
+	Path *path = Path_New(NULL, 3);
 	Path *clone;
 	Node *n;
 	Edge *e;
@@ -381,6 +381,13 @@ TEST_F(ValueTest, TestPath) {
 	ASSERT_EQ(Path_EdgeCount(path), 2);
 	ASSERT_EQ(Path_Len(path), 2);
 
+	// Make sure all nodes and edges IDs are in path.
+	for (uint i = 0; i < 2; i++) {
+		ASSERT_EQ(Path_GetNodeID(path, i), i);
+		ASSERT_EQ(Path_GetEdgeID(path, i), i);
+	}
+	ASSERT_EQ(Path_GetNodeID(path, 2), 2);
+
 	// Make sure all nodes and edges are in path.
 	for (uint i = 0; i < 2; i++) {
 		n = Path_GetNode(path, i);